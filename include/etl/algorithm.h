@@ -41,6 +41,7 @@ SOFTWARE.
 #include "stl/iterator.h"
 #include "stl/functional.h"
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "platform.h"
@@ -49,6 +50,9 @@ SOFTWARE.
 
 namespace etl
 {
+  template <typename T, const size_t SIZE_>
+  class array;
+
   //***************************************************************************
   /// Finds the greatest and the smallest element in the range (begin, end).<br>
   ///<a href="http://en.cppreference.com/w/cpp/algorithm/minmax_element"></a>
@@ -465,6 +469,192 @@ namespace etl
     return it;
   }
 
+  namespace private_algorithm
+  {
+    //*************************************************************************
+    /// Prefetches the element at a pointer.
+    //*************************************************************************
+    template <typename T>
+    void prefetch(T* p)
+    {
+      ETL_PREFETCH(p);
+    }
+
+    //*************************************************************************
+    /// Other iterators may not refer to contiguous memory, so do nothing.
+    //*************************************************************************
+    template <typename TIterator>
+    void prefetch(TIterator)
+    {
+    }
+  }
+
+  //***************************************************************************
+  /// branchless_lower_bound
+  ///\ingroup algorithm
+  /// Returns the same result as std::lower_bound, for random access iterators.
+  /// The loop always runs log2(N) times and the only decision in it is which
+  /// half to keep, which the compiler can turn into a conditional move, so
+  /// there are no mispredicted branches. When the iterators are pointers the
+  /// two possible next probes are prefetched.
+  //***************************************************************************
+  template <typename TIterator,
+            typename TValue,
+            typename TCompare>
+    TIterator branchless_lower_bound(TIterator     begin,
+                                     TIterator     end,
+                                     const TValue& value,
+                                     TCompare      compare)
+  {
+    typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
+
+    difference_t length = end - begin;
+
+    if (length == 0)
+    {
+      return begin;
+    }
+
+    while (length > 1)
+    {
+      difference_t half      = length / 2;
+      difference_t next_half = (length - half) / 2;
+
+      private_algorithm::prefetch(begin + next_half);
+      private_algorithm::prefetch(begin + half + next_half);
+
+      begin   = compare(begin[half], value) ? begin + half : begin;
+      length -= half;
+    }
+
+    return compare(*begin, value) ? begin + 1 : begin;
+  }
+
+  //***************************************************************************
+  /// branchless_lower_bound
+  ///\ingroup algorithm
+  /// Returns the same result as std::lower_bound, for random access iterators.
+  //***************************************************************************
+  template <typename TIterator,
+            typename TValue>
+    TIterator branchless_lower_bound(TIterator     begin,
+                                     TIterator     end,
+                                     const TValue& value)
+  {
+    typedef std::less<typename std::iterator_traits<TIterator>::value_type> compare;
+
+    return etl::branchless_lower_bound(begin, end, value, compare());
+  }
+
+  //***************************************************************************
+  /// branchless_upper_bound
+  ///\ingroup algorithm
+  /// Returns the same result as std::upper_bound, for random access iterators.
+  /// See branchless_lower_bound.
+  //***************************************************************************
+  template <typename TIterator,
+            typename TValue,
+            typename TCompare>
+    TIterator branchless_upper_bound(TIterator     begin,
+                                     TIterator     end,
+                                     const TValue& value,
+                                     TCompare      compare)
+  {
+    typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
+
+    difference_t length = end - begin;
+
+    if (length == 0)
+    {
+      return begin;
+    }
+
+    while (length > 1)
+    {
+      difference_t half      = length / 2;
+      difference_t next_half = (length - half) / 2;
+
+      private_algorithm::prefetch(begin + next_half);
+      private_algorithm::prefetch(begin + half + next_half);
+
+      begin   = compare(value, begin[half]) ? begin : begin + half;
+      length -= half;
+    }
+
+    return compare(value, *begin) ? begin : begin + 1;
+  }
+
+  //***************************************************************************
+  /// branchless_upper_bound
+  ///\ingroup algorithm
+  /// Returns the same result as std::upper_bound, for random access iterators.
+  //***************************************************************************
+  template <typename TIterator,
+            typename TValue>
+    TIterator branchless_upper_bound(TIterator     begin,
+                                     TIterator     end,
+                                     const TValue& value)
+  {
+    typedef std::less<typename std::iterator_traits<TIterator>::value_type> compare;
+
+    return etl::branchless_upper_bound(begin, end, value, compare());
+  }
+
+  //***************************************************************************
+  /// Selects whether the sorted containers search with branchless_lower_bound
+  /// and branchless_upper_bound for a key type.
+  /// The branchless search wins when comparisons are cheap. When they are not,
+  /// as with strings, speculating past the branches of std::lower_bound overlaps
+  /// the comparisons' memory accesses and is faster.
+  /// Specialise for user key types that are cheap to compare.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TKey>
+  struct use_branchless_search : etl::integral_constant<bool, etl::is_arithmetic<TKey>::value || etl::is_pointer<TKey>::value>
+  {
+  };
+
+  namespace private_algorithm
+  {
+    //*************************************************************************
+    /// The searches used by the sorted containers.
+    //*************************************************************************
+    template <bool BRANCHLESS>
+    struct sorted_search;
+
+    template <>
+    struct sorted_search<true>
+    {
+      template <typename TIterator, typename TValue, typename TCompare>
+      static TIterator lower_bound(TIterator begin, TIterator end, const TValue& value, TCompare compare)
+      {
+        return etl::branchless_lower_bound(begin, end, value, compare);
+      }
+
+      template <typename TIterator, typename TValue, typename TCompare>
+      static TIterator upper_bound(TIterator begin, TIterator end, const TValue& value, TCompare compare)
+      {
+        return etl::branchless_upper_bound(begin, end, value, compare);
+      }
+    };
+
+    template <>
+    struct sorted_search<false>
+    {
+      template <typename TIterator, typename TValue, typename TCompare>
+      static TIterator lower_bound(TIterator begin, TIterator end, const TValue& value, TCompare compare)
+      {
+        return std::lower_bound(begin, end, value, compare);
+      }
+
+      template <typename TIterator, typename TValue, typename TCompare>
+      static TIterator upper_bound(TIterator begin, TIterator end, const TValue& value, TCompare compare)
+      {
+        return std::upper_bound(begin, end, value, compare);
+      }
+    };
+  }
+
   //***************************************************************************
   /// find_if_not
   ///\ingroup algorithm
@@ -1122,47 +1312,1025 @@ namespace etl
     return std::pair<TDestinationTrue, TDestinationFalse>(destination_true, destination_false);
   }
 
-  //***************************************************************************
-  /// Sorts the elements using shell sort.
-  /// Uses users defined comparison.
-  ///\ingroup algorithm
-  //***************************************************************************
-  template <typename TIterator, typename TCompare>
-  void sort(TIterator first, TIterator last, TCompare compare)
+
+  namespace private_sort
   {
-    typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
-  
-    difference_t n = std::distance(first, last);
+    //*************************************************************************
+    /// Tuning parameters for the pattern defeating quicksort.
+    //*************************************************************************
+    enum
+    {
+      INSERTION_SORT_THRESHOLD      = 24,  ///< Ranges smaller than this are insertion sorted.
+      NINTHER_THRESHOLD             = 128, ///< Ranges larger than this use the Tukey ninther as the pivot.
+      PARTIAL_INSERTION_SORT_LIMIT  = 8,   ///< Maximum moves before a partial insertion sort gives up.
+      BLOCK_SIZE                    = 64,  ///< Elements per block in the branchless partition.
+      MERGE_SORT_RUN                = 16   ///< Length of the insertion sorted runs in the merge sort.
+    };
+
+    //*************************************************************************
+    /// Moves if the compiler supports it, otherwise copies.
+    //*************************************************************************
+#if ETL_CPP11_SUPPORTED
+    template <typename T>
+    T&& move(T& value)
+    {
+      return static_cast<T&&>(value);
+    }
+#else
+    template <typename T>
+    T& move(T& value)
+    {
+      return value;
+    }
+#endif
 
-    for (difference_t i = n / 2; i > 0; i /= 2) 
+    //*************************************************************************
+    /// Sorts the range with an insertion sort.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void insertion_sort(TIterator first, TIterator last, TCompare compare)
     {
-      for (difference_t j = i; j < n; ++j) 
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      if (first == last)
+      {
+        return;
+      }
+
+      for (TIterator current = first + 1; current != last; ++current)
       {
-        for (difference_t k = j - i; k >= 0; k -= i)
+        TIterator sift   = current;
+        TIterator sift_1 = current - 1;
+
+        if (compare(*sift, *sift_1))
         {
-          TIterator itr1 = first; 
-          TIterator itr2 = first;
-          
-          std::advance(itr1, k);
-          std::advance(itr2, k + i);
-          
-          if (compare(*itr2, *itr1))
+          value_t temp(private_sort::move(*sift));
+
+          do
           {
-            std::iter_swap(itr1, itr2);
-          }
+            *sift-- = private_sort::move(*sift_1);
+          } while ((sift != first) && compare(temp, *--sift_1));
+
+          *sift = private_sort::move(temp);
         }
       }
     }
-  }
 
-  //***************************************************************************
-  /// Sorts the elements using shell sort.
-  ///\ingroup algorithm
-  //***************************************************************************
-  template <typename TIterator>
-  void sort(TIterator first, TIterator last)
-  {
-    etl::sort(first, last, std::less<typename std::iterator_traits<TIterator>::value_type>());
+    //*************************************************************************
+    /// Sorts the range with an insertion sort.
+    /// The element before 'first' must not be greater than any in the range.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void unguarded_insertion_sort(TIterator first, TIterator last, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      if (first == last)
+      {
+        return;
+      }
+
+      for (TIterator current = first + 1; current != last; ++current)
+      {
+        TIterator sift   = current;
+        TIterator sift_1 = current - 1;
+
+        if (compare(*sift, *sift_1))
+        {
+          value_t temp(private_sort::move(*sift));
+
+          do
+          {
+            *sift-- = private_sort::move(*sift_1);
+          } while (compare(temp, *--sift_1));
+
+          *sift = private_sort::move(temp);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Attempts an insertion sort, but gives up if too many elements move.
+    /// Returns true if the range was sorted.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    bool partial_insertion_sort(TIterator first, TIterator last, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      if (first == last)
+      {
+        return true;
+      }
+
+      size_t limit = 0;
+
+      for (TIterator current = first + 1; current != last; ++current)
+      {
+        TIterator sift   = current;
+        TIterator sift_1 = current - 1;
+
+        if (compare(*sift, *sift_1))
+        {
+          value_t temp(private_sort::move(*sift));
+
+          do
+          {
+            *sift-- = private_sort::move(*sift_1);
+          } while ((sift != first) && compare(temp, *--sift_1));
+
+          *sift = private_sort::move(temp);
+          limit += (current - sift);
+        }
+
+        if (limit > PARTIAL_INSERTION_SORT_LIMIT)
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Sorts two elements.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void sort2(TIterator a, TIterator b, TCompare compare)
+    {
+      if (compare(*b, *a))
+      {
+        std::iter_swap(a, b);
+      }
+    }
+
+    //*************************************************************************
+    /// Sorts three elements.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void sort3(TIterator a, TIterator b, TIterator c, TCompare compare)
+    {
+      private_sort::sort2(a, b, compare);
+      private_sort::sort2(b, c, compare);
+      private_sort::sort2(a, b, compare);
+    }
+
+    //*************************************************************************
+    /// Sorts the range with a heap sort.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void heap_sort(TIterator first, TIterator last, TCompare compare)
+    {
+      std::make_heap(first, last, compare);
+
+      while ((last - first) > 1)
+      {
+        std::pop_heap(first, last, compare);
+        --last;
+      }
+    }
+
+    //*************************************************************************
+    /// Returns floor(log2(n)).
+    //*************************************************************************
+    template <typename T>
+    int log2(T n)
+    {
+      int result = 0;
+
+      while (n >>= 1)
+      {
+        ++result;
+      }
+
+      return result;
+    }
+
+    //*************************************************************************
+    /// Partitions around the pivot at 'first'.
+    /// Elements equal to the pivot go to the right.
+    /// Returns the pivot's final position and whether the range was already partitioned.
+    /// Requires an element not less than the pivot at the end of the range.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    std::pair<TIterator, bool> partition_right(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      value_t pivot(private_sort::move(*begin));
+
+      TIterator first = begin;
+      TIterator last  = end;
+
+      // Find the first element not less than the pivot.
+      while (compare(*++first, pivot))
+      {
+      }
+
+      // Find the last element less than the pivot.
+      // If nothing was skipped on the left then there is no guard element.
+      if ((first - 1) == begin)
+      {
+        while ((first < last) && !compare(*--last, pivot))
+        {
+        }
+      }
+      else
+      {
+        while (!compare(*--last, pivot))
+        {
+        }
+      }
+
+      const bool already_partitioned = (first >= last);
+
+      while (first < last)
+      {
+        std::iter_swap(first, last);
+
+        while (compare(*++first, pivot))
+        {
+        }
+
+        while (!compare(*--last, pivot))
+        {
+        }
+      }
+
+      TIterator pivot_position = first - 1;
+      *begin          = private_sort::move(*pivot_position);
+      *pivot_position = private_sort::move(pivot);
+
+      return std::pair<TIterator, bool>(pivot_position, already_partitioned);
+    }
+
+    //*************************************************************************
+    /// Swaps the misplaced elements found by the branchless partition.
+    //*************************************************************************
+    template <typename TIterator>
+    void swap_offsets(TIterator first, TIterator last,
+                      const unsigned char* offsets_l, const unsigned char* offsets_r,
+                      size_t n, bool use_swaps)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      if (use_swaps)
+      {
+        // Needed when the counts are equal, as the cyclic permutation would lose an element.
+        for (size_t i = 0; i < n; ++i)
+        {
+          std::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+        }
+      }
+      else if (n > 0)
+      {
+        TIterator l = first + offsets_l[0];
+        TIterator r = last  - offsets_r[0];
+
+        value_t temp(private_sort::move(*l));
+        *l = private_sort::move(*r);
+
+        for (size_t i = 1; i < n; ++i)
+        {
+          l  = first + offsets_l[i];
+          *r = private_sort::move(*l);
+          r  = last - offsets_r[i];
+          *l = private_sort::move(*r);
+        }
+
+        *r = private_sort::move(temp);
+      }
+    }
+
+    //*************************************************************************
+    /// As partition_right, but the comparisons are collected into blocks of
+    /// offsets so that the loops do not branch on the comparison result.
+    /// Only used for arithmetic types with the default comparisons.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    std::pair<TIterator, bool> partition_right_branchless(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      value_t pivot(private_sort::move(*begin));
+
+      TIterator first = begin;
+      TIterator last  = end;
+
+      while (compare(*++first, pivot))
+      {
+      }
+
+      if ((first - 1) == begin)
+      {
+        while ((first < last) && !compare(*--last, pivot))
+        {
+        }
+      }
+      else
+      {
+        while (!compare(*--last, pivot))
+        {
+        }
+      }
+
+      const bool already_partitioned = (first >= last);
+
+      if (!already_partitioned)
+      {
+        std::iter_swap(first, last);
+        ++first;
+
+        unsigned char offsets_l[BLOCK_SIZE];
+        unsigned char offsets_r[BLOCK_SIZE];
+
+        TIterator offsets_l_base = first;
+        TIterator offsets_r_base = last;
+        size_t    num_l   = 0;
+        size_t    num_r   = 0;
+        size_t    start_l = 0;
+        size_t    start_r = 0;
+
+        while (first < last)
+        {
+          // Fill whichever offset blocks are empty.
+          const size_t num_unknown = size_t(last - first);
+          const size_t left_split  = (num_l == 0) ? ((num_r == 0) ? (num_unknown / 2) : num_unknown) : 0;
+          const size_t right_split = (num_r == 0) ? (num_unknown - left_split) : 0;
+
+          const size_t left_count = (left_split < size_t(BLOCK_SIZE)) ? left_split : size_t(BLOCK_SIZE);
+
+          for (size_t i = 0; i < left_count; ++i)
+          {
+            offsets_l[num_l] = static_cast<unsigned char>(i);
+            num_l += !compare(*first, pivot);
+            ++first;
+          }
+
+          const size_t right_count = (right_split < size_t(BLOCK_SIZE)) ? right_split : size_t(BLOCK_SIZE);
+
+          for (size_t i = 1; i <= right_count; ++i)
+          {
+            offsets_r[num_r] = static_cast<unsigned char>(i);
+            num_r += compare(*--last, pivot);
+          }
+
+          // Swap the elements that are on the wrong side.
+          const size_t n = (num_l < num_r) ? num_l : num_r;
+          private_sort::swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l, offsets_r + start_r, n, num_l == num_r);
+
+          num_l   -= n;
+          num_r   -= n;
+          start_l += n;
+          start_r += n;
+
+          if (num_l == 0)
+          {
+            start_l        = 0;
+            offsets_l_base = first;
+          }
+
+          if (num_r == 0)
+          {
+            start_r        = 0;
+            offsets_r_base = last;
+          }
+        }
+
+        // At most one block has elements left over. Move them to the middle.
+        if (num_l != 0)
+        {
+          const unsigned char* offsets = offsets_l + start_l;
+
+          while (num_l-- != 0)
+          {
+            std::iter_swap(offsets_l_base + offsets[num_l], --last);
+          }
+
+          first = last;
+        }
+
+        if (num_r != 0)
+        {
+          const unsigned char* offsets = offsets_r + start_r;
+
+          while (num_r-- != 0)
+          {
+            std::iter_swap(offsets_r_base - offsets[num_r], first);
+            ++first;
+          }
+
+          last = first;
+        }
+      }
+
+      TIterator pivot_position = first - 1;
+      *begin          = private_sort::move(*pivot_position);
+      *pivot_position = private_sort::move(pivot);
+
+      return std::pair<TIterator, bool>(pivot_position, already_partitioned);
+    }
+
+    //*************************************************************************
+    /// Partitions around the pivot at 'first'.
+    /// Elements equal to the pivot go to the left.
+    /// Used when the pivot equals the element before the range, so that runs
+    /// of equal elements are skipped in linear time.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    TIterator partition_left(TIterator begin, TIterator end, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      value_t pivot(private_sort::move(*begin));
+
+      TIterator first = begin;
+      TIterator last  = end;
+
+      while (compare(pivot, *--last))
+      {
+      }
+
+      if ((last + 1) == end)
+      {
+        while ((first < last) && !compare(pivot, *++first))
+        {
+        }
+      }
+      else
+      {
+        while (!compare(pivot, *++first))
+        {
+        }
+      }
+
+      while (first < last)
+      {
+        std::iter_swap(first, last);
+
+        while (compare(pivot, *--last))
+        {
+        }
+
+        while (!compare(pivot, *++first))
+        {
+        }
+      }
+
+      TIterator pivot_position = last;
+      *begin          = private_sort::move(*pivot_position);
+      *pivot_position = private_sort::move(pivot);
+
+      return pivot_position;
+    }
+
+    //*************************************************************************
+    /// Chooses a pivot and moves it to 'first'.
+    /// Uses the median of three, or Tukey's ninther for large ranges.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void choose_pivot(TIterator first, TIterator last, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
+
+      const difference_t size = last - first;
+      const difference_t s2   = size / 2;
+
+      if (size > NINTHER_THRESHOLD)
+      {
+        private_sort::sort3(first,            first + s2,       last - 1, compare);
+        private_sort::sort3(first + 1,        first + (s2 - 1), last - 2, compare);
+        private_sort::sort3(first + 2,        first + (s2 + 1), last - 3, compare);
+        private_sort::sort3(first + (s2 - 1), first + s2,       first + (s2 + 1), compare);
+        std::iter_swap(first, first + s2);
+      }
+      else
+      {
+        private_sort::sort3(first + s2, first, last - 1, compare);
+      }
+    }
+
+    //*************************************************************************
+    /// Scatters some elements to break up patterns after a bad partition.
+    //*************************************************************************
+    template <typename TIterator>
+    void break_patterns(TIterator first, TIterator pivot_position, TIterator last)
+    {
+      typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
+
+      const difference_t l_size = pivot_position - first;
+      const difference_t r_size = last - (pivot_position + 1);
+
+      if (l_size >= INSERTION_SORT_THRESHOLD)
+      {
+        std::iter_swap(first,              first + l_size / 4);
+        std::iter_swap(pivot_position - 1, pivot_position - l_size / 4);
+
+        if (l_size > NINTHER_THRESHOLD)
+        {
+          std::iter_swap(first + 1,          first + (l_size / 4 + 1));
+          std::iter_swap(first + 2,          first + (l_size / 4 + 2));
+          std::iter_swap(pivot_position - 2, pivot_position - (l_size / 4 + 1));
+          std::iter_swap(pivot_position - 3, pivot_position - (l_size / 4 + 2));
+        }
+      }
+
+      if (r_size >= INSERTION_SORT_THRESHOLD)
+      {
+        std::iter_swap(pivot_position + 1, pivot_position + (1 + r_size / 4));
+        std::iter_swap(last - 1,           last - r_size / 4);
+
+        if (r_size > NINTHER_THRESHOLD)
+        {
+          std::iter_swap(pivot_position + 2, pivot_position + (2 + r_size / 4));
+          std::iter_swap(pivot_position + 3, pivot_position + (3 + r_size / 4));
+          std::iter_swap(last - 2,           last - (1 + r_size / 4));
+          std::iter_swap(last - 3,           last - (2 + r_size / 4));
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Pattern defeating quicksort.
+    /// Falls back to heap sort after too many unbalanced partitions.
+    /// 'leftmost' is false when the element before 'first' may be used as a guard.
+    //*************************************************************************
+    template <bool BRANCHLESS, typename TIterator, typename TCompare>
+    void pdq_sort(TIterator first, TIterator last, TCompare compare, int bad_allowed, bool leftmost)
+    {
+      typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
+
+      while (true)
+      {
+        const difference_t size = last - first;
+
+        if (size < INSERTION_SORT_THRESHOLD)
+        {
+          if (leftmost)
+          {
+            private_sort::insertion_sort(first, last, compare);
+          }
+          else
+          {
+            private_sort::unguarded_insertion_sort(first, last, compare);
+          }
+
+          return;
+        }
+
+        private_sort::choose_pivot(first, last, compare);
+
+        // If the pivot equals the guard then everything equal to it is already in place.
+        if (!leftmost && !compare(*(first - 1), *first))
+        {
+          first = private_sort::partition_left(first, last, compare) + 1;
+          continue;
+        }
+
+        const std::pair<TIterator, bool> partition = BRANCHLESS ? private_sort::partition_right_branchless(first, last, compare)
+                                                                : private_sort::partition_right(first, last, compare);
+
+        const TIterator pivot_position = partition.first;
+
+        const difference_t l_size = pivot_position - first;
+        const difference_t r_size = last - (pivot_position + 1);
+
+        if ((l_size < (size / 8)) || (r_size < (size / 8)))
+        {
+          if (--bad_allowed == 0)
+          {
+            private_sort::heap_sort(first, last, compare);
+            return;
+          }
+
+          private_sort::break_patterns(first, pivot_position, last);
+        }
+        else if (partition.second &&
+                 private_sort::partial_insertion_sort(first, pivot_position, compare) &&
+                 private_sort::partial_insertion_sort(pivot_position + 1, last, compare))
+        {
+          // The range was already, or nearly, sorted.
+          return;
+        }
+
+        // Recurse on the left, loop on the right.
+        private_sort::pdq_sort<BRANCHLESS>(first, pivot_position, compare, bad_allowed, leftmost);
+        first    = pivot_position + 1;
+        leftmost = false;
+      }
+    }
+
+    //*************************************************************************
+    /// The branchless partition is only worthwhile for arithmetic types with
+    /// the standard comparisons.
+    //*************************************************************************
+    template <typename T, typename TCompare>
+    struct use_branchless
+    {
+      static const bool value = etl::is_arithmetic<T>::value &&
+                                (etl::is_same<TCompare, std::less<T> >::value ||
+                                 etl::is_same<TCompare, std::greater<T> >::value);
+    };
+
+    //*************************************************************************
+    /// Shell sort for iterators that are not random access.
+    //*************************************************************************
+    template <typename TIterator, typename TCompare>
+    void shell_sort(TIterator first, TIterator last, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
+
+      difference_t n = std::distance(first, last);
+
+      for (difference_t i = n / 2; i > 0; i /= 2)
+      {
+        for (difference_t j = i; j < n; ++j)
+        {
+          for (difference_t k = j - i; k >= 0; k -= i)
+          {
+            TIterator itr1 = first;
+            TIterator itr2 = first;
+
+            std::advance(itr1, k);
+            std::advance(itr2, k + i);
+
+            if (compare(*itr2, *itr1))
+            {
+              std::iter_swap(itr1, itr2);
+            }
+            else
+            {
+              // The rest of this gap sequence is already in order.
+              break;
+            }
+          }
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Reverses a random access range.
+    //*************************************************************************
+    template <typename TIterator>
+    void reverse(TIterator first, TIterator last)
+    {
+      while ((last - first) > 1)
+      {
+        --last;
+        std::iter_swap(first, last);
+        ++first;
+      }
+    }
+
+    //*************************************************************************
+    /// Rotates a random access range so that 'middle' becomes the first element.
+    /// Returns the new position of the original first element.
+    //*************************************************************************
+    template <typename TIterator>
+    TIterator rotate(TIterator first, TIterator middle, TIterator last)
+    {
+      private_sort::reverse(first, middle);
+      private_sort::reverse(middle, last);
+      private_sort::reverse(first, last);
+
+      return first + (last - middle);
+    }
+
+    //*************************************************************************
+    /// Merges the sorted ranges [first, middle) and [middle, last).
+    /// Uses the buffer if one of the ranges fits, otherwise divides the
+    /// problem with a rotation until it does.
+    //*************************************************************************
+    template <typename TIterator, typename TBufferIterator, typename TDistance, typename TCompare>
+    void merge_adaptive(TIterator first, TIterator middle, TIterator last,
+                        TDistance length1, TDistance length2,
+                        TBufferIterator buffer, TDistance buffer_size,
+                        TCompare compare)
+    {
+      if ((length1 == 0) || (length2 == 0) || !compare(*middle, *(middle - 1)))
+      {
+        return;
+      }
+
+      if ((length1 + length2) == 2)
+      {
+        // The two elements are out of order.
+        std::iter_swap(first, middle);
+        return;
+      }
+
+      if ((length1 <= length2) && (length1 <= buffer_size))
+      {
+        // Move the left range to the buffer and merge forwards.
+        TBufferIterator b     = buffer;
+        TBufferIterator b_end = buffer;
+
+        for (TIterator itr = first; itr != middle; ++itr)
+        {
+          *b_end++ = private_sort::move(*itr);
+        }
+
+        TIterator r   = middle;
+        TIterator out = first;
+
+        while ((b != b_end) && (r != last))
+        {
+          if (compare(*r, *b))
+          {
+            *out++ = private_sort::move(*r++);
+          }
+          else
+          {
+            *out++ = private_sort::move(*b++);
+          }
+        }
+
+        while (b != b_end)
+        {
+          *out++ = private_sort::move(*b++);
+        }
+      }
+      else if (length2 <= buffer_size)
+      {
+        // Move the right range to the buffer and merge backwards.
+        TBufferIterator b_end = buffer;
+
+        for (TIterator itr = middle; itr != last; ++itr)
+        {
+          *b_end++ = private_sort::move(*itr);
+        }
+
+        TIterator l   = middle;
+        TIterator out = last;
+
+        while ((b_end != buffer) && (l != first))
+        {
+          if (compare(*(b_end - 1), *(l - 1)))
+          {
+            *--out = private_sort::move(*--l);
+          }
+          else
+          {
+            *--out = private_sort::move(*--b_end);
+          }
+        }
+
+        while (b_end != buffer)
+        {
+          *--out = private_sort::move(*--b_end);
+        }
+      }
+      else
+      {
+        TIterator cut1;
+        TIterator cut2;
+        TDistance length11;
+        TDistance length22;
+
+        if (length1 > length2)
+        {
+          length11 = length1 / 2;
+          cut1     = first + length11;
+          cut2     = std::lower_bound(middle, last, *cut1, compare);
+          length22 = TDistance(cut2 - middle);
+        }
+        else
+        {
+          length22 = length2 / 2;
+          cut2     = middle + length22;
+          cut1     = std::upper_bound(first, middle, *cut2, compare);
+          length11 = TDistance(cut1 - first);
+        }
+
+        TIterator new_middle = private_sort::rotate(cut1, middle, cut2);
+
+        private_sort::merge_adaptive(first, cut1, new_middle, length11, length22, buffer, buffer_size, compare);
+        private_sort::merge_adaptive(new_middle, cut2, last, TDistance(length1 - length11), TDistance(length2 - length22), buffer, buffer_size, compare);
+      }
+    }
+
+    //*************************************************************************
+    /// Bottom up merge sort.
+    /// Insertion sorts short runs, then merges them in pairs.
+    //*************************************************************************
+    template <typename TIterator, typename TBufferIterator, typename TCompare>
+    void merge_sort(TIterator first, TIterator last, TBufferIterator buffer, size_t buffer_size, TCompare compare)
+    {
+      typedef typename std::iterator_traits<TIterator>::difference_type difference_t;
+
+      const difference_t n = last - first;
+
+      for (difference_t i = 0; i < n; i += MERGE_SORT_RUN)
+      {
+        private_sort::insertion_sort(first + i, first + ((n - i) < MERGE_SORT_RUN ? n : i + MERGE_SORT_RUN), compare);
+      }
+
+      for (difference_t width = MERGE_SORT_RUN; width < n; width *= 2)
+      {
+        for (difference_t low = 0; low < (n - width); low += (2 * width))
+        {
+          const difference_t high = ((n - low) < (2 * width)) ? n : low + (2 * width);
+
+          private_sort::merge_adaptive(first + low, first + low + width, first + high,
+                                       width, high - (low + width),
+                                       buffer, difference_t(buffer_size),
+                                       compare);
+        }
+      }
+    }
+  }
+
+  //***************************************************************************
+  /// Sorts the elements.
+  /// Random access ranges use a pattern defeating quicksort, which is
+  /// O(N log N) in the worst case and O(N) for sorted or reversed ranges.
+  /// Other ranges use a shell sort.
+  /// Uses users defined comparison.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator, typename TCompare>
+  typename etl::enable_if<etl::is_random_iterator<TIterator>::value, void>::type
+    sort(TIterator first, TIterator last, TCompare compare)
+  {
+    typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+    if ((last - first) > 1)
+    {
+      private_sort::pdq_sort<private_sort::use_branchless<value_t, TCompare>::value>(first, last, compare, private_sort::log2(last - first), true);
+    }
+  }
+
+  //***************************************************************************
+  /// Sorts the elements using shell sort.
+  /// Uses users defined comparison.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator, typename TCompare>
+  typename etl::enable_if<!etl::is_random_iterator<TIterator>::value, void>::type
+    sort(TIterator first, TIterator last, TCompare compare)
+  {
+    private_sort::shell_sort(first, last, compare);
+  }
+
+  //***************************************************************************
+  /// Sorts the elements.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator>
+  void sort(TIterator first, TIterator last)
+  {
+    etl::sort(first, last, std::less<typename std::iterator_traits<TIterator>::value_type>());
+  }
+
+  //***************************************************************************
+  /// Sorts the elements, keeping the order of equal elements.
+  /// A merge sort that uses the caller's buffer as scratch space.
+  /// O(N log N) if the buffer holds half of the range, degrading gracefully
+  /// to O(N log² N) as the buffer gets smaller.
+  /// Uses users defined comparison.
+  ///\param buffer The scratch space. The contents are overwritten.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator, typename T, const size_t SIZE, typename TCompare>
+  void stable_sort(TIterator first, TIterator last, etl::array<T, SIZE>& buffer, TCompare compare)
+  {
+    private_sort::merge_sort(first, last, buffer.begin(), SIZE, compare);
+  }
+
+  //***************************************************************************
+  /// Sorts the elements, keeping the order of equal elements.
+  /// A merge sort that uses the caller's buffer as scratch space.
+  ///\param buffer The scratch space. The contents are overwritten.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator, typename T, const size_t SIZE>
+  void stable_sort(TIterator first, TIterator last, etl::array<T, SIZE>& buffer)
+  {
+    etl::stable_sort(first, last, buffer, std::less<typename std::iterator_traits<TIterator>::value_type>());
+  }
+
+  //***************************************************************************
+  /// Sorts the elements, keeping the order of equal elements.
+  /// An in-place merge sort. O(N log² N).
+  /// Uses users defined comparison.
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator, typename TCompare>
+  void stable_sort(TIterator first, TIterator last, TCompare compare)
+  {
+    typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+    private_sort::merge_sort(first, last, static_cast<value_t*>(0), 0U, compare);
+  }
+
+  //***************************************************************************
+  /// Sorts the elements, keeping the order of equal elements.
+  /// An in-place merge sort. O(N log² N).
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator>
+  void stable_sort(TIterator first, TIterator last)
+  {
+    etl::stable_sort(first, last, std::less<typename std::iterator_traits<TIterator>::value_type>());
+  }
+
+  //***************************************************************************
+  /// Sorts the smallest (middle - first) elements into [first, middle).
+  /// The order of the rest is unspecified.
+  /// Uses users defined comparison.
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/partial_sort"></a>
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator, typename TCompare>
+  void partial_sort(TIterator first, TIterator middle, TIterator last, TCompare compare)
+  {
+    if (first == middle)
+    {
+      return;
+    }
+
+    std::make_heap(first, middle, compare);
+
+    for (TIterator itr = middle; itr != last; ++itr)
+    {
+      if (compare(*itr, *first))
+      {
+        std::pop_heap(first, middle, compare);
+        std::iter_swap(middle - 1, itr);
+        std::push_heap(first, middle, compare);
+      }
+    }
+
+    private_sort::heap_sort(first, middle, compare);
+  }
+
+  //***************************************************************************
+  /// Sorts the smallest (middle - first) elements into [first, middle).
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/partial_sort"></a>
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator>
+  void partial_sort(TIterator first, TIterator middle, TIterator last)
+  {
+    etl::partial_sort(first, middle, last, std::less<typename std::iterator_traits<TIterator>::value_type>());
+  }
+
+  //***************************************************************************
+  /// Puts the element that would be at 'nth' in a sorted range at 'nth'.
+  /// No element before it is greater, and no element after it is less.
+  /// Introselect; O(N) on average and O(N log N) in the worst case.
+  /// Uses users defined comparison.
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/nth_element"></a>
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator, typename TCompare>
+  void nth_element(TIterator first, TIterator nth, TIterator last, TCompare compare)
+  {
+    if (nth == last)
+    {
+      return;
+    }
+
+    int depth_limit = 2 * private_sort::log2(last - first);
+
+    while ((last - first) > private_sort::INSERTION_SORT_THRESHOLD)
+    {
+      if (depth_limit-- == 0)
+      {
+        etl::partial_sort(first, nth + 1, last, compare);
+        return;
+      }
+
+      private_sort::choose_pivot(first, last, compare);
+
+      TIterator pivot_position = private_sort::partition_right(first, last, compare).first;
+
+      if (pivot_position == nth)
+      {
+        return;
+      }
+      else if (nth < pivot_position)
+      {
+        last = pivot_position;
+      }
+      else
+      {
+        first = pivot_position + 1;
+      }
+    }
+
+    private_sort::insertion_sort(first, last, compare);
+  }
+
+  //***************************************************************************
+  /// Puts the element that would be at 'nth' in a sorted range at 'nth'.
+  ///<a href="http://en.cppreference.com/w/cpp/algorithm/nth_element"></a>
+  ///\ingroup algorithm
+  //***************************************************************************
+  template <typename TIterator>
+  void nth_element(TIterator first, TIterator nth, TIterator last)
+  {
+    etl::nth_element(first, nth, last, std::less<typename std::iterator_traits<TIterator>::value_type>());
   }
 }
 
@@ -0,0 +1,569 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_ARENA_INCLUDED
+#define ETL_ARENA_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+
+#include "platform.h"
+
+#include "stl/utility.h"
+
+#include "error_handler.h"
+#include "exception.h"
+#include "alignment.h"
+#include "largest.h"
+#include "nullptr.h"
+#include "static_assert.h"
+#include "type_traits.h"
+
+#if ETL_CPP17_SUPPORTED && !defined(ETL_NO_STL)
+  #if defined(__has_include)
+    #if __has_include(<memory_resource>)
+      #define ETL_ARENA_MEMORY_RESOURCE
+    #endif
+  #else
+    #define ETL_ARENA_MEMORY_RESOURCE
+  #endif
+#endif
+
+#if defined(ETL_ARENA_MEMORY_RESOURCE)
+  #include <memory_resource>
+#endif
+
+#undef ETL_FILE
+#define ETL_FILE "60"
+
+#define ETL_ARENA_CPP03_CODE 0
+
+//*****************************************************************************
+///\defgroup arena arena
+/// A fixed capacity monotonic allocator.
+/// Allocation bumps an offset into the buffer. Nothing is freed individually;
+/// the arena is rewound to a marker, or reset, as a whole.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// The base class for arena exceptions.
+  ///\ingroup arena
+  //***************************************************************************
+  class arena_exception : public etl::exception
+  {
+  public:
+
+    arena_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The exception thrown when the arena has too little space left.
+  ///\ingroup arena
+  //***************************************************************************
+  class arena_no_allocation : public etl::arena_exception
+  {
+  public:
+
+    explicit arena_no_allocation(string_type file_name_, numeric_type line_number_)
+      : arena_exception(ETL_ERROR_TEXT("arena:allocation", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The exception thrown when the arena is rewound to a marker that is ahead
+  /// of the current position.
+  ///\ingroup arena
+  //***************************************************************************
+  class arena_invalid_marker : public etl::arena_exception
+  {
+  public:
+
+    explicit arena_invalid_marker(string_type file_name_, numeric_type line_number_)
+      : arena_exception(ETL_ERROR_TEXT("arena:invalid marker", ETL_FILE"B"), file_name_, line_number_)
+    {
+    }
+  };
+
+#if defined(ETL_ARENA_MEMORY_RESOURCE)
+  class arena_memory_resource;
+#endif
+
+  //***************************************************************************
+  /// The interface for an arena of any size.
+  /// Destructors of created objects are not called by rewind or reset.
+  ///\ingroup arena
+  //***************************************************************************
+  class iarena
+  {
+  public:
+
+    typedef size_t size_type;
+    typedef size_t marker_type;
+
+    /// The alignment used when none is specified.
+    static const size_t DEFAULT_ALIGNMENT = etl::largest_alignment<int64_t, double, void*>::value;
+
+    //*************************************************************************
+    /// Allocate 'size' bytes aligned to 'alignment', which must be a power of two.
+    /// If asserts or exceptions are enabled and there is not enough space left
+    /// an etl::arena_no_allocation is thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    void* allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT)
+    {
+      void* p = allocate_bytes(size, alignment);
+
+      ETL_ASSERT(p != nullptr, ETL_ERROR(etl::arena_no_allocation));
+
+      return p;
+    }
+
+    //*************************************************************************
+    /// Allocate uninitialised storage for 'n' objects of type 'T'.
+    /// If asserts or exceptions are enabled and there is not enough space left
+    /// an etl::arena_no_allocation is thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename T>
+    T* allocate(size_t n = 1)
+    {
+      void* p = nullptr;
+
+      if (n <= (CAPACITY / sizeof(T)))
+      {
+        p = allocate_bytes(n * sizeof(T), etl::alignment_of<T>::value);
+      }
+
+      ETL_ASSERT(p != nullptr, ETL_ERROR(etl::arena_no_allocation));
+
+      return static_cast<T*>(p);
+    }
+
+#if !ETL_CPP11_SUPPORTED || ETL_ARENA_CPP03_CODE || defined(ETL_STLPORT) || defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Allocate storage for an object and create default.
+    //*************************************************************************
+    template <typename T>
+    T* create()
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T();
+      }
+
+      return p;
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object and create with 1 parameter.
+    //*************************************************************************
+    template <typename T, typename T1>
+    T* create(const T1& value1)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2>
+    T* create(const T1& value1, const T2& value2)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3>
+    T* create(const T1& value1, const T2& value2, const T3& value3)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3, typename T4>
+    T* create(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3, value4);
+      }
+
+      return p;
+    }
+#else
+    //*************************************************************************
+    /// Emplace with variadic constructor parameters.
+    //*************************************************************************
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(std::forward<Args>(args)...);
+      }
+
+      return p;
+    }
+#endif
+
+    //*************************************************************************
+    /// Gets a marker for the current position.
+    //*************************************************************************
+    marker_type get_marker() const
+    {
+      return used;
+    }
+
+    //*************************************************************************
+    /// Releases everything allocated since the marker was taken.
+    /// If asserts or exceptions are enabled and the marker is ahead of the
+    /// current position an etl::arena_invalid_marker is thrown.
+    //*************************************************************************
+    void rewind(marker_type marker)
+    {
+      ETL_ASSERT(marker <= used, ETL_ERROR(etl::arena_invalid_marker));
+
+      if (marker <= used)
+      {
+        used = marker;
+      }
+    }
+
+    //*************************************************************************
+    /// Releases everything.
+    //*************************************************************************
+    void reset()
+    {
+      used = 0;
+    }
+
+    //*************************************************************************
+    /// Check to see if the address lies within the arena's buffer.
+    //*************************************************************************
+    bool is_in_arena(const void* p_object) const
+    {
+      const char* p = static_cast<const char*>(p_object);
+
+      return (p >= p_buffer) && (p < (p_buffer + CAPACITY));
+    }
+
+    //*************************************************************************
+    /// Returns the number of bytes allocated, including alignment padding.
+    //*************************************************************************
+    size_t size() const
+    {
+      return used;
+    }
+
+    //*************************************************************************
+    /// Returns the number of bytes in the buffer.
+    //*************************************************************************
+    size_t capacity() const
+    {
+      return CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Returns the number of bytes in the buffer.
+    //*************************************************************************
+    size_t max_size() const
+    {
+      return CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Returns the number of unallocated bytes, ignoring alignment padding.
+    //*************************************************************************
+    size_t available() const
+    {
+      return CAPACITY - used;
+    }
+
+    //*************************************************************************
+    /// Checks to see if nothing has been allocated.
+    //*************************************************************************
+    bool empty() const
+    {
+      return used == 0;
+    }
+
+    //*************************************************************************
+    /// Checks to see if every byte has been allocated.
+    //*************************************************************************
+    bool full() const
+    {
+      return used == CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Returns the largest number of bytes that have been allocated at once.
+    /// Useful for sizing the arena.
+    //*************************************************************************
+    size_t high_water_mark() const
+    {
+      return peak;
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    iarena(char* p_buffer_, size_t capacity_)
+      : p_buffer(p_buffer_),
+        used(0),
+        peak(0),
+        CAPACITY(capacity_)
+    {
+    }
+
+  private:
+
+#if defined(ETL_ARENA_MEMORY_RESOURCE)
+    friend class etl::arena_memory_resource;
+#endif
+
+    //*************************************************************************
+    /// Bumps the position past the aligned block.
+    /// Returns a nullptr, without changing anything, if the block does not fit.
+    //*************************************************************************
+    void* allocate_bytes(size_t size, size_t alignment)
+    {
+      const uintptr_t current = reinterpret_cast<uintptr_t>(p_buffer + used);
+      const size_t    padding = size_t((alignment - (current & (alignment - 1))) & (alignment - 1));
+
+      if ((padding > (CAPACITY - used)) || (size > (CAPACITY - used - padding)))
+      {
+        return nullptr;
+      }
+
+      char* p = p_buffer + used + padding;
+
+      used += padding + size;
+
+      if (used > peak)
+      {
+        peak = used;
+      }
+
+      return p;
+    }
+
+    // Disable copy construction and assignment.
+    iarena(const iarena&);
+    iarena& operator =(const iarena&);
+
+    char*        p_buffer;
+    size_t       used;     ///< The offset of the first unallocated byte.
+    size_t       peak;     ///< The largest value that 'used' has had.
+    const size_t CAPACITY;
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_ARENA) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~iarena()
+    {
+    }
+#else
+  protected:
+    ~iarena()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  /// An arena with its own buffer.
+  /// \tparam SIZE_      The number of bytes in the buffer.
+  /// \tparam ALIGNMENT_ The alignment of the start of the buffer.
+  ///\ingroup arena
+  //***************************************************************************
+  template <const size_t SIZE_, const size_t ALIGNMENT_ = etl::iarena::DEFAULT_ALIGNMENT>
+  class arena : public etl::iarena
+  {
+  public:
+
+    static const size_t SIZE      = SIZE_;
+    static const size_t ALIGNMENT = ALIGNMENT_;
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    arena()
+      : etl::iarena(reinterpret_cast<char*>(&buffer[0]), SIZE)
+    {
+    }
+
+  private:
+
+    // Should not be copied.
+    arena(const arena&);
+    arena& operator =(const arena&);
+
+    typename etl::aligned_storage<SIZE, ALIGNMENT>::type buffer[1];
+  };
+
+  //***************************************************************************
+  /// Rewinds an arena to where it was when the scope was entered.
+  ///\ingroup arena
+  //***************************************************************************
+  class arena_scope
+  {
+  public:
+
+    //*************************************************************************
+    /// Constructor. Takes a marker for the current position.
+    //*************************************************************************
+    explicit arena_scope(etl::iarena& arena_)
+      : arena(arena_),
+        marker(arena_.get_marker())
+    {
+    }
+
+    //*************************************************************************
+    /// Destructor. Releases everything allocated during the scope.
+    //*************************************************************************
+    ~arena_scope()
+    {
+      arena.rewind(marker);
+    }
+
+    //*************************************************************************
+    /// Gets the marker that the arena will be rewound to.
+    //*************************************************************************
+    etl::iarena::marker_type get_marker() const
+    {
+      return marker;
+    }
+
+  private:
+
+    // Should not be copied.
+    arena_scope(const arena_scope&);
+    arena_scope& operator =(const arena_scope&);
+
+    etl::iarena&                   arena;
+    const etl::iarena::marker_type marker;
+  };
+
+#if defined(ETL_ARENA_MEMORY_RESOURCE)
+  //***************************************************************************
+  /// Allows an arena to be used by the std::pmr containers.
+  /// Deallocation does nothing; the memory is recovered by rewinding or
+  /// resetting the arena. When the arena is exhausted, throws std::bad_alloc
+  /// if ETL_THROW_EXCEPTIONS is defined, otherwise raises arena_no_allocation
+  /// and returns nullptr.
+  ///\ingroup arena
+  //***************************************************************************
+  class arena_memory_resource : public std::pmr::memory_resource
+  {
+  public:
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    explicit arena_memory_resource(etl::iarena& arena_)
+      : arena(arena_)
+    {
+    }
+
+    //*************************************************************************
+    /// Gets the arena.
+    //*************************************************************************
+    etl::iarena& get_arena() const
+    {
+      return arena;
+    }
+
+  private:
+
+    void* do_allocate(size_t bytes, size_t alignment) override
+    {
+      void* p = arena.allocate_bytes(bytes, alignment);
+
+#if defined(ETL_THROW_EXCEPTIONS)
+      if (p == nullptr)
+      {
+        throw std::bad_alloc();
+      }
+#else
+      ETL_ASSERT(p != nullptr, ETL_ERROR(etl::arena_no_allocation));
+#endif
+
+      return p;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override
+    {
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+      return this == &other;
+    }
+
+    etl::iarena& arena;
+  };
+#endif
+}
+
+#undef ETL_FILE
+
+#endif
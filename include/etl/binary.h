@@ -50,6 +50,30 @@ SOFTWARE.
 #undef ETL_FILE
 #define ETL_FILE "50"
 
+//*****************************************************************************
+// The bit counting and byte swapping functions use the compiler's intrinsics
+// where they are available. These are usually a single instruction and may be
+// used in constant expressions.
+// count_bits and parity only use them if the target has a population count
+// instruction, as the library fallback is slower than the portable code.
+// Define ETL_NO_BINARY_BUILTINS to always use the portable versions.
+//*****************************************************************************
+#if !defined(ETL_NO_BINARY_BUILTINS) && (defined(ETL_COMPILER_GCC) || defined(__clang__))
+  #define ETL_BINARY_USE_BUILTINS 1
+  #define ETL_BINARY_CONSTEXPR    ETL_CONSTEXPR
+#else
+  #define ETL_BINARY_USE_BUILTINS 0
+  #define ETL_BINARY_CONSTEXPR
+#endif
+
+#if ETL_BINARY_USE_BUILTINS && (defined(__POPCNT__) || defined(__aarch64__))
+  #define ETL_BINARY_USE_BUILTIN_POPCOUNT 1
+  #define ETL_BINARY_POPCOUNT_CONSTEXPR   ETL_CONSTEXPR
+#else
+  #define ETL_BINARY_USE_BUILTIN_POPCOUNT 0
+  #define ETL_BINARY_POPCOUNT_CONSTEXPR
+#endif
+
 namespace etl
 {
   //***************************************************************************
@@ -618,12 +642,12 @@ namespace etl
   ///\ingroup binary
   //***************************************************************************
 #if ETL_8BIT_SUPPORT
-  inline uint8_t reverse_bytes(uint8_t value)
+  inline ETL_CONSTEXPR uint8_t reverse_bytes(uint8_t value)
   {
     return value;
   }
 
-  inline int8_t reverse_bytes(int8_t value)
+  inline ETL_CONSTEXPR int8_t reverse_bytes(int8_t value)
   {
     return value;
   }
@@ -633,14 +657,18 @@ namespace etl
   /// Reverse bytes 16 bit.
   ///\ingroup binary
   //***************************************************************************
-  inline uint16_t reverse_bytes(uint16_t value)
+  inline ETL_BINARY_CONSTEXPR uint16_t reverse_bytes(uint16_t value)
   {
+#if ETL_BINARY_USE_BUILTINS
+    return __builtin_bswap16(value);
+#else
     value = (value >> 8) | (value << 8);
 
     return value;
+#endif
   }
 
-  inline int16_t reverse_bytes(int16_t value)
+  inline ETL_BINARY_CONSTEXPR int16_t reverse_bytes(int16_t value)
   {
     return int16_t(reverse_bytes(uint16_t(value)));
   }
@@ -649,15 +677,19 @@ namespace etl
   /// Reverse bytes 32 bit.
   ///\ingroup binary
   //***************************************************************************
-  inline uint32_t reverse_bytes(uint32_t value)
+  inline ETL_BINARY_CONSTEXPR uint32_t reverse_bytes(uint32_t value)
   {
+#if ETL_BINARY_USE_BUILTINS
+    return __builtin_bswap32(value);
+#else
     value = ((value & 0xFF00FF00) >> 8) | ((value & 0x00FF00FF) << 8);
     value = (value >> 16) | (value << 16);
 
     return value;
+#endif
   }
 
-  inline int32_t reverse_bytes(int32_t value)
+  inline ETL_BINARY_CONSTEXPR int32_t reverse_bytes(int32_t value)
   {
     return int32_t(reverse_bytes(uint32_t(value)));
   }
@@ -666,16 +698,20 @@ namespace etl
   /// Reverse bytes 64 bit.
   ///\ingroup binary
   //***************************************************************************
-  inline uint64_t reverse_bytes(uint64_t value)
+  inline ETL_BINARY_CONSTEXPR uint64_t reverse_bytes(uint64_t value)
   {
+#if ETL_BINARY_USE_BUILTINS
+    return __builtin_bswap64(value);
+#else
     value = ((value & 0xFF00FF00FF00FF00) >> 8)  | ((value & 0x00FF00FF00FF00FF) << 8);
     value = ((value & 0xFFFF0000FFFF0000) >> 16) | ((value & 0x0000FFFF0000FFFF) << 16);
     value = (value >> 32) | (value << 32);
 
     return value;
+#endif
   }
 
-  inline int64_t reverse_bytes(int64_t value)
+  inline ETL_BINARY_CONSTEXPR int64_t reverse_bytes(int64_t value)
   {
     return int64_t(reverse_bytes(uint64_t(value)));
   }
@@ -765,20 +801,22 @@ namespace etl
   /// Count set bits. 8 bits.
   ///\ingroup binary
   //***************************************************************************
-  inline uint_least8_t count_bits(uint8_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t count_bits(uint8_t value)
   {
+#if ETL_BINARY_USE_BUILTIN_POPCOUNT
+    return uint_least8_t(__builtin_popcount(value));
+#else
     uint32_t count;
-    static const int S[] = { 1, 2, 4 };
-    static const uint8_t B[] = { 0x55, 0x33, 0x0F };
 
-    count = value - ((value >> 1) & B[0]);
-    count = ((count >> S[1]) & B[1]) + (count & B[1]);
-    count = ((count >> S[2]) + count) & B[2];
+    count = value - ((value >> 1) & 0x55);
+    count = ((count >> 2) & 0x33) + (count & 0x33);
+    count = ((count >> 4) + count) & 0x0F;
 
     return uint_least8_t(count);
+#endif
   }
 
-  inline uint_least8_t count_bits(int8_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t count_bits(int8_t value)
   {
     return count_bits(uint8_t(value));
   }
@@ -789,21 +827,23 @@ namespace etl
   /// Count set bits. 16 bits.
   ///\ingroup binary
   //***************************************************************************
-  inline uint_least8_t count_bits(uint16_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t count_bits(uint16_t value)
   {
+#if ETL_BINARY_USE_BUILTIN_POPCOUNT
+    return uint_least8_t(__builtin_popcount(value));
+#else
     uint32_t count;
-    static const int S[] = { 1, 2, 4, 8 };
-    static const uint16_t B[] = { 0x5555, 0x3333, 0x0F0F, 0x00FF };
 
-    count = value - ((value >> 1) & B[0]);
-    count = ((count >> S[1]) & B[1]) + (count & B[1]);
-    count = ((count >> S[2]) + count) & B[2];
-    count = ((count >> S[3]) + count) & B[3];
+    count = value - ((value >> 1) & 0x5555);
+    count = ((count >> 2) & 0x3333) + (count & 0x3333);
+    count = ((count >> 4) + count) & 0x0F0F;
+    count = ((count >> 8) + count) & 0x00FF;
 
-    return count;
+    return uint_least8_t(count);
+#endif
   }
 
-  inline uint_least8_t count_bits(int16_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t count_bits(int16_t value)
   {
     return count_bits(uint16_t(value));
   }
@@ -812,8 +852,11 @@ namespace etl
   /// Count set bits. 32 bits.
   ///\ingroup binary
   //***************************************************************************
-  inline uint_least8_t count_bits(uint32_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t count_bits(uint32_t value)
   {
+#if ETL_BINARY_USE_BUILTIN_POPCOUNT
+    return uint_least8_t(__builtin_popcountl(value));
+#else
     uint32_t count;
 
     value = value - ((value >> 1) & 0x55555555);
@@ -821,9 +864,10 @@ namespace etl
     count = (((value + (value >> 4)) & 0xF0F0F0F) * 0x1010101) >> 24;
 
     return uint_least8_t(count);
+#endif
   }
 
-  inline uint_least8_t count_bits(int32_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t count_bits(int32_t value)
   {
     return count_bits(uint32_t(value));
   }
@@ -832,23 +876,22 @@ namespace etl
   /// Count set bits. 64 bits.
   ///\ingroup binary
   //***************************************************************************
-  inline uint_least8_t count_bits(uint64_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t count_bits(uint64_t value)
   {
+#if ETL_BINARY_USE_BUILTIN_POPCOUNT
+    return uint_least8_t(__builtin_popcountll(value));
+#else
     uint64_t count;
-    static const int S[] = { 1, 2, 4, 8, 16, 32 };
-    static const uint64_t B[] = { 0x5555555555555555, 0x3333333333333333, 0x0F0F0F0F0F0F0F0F, 0x00FF00FF00FF00FF, 0x0000FFFF0000FFFF, 0x00000000FFFFFFFF };
 
-    count = value - ((value >> 1) & B[0]);
-    count = ((count >> S[1]) & B[1]) + (count & B[1]);
-    count = ((count >> S[2]) + count) & B[2];
-    count = ((count >> S[3]) + count) & B[3];
-    count = ((count >> S[4]) + count) & B[4];
-    count = ((count >> S[5]) + count) & B[5];
+    count = value - ((value >> 1) & 0x5555555555555555);
+    count = ((count >> 2) & 0x3333333333333333) + (count & 0x3333333333333333);
+    count = (((count + (count >> 4)) & 0x0F0F0F0F0F0F0F0F) * 0x0101010101010101) >> 56;
 
     return uint_least8_t(count);
+#endif
   }
 
-  inline uint_least8_t count_bits(int64_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t count_bits(int64_t value)
   {
     return count_bits(uint64_t(value));
   }
@@ -858,14 +901,18 @@ namespace etl
   /// Parity. 8bits. 0 = even, 1 = odd
   ///\ingroup binary
   //***************************************************************************
-  inline uint_least8_t parity(uint8_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t parity(uint8_t value)
   {
+#if ETL_BINARY_USE_BUILTIN_POPCOUNT
+    return uint_least8_t(__builtin_parity(value));
+#else
     value ^= value >> 4;
     value &= 0x0F;
     return (0x6996 >> value) & 1;
+#endif
   }
 
-  inline uint_least8_t parity(int8_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t parity(int8_t value)
   {
     return parity(uint8_t(value));
   }
@@ -875,15 +922,19 @@ namespace etl
   /// Parity. 16bits. 0 = even, 1 = odd
   ///\ingroup binary
   //***************************************************************************
-  inline uint_least8_t parity(uint16_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t parity(uint16_t value)
   {
+#if ETL_BINARY_USE_BUILTIN_POPCOUNT
+    return uint_least8_t(__builtin_parity(value));
+#else
     value ^= value >> 8;
     value ^= value >> 4;
     value &= 0x0F;
     return (0x6996 >> value) & 1;
+#endif
   }
 
-  inline uint_least8_t parity(int16_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t parity(int16_t value)
   {
     return parity(uint16_t(value));
   }
@@ -892,16 +943,20 @@ namespace etl
   /// Parity. 32bits. 0 = even, 1 = odd
   ///\ingroup binary
   //***************************************************************************
-  inline uint_least8_t parity(uint32_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t parity(uint32_t value)
   {
+#if ETL_BINARY_USE_BUILTIN_POPCOUNT
+    return uint_least8_t(__builtin_parityl(value));
+#else
     value ^= value >> 16;
     value ^= value >> 8;
     value ^= value >> 4;
     value &= 0x0F;
     return (0x6996 >> value) & 1;
+#endif
   }
 
-  inline uint_least8_t parity(int32_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t parity(int32_t value)
   {
     return parity(uint32_t(value));
   }
@@ -910,17 +965,21 @@ namespace etl
   /// Parity. 64bits. 0 = even, 1 = odd
   ///\ingroup binary
   //***************************************************************************
-  inline uint_least8_t parity(uint64_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t parity(uint64_t value)
   {
+#if ETL_BINARY_USE_BUILTIN_POPCOUNT
+    return uint_least8_t(__builtin_parityll(value));
+#else
     value ^= value >> 32;
     value ^= value >> 16;
     value ^= value >> 8;
     value ^= value >> 4;
     value &= 0x0F;
     return (0x69966996 >> value) & 1;
+#endif
   }
 
-  inline uint_least8_t parity(int64_t value)
+  inline ETL_BINARY_POPCOUNT_CONSTEXPR uint_least8_t parity(int64_t value)
   {
     return parity(uint64_t(value));
   }
@@ -928,14 +987,21 @@ namespace etl
 #if ETL_8BIT_SUPPORT
   //***************************************************************************
   /// Count trailing zeros. bit.
-  /// Uses a binary search.
+  /// Returns the number of bits if the value is zero.
   ///\ingroup binary
   //***************************************************************************
-  inline uint_least8_t count_trailing_zeros(uint8_t value)
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_trailing_zeros(uint8_t value)
   {
+#if ETL_BINARY_USE_BUILTINS
+    return (value == 0) ? uint_least8_t(8) : uint_least8_t(__builtin_ctz(value));
+#else
     uint_least8_t count;
 
-    if (value & 0x1)
+    if (value == 0)
+    {
+      count = 8;
+    }
+    else if (value & 0x1)
     {
       count = 0;
     }
@@ -959,9 +1025,10 @@ namespace etl
     }
 
     return count;
+#endif
   }
 
-  inline uint_least8_t count_trailing_zeros(int8_t value)
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_trailing_zeros(int8_t value)
   {
     return count_trailing_zeros(uint8_t(value));
   }
@@ -969,14 +1036,21 @@ namespace etl
 
   //***************************************************************************
   /// Count trailing zeros. 16bit.
-  /// Uses a binary search.
+  /// Returns the number of bits if the value is zero.
   ///\ingroup binary
   //***************************************************************************
-  inline uint_least8_t count_trailing_zeros(uint16_t value)
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_trailing_zeros(uint16_t value)
   {
+#if ETL_BINARY_USE_BUILTINS
+    return (value == 0) ? uint_least8_t(16) : uint_least8_t(__builtin_ctz(value));
+#else
     uint_least8_t count;
 
-    if (value & 0x1)
+    if (value == 0)
+    {
+      count = 16;
+    }
+    else if (value & 0x1)
     {
       count = 0;
     }
@@ -1006,23 +1080,31 @@ namespace etl
     }
 
     return count;
+#endif
   }
 
-  inline uint_least8_t count_trailing_zeros(int16_t value)
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_trailing_zeros(int16_t value)
   {
     return count_trailing_zeros(uint16_t(value));
   }
 
   //***************************************************************************
   /// Count trailing zeros. 32bit.
-  /// Uses a binary search.
+  /// Returns the number of bits if the value is zero.
   ///\ingroup binary
   //***************************************************************************
-  inline uint_least8_t count_trailing_zeros(uint32_t value)
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_trailing_zeros(uint32_t value)
   {
+#if ETL_BINARY_USE_BUILTINS
+    return (value == 0) ? uint_least8_t(32) : uint_least8_t(__builtin_ctzl(value));
+#else
     uint_least8_t count;
 
-    if (value & 0x1)
+    if (value == 0)
+    {
+      count = 32;
+    }
+    else if (value & 0x1)
     {
       count = 0;
     }
@@ -1058,71 +1140,306 @@ namespace etl
     }
 
     return count;
+#endif
   }
 
-  inline uint_least8_t count_trailing_zeros(int32_t value)
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_trailing_zeros(int32_t value)
   {
     return count_trailing_zeros(uint32_t(value));
   }
 
   //***************************************************************************
   /// Count trailing zeros. 64bit.
-  /// Uses a binary search.
+  /// Returns the number of bits if the value is zero.
   ///\ingroup binary
   //***************************************************************************
-  inline uint_least8_t count_trailing_zeros(uint64_t value)
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_trailing_zeros(uint64_t value)
   {
-      uint_least8_t count;
+#if ETL_BINARY_USE_BUILTINS
+    return (value == 0) ? uint_least8_t(64) : uint_least8_t(__builtin_ctzll(value));
+#else
+    uint_least8_t count;
 
-      if (value & 0x1)
+    if (value == 0)
+    {
+      count = 64;
+    }
+    else if (value & 0x1)
+    {
+      count = 0;
+    }
+    else
+    {
+      count = 1;
+
+      if ((value & 0xFFFFFFFF) == 0)
+      {
+        value >>= 32;
+        count += 32;
+      }
+
+      if ((value & 0xFFFF) == 0)
       {
-        count = 0;
+        value >>= 16;
+        count += 16;
+      }
+
+      if ((value & 0xFF) == 0)
+      {
+        value >>= 8;
+        count += 8;
+      }
+
+      if ((value & 0xF) == 0)
+      {
+        value >>= 4;
+        count += 4;
       }
-      else
+
+      if ((value & 0x3) == 0)
       {
-        count = 1;
-
-        if ((value & 0xFFFFFFFF) == 0)
-        {
-          value >>= 32;
-          count += 32;
-        }
-
-        if ((value & 0xFFFF) == 0)
-        {
-          value >>= 16;
-          count += 16;
-        }
-
-        if ((value & 0xFF) == 0)
-        {
-          value >>= 8;
-          count += 8;
-        }
-
-        if ((value & 0xF) == 0)
-        {
-          value >>= 4;
-          count += 4;
-        }
-
-        if ((value & 0x3) == 0)
-        {
-          value >>= 2;
-          count += 2;
-        }
-
-        count -= value & 0x1;
+        value >>= 2;
+        count += 2;
       }
 
-      return count;
+      count -= value & 0x1;
+    }
+
+    return count;
+#endif
   }
 
-  inline uint_least8_t count_trailing_zeros(int64_t value)
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_trailing_zeros(int64_t value)
   {
     return count_trailing_zeros(uint64_t(value));
   }
 
+#if ETL_8BIT_SUPPORT
+  //***************************************************************************
+  /// Count leading zeros. 8bit.
+  /// Returns the number of bits if the value is zero.
+  ///\ingroup binary
+  //***************************************************************************
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_leading_zeros(uint8_t value)
+  {
+#if ETL_BINARY_USE_BUILTINS
+    return (value == 0) ? uint_least8_t(8) : uint_least8_t(__builtin_clz(value) - (etl::integral_limits<unsigned int>::bits - 8));
+#else
+    uint_least8_t count;
+
+    if (value == 0)
+    {
+      count = 8;
+    }
+    else
+    {
+      count = 0;
+
+      if ((value & 0xF0) == 0)
+      {
+        value <<= 4;
+        count += 4;
+      }
+
+      if ((value & 0xC0) == 0)
+      {
+        value <<= 2;
+        count += 2;
+      }
+
+      if ((value & 0x80) == 0)
+      {
+        ++count;
+      }
+    }
+
+    return count;
+#endif
+  }
+
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_leading_zeros(int8_t value)
+  {
+    return count_leading_zeros(uint8_t(value));
+  }
+#endif
+
+  //***************************************************************************
+  /// Count leading zeros. 16bit.
+  /// Returns the number of bits if the value is zero.
+  ///\ingroup binary
+  //***************************************************************************
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_leading_zeros(uint16_t value)
+  {
+#if ETL_BINARY_USE_BUILTINS
+    return (value == 0) ? uint_least8_t(16) : uint_least8_t(__builtin_clz(value) - (etl::integral_limits<unsigned int>::bits - 16));
+#else
+    uint_least8_t count;
+
+    if (value == 0)
+    {
+      count = 16;
+    }
+    else
+    {
+      count = 0;
+
+      if ((value & 0xFF00) == 0)
+      {
+        value <<= 8;
+        count += 8;
+      }
+
+      if ((value & 0xF000) == 0)
+      {
+        value <<= 4;
+        count += 4;
+      }
+
+      if ((value & 0xC000) == 0)
+      {
+        value <<= 2;
+        count += 2;
+      }
+
+      if ((value & 0x8000) == 0)
+      {
+        ++count;
+      }
+    }
+
+    return count;
+#endif
+  }
+
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_leading_zeros(int16_t value)
+  {
+    return count_leading_zeros(uint16_t(value));
+  }
+
+  //***************************************************************************
+  /// Count leading zeros. 32bit.
+  /// Returns the number of bits if the value is zero.
+  ///\ingroup binary
+  //***************************************************************************
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_leading_zeros(uint32_t value)
+  {
+#if ETL_BINARY_USE_BUILTINS
+    return (value == 0) ? uint_least8_t(32) : uint_least8_t(__builtin_clzl(value) - (etl::integral_limits<unsigned long>::bits - 32));
+#else
+    uint_least8_t count;
+
+    if (value == 0)
+    {
+      count = 32;
+    }
+    else
+    {
+      count = 0;
+
+      if ((value & 0xFFFF0000) == 0)
+      {
+        value <<= 16;
+        count += 16;
+      }
+
+      if ((value & 0xFF000000) == 0)
+      {
+        value <<= 8;
+        count += 8;
+      }
+
+      if ((value & 0xF0000000) == 0)
+      {
+        value <<= 4;
+        count += 4;
+      }
+
+      if ((value & 0xC0000000) == 0)
+      {
+        value <<= 2;
+        count += 2;
+      }
+
+      if ((value & 0x80000000) == 0)
+      {
+        ++count;
+      }
+    }
+
+    return count;
+#endif
+  }
+
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_leading_zeros(int32_t value)
+  {
+    return count_leading_zeros(uint32_t(value));
+  }
+
+  //***************************************************************************
+  /// Count leading zeros. 64bit.
+  /// Returns the number of bits if the value is zero.
+  ///\ingroup binary
+  //***************************************************************************
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_leading_zeros(uint64_t value)
+  {
+#if ETL_BINARY_USE_BUILTINS
+    return (value == 0) ? uint_least8_t(64) : uint_least8_t(__builtin_clzll(value));
+#else
+    uint_least8_t count;
+
+    if (value == 0)
+    {
+      count = 64;
+    }
+    else
+    {
+      count = 0;
+
+      if ((value & 0xFFFFFFFF00000000) == 0)
+      {
+        value <<= 32;
+        count += 32;
+      }
+
+      if ((value & 0xFFFF000000000000) == 0)
+      {
+        value <<= 16;
+        count += 16;
+      }
+
+      if ((value & 0xFF00000000000000) == 0)
+      {
+        value <<= 8;
+        count += 8;
+      }
+
+      if ((value & 0xF000000000000000) == 0)
+      {
+        value <<= 4;
+        count += 4;
+      }
+
+      if ((value & 0xC000000000000000) == 0)
+      {
+        value <<= 2;
+        count += 2;
+      }
+
+      if ((value & 0x8000000000000000) == 0)
+      {
+        ++count;
+      }
+    }
+
+    return count;
+#endif
+  }
+
+  inline ETL_BINARY_CONSTEXPR uint_least8_t count_leading_zeros(int64_t value)
+  {
+    return count_leading_zeros(uint64_t(value));
+  }
+
 #if ETL_8BIT_SUPPORT
   //*****************************************************************************
   /// Binary interleave
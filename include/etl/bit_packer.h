@@ -0,0 +1,354 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_BIT_PACKER_INCLUDED
+#define ETL_BIT_PACKER_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+
+#include "platform.h"
+#include "binary.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "static_assert.h"
+
+#undef ETL_FILE
+#define ETL_FILE "64"
+
+///\defgroup bit_packer bit_packer
+/// Packs blocks of integers to a fixed number of bits each.
+///\ingroup utilities
+
+namespace etl
+{
+  //***************************************************************************
+  /// The base class for bit_packer exceptions.
+  ///\ingroup bit_packer
+  //***************************************************************************
+  class bit_packer_exception : public etl::exception
+  {
+  public:
+
+    bit_packer_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The invalid width exception.
+  ///\ingroup bit_packer
+  //***************************************************************************
+  class bit_packer_invalid_width : public etl::bit_packer_exception
+  {
+  public:
+
+    explicit bit_packer_invalid_width(string_type file_name_, numeric_type line_number_)
+      : bit_packer_exception(ETL_ERROR_TEXT("bit_packer:width", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  namespace private_bit_packer
+  {
+    //*************************************************************************
+    /// The mask for the lowest BITS bits of a TWord.
+    //*************************************************************************
+    template <typename TWord, const size_t BITS>
+    struct mask
+    {
+      static const size_t WORD_BITS = CHAR_BIT * sizeof(TWord);
+
+      static const TWord value = (BITS == 0) ? TWord(0) : TWord(TWord(~TWord(0)) >> ((WORD_BITS - BITS) % WORD_BITS));
+    };
+  }
+
+  //***************************************************************************
+  /// Packs blocks of unsigned integers to BITS bits each, as in FastPFor.
+  /// A block of 32 uint32_t values packs to BITS uint32_t words, and a block of
+  /// 64 uint64_t values packs to BITS uint64_t words.
+  /// Values are stored least significant bit first, from bit 0 of the first word.
+  /// The loops have a fixed trip count and every shift is a constant once they
+  /// are unrolled, so compilers unroll and vectorise them.
+  /// The overloads with a 'reference' store each value less the reference
+  /// (frame of reference coding), so values close to the reference need few bits.
+  ///\tparam BITS The number of bits for each value.
+  ///\ingroup bit_packer
+  //***************************************************************************
+  template <const size_t BITS>
+  class bit_packer
+  {
+  public:
+
+    static const size_t BLOCK_SIZE_32 = 32; ///< The number of uint32_t values in a block.
+    static const size_t BLOCK_SIZE_64 = 64; ///< The number of uint64_t values in a block.
+
+    //*************************************************************************
+    /// Packs 32 values to BITS words.
+    //*************************************************************************
+    static void pack(const uint32_t* input, uint32_t* output, uint32_t reference = 0U)
+    {
+      pack_block(input, output, reference);
+    }
+
+    //*************************************************************************
+    /// Unpacks BITS words to 32 values.
+    //*************************************************************************
+    static void unpack(const uint32_t* input, uint32_t* output, uint32_t reference = 0U)
+    {
+      unpack_block(input, output, reference);
+    }
+
+    //*************************************************************************
+    /// Packs 64 values to BITS words.
+    //*************************************************************************
+    static void pack(const uint64_t* input, uint64_t* output, uint64_t reference = 0U)
+    {
+      pack_block(input, output, reference);
+    }
+
+    //*************************************************************************
+    /// Unpacks BITS words to 64 values.
+    //*************************************************************************
+    static void unpack(const uint64_t* input, uint64_t* output, uint64_t reference = 0U)
+    {
+      unpack_block(input, output, reference);
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Packs one block.
+    //*************************************************************************
+    template <typename TWord>
+    static void pack_block(const TWord* input, TWord* output, TWord reference)
+    {
+      static const size_t WORD_BITS = CHAR_BIT * sizeof(TWord);
+      static const TWord  MASK      = private_bit_packer::mask<TWord, BITS>::value;
+
+      ETL_STATIC_ASSERT(BITS <= WORD_BITS, "BITS is wider than the word");
+
+      if (BITS == 0)
+      {
+        return;
+      }
+
+      TWord  word  = 0U;
+      size_t shift = 0U;
+
+      for (size_t i = 0U; i < WORD_BITS; ++i)
+      {
+        const TWord value = TWord(input[i] - reference) & MASK;
+
+        word  |= TWord(value << shift);
+        shift += BITS;
+
+        if (shift >= WORD_BITS)
+        {
+          *output++ = word;
+          shift -= WORD_BITS;
+
+          // The bits that did not fit start the next word.
+          word = (shift != 0U) ? TWord(value >> (BITS - shift)) : TWord(0U);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Unpacks one block.
+    //*************************************************************************
+    template <typename TWord>
+    static void unpack_block(const TWord* input, TWord* output, TWord reference)
+    {
+      static const size_t WORD_BITS = CHAR_BIT * sizeof(TWord);
+      static const TWord  MASK      = private_bit_packer::mask<TWord, BITS>::value;
+
+      ETL_STATIC_ASSERT(BITS <= WORD_BITS, "BITS is wider than the word");
+
+      if (BITS == 0)
+      {
+        for (size_t i = 0U; i < WORD_BITS; ++i)
+        {
+          output[i] = reference;
+        }
+
+        return;
+      }
+
+      size_t shift = 0U;
+
+      for (size_t i = 0U; i < WORD_BITS; ++i)
+      {
+        TWord value = TWord(*input >> shift);
+        shift += BITS;
+
+        if (shift >= WORD_BITS)
+        {
+          ++input;
+          shift -= WORD_BITS;
+
+          // The rest of the bits are at the start of the next word.
+          if (shift != 0U)
+          {
+            value |= TWord(*input << (BITS - shift));
+          }
+        }
+
+        output[i] = TWord((value & MASK) + reference);
+      }
+    }
+  };
+
+  namespace private_bit_packer
+  {
+    //*************************************************************************
+    /// Selects the bit_packer for a width known only at run time.
+    //*************************************************************************
+    template <typename TWord, const size_t BITS>
+    struct dispatch
+    {
+      static void pack(const TWord* input, TWord* output, size_t bits, TWord reference)
+      {
+        if (bits == BITS)
+        {
+          etl::bit_packer<BITS>::pack(input, output, reference);
+        }
+        else
+        {
+          dispatch<TWord, BITS - 1>::pack(input, output, bits, reference);
+        }
+      }
+
+      static void unpack(const TWord* input, TWord* output, size_t bits, TWord reference)
+      {
+        if (bits == BITS)
+        {
+          etl::bit_packer<BITS>::unpack(input, output, reference);
+        }
+        else
+        {
+          dispatch<TWord, BITS - 1>::unpack(input, output, bits, reference);
+        }
+      }
+    };
+
+    template <typename TWord>
+    struct dispatch<TWord, 0>
+    {
+      static void pack(const TWord* input, TWord* output, size_t, TWord reference)
+      {
+        etl::bit_packer<0>::pack(input, output, reference);
+      }
+
+      static void unpack(const TWord* input, TWord* output, size_t, TWord reference)
+      {
+        etl::bit_packer<0>::unpack(input, output, reference);
+      }
+    };
+  }
+
+  //***************************************************************************
+  /// Returns the number of bits needed to pack the values, less the reference.
+  ///\ingroup bit_packer
+  //***************************************************************************
+  inline size_t bit_pack_width(const uint32_t* input, size_t count, uint32_t reference = 0U)
+  {
+    uint32_t all = 0U;
+
+    for (size_t i = 0U; i < count; ++i)
+    {
+      all |= uint32_t(input[i] - reference);
+    }
+
+    return (all == 0U) ? 0U : (32U - etl::count_leading_zeros(all));
+  }
+
+  inline size_t bit_pack_width(const uint64_t* input, size_t count, uint64_t reference = 0U)
+  {
+    uint64_t all = 0U;
+
+    for (size_t i = 0U; i < count; ++i)
+    {
+      all |= uint64_t(input[i] - reference);
+    }
+
+    return (all == 0U) ? 0U : (64U - etl::count_leading_zeros(all));
+  }
+
+  //***************************************************************************
+  /// Packs a block of 32 values to 'bits' bits each, chosen at run time.
+  ///\ingroup bit_packer
+  //***************************************************************************
+  inline void bit_pack(const uint32_t* input, uint32_t* output, size_t bits, uint32_t reference = 0U)
+  {
+    ETL_ASSERT(bits <= 32U, ETL_ERROR(bit_packer_invalid_width));
+
+    private_bit_packer::dispatch<uint32_t, 32>::pack(input, output, bits, reference);
+  }
+
+  //***************************************************************************
+  /// Unpacks a block of 32 values of 'bits' bits each, chosen at run time.
+  ///\ingroup bit_packer
+  //***************************************************************************
+  inline void bit_unpack(const uint32_t* input, uint32_t* output, size_t bits, uint32_t reference = 0U)
+  {
+    ETL_ASSERT(bits <= 32U, ETL_ERROR(bit_packer_invalid_width));
+
+    private_bit_packer::dispatch<uint32_t, 32>::unpack(input, output, bits, reference);
+  }
+
+  //***************************************************************************
+  /// Packs a block of 64 values to 'bits' bits each, chosen at run time.
+  ///\ingroup bit_packer
+  //***************************************************************************
+  inline void bit_pack(const uint64_t* input, uint64_t* output, size_t bits, uint64_t reference = 0U)
+  {
+    ETL_ASSERT(bits <= 64U, ETL_ERROR(bit_packer_invalid_width));
+
+    private_bit_packer::dispatch<uint64_t, 64>::pack(input, output, bits, reference);
+  }
+
+  //***************************************************************************
+  /// Unpacks a block of 64 values of 'bits' bits each, chosen at run time.
+  ///\ingroup bit_packer
+  //***************************************************************************
+  inline void bit_unpack(const uint64_t* input, uint64_t* output, size_t bits, uint64_t reference = 0U)
+  {
+    ETL_ASSERT(bits <= 64U, ETL_ERROR(bit_packer_invalid_width));
+
+    private_bit_packer::dispatch<uint64_t, 64>::unpack(input, output, bits, reference);
+  }
+}
+
+#undef ETL_FILE
+
+#endif
@@ -28,6 +28,7 @@ SOFTWARE.
 
 #include <stdint.h>
 #include <limits.h>
+#include <string.h>
 
 #include "etl/platform.h"
 #include "etl/type_traits.h"
@@ -162,19 +163,7 @@ namespace etl
     //***************************************************************************
     bool put(bool value)
     {
-      bool success = false;
-
-      if (pdata != nullptr)
-      {
-        if (bits_remaining > 0)
-        {
-          unsigned char chunk = value ? 1 : 0;
-          put_integral(uint32_t(chunk), 1);
-          success = true;
-        }
-      }
-
-      return success;
+      return put_integral(uint64_t(value ? 1U : 0U), 1U);
     }
 
     //***************************************************************************
@@ -184,7 +173,7 @@ namespace etl
     typename etl::enable_if<etl::is_integral<T>::value, bool>::type
       put(T value, uint_least8_t width = CHAR_BIT * sizeof(T))
     {
-      return put_integral(static_cast<uint32_t>(value), width);
+      return put_integral(static_cast<uint64_t>(value), width);
     }
 
     //***************************************************************************
@@ -210,16 +199,56 @@ namespace etl
     typename etl::enable_if<etl::is_floating_point<T>::value, bool>::type
       put(T value)
     {
-      bool success = true;
+      bool success = false;
 
-      unsigned char data[sizeof(T)];
-      to_bytes(value, data);
+      if (pdata != nullptr)
+      {
+        // Do we have enough bits?
+        if (bits_remaining >= (CHAR_BIT * sizeof(T)))
+        {
+          unsigned char data[sizeof(T)];
+          to_bytes(value, data);
+
+          put_bytes(data, sizeof(T));
 
-      for (size_t i = 0; i < sizeof(T); ++i)
+          success = true;
+        }
+      }
+
+      return success;
+    }
+
+    //***************************************************************************
+    /// Puts an array of integral values, each 'width' bits wide.
+    /// Up to 32 bits wide, the values are gathered in a 64 bit register and
+    /// written to the stream 32 bits at a time.
+    /// Nothing is written if there is not enough space for all of them.
+    //***************************************************************************
+    template <typename T>
+    typename etl::enable_if<etl::is_integral<T>::value, bool>::type
+      put_array(const T* values, size_t count, uint_least8_t width = CHAR_BIT * sizeof(T))
+    {
+      bool success = false;
+
+      if (pdata != nullptr)
       {
-        if (!put_integral(uint32_t(data[i]), CHAR_BIT))
+        // Do we have enough bits?
+        if ((count == 0) || ((bits_remaining / count) >= width))
         {
-          success = false;
+          if (width > 32U)
+          {
+            for (size_t i = 0; i < count; ++i)
+            {
+              put_integral(static_cast<uint64_t>(values[i]), width);
+            }
+          }
+          else if ((width != 0U) && (count != 0U))
+          {
+            // The packed paths read the current byte, which is past the end of a full stream.
+            put_packed(values, count, width);
+          }
+
+          success = true;
         }
       }
 
@@ -238,7 +267,7 @@ namespace etl
         // Do we have enough bits?
         if (bits_remaining > 0)
         {
-          value = get_bit();
+          value = get_bits(1U) != 0U;
           success = true;
         }
       }
@@ -254,34 +283,22 @@ namespace etl
       get(T& value, uint_least8_t width = CHAR_BIT * sizeof(T))
     {
       bool success = false;
-      uint_least8_t bits = width;
 
       if (pdata != nullptr)
       {
         // Do we have enough bits?
         if (bits_remaining >= width)
         {
-          value = 0;
-
-          // Get the bits from the stream.
-          while (width != 0)
-          {
-            unsigned char mask_width = static_cast<unsigned char>(std::min(width, bits_in_byte));
-            unsigned char chunk = get_chunk(mask_width);
-
-            width -= mask_width;
-            value |= static_cast<T>(chunk) << width;
-          }
-
+          value = static_cast<T>(get_integral(width));
           success = true;
         }
       }
 
       // Sign extend if signed type and not already full bit width.
-      if (etl::is_signed<T>::value && (bits != (CHAR_BIT * sizeof(T))))
+      if (etl::is_signed<T>::value && (width != (CHAR_BIT * sizeof(T))))
       {
         typedef typename etl::make_signed<T>::type ST;
-        value = etl::sign_extend<ST, ST>(value, bits);
+        value = etl::sign_extend<ST, ST>(value, width);
       }
 
       return success;
@@ -298,22 +315,66 @@ namespace etl
 
       if (pdata != nullptr)
       {
-        uint_least8_t width = CHAR_BIT * sizeof(T);
-
         // Do we have enough bits?
-        if (bits_remaining >= width)
+        if (bits_remaining >= (CHAR_BIT * sizeof(T)))
         {
           // Temporary storage.
           unsigned char data[sizeof(T)];
 
-          for (size_t i = 0; i < sizeof(T); ++i)
+          get_bytes(data, sizeof(T));
+          from_bytes(data, value);
+
+          success = true;
+        }
+      }
+
+      return success;
+    }
+
+    //***************************************************************************
+    /// Gets an array of integral values, each 'width' bits wide.
+    /// Up to 32 bits wide, the stream is read into a 64 bit register 32 bits
+    /// at a time.
+    /// Nothing is read if the stream does not contain all of them.
+    //***************************************************************************
+    template <typename T>
+    typename etl::enable_if<etl::is_integral<T>::value, bool>::type
+      get_array(T* values, size_t count, uint_least8_t width = CHAR_BIT * sizeof(T))
+    {
+      bool success = false;
+
+      if (pdata != nullptr)
+      {
+        // Do we have enough bits?
+        if ((count == 0) || ((bits_remaining / count) >= width))
+        {
+          if (width > 32U)
+          {
+            for (size_t i = 0; i < count; ++i)
+            {
+              values[i] = static_cast<T>(get_integral(width));
+            }
+          }
+          else if ((width != 0U) && (count != 0U))
+          {
+            // The packed paths read the current byte, which is past the end of a full stream.
+            get_packed(values, count, width);
+          }
+          else
           {
-             get(data[i], CHAR_BIT);
+            std::fill(values, values + count, T(0));
           }
 
-          from_bytes(data, value);
+          // Sign extend if signed type and not already full bit width.
+          if (etl::is_signed<T>::value && (width != (CHAR_BIT * sizeof(T))))
+          {
+            typedef typename etl::make_signed<T>::type ST;
 
-          bits_remaining -= width;
+            for (size_t i = 0; i < count; ++i)
+            {
+              values[i] = etl::sign_extend<ST, ST>(values[i], width);
+            }
+          }
 
           success = true;
         }
@@ -364,10 +425,13 @@ namespace etl
 
   private:
 
+    /// The widest field that can be merged with a part used byte in one 64 bit word.
+    static const uint_least8_t MAX_WORD_FIELD = 56U;
+
     //***************************************************************************
     /// For unsigned integral types
     //***************************************************************************
-    bool put_integral(uint32_t value, uint_least8_t width)
+    bool put_integral(uint64_t value, uint_least8_t width)
     {
       bool success = false;
 
@@ -376,18 +440,14 @@ namespace etl
         // Do we have enough bits?
         if (bits_remaining >= width)
         {
-          // Send the bits to the stream.
-          while (width != 0)
+          if (width > MAX_WORD_FIELD)
           {
-            unsigned char mask_width = static_cast<unsigned char>(std::min(width, bits_in_byte));
-            width -= mask_width;
-            uint32_t mask = ((uint32_t(1U) << mask_width) - 1U) << width;
-
-            // Move chunk to lowest char bits.
-            // Chunks are never larger than one char.
-            uint32_t chunk = ((value & mask) >> width) << (bits_in_byte - mask_width);
-
-            put_chunk(static_cast<unsigned char>(chunk), mask_width);
+            put_bits(value >> 32, width - 32U);
+            put_bits(value, 32U);
+          }
+          else
+          {
+            put_bits(value, width);
           }
 
           success = true;
@@ -398,90 +458,253 @@ namespace etl
     }
 
     //***************************************************************************
-    /// For unsigned integral types. 64bit
+    /// Gets an unsigned value. The stream must contain 'width' bits.
     //***************************************************************************
-    bool put_integral(uint64_t value, uint_least8_t width)
+    uint64_t get_integral(uint_least8_t width)
     {
-      bool success = false;
+      if (width > MAX_WORD_FIELD)
+      {
+        uint64_t high = get_bits(width - 32U);
 
-      if (pdata != nullptr)
+        return (high << 32) | get_bits(32U);
+      }
+      else
       {
-        // Do we have enough bits?
-        if (bits_remaining >= width)
-        {
-          // Send the bits to the stream.
-          while (width != 0)
-          {
-            unsigned char mask_width = static_cast<unsigned char>(std::min(width, bits_in_byte));
-            width -= mask_width;
-            uint64_t mask = ((uint64_t(1U) << mask_width) - 1U) << width;
+        return get_bits(width);
+      }
+    }
 
-            // Move chunk to lowest char bits.
-            // Chunks are never larger than one char.
-            uint64_t chunk = ((value & mask) >> width) << (bits_in_byte - mask_width);
+    //***************************************************************************
+    /// Puts up to MAX_WORD_FIELD bits, merged with the used bits of the
+    /// current byte, as one big endian word.
+    /// Only the bytes that the field touches are changed.
+    //***************************************************************************
+    void put_bits(uint64_t value, uint_least8_t width)
+    {
+      if (width == 0U)
+      {
+        return;
+      }
 
-            put_chunk(static_cast<unsigned char>(chunk), mask_width);
-          }
+      const size_t used    = CHAR_BIT - bits_in_byte;
+      const size_t total   = used + width;
+      const size_t n_bytes = (total + (CHAR_BIT - 1U)) / CHAR_BIT;
 
-          success = true;
+      uint64_t word = (value & ((uint64_t(1U) << width) - 1U)) << (64U - total);
+      word |= uint64_t(static_cast<unsigned char>(pdata[byte_index] & (0xFFU << bits_in_byte))) << 56U;
+
+      if ((byte_index + sizeof(uint64_t)) <= length)
+      {
+        // Keep the bytes after the field.
+        if (n_bytes < sizeof(uint64_t))
+        {
+          word |= load_word(pdata + byte_index) & (~uint64_t(0U) >> (CHAR_BIT * n_bytes));
+        }
+
+        store_word(pdata + byte_index, word);
+      }
+      else
+      {
+        for (size_t i = 0U; i < n_bytes; ++i)
+        {
+          pdata[byte_index + i] = static_cast<unsigned char>(word >> (56U - (CHAR_BIT * i)));
         }
       }
 
-      return success;
+      step(width);
     }
 
     //***************************************************************************
-    /// Put a data chunk to the stream
+    /// Gets up to MAX_WORD_FIELD bits, read from the stream as one big endian word.
     //***************************************************************************
-    void put_chunk(unsigned char chunk, unsigned char width)
+    uint64_t get_bits(uint_least8_t width)
     {
-      // Clear if new byte.
-      if (bits_in_byte == 8)
+      if (width == 0U)
+      {
+        return 0U;
+      }
+
+      const size_t used = CHAR_BIT - bits_in_byte;
+
+      uint64_t word = 0U;
+
+      if ((byte_index + sizeof(uint64_t)) <= length)
+      {
+        word = load_word(pdata + byte_index);
+      }
+      else
       {
-        pdata[byte_index] = 0U;
+        const size_t n_bytes = (used + width + (CHAR_BIT - 1U)) / CHAR_BIT;
+
+        for (size_t i = 0U; i < n_bytes; ++i)
+        {
+          word |= uint64_t(pdata[byte_index + i]) << (56U - (CHAR_BIT * i));
+        }
       }
 
-      pdata[byte_index] |= chunk;
       step(width);
+
+      return (word << used) >> (64U - width);
     }
 
     //***************************************************************************
-    /// Get a data chunk from the stream
+    /// Puts bytes, up to seven at a time.
     //***************************************************************************
-    unsigned char get_chunk(unsigned char width)
+    void put_bytes(const unsigned char* data, size_t n)
     {
-      unsigned char value = pdata[byte_index];
+      while (n != 0U)
+      {
+        const size_t chunk = std::min(n, size_t(MAX_WORD_FIELD / CHAR_BIT));
+        uint64_t value = 0U;
 
-      value >>= (bits_in_byte - width);
+        for (size_t i = 0U; i < chunk; ++i)
+        {
+          value = (value << CHAR_BIT) | *data++;
+        }
 
-      unsigned char mask;
+        put_bits(value, uint_least8_t(chunk * CHAR_BIT));
+        n -= chunk;
+      }
+    }
 
-      if (width == CHAR_BIT)
+    //***************************************************************************
+    /// Gets bytes, up to seven at a time.
+    //***************************************************************************
+    void get_bytes(unsigned char* data, size_t n)
+    {
+      while (n != 0U)
       {
-        mask = etl::integral_limits<unsigned char>::max;
+        const size_t chunk = std::min(n, size_t(MAX_WORD_FIELD / CHAR_BIT));
+        uint64_t value = get_bits(uint_least8_t(chunk * CHAR_BIT));
+
+        for (size_t i = chunk; i != 0U; --i)
+        {
+          data[i - 1U] = static_cast<unsigned char>(value);
+          value >>= CHAR_BIT;
+        }
+
+        data += chunk;
+        n -= chunk;
       }
-      else
+    }
+
+    //***************************************************************************
+    /// Puts values of up to 32 bits through a 64 bit register.
+    /// Whole 32 bit words are written as they fill.
+    //***************************************************************************
+    template <typename T>
+    void put_packed(const T* values, size_t count, uint_least8_t width)
+    {
+      const uint64_t mask = (uint64_t(1U) << width) - 1U;
+
+      unsigned char* p = pdata + byte_index;
+
+      // Start with the used bits of the current byte.
+      size_t   n_bits = CHAR_BIT - bits_in_byte;
+      uint64_t buffer = uint64_t(static_cast<unsigned char>(*p & (0xFFU << bits_in_byte))) << 56U;
+
+      for (size_t i = 0U; i < count; ++i)
       {
-        mask = (1U << width) - 1;
+        n_bits += width;
+        buffer |= (static_cast<uint64_t>(values[i]) & mask) << (64U - n_bits);
+
+        if (n_bits >= 32U)
+        {
+          store_word(p, uint32_t(buffer >> 32));
+          p      += sizeof(uint32_t);
+          buffer <<= 32;
+          n_bits -= 32U;
+        }
       }
 
-      value &= mask;
+      // The last, part filled, bytes.
+      while (n_bits != 0U)
+      {
+        *p++   = static_cast<unsigned char>(buffer >> 56U);
+        buffer <<= CHAR_BIT;
+        n_bits  = (n_bits > CHAR_BIT) ? n_bits - CHAR_BIT : 0U;
+      }
 
-      step(width);
+      step(count * width);
+    }
+
+    //***************************************************************************
+    /// Gets values of up to 32 bits through a 64 bit register.
+    /// Whole 32 bit words are read while they are inside the stream.
+    //***************************************************************************
+    template <typename T>
+    void get_packed(T* values, size_t count, uint_least8_t width)
+    {
+      const unsigned char* p     = pdata + byte_index;
+      const unsigned char* p_end = pdata + length;
+
+      // Start with the unused bits of the current byte.
+      size_t   n_bits = bits_in_byte;
+      uint64_t buffer = uint64_t(*p++) << (56U + (CHAR_BIT - bits_in_byte));
+
+      for (size_t i = 0U; i < count; ++i)
+      {
+        while (n_bits < width)
+        {
+          if ((p_end - p) >= ptrdiff_t(sizeof(uint32_t)))
+          {
+            buffer |= uint64_t(load_word32(p)) << (32U - n_bits);
+            p      += sizeof(uint32_t);
+            n_bits += 32U;
+          }
+          else
+          {
+            buffer |= uint64_t(*p++) << (56U - n_bits);
+            n_bits += CHAR_BIT;
+          }
+        }
 
-      return value;
+        values[i] = static_cast<T>(buffer >> (64U - width));
+        buffer <<= width;
+        n_bits -= width;
+      }
+
+      step(count * width);
     }
 
     //***************************************************************************
-    /// Get a bool from the stream
+    /// Reads a big endian 64 bit word.
     //***************************************************************************
-    bool get_bit()
+    static uint64_t load_word(const unsigned char* p)
     {
-      bool result = (pdata[byte_index] & (1 << (bits_in_byte - 1))) != 0;
+      uint64_t word;
+      memcpy(&word, p, sizeof(word));
+
+      return etl::ntoh(word);
+    }
 
-      step(1U);
+    //***************************************************************************
+    /// Reads a big endian 32 bit word.
+    //***************************************************************************
+    static uint32_t load_word32(const unsigned char* p)
+    {
+      uint32_t word;
+      memcpy(&word, p, sizeof(word));
 
-      return result;
+      return etl::ntoh(word);
+    }
+
+    //***************************************************************************
+    /// Writes a big endian 64 bit word.
+    //***************************************************************************
+    static void store_word(unsigned char* p, uint64_t word)
+    {
+      word = etl::hton(word);
+      memcpy(p, &word, sizeof(word));
+    }
+
+    //***************************************************************************
+    /// Writes a big endian 32 bit word.
+    //***************************************************************************
+    static void store_word(unsigned char* p, uint32_t word)
+    {
+      word = etl::hton(word);
+      memcpy(p, &word, sizeof(word));
     }
 
     //***************************************************************************
@@ -526,18 +749,13 @@ namespace etl
 
     //***************************************************************************
     /// Step the specified number of bits along the stream.
-    /// The width will never be larger than 'bits_in_byte'.
     //***************************************************************************
-    void step(unsigned char width)
+    void step(size_t width)
     {
-      bits_in_byte -= width;
-
-      if (bits_in_byte == 0)
-      {
-        ++byte_index;
-        bits_in_byte = 8;
-      }
+      size_t bit_index = (CHAR_BIT - bits_in_byte) + width;
 
+      byte_index     += bit_index / CHAR_BIT;
+      bits_in_byte    = static_cast<unsigned char>(CHAR_BIT - (bit_index % CHAR_BIT));
       bits_remaining -= width;
     }
 
@@ -113,6 +113,7 @@ namespace etl
     static const element_t ALL_CLEAR = 0;
 
     static const size_t    BITS_PER_ELEMENT = etl::integral_limits<element_t>::bits;
+    static const size_t    ELEMENTS_PER_WORD = sizeof(uint64_t) / sizeof(element_t);
 
     enum
     {
@@ -209,8 +210,21 @@ namespace etl
     size_t count() const
     {
       size_t n = 0;
+      size_t i = 0;
 
-      for (size_t i = 0; i < SIZE; ++i)
+      // Narrow elements are counted a 64 bit word at a time.
+      if (ELEMENTS_PER_WORD > 1)
+      {
+        for (; (i + ELEMENTS_PER_WORD) <= SIZE; i += ELEMENTS_PER_WORD)
+        {
+          uint64_t word;
+          memcpy(&word, pdata + i, sizeof(word));
+
+          n += etl::count_bits(word);
+        }
+      }
+
+      for (; i < SIZE; ++i)
       {
         n += etl::count_bits(pdata[i]);
       }
@@ -463,45 +477,65 @@ namespace etl
         bit = position & (BITS_PER_ELEMENT - 1);
       }
 
-      element_t mask = 1 << bit;
+      if (bit >= BITS_PER_ELEMENT)
+      {
+        return ibitset::npos;
+      }
 
-      // For each element in the bitset...
-      while (index < SIZE)
+      if (index >= SIZE)
       {
-        element_t value = pdata[index];
+        return ibitset::npos;
+      }
+
+      // Copies, as element_t may alias the members.
+      const element_t* const p_data = pdata;
+      const size_t           size   = SIZE;
 
-        // Needs checking?
-        if ((state && (value != ALL_CLEAR)) ||
-          (!state && (value != ALL_SET)))
+      // Searching for clear bits is a search for set bits in the inverse.
+      const element_t invert = state ? ALL_CLEAR : ALL_SET;
+
+      // Ignore the bits before the start position.
+      element_t value = element_t((p_data[index] ^ invert) & element_t(ALL_SET << bit));
+
+      // Skip the elements with no matching bits.
+      while (value == ALL_CLEAR)
+      {
+        if (++index == size)
         {
-          // For each bit in the element...
-          while ((bit < BITS_PER_ELEMENT) && (position < NBITS))
+          return ibitset::npos;
+        }
+
+        // Narrow elements are skipped a 64 bit word at a time.
+        if (ELEMENTS_PER_WORD > 1)
+        {
+          const uint64_t skip = (invert == ALL_CLEAR) ? 0 : ~uint64_t(0);
+
+          while ((index + ELEMENTS_PER_WORD) <= size)
           {
-            // Equal to the required state?
-            if (((value & mask) != 0) == state)
+            uint64_t word;
+            memcpy(&word, p_data + index, sizeof(word));
+
+            if (word != skip)
             {
-              return position;
+              break;
             }
 
-            // Move on to the next bit.
-            mask <<= 1;
-            ++position;
-            ++bit;
+            index += ELEMENTS_PER_WORD;
           }
-        }
-        else
-        {
-          position += BITS_PER_ELEMENT;
-        }
 
-        // Start at the beginning for all other elements.
-        bit = 0;
-        mask = 1;
+          if (index == size)
+          {
+            return ibitset::npos;
+          }
+        }
 
-        ++index;
+        value = element_t(p_data[index] ^ invert);
       }
 
-      return ibitset::npos;
+      position = (index * BITS_PER_ELEMENT) + etl::count_trailing_zeros(value);
+
+      // The unused bits in the last element may match a search for clear bits.
+      return (position < NBITS) ? position : ibitset::npos;
     }
 
     //*************************************************************************
@@ -0,0 +1,354 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_BLOCKED_BLOOM_FILTER_INCLUDED
+#define ETL_BLOCKED_BLOOM_FILTER_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "parameter_type.h"
+#include "binary.h"
+#include "static_assert.h"
+
+#define ETL_IN_BLOCKED_BLOOM_FILTER_H
+#include "private/filter_hash.h"
+#undef ETL_IN_BLOCKED_BLOOM_FILTER_H
+
+///\defgroup blocked_bloom_filter blocked_bloom_filter
+/// A cache blocked Bloom filter
+///\ingroup containers
+
+namespace etl
+{
+  //***************************************************************************
+  /// A Bloom filter in which all of the bits for a key are in one 512 bit
+  /// block, so that each add or test touches a single cache line.
+  /// The block and the N_HASHES bits within it are all derived from one hash
+  /// of the key, using Kirsch-Mitzenmacher double hashing.
+  /// The hash class must support the () operator and define 'argument_type'.
+  /// Its result is mixed before use, so simple hashes may be used.
+  ///\tparam DESIRED_WIDTH The desired number of bits. Rounded up to a whole number of blocks.
+  ///\tparam THash         The hash generator class.
+  ///\tparam N_HASHES_     The number of bits set for each key.
+  ///\ingroup blocked_bloom_filter
+  //***************************************************************************
+  template <const size_t DESIRED_WIDTH, typename THash, const size_t N_HASHES_ = 8>
+  class blocked_bloom_filter
+  {
+  private:
+
+    typedef typename etl::parameter_type<typename THash::argument_type>::type parameter_t;
+    typedef uint64_t word_t;
+
+  public:
+
+    static const size_t BLOCK_BITS       = 512;
+    static const size_t BLOCK_BYTES      = BLOCK_BITS / 8;
+    static const size_t WORD_BITS        = 64;
+    static const size_t WORDS_PER_BLOCK  = BLOCK_BITS / WORD_BITS;
+    static const size_t NUMBER_OF_BLOCKS = (DESIRED_WIDTH == 0) ? 1 : ((DESIRED_WIDTH + BLOCK_BITS - 1) / BLOCK_BITS);
+    static const size_t WIDTH            = NUMBER_OF_BLOCKS * BLOCK_BITS;
+    static const size_t N_HASHES         = N_HASHES_;
+
+    /// The number of keys hashed ahead of being tested, in the batch functions.
+    static const size_t PREFETCH_DISTANCE = 8;
+
+    ETL_STATIC_ASSERT(N_HASHES > 0, "There must be at least one hash");
+    ETL_STATIC_ASSERT(uint64_t(NUMBER_OF_BLOCKS) <= uint64_t(UINT32_MAX), "Too many blocks");
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    blocked_bloom_filter()
+    {
+      clear();
+    }
+
+    //*************************************************************************
+    /// Copy constructor.
+    //*************************************************************************
+    blocked_bloom_filter(const blocked_bloom_filter& other)
+    {
+      copy_blocks(other);
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    blocked_bloom_filter& operator =(const blocked_bloom_filter& other)
+    {
+      if (&other != this)
+      {
+        copy_blocks(other);
+      }
+
+      return *this;
+    }
+
+    //*************************************************************************
+    /// Clears the bloom filter of all entries.
+    //*************************************************************************
+    void clear()
+    {
+      for (size_t i = 0; i < N_WORDS; ++i)
+      {
+        words[i] = 0;
+      }
+    }
+
+    //*************************************************************************
+    /// Adds a key to the filter.
+    ///\param key The key to add.
+    //*************************************************************************
+    void add(parameter_t key)
+    {
+      add_hash(get_hash(key));
+    }
+
+    //*************************************************************************
+    /// Adds a range of keys to the filter.
+    /// The blocks for each group of keys are prefetched before they are set.
+    //*************************************************************************
+    template <typename TIterator>
+    void add(TIterator first, TIterator last)
+    {
+      uint64_t hashes[PREFETCH_DISTANCE];
+
+      while (first != last)
+      {
+        size_t n = hash_ahead(first, last, hashes);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          add_hash(hashes[i]);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Tests a key to see if it exists in the filter.
+    ///\param  key The key to test.
+    ///\return <b>true</b> if the key exists in the filter.
+    //*************************************************************************
+    bool exists(parameter_t key) const
+    {
+      return exists_hash(get_hash(key));
+    }
+
+    //*************************************************************************
+    /// Tests a range of keys, writing a <b>bool</b> result for each to 'out'.
+    /// The blocks for each group of keys are prefetched before they are tested.
+    ///\return The output iterator, one past the last result.
+    //*************************************************************************
+    template <typename TIterator, typename TOutputIterator>
+    TOutputIterator exists(TIterator first, TIterator last, TOutputIterator out) const
+    {
+      uint64_t hashes[PREFETCH_DISTANCE];
+
+      while (first != last)
+      {
+        size_t n = hash_ahead(first, last, hashes);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          *out = exists_hash(hashes[i]);
+          ++out;
+        }
+      }
+
+      return out;
+    }
+
+    //*************************************************************************
+    /// Returns the width of the Bloom filter.
+    //*************************************************************************
+    size_t width() const
+    {
+      return WIDTH;
+    }
+
+    //*************************************************************************
+    /// Returns the percentage of usage. Range 0 to 100.
+    //*************************************************************************
+    size_t usage() const
+    {
+      return (100 * count()) / WIDTH;
+    }
+
+    //*************************************************************************
+    /// Returns the number of filter flags set.
+    //*************************************************************************
+    size_t count() const
+    {
+      const word_t* p_words = get_words();
+      size_t n = 0;
+
+      for (size_t i = 0; i < (NUMBER_OF_BLOCKS * WORDS_PER_BLOCK); ++i)
+      {
+        n += etl::count_bits(p_words[i]);
+      }
+
+      return n;
+    }
+
+  private:
+
+    // One spare block, so that the blocks can start on a block boundary.
+    static const size_t N_WORDS = (NUMBER_OF_BLOCKS + 1) * WORDS_PER_BLOCK;
+
+    //*************************************************************************
+    /// Gets the mixed hash for the key.
+    //*************************************************************************
+    static uint64_t get_hash(parameter_t key)
+    {
+      return private_filter_hash::mix(uint64_t(THash()(key)));
+    }
+
+    //*************************************************************************
+    /// Hashes up to PREFETCH_DISTANCE keys, advancing 'first', and prefetches
+    /// their blocks.
+    ///\return The number of keys hashed.
+    //*************************************************************************
+    template <typename TIterator>
+    size_t hash_ahead(TIterator& first, TIterator last, uint64_t* hashes) const
+    {
+      size_t n = 0;
+
+      while ((n < PREFETCH_DISTANCE) && (first != last))
+      {
+        hashes[n] = get_hash(*first);
+        ETL_PREFETCH(get_block(hashes[n]));
+        ++first;
+        ++n;
+      }
+
+      return n;
+    }
+
+    //*************************************************************************
+    /// Sets the bits for a hash.
+    /// Bit 'i' is h1 + i.h2, modulo the block size, so only the low bits of
+    /// each half are used. The block is chosen by the high bits of the upper half.
+    //*************************************************************************
+    void add_hash(uint64_t hash)
+    {
+      word_t* p_block = get_block(hash);
+
+      uint32_t h1 = uint32_t(hash);
+      uint32_t h2 = uint32_t(hash >> 32) | 1U; // Odd, so that the bits are distinct.
+
+      for (size_t i = 0; i < N_HASHES; ++i)
+      {
+        uint32_t bit = h1 & (BLOCK_BITS - 1);
+        p_block[bit / WORD_BITS] |= word_t(1) << (bit % WORD_BITS);
+        h1 += h2;
+      }
+    }
+
+    //*************************************************************************
+    /// Tests the bits for a hash.
+    /// All of the bits are tested without branching. They are in the same
+    /// cache line, so the loads are cheap once the first has completed.
+    //*************************************************************************
+    bool exists_hash(uint64_t hash) const
+    {
+      const word_t* p_block = get_block(hash);
+
+      uint32_t h1 = uint32_t(hash);
+      uint32_t h2 = uint32_t(hash >> 32) | 1U;
+
+      word_t missing = 0;
+
+      for (size_t i = 0; i < N_HASHES; ++i)
+      {
+        uint32_t bit = h1 & (BLOCK_BITS - 1);
+        missing |= ~p_block[bit / WORD_BITS] & (word_t(1) << (bit % WORD_BITS));
+        h1 += h2;
+      }
+
+      return missing == 0;
+    }
+
+    //*************************************************************************
+    /// Gets the block for a hash.
+    /// Maps the upper half of the hash to a block without a division.
+    //*************************************************************************
+    word_t* get_block(uint64_t hash)
+    {
+      size_t index = private_filter_hash::reduce(uint32_t(hash >> 32), NUMBER_OF_BLOCKS);
+
+      return get_words() + (index * WORDS_PER_BLOCK);
+    }
+
+    const word_t* get_block(uint64_t hash) const
+    {
+      return const_cast<blocked_bloom_filter*>(this)->get_block(hash);
+    }
+
+    //*************************************************************************
+    /// Gets the first word of the first block.
+    //*************************************************************************
+    word_t* get_words()
+    {
+      uintptr_t address = reinterpret_cast<uintptr_t>(&words[0]);
+
+      address = (address + (BLOCK_BYTES - 1)) & ~uintptr_t(BLOCK_BYTES - 1);
+
+      return reinterpret_cast<word_t*>(address);
+    }
+
+    const word_t* get_words() const
+    {
+      return const_cast<blocked_bloom_filter*>(this)->get_words();
+    }
+
+    //*************************************************************************
+    /// Copies the blocks of another filter.
+    /// The blocks may start at a different offset in each filter.
+    //*************************************************************************
+    void copy_blocks(const blocked_bloom_filter& other)
+    {
+      const word_t* p_source      = other.get_words();
+      word_t*       p_destination = get_words();
+
+      for (size_t i = 0; i < (NUMBER_OF_BLOCKS * WORDS_PER_BLOCK); ++i)
+      {
+        p_destination[i] = p_source[i];
+      }
+    }
+
+    /// The Bloom filter flags.
+    word_t words[N_WORDS];
+  };
+}
+
+#endif
@@ -0,0 +1,1911 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_BTREE_MAP_INCLUDED
+#define ETL_BTREE_MAP_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <new>
+
+#include "platform.h"
+
+#include "stl/algorithm.h"
+#include "stl/iterator.h"
+#include "stl/functional.h"
+#include "stl/utility.h"
+
+#include "container.h"
+#include "pool.h"
+#include "alignment.h"
+#include "type_traits.h"
+#include "parameter_type.h"
+#include "nullptr.h"
+#include "static_assert.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "debug_count.h"
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+  #include <initializer_list>
+#endif
+
+#undef ETL_FILE
+#define ETL_FILE "62"
+
+//*****************************************************************************
+/// The target size, in bytes, of a btree leaf node.
+/// Should be a multiple of the cache line size.
+//*****************************************************************************
+#if !defined(ETL_BTREE_NODE_SIZE)
+  #define ETL_BTREE_NODE_SIZE 256
+#endif
+
+//*****************************************************************************
+///\defgroup btree_map btree_map
+/// An ordered map with the capacity defined at compile time.
+/// Elements are stored in B-tree nodes of several values each, drawn from
+/// fixed pools, so a lookup touches one node per level of the tree.
+/// Inserting or erasing may move elements between nodes, so, unlike etl::map,
+/// both invalidate all iterators.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// Exception for the btree_map.
+  ///\ingroup btree_map
+  //***************************************************************************
+  class btree_map_exception : public etl::exception
+  {
+  public:
+
+    btree_map_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : etl::exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Full exception for the btree_map.
+  ///\ingroup btree_map
+  //***************************************************************************
+  class btree_map_full : public etl::btree_map_exception
+  {
+  public:
+
+    btree_map_full(string_type file_name_, numeric_type line_number_)
+      : etl::btree_map_exception(ETL_ERROR_TEXT("btree_map:full", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Out of bounds exception for the btree_map.
+  ///\ingroup btree_map
+  //***************************************************************************
+  class btree_map_out_of_bounds : public etl::btree_map_exception
+  {
+  public:
+
+    btree_map_out_of_bounds(string_type file_name_, numeric_type line_number_)
+      : etl::btree_map_exception(ETL_ERROR_TEXT("btree_map:bounds", ETL_FILE"B"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Iterator exception for the btree_map.
+  ///\ingroup btree_map
+  //***************************************************************************
+  class btree_map_iterator : public etl::btree_map_exception
+  {
+  public:
+
+    btree_map_iterator(string_type file_name_, numeric_type line_number_)
+      : etl::btree_map_exception(ETL_ERROR_TEXT("btree_map:iterator", ETL_FILE"C"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The base class for specifically sized btree_map.
+  /// Can be used as a reference type for all btree_map containing a specific type.
+  ///\ingroup btree_map
+  //***************************************************************************
+  template <typename TKey, typename TMapped, typename TKeyCompare = std::less<TKey> >
+  class ibtree_map
+  {
+  public:
+
+    typedef TKey                           key_type;
+    typedef std::pair<const TKey, TMapped> value_type;
+    typedef TMapped                        mapped_type;
+    typedef TKeyCompare                    key_compare;
+    typedef value_type&                    reference;
+    typedef const value_type&              const_reference;
+    typedef value_type*                    pointer;
+    typedef const value_type*              const_pointer;
+    typedef size_t                         size_type;
+
+    class value_compare
+    {
+    public:
+
+      bool operator()(const value_type& lhs, const value_type& rhs) const
+      {
+        return (kcompare(lhs.first, rhs.first));
+      }
+
+    private:
+
+      key_compare kcompare;
+    };
+
+  protected:
+
+    typedef typename etl::parameter_type<TKey>::type key_parameter_t;
+
+    //*************************************************************************
+    /// The number of values held by a node.
+    /// As many as fit in ETL_BTREE_NODE_SIZE, with a minimum of 3.
+    //*************************************************************************
+    enum
+    {
+      FITTED_VALUES = (ETL_BTREE_NODE_SIZE - (2 * sizeof(void*))) / sizeof(value_type),
+      NODE_VALUES   = (FITTED_VALUES < 3) ? 3 : ((FITTED_VALUES > 255) ? 255 : FITTED_VALUES),
+      MIN_VALUES    = NODE_VALUES / 2 ///< Every node apart from the root holds at least this many.
+    };
+
+    //*************************************************************************
+    /// A leaf node.
+    //*************************************************************************
+    struct node_t
+    {
+      value_type* values()
+      {
+        return reinterpret_cast<value_type*>(&storage);
+      }
+
+      const value_type* values() const
+      {
+        return reinterpret_cast<const value_type*>(&storage);
+      }
+
+      node_t* parent;   ///< nullptr for the root.
+      uint8_t position; ///< The index of this node in the parent's children.
+      uint8_t count;    ///< The number of values.
+      bool    leaf;
+
+      typename etl::aligned_storage<sizeof(value_type) * NODE_VALUES, etl::alignment_of<value_type>::value>::type storage;
+    };
+
+    //*************************************************************************
+    /// An internal node.
+    /// Child 'i' holds the values less than value 'i'.
+    //*************************************************************************
+    struct internal_node_t : public node_t
+    {
+      node_t* children[NODE_VALUES + 1];
+    };
+
+  public:
+
+    class const_iterator;
+
+    //*************************************************************************
+    /// iterator.
+    //*************************************************************************
+    class iterator : public std::iterator<std::bidirectional_iterator_tag, value_type>
+    {
+    public:
+
+      friend class ibtree_map;
+      friend class const_iterator;
+
+      iterator()
+        : p_node(nullptr),
+          index(0)
+      {
+      }
+
+      iterator(const iterator& other)
+        : p_node(other.p_node),
+          index(other.index)
+      {
+      }
+
+      iterator& operator ++()
+      {
+        ibtree_map::next_value(p_node, index);
+        return *this;
+      }
+
+      iterator operator ++(int)
+      {
+        iterator temp(*this);
+        ibtree_map::next_value(p_node, index);
+        return temp;
+      }
+
+      iterator& operator --()
+      {
+        ibtree_map::previous_value(p_node, index);
+        return *this;
+      }
+
+      iterator operator --(int)
+      {
+        iterator temp(*this);
+        ibtree_map::previous_value(p_node, index);
+        return temp;
+      }
+
+      iterator& operator =(const iterator& other)
+      {
+        p_node = other.p_node;
+        index  = other.index;
+        return *this;
+      }
+
+      reference operator *()
+      {
+        return p_node->values()[index];
+      }
+
+      const_reference operator *() const
+      {
+        return p_node->values()[index];
+      }
+
+      pointer operator &()
+      {
+        return &p_node->values()[index];
+      }
+
+      const_pointer operator &() const
+      {
+        return &p_node->values()[index];
+      }
+
+      pointer operator ->()
+      {
+        return &p_node->values()[index];
+      }
+
+      const_pointer operator ->() const
+      {
+        return &p_node->values()[index];
+      }
+
+      friend bool operator == (const iterator& lhs, const iterator& rhs)
+      {
+        return (lhs.p_node == rhs.p_node) && (lhs.index == rhs.index);
+      }
+
+      friend bool operator != (const iterator& lhs, const iterator& rhs)
+      {
+        return !(lhs == rhs);
+      }
+
+    private:
+
+      iterator(node_t* p_node_, size_t index_)
+        : p_node(p_node_),
+          index(index_)
+      {
+      }
+
+      node_t* p_node;
+      size_t  index;
+    };
+
+    friend class iterator;
+
+    //*************************************************************************
+    /// const_iterator
+    //*************************************************************************
+    class const_iterator : public std::iterator<std::bidirectional_iterator_tag, const value_type>
+    {
+    public:
+
+      friend class ibtree_map;
+
+      const_iterator()
+        : p_node(nullptr),
+          index(0)
+      {
+      }
+
+      const_iterator(const typename ibtree_map::iterator& other)
+        : p_node(other.p_node),
+          index(other.index)
+      {
+      }
+
+      const_iterator(const const_iterator& other)
+        : p_node(other.p_node),
+          index(other.index)
+      {
+      }
+
+      const_iterator& operator ++()
+      {
+        ibtree_map::next_value(p_node, index);
+        return *this;
+      }
+
+      const_iterator operator ++(int)
+      {
+        const_iterator temp(*this);
+        ibtree_map::next_value(p_node, index);
+        return temp;
+      }
+
+      const_iterator& operator --()
+      {
+        ibtree_map::previous_value(p_node, index);
+        return *this;
+      }
+
+      const_iterator operator --(int)
+      {
+        const_iterator temp(*this);
+        ibtree_map::previous_value(p_node, index);
+        return temp;
+      }
+
+      const_iterator& operator =(const const_iterator& other)
+      {
+        p_node = other.p_node;
+        index  = other.index;
+        return *this;
+      }
+
+      const_reference operator *() const
+      {
+        return p_node->values()[index];
+      }
+
+      const_pointer operator &() const
+      {
+        return &p_node->values()[index];
+      }
+
+      const_pointer operator ->() const
+      {
+        return &p_node->values()[index];
+      }
+
+      friend bool operator == (const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return (lhs.p_node == rhs.p_node) && (lhs.index == rhs.index);
+      }
+
+      friend bool operator != (const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return !(lhs == rhs);
+      }
+
+    private:
+
+      const_iterator(const node_t* p_node_, size_t index_)
+        : p_node(p_node_),
+          index(index_)
+      {
+      }
+
+      const node_t* p_node;
+      size_t        index;
+    };
+
+    friend class const_iterator;
+
+    typedef typename std::iterator_traits<iterator>::difference_type difference_type;
+
+    typedef std::reverse_iterator<iterator>       reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    //*************************************************************************
+    /// Gets the beginning of the btree_map.
+    //*************************************************************************
+    iterator begin()
+    {
+      return iterator(p_leftmost, 0);
+    }
+
+    //*************************************************************************
+    /// Gets the beginning of the btree_map.
+    //*************************************************************************
+    const_iterator begin() const
+    {
+      return const_iterator(p_leftmost, 0);
+    }
+
+    //*************************************************************************
+    /// Gets the end of the btree_map.
+    //*************************************************************************
+    iterator end()
+    {
+      return iterator(p_rightmost, (p_rightmost == nullptr) ? 0 : p_rightmost->count);
+    }
+
+    //*************************************************************************
+    /// Gets the end of the btree_map.
+    //*************************************************************************
+    const_iterator end() const
+    {
+      return const_iterator(p_rightmost, (p_rightmost == nullptr) ? 0 : p_rightmost->count);
+    }
+
+    //*************************************************************************
+    /// Gets the beginning of the btree_map.
+    //*************************************************************************
+    const_iterator cbegin() const
+    {
+      return begin();
+    }
+
+    //*************************************************************************
+    /// Gets the end of the btree_map.
+    //*************************************************************************
+    const_iterator cend() const
+    {
+      return end();
+    }
+
+    //*************************************************************************
+    /// Gets the reverse beginning of the list.
+    //*************************************************************************
+    reverse_iterator rbegin()
+    {
+      return reverse_iterator(end());
+    }
+
+    //*************************************************************************
+    /// Gets the reverse beginning of the list.
+    //*************************************************************************
+    const_reverse_iterator rbegin() const
+    {
+      return const_reverse_iterator(end());
+    }
+
+    //*************************************************************************
+    /// Gets the reverse end of the list.
+    //*************************************************************************
+    reverse_iterator rend()
+    {
+      return reverse_iterator(begin());
+    }
+
+    //*************************************************************************
+    /// Gets the reverse end of the list.
+    //*************************************************************************
+    const_reverse_iterator rend() const
+    {
+      return const_reverse_iterator(begin());
+    }
+
+    //*************************************************************************
+    /// Gets the reverse beginning of the list.
+    //*************************************************************************
+    const_reverse_iterator crbegin() const
+    {
+      return const_reverse_iterator(end());
+    }
+
+    //*************************************************************************
+    /// Gets the reverse end of the list.
+    //*************************************************************************
+    const_reverse_iterator crend() const
+    {
+      return const_reverse_iterator(begin());
+    }
+
+    //*********************************************************************
+    /// Returns a reference to the value at index 'key'
+    /// If asserts or exceptions are enabled, emits btree_map_full if a new element is needed and the btree_map is full.
+    ///\param i The index.
+    ///\return A reference to the value at index 'key'
+    //*********************************************************************
+    mapped_type& operator [](key_parameter_t key)
+    {
+      return insert(value_type(key, mapped_type())).first->second;
+    }
+
+    //*********************************************************************
+    /// Returns a reference to the value at index 'key'
+    /// If asserts or exceptions are enabled, emits an etl::btree_map_out_of_bounds if the key is not in the range.
+    ///\param i The index.
+    ///\return A reference to the value at index 'key'
+    //*********************************************************************
+    mapped_type& at(key_parameter_t key)
+    {
+      iterator i_element = find(key);
+
+      ETL_ASSERT(i_element != end(), ETL_ERROR(btree_map_out_of_bounds));
+
+      return i_element->second;
+    }
+
+    //*********************************************************************
+    /// Returns a const reference to the value at index 'key'
+    /// If asserts or exceptions are enabled, emits an etl::btree_map_out_of_bounds if the key is not in the range.
+    ///\param i The index.
+    ///\return A const reference to the value at index 'key'
+    //*********************************************************************
+    const mapped_type& at(key_parameter_t key) const
+    {
+      const_iterator i_element = find(key);
+
+      ETL_ASSERT(i_element != end(), ETL_ERROR(btree_map_out_of_bounds));
+
+      return i_element->second;
+    }
+
+    //*********************************************************************
+    /// Assigns values to the btree_map.
+    /// If asserts or exceptions are enabled, emits btree_map_full if the btree_map does not have enough free space.
+    /// If asserts or exceptions are enabled, emits btree_map_iterator if the iterators are reversed.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*********************************************************************
+    template <typename TIterator>
+    void assign(TIterator first, TIterator last)
+    {
+#if defined(ETL_DEBUG)
+      difference_type d = std::distance(first, last);
+      ETL_ASSERT(d >= 0, ETL_ERROR(btree_map_iterator));
+      ETL_ASSERT(size_t(d) <= max_size(), ETL_ERROR(btree_map_full));
+#endif
+
+      clear();
+
+      while (first != last)
+      {
+        insert(*first++);
+      }
+    }
+
+    //*************************************************************************
+    /// Clears the btree_map.
+    //*************************************************************************
+    void clear()
+    {
+      initialise();
+    }
+
+    //*********************************************************************
+    /// Counts the number of elements that contain the key specified.
+    ///\param key The key to search for.
+    ///\return 1 if element was found, 0 otherwise.
+    //*********************************************************************
+    size_type count(key_parameter_t key) const
+    {
+      size_t index;
+      return (find_node(key, index) != nullptr) ? 1 : 0;
+    }
+
+    //*************************************************************************
+    /// Returns two iterators with bounding (lower bound, upper bound) the key
+    /// provided
+    //*************************************************************************
+    std::pair<iterator, iterator> equal_range(key_parameter_t key)
+    {
+      iterator first = lower_bound(key);
+      iterator last  = first;
+
+      if ((last != end()) && !compare(key, last->first))
+      {
+        ++last;
+      }
+
+      return std::pair<iterator, iterator>(first, last);
+    }
+
+    //*************************************************************************
+    /// Returns two const iterators with bounding (lower bound, upper bound)
+    /// the key provided.
+    //*************************************************************************
+    std::pair<const_iterator, const_iterator> equal_range(key_parameter_t key) const
+    {
+      const_iterator first = lower_bound(key);
+      const_iterator last  = first;
+
+      if ((last != end()) && !compare(key, last->first))
+      {
+        ++last;
+      }
+
+      return std::pair<const_iterator, const_iterator>(first, last);
+    }
+
+    //*************************************************************************
+    /// Erases the value at the specified position.
+    ///\return An iterator to the element after the one erased.
+    //*************************************************************************
+    iterator erase(iterator position)
+    {
+      return erase_at(position.p_node, position.index);
+    }
+
+    //*************************************************************************
+    /// Erases the value at the specified position.
+    ///\return An iterator to the element after the one erased.
+    //*************************************************************************
+    iterator erase(const_iterator position)
+    {
+      return erase_at(const_cast<node_t*>(position.p_node), position.index);
+    }
+
+    //*************************************************************************
+    // Erase the key specified.
+    ///\return The number of elements erased. 0 or 1.
+    //*************************************************************************
+    size_type erase(key_parameter_t key)
+    {
+      size_t index;
+      const node_t* p_node = find_node(key, index);
+
+      if (p_node == nullptr)
+      {
+        return 0;
+      }
+
+      erase_at(const_cast<node_t*>(p_node), index);
+
+      return 1;
+    }
+
+    //*************************************************************************
+    /// Erases a range of elements.
+    ///\return An iterator to the element after the last one erased.
+    //*************************************************************************
+    iterator erase(iterator first, iterator last)
+    {
+      return erase(const_iterator(first), const_iterator(last));
+    }
+
+    //*************************************************************************
+    /// Erases a range of elements.
+    ///\return An iterator to the element after the last one erased.
+    //*************************************************************************
+    iterator erase(const_iterator first, const_iterator last)
+    {
+      if ((first == cbegin()) && (last == cend()))
+      {
+        clear();
+        return end();
+      }
+
+      // Erasing moves elements, so count them first.
+      size_t n = std::distance(first, last);
+
+      iterator position(const_cast<node_t*>(first.p_node), first.index);
+
+      while (n-- != 0)
+      {
+        position = erase(position);
+      }
+
+      return position;
+    }
+
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator pointing to the element or end() if not found.
+    //*********************************************************************
+    iterator find(key_parameter_t key)
+    {
+      size_t index;
+      const node_t* p_node = find_node(key, index);
+
+      return (p_node == nullptr) ? end() : iterator(const_cast<node_t*>(p_node), index);
+    }
+
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator pointing to the element or end() if not found.
+    //*********************************************************************
+    const_iterator find(key_parameter_t key) const
+    {
+      size_t index;
+      const node_t* p_node = find_node(key, index);
+
+      return (p_node == nullptr) ? end() : const_iterator(p_node, index);
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the btree_map.
+    /// If asserts or exceptions are enabled, emits btree_map_full if the btree_map is already full.
+    ///\param value    The value to insert.
+    //*********************************************************************
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+      if (p_root == nullptr)
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(btree_map_full));
+
+        p_root      = allocate_node(true);
+        p_leftmost  = p_root;
+        p_rightmost = p_root;
+      }
+
+      // Find the leaf to insert into, unless the key is already present.
+      node_t* p_node = p_root;
+      size_t  index;
+
+      while (true)
+      {
+        index = lower_bound_index(p_node, value.first);
+
+        if ((index < p_node->count) && !compare(value.first, p_node->values()[index].first))
+        {
+          return std::pair<iterator, bool>(iterator(p_node, index), false);
+        }
+
+        if (p_node->leaf)
+        {
+          break;
+        }
+
+        p_node = child(p_node, index);
+      }
+
+      ETL_ASSERT(!full(), ETL_ERROR(btree_map_full));
+
+      iterator position = insert_value(p_node, index, value, nullptr);
+      ++current_size;
+      ETL_INCREMENT_DEBUG_COUNT
+
+      return std::pair<iterator, bool>(position, true);
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the btree_map.
+    /// The position hint is ignored.
+    /// If asserts or exceptions are enabled, emits btree_map_full if the btree_map is already full.
+    ///\param value    The value to insert.
+    //*********************************************************************
+    iterator insert(const_iterator, const value_type& value)
+    {
+      return insert(value).first;
+    }
+
+    //*********************************************************************
+    /// Inserts a range of values to the btree_map.
+    /// If asserts or exceptions are enabled, emits btree_map_full if the btree_map does not have enough free space.
+    ///\param position The position to insert at.
+    ///\param first    The first element to add.
+    ///\param last     The last + 1 element to add.
+    //*********************************************************************
+    template <class TIterator>
+    void insert(TIterator first, TIterator last)
+    {
+      while (first != last)
+      {
+        insert(*first++);
+      }
+    }
+
+    //*********************************************************************
+    /// Returns an iterator pointing to the first element in the container
+    /// whose key is not considered to go before the key provided or end()
+    /// if all keys are considered to go before the key provided.
+    ///\return An iterator pointing to the element not before key or end()
+    //*********************************************************************
+    iterator lower_bound(key_parameter_t key)
+    {
+      size_t index;
+      const node_t* p_node = find_bound(key, index, false);
+
+      return iterator(const_cast<node_t*>(p_node), index);
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator pointing to the first element in the
+    /// container whose key is not considered to go before the key provided
+    /// or end() if all keys are considered to go before the key provided.
+    ///\return An const_iterator pointing to the element not before key or end()
+    //*********************************************************************
+    const_iterator lower_bound(key_parameter_t key) const
+    {
+      size_t index;
+      const node_t* p_node = find_bound(key, index, false);
+
+      return const_iterator(p_node, index);
+    }
+
+    //*********************************************************************
+    /// Returns an iterator pointing to the first element in the container
+    /// whose key is not considered to go after the key provided or end()
+    /// if all keys are considered to go after the key provided.
+    ///\return An iterator pointing to the element after key or end()
+    //*********************************************************************
+    iterator upper_bound(key_parameter_t key)
+    {
+      size_t index;
+      const node_t* p_node = find_bound(key, index, true);
+
+      return iterator(const_cast<node_t*>(p_node), index);
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator pointing to the first element in the
+    /// container whose key is not considered to go after the key provided
+    /// or end() if all keys are considered to go after the key provided.
+    ///\return An const_iterator pointing to the element after key or end()
+    //*********************************************************************
+    const_iterator upper_bound(key_parameter_t key) const
+    {
+      size_t index;
+      const node_t* p_node = find_bound(key, index, true);
+
+      return const_iterator(p_node, index);
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    ibtree_map& operator = (const ibtree_map& rhs)
+    {
+      // Skip if doing self assignment
+      if (this != &rhs)
+      {
+        assign(rhs.cbegin(), rhs.cend());
+      }
+
+      return *this;
+    }
+
+    //*************************************************************************
+    /// Gets the size of the btree_map.
+    //*************************************************************************
+    size_type size() const
+    {
+      return current_size;
+    }
+
+    //*************************************************************************
+    /// Gets the maximum possible size of the btree_map.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the btree_map is empty.
+    //*************************************************************************
+    bool empty() const
+    {
+      return current_size == 0;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the btree_map is full.
+    //*************************************************************************
+    bool full() const
+    {
+      return current_size == CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Returns the capacity of the btree_map.
+    ///\return The capacity of the btree_map.
+    //*************************************************************************
+    size_type capacity() const
+    {
+      return CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Returns the remaining capacity.
+    ///\return The remaining capacity.
+    //*************************************************************************
+    size_t available() const
+    {
+      return max_size() - size();
+    }
+
+    //*************************************************************************
+    /// How to compare two key elements.
+    //*************************************************************************
+    key_compare key_comp() const
+    {
+      return compare;
+    }
+
+    //*************************************************************************
+    /// How to compare two value elements.
+    //*************************************************************************
+    value_compare value_comp() const
+    {
+      return value_compare();
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    ibtree_map(etl::ipool& leaf_pool, etl::ipool& internal_pool, size_t max_size_)
+      : p_leaf_pool(&leaf_pool),
+        p_internal_pool(&internal_pool),
+        p_root(nullptr),
+        p_leftmost(nullptr),
+        p_rightmost(nullptr),
+        current_size(0),
+        CAPACITY(max_size_)
+    {
+    }
+
+    //*************************************************************************
+    /// Initialise the btree_map.
+    //*************************************************************************
+    void initialise()
+    {
+      if (p_root != nullptr)
+      {
+        destroy_subtree(p_root);
+      }
+
+      p_root       = nullptr;
+      p_leftmost   = nullptr;
+      p_rightmost  = nullptr;
+      current_size = 0;
+      ETL_RESET_DEBUG_COUNT
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Gets a child of an internal node.
+    //*************************************************************************
+    static node_t* child(node_t* p_node, size_t index)
+    {
+      return static_cast<internal_node_t*>(p_node)->children[index];
+    }
+
+    //*************************************************************************
+    /// Gets a child of an internal node.
+    //*************************************************************************
+    static const node_t* child(const node_t* p_node, size_t index)
+    {
+      return static_cast<const internal_node_t*>(p_node)->children[index];
+    }
+
+    //*************************************************************************
+    /// Sets a child of an internal node.
+    //*************************************************************************
+    static void set_child(node_t* p_node, size_t index, node_t* p_child)
+    {
+      static_cast<internal_node_t*>(p_node)->children[index] = p_child;
+      p_child->parent   = p_node;
+      p_child->position = uint8_t(index);
+    }
+
+    //*************************************************************************
+    /// Moves 'n' children from 'p_source' to 'p_destination', starting at the
+    /// given indexes. The ranges may be in the same node and may overlap.
+    //*************************************************************************
+    static void move_children(node_t* p_destination, size_t destination_index, node_t* p_source, size_t source_index, size_t n)
+    {
+      node_t** children = static_cast<internal_node_t*>(p_source)->children;
+
+      memmove(static_cast<internal_node_t*>(p_destination)->children + destination_index, children + source_index, n * sizeof(node_t*));
+
+      for (size_t i = destination_index; i < (destination_index + n); ++i)
+      {
+        set_child(p_destination, i, child(p_destination, i));
+      }
+    }
+
+    //*************************************************************************
+    /// Moves 'n' values from 'p_source' to 'p_destination'.
+    /// The ranges may overlap.
+    //*************************************************************************
+    static void move_values(value_type* p_destination, value_type* p_source, size_t n)
+    {
+      if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<value_type>::value)
+      {
+        memmove(static_cast<void*>(p_destination), static_cast<const void*>(p_source), n * sizeof(value_type));
+      }
+      else if (p_destination < p_source)
+      {
+        for (size_t i = 0; i < n; ++i)
+        {
+          ::new (p_destination + i) value_type(p_source[i]);
+          p_source[i].~value_type();
+        }
+      }
+      else
+      {
+        while (n-- != 0)
+        {
+          ::new (p_destination + n) value_type(p_source[n]);
+          p_source[n].~value_type();
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Moves one value from 'p_source' to 'p_destination'.
+    //*************************************************************************
+    static void move_value(value_type* p_destination, value_type* p_source)
+    {
+      ::new (p_destination) value_type(*p_source);
+      p_source->~value_type();
+    }
+
+    //*************************************************************************
+    /// Moves to the next value.
+    /// Leaves (p_node, index) at end() if there is no next value.
+    //*************************************************************************
+    template <typename TNodePointer>
+    static void next_value(TNodePointer& p_node, size_t& index)
+    {
+      if (p_node->leaf)
+      {
+        ++index;
+        climb(p_node, index);
+      }
+      else
+      {
+        // The leftmost value of the right hand subtree.
+        p_node = child(p_node, index + 1);
+
+        while (!p_node->leaf)
+        {
+          p_node = child(p_node, 0);
+        }
+
+        index = 0;
+      }
+    }
+
+    //*************************************************************************
+    /// Moves to the previous value.
+    //*************************************************************************
+    template <typename TNodePointer>
+    static void previous_value(TNodePointer& p_node, size_t& index)
+    {
+      if (p_node->leaf)
+      {
+        // Up until there is a value to the left.
+        while ((index == 0) && (p_node->parent != nullptr))
+        {
+          index  = p_node->position;
+          p_node = p_node->parent;
+        }
+
+        if (index != 0)
+        {
+          --index;
+        }
+      }
+      else
+      {
+        // The rightmost value of the left hand subtree.
+        p_node = child(p_node, index);
+
+        while (!p_node->leaf)
+        {
+          p_node = child(p_node, p_node->count);
+        }
+
+        index = p_node->count - 1;
+      }
+    }
+
+    //*************************************************************************
+    /// If (p_node, index) is one past the last value of a leaf, moves up to
+    /// the next value. Stays put if there is none, as this is end().
+    //*************************************************************************
+    template <typename TNodePointer>
+    static void climb(TNodePointer& p_node, size_t& index)
+    {
+      if (index < p_node->count)
+      {
+        return;
+      }
+
+      TNodePointer p_leaf     = p_node;
+      size_t       leaf_index = index;
+
+      while ((index == p_node->count) && (p_node->parent != nullptr))
+      {
+        index  = p_node->position;
+        p_node = p_node->parent;
+      }
+
+      if (index == p_node->count)
+      {
+        p_node = p_leaf;
+        index  = leaf_index;
+      }
+    }
+
+    //*************************************************************************
+    /// The index of the first value in the node that is not less than the key.
+    //*************************************************************************
+    size_t lower_bound_index(const node_t* p_node, key_parameter_t key) const
+    {
+      const value_type* values = p_node->values();
+      size_t first = 0;
+      size_t n     = p_node->count;
+
+      while (n != 0)
+      {
+        size_t step = n / 2;
+
+        if (compare(values[first + step].first, key))
+        {
+          first += step + 1;
+          n     -= step + 1;
+        }
+        else
+        {
+          n = step;
+        }
+      }
+
+      return first;
+    }
+
+    //*************************************************************************
+    /// The index of the first value in the node that is greater than the key.
+    //*************************************************************************
+    size_t upper_bound_index(const node_t* p_node, key_parameter_t key) const
+    {
+      const value_type* values = p_node->values();
+      size_t first = 0;
+      size_t n     = p_node->count;
+
+      while (n != 0)
+      {
+        size_t step = n / 2;
+
+        if (!compare(key, values[first + step].first))
+        {
+          first += step + 1;
+          n     -= step + 1;
+        }
+        else
+        {
+          n = step;
+        }
+      }
+
+      return first;
+    }
+
+    //*************************************************************************
+    /// Finds the node and index holding the key.
+    ///\return The node, or nullptr if the key is not present.
+    //*************************************************************************
+    const node_t* find_node(key_parameter_t key, size_t& index) const
+    {
+      const node_t* p_node = p_root;
+
+      while (p_node != nullptr)
+      {
+        index = lower_bound_index(p_node, key);
+
+        if ((index < p_node->count) && !compare(key, p_node->values()[index].first))
+        {
+          return p_node;
+        }
+
+        if (p_node->leaf)
+        {
+          break;
+        }
+
+        p_node = child(p_node, index);
+      }
+
+      return nullptr;
+    }
+
+    //*************************************************************************
+    /// Finds the position of the lower or upper bound of the key.
+    //*************************************************************************
+    const node_t* find_bound(key_parameter_t key, size_t& index, bool upper) const
+    {
+      const node_t* p_node = p_root;
+      index = 0;
+
+      if (p_node == nullptr)
+      {
+        return p_node;
+      }
+
+      while (true)
+      {
+        if (upper)
+        {
+          index = upper_bound_index(p_node, key);
+        }
+        else
+        {
+          index = lower_bound_index(p_node, key);
+
+          if ((index < p_node->count) && !compare(key, p_node->values()[index].first))
+          {
+            return p_node;
+          }
+        }
+
+        if (p_node->leaf)
+        {
+          break;
+        }
+
+        p_node = child(p_node, index);
+      }
+
+      climb(p_node, index);
+
+      return p_node;
+    }
+
+    //*************************************************************************
+    /// Allocates an empty node.
+    //*************************************************************************
+    node_t* allocate_node(bool leaf)
+    {
+      node_t* p_node;
+
+      if (leaf)
+      {
+        p_node = p_leaf_pool->template allocate<node_t>();
+      }
+      else
+      {
+        p_node = p_internal_pool->template allocate<internal_node_t>();
+      }
+
+      p_node->parent   = nullptr;
+      p_node->position = 0;
+      p_node->count    = 0;
+      p_node->leaf     = leaf;
+
+      return p_node;
+    }
+
+    //*************************************************************************
+    /// Returns an empty node to its pool.
+    //*************************************************************************
+    void release_node(node_t* p_node)
+    {
+      if (p_node->leaf)
+      {
+        p_leaf_pool->release(p_node);
+      }
+      else
+      {
+        p_internal_pool->release(static_cast<internal_node_t*>(p_node));
+      }
+    }
+
+    //*************************************************************************
+    /// Destroys the values of a subtree and releases its nodes.
+    //*************************************************************************
+    void destroy_subtree(node_t* p_node)
+    {
+      if (!p_node->leaf)
+      {
+        for (size_t i = 0; i <= p_node->count; ++i)
+        {
+          destroy_subtree(child(p_node, i));
+        }
+      }
+
+      if ETL_IF_CONSTEXPR(!etl::is_trivially_destructible<value_type>::value)
+      {
+        value_type* values = p_node->values();
+
+        for (size_t i = 0; i < p_node->count; ++i)
+        {
+          values[i].~value_type();
+        }
+      }
+
+      release_node(p_node);
+    }
+
+    //*************************************************************************
+    /// Inserts a value before 'index' in the node.
+    /// For an internal node 'p_right' is the new child to the right of the value.
+    /// A full node is split in two around its median, which is inserted in the parent.
+    ///\return The position of the inserted value.
+    //*************************************************************************
+    iterator insert_value(node_t* p_node, size_t index, const value_type& value, node_t* p_right)
+    {
+      value_type* values = p_node->values();
+
+      if (p_node->count < NODE_VALUES)
+      {
+        move_values(values + index + 1, values + index, p_node->count - index);
+        ::new (values + index) value_type(value);
+
+        if (!p_node->leaf)
+        {
+          move_children(p_node, index + 2, p_node, index + 1, p_node->count - index);
+          set_child(p_node, index + 1, p_right);
+        }
+
+        ++p_node->count;
+
+        return iterator(p_node, index);
+      }
+
+      // Split the full node. The left keeps MIDDLE values, the right gets the
+      // rest, and the middle one of the NODE_VALUES + 1 goes to the parent.
+      const size_t MIDDLE  = NODE_VALUES / 2;
+      node_t*      p_split = allocate_node(p_node->leaf);
+      value_type*  split   = p_split->values();
+      iterator     position;
+
+      if (index < MIDDLE)
+      {
+        move_values(split, values + MIDDLE, NODE_VALUES - MIDDLE);
+        p_split->count = NODE_VALUES - MIDDLE;
+
+        if (!p_node->leaf)
+        {
+          move_children(p_split, 0, p_node, MIDDLE, NODE_VALUES - MIDDLE + 1);
+        }
+
+        p_node->count = MIDDLE - 1;
+        insert_in_parent(p_node, values[MIDDLE - 1], p_split);
+        values[MIDDLE - 1].~value_type();
+
+        move_values(values + index + 1, values + index, MIDDLE - 1 - index);
+        ::new (values + index) value_type(value);
+
+        if (!p_node->leaf)
+        {
+          move_children(p_node, index + 2, p_node, index + 1, MIDDLE - 1 - index);
+          set_child(p_node, index + 1, p_right);
+        }
+
+        p_node->count = MIDDLE;
+        position = iterator(p_node, index);
+      }
+      else if (index == MIDDLE)
+      {
+        // The new value is the median.
+        move_values(split, values + MIDDLE, NODE_VALUES - MIDDLE);
+        p_split->count = NODE_VALUES - MIDDLE;
+
+        if (!p_node->leaf)
+        {
+          move_children(p_split, 1, p_node, MIDDLE + 1, NODE_VALUES - MIDDLE);
+          set_child(p_split, 0, p_right);
+        }
+
+        p_node->count = MIDDLE;
+        position = insert_in_parent(p_node, value, p_split);
+      }
+      else
+      {
+        const size_t split_index = index - MIDDLE - 1;
+
+        move_values(split, values + MIDDLE + 1, split_index);
+        ::new (split + split_index) value_type(value);
+        move_values(split + split_index + 1, values + index, NODE_VALUES - index);
+        p_split->count = NODE_VALUES - MIDDLE;
+
+        if (!p_node->leaf)
+        {
+          move_children(p_split, 0, p_node, MIDDLE + 1, split_index + 1);
+          set_child(p_split, split_index + 1, p_right);
+          move_children(p_split, split_index + 2, p_node, index + 1, NODE_VALUES - index);
+        }
+
+        p_node->count = MIDDLE;
+        insert_in_parent(p_node, values[MIDDLE], p_split);
+        values[MIDDLE].~value_type();
+
+        position = iterator(p_split, split_index);
+      }
+
+      if (p_node == p_rightmost)
+      {
+        p_rightmost = p_split;
+      }
+
+      return position;
+    }
+
+    //*************************************************************************
+    /// Inserts the median of a split in the parent, with 'p_right' to its right.
+    /// Adds a new root if the split node was the root.
+    //*************************************************************************
+    iterator insert_in_parent(node_t* p_left, const value_type& value, node_t* p_right)
+    {
+      if (p_left->parent == nullptr)
+      {
+        p_root = allocate_node(false);
+        ::new (p_root->values()) value_type(value);
+        p_root->count = 1;
+        set_child(p_root, 0, p_left);
+        set_child(p_root, 1, p_right);
+
+        return iterator(p_root, 0);
+      }
+
+      return insert_value(p_left->parent, p_left->position, value, p_right);
+    }
+
+    //*************************************************************************
+    /// Erases the value at the position.
+    ///\return The position of the next value.
+    //*************************************************************************
+    iterator erase_at(node_t* p_node, size_t index)
+    {
+      bool next_is_successor = true;
+
+      if (p_node->leaf)
+      {
+        value_type* values = p_node->values();
+
+        values[index].~value_type();
+        move_values(values + index, values + index + 1, p_node->count - index - 1);
+        --p_node->count;
+      }
+      else
+      {
+        // Replace with the predecessor, the rightmost value of the left hand subtree.
+        node_t* p_leaf = child(p_node, index);
+
+        while (!p_leaf->leaf)
+        {
+          p_leaf = child(p_leaf, p_leaf->count);
+        }
+
+        p_node->values()[index].~value_type();
+        --p_leaf->count;
+        move_value(p_node->values() + index, p_leaf->values() + p_leaf->count);
+
+        // The tracked position is now the predecessor, so the next value is the one after.
+        p_node            = p_leaf;
+        index             = p_leaf->count;
+        next_is_successor = false;
+      }
+
+      --current_size;
+      ETL_DECREMENT_DEBUG_COUNT
+
+      rebalance(p_node, index);
+
+      if (p_root == nullptr)
+      {
+        return end();
+      }
+
+      climb(p_node, index);
+
+      iterator position(p_node, index);
+
+      if (!next_is_successor)
+      {
+        ++position;
+      }
+
+      return position;
+    }
+
+    //*************************************************************************
+    /// Restores the minimum number of values in the leaf after an erase, by
+    /// borrowing from or merging with a sibling, and then up the tree.
+    /// (p_leaf, index) is a position in the leaf that is kept up to date.
+    //*************************************************************************
+    void rebalance(node_t*& p_leaf, size_t& index)
+    {
+      node_t* p_node = p_leaf;
+
+      while (p_node != p_root)
+      {
+        if (p_node->count >= MIN_VALUES)
+        {
+          return;
+        }
+
+        node_t* p_parent = p_node->parent;
+        size_t  position = p_node->position;
+        node_t* p_left   = (position > 0)                ? child(p_parent, position - 1) : nullptr;
+        node_t* p_right  = (position < p_parent->count) ? child(p_parent, position + 1) : nullptr;
+
+        if ((p_left != nullptr) && (p_left->count > MIN_VALUES))
+        {
+          rotate_right(p_left, p_node);
+
+          if (p_node == p_leaf)
+          {
+            ++index;
+          }
+
+          return;
+        }
+
+        if ((p_right != nullptr) && (p_right->count > MIN_VALUES))
+        {
+          rotate_left(p_node, p_right);
+          return;
+        }
+
+        if (p_left != nullptr)
+        {
+          if (p_node == p_leaf)
+          {
+            index += p_left->count + 1;
+            p_leaf = p_left;
+          }
+
+          merge(p_left, p_node);
+        }
+        else
+        {
+          merge(p_node, p_right);
+        }
+
+        p_node = p_parent;
+      }
+
+      // The root may be left empty.
+      if (p_root->count == 0)
+      {
+        node_t* p_old_root = p_root;
+
+        if (p_root->leaf)
+        {
+          p_root      = nullptr;
+          p_leftmost  = nullptr;
+          p_rightmost = nullptr;
+        }
+        else
+        {
+          p_root = child(p_root, 0);
+          p_root->parent   = nullptr;
+          p_root->position = 0;
+        }
+
+        release_node(p_old_root);
+      }
+    }
+
+    //*************************************************************************
+    /// Moves the last value of 'p_left' up to the parent and the parent's
+    /// separator down to the front of 'p_right'.
+    //*************************************************************************
+    void rotate_right(node_t* p_left, node_t* p_right)
+    {
+      value_type* separator = p_right->parent->values() + p_left->position;
+      value_type* values    = p_right->values();
+
+      move_values(values + 1, values, p_right->count);
+      move_value(values, separator);
+      move_value(separator, p_left->values() + p_left->count - 1);
+
+      if (!p_right->leaf)
+      {
+        move_children(p_right, 1, p_right, 0, p_right->count + 1);
+        set_child(p_right, 0, child(p_left, p_left->count));
+      }
+
+      --p_left->count;
+      ++p_right->count;
+    }
+
+    //*************************************************************************
+    /// Moves the first value of 'p_right' up to the parent and the parent's
+    /// separator down to the end of 'p_left'.
+    //*************************************************************************
+    void rotate_left(node_t* p_left, node_t* p_right)
+    {
+      value_type* separator = p_left->parent->values() + p_left->position;
+      value_type* values    = p_right->values();
+
+      move_value(p_left->values() + p_left->count, separator);
+      move_value(separator, values);
+      move_values(values, values + 1, p_right->count - 1);
+
+      if (!p_left->leaf)
+      {
+        set_child(p_left, p_left->count + 1, child(p_right, 0));
+        move_children(p_right, 0, p_right, 1, p_right->count);
+      }
+
+      ++p_left->count;
+      --p_right->count;
+    }
+
+    //*************************************************************************
+    /// Moves the parent's separator and all of 'p_right' into 'p_left', then
+    /// removes the separator and 'p_right' from the parent.
+    //*************************************************************************
+    void merge(node_t* p_left, node_t* p_right)
+    {
+      node_t*     p_parent = p_left->parent;
+      size_t      position = p_left->position;
+      value_type* values   = p_left->values();
+
+      move_value(values + p_left->count, p_parent->values() + position);
+      move_values(values + p_left->count + 1, p_right->values(), p_right->count);
+
+      if (!p_left->leaf)
+      {
+        move_children(p_left, p_left->count + 1, p_right, 0, p_right->count + 1);
+      }
+
+      p_left->count += p_right->count + 1;
+
+      move_values(p_parent->values() + position, p_parent->values() + position + 1, p_parent->count - position - 1);
+      move_children(p_parent, position + 1, p_parent, position + 2, p_parent->count - position - 1);
+      --p_parent->count;
+
+      if (p_right == p_rightmost)
+      {
+        p_rightmost = p_left;
+      }
+
+      p_right->count = 0;
+      release_node(p_right);
+    }
+
+    // Disable copy construction.
+    ibtree_map(const ibtree_map&);
+
+    /// The pool of leaf nodes.
+    etl::ipool* p_leaf_pool;
+
+    /// The pool of internal nodes.
+    etl::ipool* p_internal_pool;
+
+    /// The root node. nullptr if empty.
+    node_t* p_root;
+
+    /// The leaf holding the first value.
+    node_t* p_leftmost;
+
+    /// The leaf holding the last value.
+    node_t* p_rightmost;
+
+    /// The number of elements.
+    size_type current_size;
+
+    /// The maximum number of elements.
+    const size_type CAPACITY;
+
+    /// How to compare keys.
+    key_compare compare;
+
+    /// For library debugging purposes only.
+    ETL_DECLARE_DEBUG_COUNT
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_BTREE_MAP) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~ibtree_map()
+    {
+    }
+#else
+  protected:
+    ~ibtree_map()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  /// Equal operator.
+  ///\param lhs Reference to the first btree_map.
+  ///\param rhs Reference to the second btree_map.
+  ///\return <b>true</b> if the maps are equal, otherwise <b>false</b>
+  ///\ingroup btree_map
+  //***************************************************************************
+  template <typename TKey, typename TMapped, typename TKeyCompare>
+  bool operator ==(const etl::ibtree_map<TKey, TMapped, TKeyCompare>& lhs, const etl::ibtree_map<TKey, TMapped, TKeyCompare>& rhs)
+  {
+    return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  //***************************************************************************
+  /// Not equal operator.
+  ///\param lhs Reference to the first btree_map.
+  ///\param rhs Reference to the second btree_map.
+  ///\return <b>true</b> if the maps are not equal, otherwise <b>false</b>
+  ///\ingroup btree_map
+  //***************************************************************************
+  template <typename TKey, typename TMapped, typename TKeyCompare>
+  bool operator !=(const etl::ibtree_map<TKey, TMapped, TKeyCompare>& lhs, const etl::ibtree_map<TKey, TMapped, TKeyCompare>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  //*************************************************************************
+  /// Less than operator.
+  ///\param lhs Reference to the first btree_map.
+  ///\param rhs Reference to the second btree_map.
+  ///\return <b>true</b> if the first btree_map is lexicographically less than the
+  /// second, otherwise <b>false</b>.
+  ///\ingroup btree_map
+  //*************************************************************************
+  template <typename TKey, typename TMapped, typename TKeyCompare>
+  bool operator <(const etl::ibtree_map<TKey, TMapped, TKeyCompare>& lhs, const etl::ibtree_map<TKey, TMapped, TKeyCompare>& rhs)
+  {
+    return std::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  //*************************************************************************
+  /// Greater than operator.
+  ///\param lhs Reference to the first btree_map.
+  ///\param rhs Reference to the second btree_map.
+  ///\return <b>true</b> if the first btree_map is lexicographically greater than the
+  /// second, otherwise <b>false</b>.
+  ///\ingroup btree_map
+  //*************************************************************************
+  template <typename TKey, typename TMapped, typename TKeyCompare>
+  bool operator >(const etl::ibtree_map<TKey, TMapped, TKeyCompare>& lhs, const etl::ibtree_map<TKey, TMapped, TKeyCompare>& rhs)
+  {
+    return (rhs < lhs);
+  }
+
+  //*************************************************************************
+  /// Less than or equal operator.
+  ///\param lhs Reference to the first btree_map.
+  ///\param rhs Reference to the second btree_map.
+  ///\return <b>true</b> if the first btree_map is lexicographically less than or equal
+  /// to the second, otherwise <b>false</b>.
+  ///\ingroup btree_map
+  //*************************************************************************
+  template <typename TKey, typename TMapped, typename TKeyCompare>
+  bool operator <=(const etl::ibtree_map<TKey, TMapped, TKeyCompare>& lhs, const etl::ibtree_map<TKey, TMapped, TKeyCompare>& rhs)
+  {
+    return !(lhs > rhs);
+  }
+
+  //*************************************************************************
+  /// Greater than or equal operator.
+  ///\param lhs Reference to the first btree_map.
+  ///\param rhs Reference to the second btree_map.
+  ///\return <b>true</b> if the first btree_map is lexicographically greater than or
+  /// equal to the second, otherwise <b>false</b>.
+  ///\ingroup btree_map
+  //*************************************************************************
+  template <typename TKey, typename TMapped, typename TKeyCompare>
+  bool operator >=(const etl::ibtree_map<TKey, TMapped, TKeyCompare>& lhs, const etl::ibtree_map<TKey, TMapped, TKeyCompare>& rhs)
+  {
+    return !(lhs < rhs);
+  }
+
+  //*************************************************************************
+  /// A templated btree_map implementation that uses fixed size node pools.
+  /// The pools are sized for the worst case, where every node apart from the
+  /// root is only half full.
+  //*************************************************************************
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare = std::less<TKey> >
+  class btree_map : public etl::ibtree_map<TKey, TValue, TCompare>
+  {
+  private:
+
+    typedef etl::ibtree_map<TKey, TValue, TCompare> base;
+
+  public:
+
+    static const size_t MAX_SIZE       = MAX_SIZE_;
+    static const size_t LEAF_NODES     = (MAX_SIZE_ / base::MIN_VALUES) + 1;
+    static const size_t INTERNAL_NODES = (LEAF_NODES / base::MIN_VALUES) + 1;
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    btree_map()
+      : base(leaf_pool, internal_pool, MAX_SIZE)
+    {
+    }
+
+    //*************************************************************************
+    /// Copy constructor.
+    //*************************************************************************
+    btree_map(const btree_map& other)
+      : base(leaf_pool, internal_pool, MAX_SIZE)
+    {
+      this->assign(other.cbegin(), other.cend());
+    }
+
+    //*************************************************************************
+    /// Constructor, from an iterator range.
+    ///\tparam TIterator The iterator type.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*************************************************************************
+    template <typename TIterator>
+    btree_map(TIterator first, TIterator last)
+      : base(leaf_pool, internal_pool, MAX_SIZE)
+    {
+      this->assign(first, last);
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Constructor, from an initializer_list.
+    //*************************************************************************
+    btree_map(std::initializer_list<typename base::value_type> init)
+      : base(leaf_pool, internal_pool, MAX_SIZE)
+    {
+      this->assign(init.begin(), init.end());
+    }
+#endif
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~btree_map()
+    {
+      this->initialise();
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    btree_map& operator = (const btree_map& rhs)
+    {
+      // Skip if doing self assignment
+      if (this != &rhs)
+      {
+        this->assign(rhs.cbegin(), rhs.cend());
+      }
+
+      return *this;
+    }
+
+  private:
+
+    /// The pool of leaf nodes.
+    etl::pool<typename base::node_t, LEAF_NODES> leaf_pool;
+
+    /// The pool of internal nodes.
+    etl::pool<typename base::internal_node_t, INTERNAL_NODES> internal_pool;
+  };
+}
+
+#undef ETL_FILE
+
+#endif
@@ -0,0 +1,324 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_COUNTING_BLOOM_FILTER_INCLUDED
+#define ETL_COUNTING_BLOOM_FILTER_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "parameter_type.h"
+#include "static_assert.h"
+
+#define ETL_IN_COUNTING_BLOOM_FILTER_H
+#include "private/filter_hash.h"
+#undef ETL_IN_COUNTING_BLOOM_FILTER_H
+
+///\defgroup counting_bloom_filter counting_bloom_filter
+/// A Bloom filter that supports removal
+///\ingroup containers
+
+namespace etl
+{
+  //***************************************************************************
+  /// A Bloom filter of 4 bit counters, so that keys may be removed.
+  /// As with etl::blocked_bloom_filter, all of the counters for a key are in
+  /// one cache line sized block, and are derived from one hash of the key.
+  /// A counter that reaches 15 saturates and is never decremented again, so
+  /// that removing other keys can not cause a false negative.
+  /// The hash class must support the () operator and define 'argument_type'.
+  ///\tparam DESIRED_WIDTH The desired number of counters. Rounded up to a whole number of blocks.
+  ///\tparam THash         The hash generator class.
+  ///\tparam N_HASHES_     The number of counters incremented for each key.
+  ///\ingroup counting_bloom_filter
+  //***************************************************************************
+  template <const size_t DESIRED_WIDTH, typename THash, const size_t N_HASHES_ = 4>
+  class counting_bloom_filter
+  {
+  private:
+
+    typedef typename etl::parameter_type<typename THash::argument_type>::type parameter_t;
+    typedef uint64_t word_t;
+
+  public:
+
+    static const size_t COUNTER_BITS       = 4;
+    static const size_t COUNTER_MAX        = (1U << COUNTER_BITS) - 1;
+    static const size_t BLOCK_BYTES        = 64;
+    static const size_t BLOCK_COUNTERS     = (BLOCK_BYTES * 8) / COUNTER_BITS;
+    static const size_t COUNTERS_PER_WORD  = (sizeof(word_t) * 8) / COUNTER_BITS;
+    static const size_t WORDS_PER_BLOCK    = BLOCK_COUNTERS / COUNTERS_PER_WORD;
+    static const size_t NUMBER_OF_BLOCKS   = (DESIRED_WIDTH == 0) ? 1 : ((DESIRED_WIDTH + BLOCK_COUNTERS - 1) / BLOCK_COUNTERS);
+    static const size_t WIDTH              = NUMBER_OF_BLOCKS * BLOCK_COUNTERS;
+    static const size_t N_HASHES           = N_HASHES_;
+
+    ETL_STATIC_ASSERT((N_HASHES > 0) && (N_HASHES <= BLOCK_COUNTERS), "N_HASHES out of range");
+    ETL_STATIC_ASSERT(uint64_t(NUMBER_OF_BLOCKS) <= uint64_t(UINT32_MAX), "Too many blocks");
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    counting_bloom_filter()
+    {
+      clear();
+    }
+
+    //*************************************************************************
+    /// Copy constructor.
+    //*************************************************************************
+    counting_bloom_filter(const counting_bloom_filter& other)
+    {
+      copy_blocks(other);
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    counting_bloom_filter& operator =(const counting_bloom_filter& other)
+    {
+      if (&other != this)
+      {
+        copy_blocks(other);
+      }
+
+      return *this;
+    }
+
+    //*************************************************************************
+    /// Clears the bloom filter of all entries.
+    //*************************************************************************
+    void clear()
+    {
+      for (size_t i = 0; i < N_WORDS; ++i)
+      {
+        words[i] = 0;
+      }
+    }
+
+    //*************************************************************************
+    /// Adds a key to the filter.
+    ///\param key The key to add.
+    //*************************************************************************
+    void add(parameter_t key)
+    {
+      uint64_t hash    = get_hash(key);
+      word_t*  p_block = get_block(hash);
+
+      uint32_t h1 = uint32_t(hash);
+      uint32_t h2 = uint32_t(hash >> 32) | 1U;
+
+      for (size_t i = 0; i < N_HASHES; ++i)
+      {
+        uint32_t counter = h1 & (BLOCK_COUNTERS - 1);
+        word_t&  word    = p_block[counter / COUNTERS_PER_WORD];
+        size_t   shift   = (counter % COUNTERS_PER_WORD) * COUNTER_BITS;
+
+        if (((word >> shift) & COUNTER_MAX) != COUNTER_MAX)
+        {
+          word += word_t(1) << shift;
+        }
+
+        h1 += h2;
+      }
+    }
+
+    //*************************************************************************
+    /// Removes a key from the filter.
+    /// Only keys that have been added should be removed. Removing a key that
+    /// was not added may cause false negatives for keys that share its counters.
+    ///\param  key The key to remove.
+    ///\return <b>true</b> if the key was in the filter.
+    //*************************************************************************
+    bool remove(parameter_t key)
+    {
+      uint64_t hash    = get_hash(key);
+      word_t*  p_block = get_block(hash);
+
+      if (!exists_hash(hash))
+      {
+        return false;
+      }
+
+      uint32_t h1 = uint32_t(hash);
+      uint32_t h2 = uint32_t(hash >> 32) | 1U;
+
+      for (size_t i = 0; i < N_HASHES; ++i)
+      {
+        uint32_t counter = h1 & (BLOCK_COUNTERS - 1);
+        word_t&  word    = p_block[counter / COUNTERS_PER_WORD];
+        size_t   shift   = (counter % COUNTERS_PER_WORD) * COUNTER_BITS;
+
+        if (((word >> shift) & COUNTER_MAX) != COUNTER_MAX)
+        {
+          word -= word_t(1) << shift;
+        }
+
+        h1 += h2;
+      }
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Tests a key to see if it exists in the filter.
+    ///\param  key The key to test.
+    ///\return <b>true</b> if the key exists in the filter.
+    //*************************************************************************
+    bool exists(parameter_t key) const
+    {
+      return exists_hash(get_hash(key));
+    }
+
+    //*************************************************************************
+    /// Returns the number of counters in the filter.
+    //*************************************************************************
+    size_t width() const
+    {
+      return WIDTH;
+    }
+
+    //*************************************************************************
+    /// Returns the percentage of usage. Range 0 to 100.
+    //*************************************************************************
+    size_t usage() const
+    {
+      return (100 * count()) / WIDTH;
+    }
+
+    //*************************************************************************
+    /// Returns the number of non-zero counters.
+    //*************************************************************************
+    size_t count() const
+    {
+      const word_t* p_words = get_words();
+      size_t n = 0;
+
+      for (size_t i = 0; i < (NUMBER_OF_BLOCKS * WORDS_PER_BLOCK); ++i)
+      {
+        for (size_t shift = 0; shift < (sizeof(word_t) * 8); shift += COUNTER_BITS)
+        {
+          n += ((p_words[i] >> shift) & COUNTER_MAX) != 0 ? 1 : 0;
+        }
+      }
+
+      return n;
+    }
+
+  private:
+
+    // One spare block, so that the blocks can start on a block boundary.
+    static const size_t N_WORDS = (NUMBER_OF_BLOCKS + 1) * WORDS_PER_BLOCK;
+
+    //*************************************************************************
+    /// Gets the mixed hash for the key.
+    //*************************************************************************
+    static uint64_t get_hash(parameter_t key)
+    {
+      return private_filter_hash::mix(uint64_t(THash()(key)));
+    }
+
+    //*************************************************************************
+    /// Tests that all of the counters for a hash are non-zero.
+    //*************************************************************************
+    bool exists_hash(uint64_t hash) const
+    {
+      const word_t* p_block = get_block(hash);
+
+      uint32_t h1 = uint32_t(hash);
+      uint32_t h2 = uint32_t(hash >> 32) | 1U;
+
+      bool found = true;
+
+      for (size_t i = 0; i < N_HASHES; ++i)
+      {
+        uint32_t counter = h1 & (BLOCK_COUNTERS - 1);
+        size_t   shift   = (counter % COUNTERS_PER_WORD) * COUNTER_BITS;
+
+        found &= ((p_block[counter / COUNTERS_PER_WORD] >> shift) & COUNTER_MAX) != 0;
+        h1 += h2;
+      }
+
+      return found;
+    }
+
+    //*************************************************************************
+    /// Gets the block for a hash.
+    //*************************************************************************
+    word_t* get_block(uint64_t hash)
+    {
+      size_t index = private_filter_hash::reduce(uint32_t(hash >> 32), NUMBER_OF_BLOCKS);
+
+      return get_words() + (index * WORDS_PER_BLOCK);
+    }
+
+    const word_t* get_block(uint64_t hash) const
+    {
+      return const_cast<counting_bloom_filter*>(this)->get_block(hash);
+    }
+
+    //*************************************************************************
+    /// Gets the first word of the first block.
+    //*************************************************************************
+    word_t* get_words()
+    {
+      uintptr_t address = reinterpret_cast<uintptr_t>(&words[0]);
+
+      address = (address + (BLOCK_BYTES - 1)) & ~uintptr_t(BLOCK_BYTES - 1);
+
+      return reinterpret_cast<word_t*>(address);
+    }
+
+    const word_t* get_words() const
+    {
+      return const_cast<counting_bloom_filter*>(this)->get_words();
+    }
+
+    //*************************************************************************
+    /// Copies the blocks of another filter.
+    /// The blocks may start at a different offset in each filter.
+    //*************************************************************************
+    void copy_blocks(const counting_bloom_filter& other)
+    {
+      const word_t* p_source      = other.get_words();
+      word_t*       p_destination = get_words();
+
+      for (size_t i = 0; i < (NUMBER_OF_BLOCKS * WORDS_PER_BLOCK); ++i)
+      {
+        p_destination[i] = p_source[i];
+      }
+    }
+
+    /// The counters, packed into words.
+    word_t words[N_WORDS];
+  };
+}
+
+#endif
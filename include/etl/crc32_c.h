@@ -36,6 +36,10 @@ SOFTWARE.
 #include "platform.h"
 #include "frame_check_sequence.h"
 
+#define ETL_IN_CRC32_C_H
+#include "private/crc32_block.h"
+#undef ETL_IN_CRC32_C_H
+
 #include "stl/iterator.h"
 
 #if defined(ETL_COMPILER_KEIL)
@@ -107,6 +111,299 @@ namespace etl
       return  (crc >> 8) ^ CRC32_C[(crc ^ value) & 0xFF];
     }
 
+    //*************************************************************************
+    /// Adds a block of bytes.
+    /// Uses the CPU's CRC instructions if it has them, otherwise slicing-by-8.
+    /// The result is identical to adding the bytes one at a time.
+    //*************************************************************************
+    inline uint32_t add_block(uint32_t crc, const uint8_t* data, size_t length) const
+    {
+#if defined(ETL_CRC_X86_HARDWARE)
+      if (private_crc32::has_sse42())
+      {
+        return private_crc32::crc32_c_sse42(crc, data, length);
+      }
+#endif
+
+      static const uint32_t CRC32_C_SLICE[8][256] =
+      {
+        {
+          0x00000000L, 0xF26B8303L, 0xE13B70F7L, 0x1350F3F4L, 0xC79A971FL, 0x35F1141CL, 0x26A1E7E8L, 0xD4CA64EBL,
+          0x8AD958CFL, 0x78B2DBCCL, 0x6BE22838L, 0x9989AB3BL, 0x4D43CFD0L, 0xBF284CD3L, 0xAC78BF27L, 0x5E133C24L,
+          0x105EC76FL, 0xE235446CL, 0xF165B798L, 0x030E349BL, 0xD7C45070L, 0x25AFD373L, 0x36FF2087L, 0xC494A384L,
+          0x9A879FA0L, 0x68EC1CA3L, 0x7BBCEF57L, 0x89D76C54L, 0x5D1D08BFL, 0xAF768BBCL, 0xBC267848L, 0x4E4DFB4BL,
+          0x20BD8EDEL, 0xD2D60DDDL, 0xC186FE29L, 0x33ED7D2AL, 0xE72719C1L, 0x154C9AC2L, 0x061C6936L, 0xF477EA35L,
+          0xAA64D611L, 0x580F5512L, 0x4B5FA6E6L, 0xB93425E5L, 0x6DFE410EL, 0x9F95C20DL, 0x8CC531F9L, 0x7EAEB2FAL,
+          0x30E349B1L, 0xC288CAB2L, 0xD1D83946L, 0x23B3BA45L, 0xF779DEAEL, 0x05125DADL, 0x1642AE59L, 0xE4292D5AL,
+          0xBA3A117EL, 0x4851927DL, 0x5B016189L, 0xA96AE28AL, 0x7DA08661L, 0x8FCB0562L, 0x9C9BF696L, 0x6EF07595L,
+          0x417B1DBCL, 0xB3109EBFL, 0xA0406D4BL, 0x522BEE48L, 0x86E18AA3L, 0x748A09A0L, 0x67DAFA54L, 0x95B17957L,
+          0xCBA24573L, 0x39C9C670L, 0x2A993584L, 0xD8F2B687L, 0x0C38D26CL, 0xFE53516FL, 0xED03A29BL, 0x1F682198L,
+          0x5125DAD3L, 0xA34E59D0L, 0xB01EAA24L, 0x42752927L, 0x96BF4DCCL, 0x64D4CECFL, 0x77843D3BL, 0x85EFBE38L,
+          0xDBFC821CL, 0x2997011FL, 0x3AC7F2EBL, 0xC8AC71E8L, 0x1C661503L, 0xEE0D9600L, 0xFD5D65F4L, 0x0F36E6F7L,
+          0x61C69362L, 0x93AD1061L, 0x80FDE395L, 0x72966096L, 0xA65C047DL, 0x5437877EL, 0x4767748AL, 0xB50CF789L,
+          0xEB1FCBADL, 0x197448AEL, 0x0A24BB5AL, 0xF84F3859L, 0x2C855CB2L, 0xDEEEDFB1L, 0xCDBE2C45L, 0x3FD5AF46L,
+          0x7198540DL, 0x83F3D70EL, 0x90A324FAL, 0x62C8A7F9L, 0xB602C312L, 0x44694011L, 0x5739B3E5L, 0xA55230E6L,
+          0xFB410CC2L, 0x092A8FC1L, 0x1A7A7C35L, 0xE811FF36L, 0x3CDB9BDDL, 0xCEB018DEL, 0xDDE0EB2AL, 0x2F8B6829L,
+          0x82F63B78L, 0x709DB87BL, 0x63CD4B8FL, 0x91A6C88CL, 0x456CAC67L, 0xB7072F64L, 0xA457DC90L, 0x563C5F93L,
+          0x082F63B7L, 0xFA44E0B4L, 0xE9141340L, 0x1B7F9043L, 0xCFB5F4A8L, 0x3DDE77ABL, 0x2E8E845FL, 0xDCE5075CL,
+          0x92A8FC17L, 0x60C37F14L, 0x73938CE0L, 0x81F80FE3L, 0x55326B08L, 0xA759E80BL, 0xB4091BFFL, 0x466298FCL,
+          0x1871A4D8L, 0xEA1A27DBL, 0xF94AD42FL, 0x0B21572CL, 0xDFEB33C7L, 0x2D80B0C4L, 0x3ED04330L, 0xCCBBC033L,
+          0xA24BB5A6L, 0x502036A5L, 0x4370C551L, 0xB11B4652L, 0x65D122B9L, 0x97BAA1BAL, 0x84EA524EL, 0x7681D14DL,
+          0x2892ED69L, 0xDAF96E6AL, 0xC9A99D9EL, 0x3BC21E9DL, 0xEF087A76L, 0x1D63F975L, 0x0E330A81L, 0xFC588982L,
+          0xB21572C9L, 0x407EF1CAL, 0x532E023EL, 0xA145813DL, 0x758FE5D6L, 0x87E466D5L, 0x94B49521L, 0x66DF1622L,
+          0x38CC2A06L, 0xCAA7A905L, 0xD9F75AF1L, 0x2B9CD9F2L, 0xFF56BD19L, 0x0D3D3E1AL, 0x1E6DCDEEL, 0xEC064EEDL,
+          0xC38D26C4L, 0x31E6A5C7L, 0x22B65633L, 0xD0DDD530L, 0x0417B1DBL, 0xF67C32D8L, 0xE52CC12CL, 0x1747422FL,
+          0x49547E0BL, 0xBB3FFD08L, 0xA86F0EFCL, 0x5A048DFFL, 0x8ECEE914L, 0x7CA56A17L, 0x6FF599E3L, 0x9D9E1AE0L,
+          0xD3D3E1ABL, 0x21B862A8L, 0x32E8915CL, 0xC083125FL, 0x144976B4L, 0xE622F5B7L, 0xF5720643L, 0x07198540L,
+          0x590AB964L, 0xAB613A67L, 0xB831C993L, 0x4A5A4A90L, 0x9E902E7BL, 0x6CFBAD78L, 0x7FAB5E8CL, 0x8DC0DD8FL,
+          0xE330A81AL, 0x115B2B19L, 0x020BD8EDL, 0xF0605BEEL, 0x24AA3F05L, 0xD6C1BC06L, 0xC5914FF2L, 0x37FACCF1L,
+          0x69E9F0D5L, 0x9B8273D6L, 0x88D28022L, 0x7AB90321L, 0xAE7367CAL, 0x5C18E4C9L, 0x4F48173DL, 0xBD23943EL,
+          0xF36E6F75L, 0x0105EC76L, 0x12551F82L, 0xE03E9C81L, 0x34F4F86AL, 0xC69F7B69L, 0xD5CF889DL, 0x27A40B9EL,
+          0x79B737BAL, 0x8BDCB4B9L, 0x988C474DL, 0x6AE7C44EL, 0xBE2DA0A5L, 0x4C4623A6L, 0x5F16D052L, 0xAD7D5351L
+        },
+        {
+          0x00000000L, 0x13A29877L, 0x274530EEL, 0x34E7A899L, 0x4E8A61DCL, 0x5D28F9ABL, 0x69CF5132L, 0x7A6DC945L,
+          0x9D14C3B8L, 0x8EB65BCFL, 0xBA51F356L, 0xA9F36B21L, 0xD39EA264L, 0xC03C3A13L, 0xF4DB928AL, 0xE7790AFDL,
+          0x3FC5F181L, 0x2C6769F6L, 0x1880C16FL, 0x0B225918L, 0x714F905DL, 0x62ED082AL, 0x560AA0B3L, 0x45A838C4L,
+          0xA2D13239L, 0xB173AA4EL, 0x859402D7L, 0x96369AA0L, 0xEC5B53E5L, 0xFFF9CB92L, 0xCB1E630BL, 0xD8BCFB7CL,
+          0x7F8BE302L, 0x6C297B75L, 0x58CED3ECL, 0x4B6C4B9BL, 0x310182DEL, 0x22A31AA9L, 0x1644B230L, 0x05E62A47L,
+          0xE29F20BAL, 0xF13DB8CDL, 0xC5DA1054L, 0xD6788823L, 0xAC154166L, 0xBFB7D911L, 0x8B507188L, 0x98F2E9FFL,
+          0x404E1283L, 0x53EC8AF4L, 0x670B226DL, 0x74A9BA1AL, 0x0EC4735FL, 0x1D66EB28L, 0x298143B1L, 0x3A23DBC6L,
+          0xDD5AD13BL, 0xCEF8494CL, 0xFA1FE1D5L, 0xE9BD79A2L, 0x93D0B0E7L, 0x80722890L, 0xB4958009L, 0xA737187EL,
+          0xFF17C604L, 0xECB55E73L, 0xD852F6EAL, 0xCBF06E9DL, 0xB19DA7D8L, 0xA23F3FAFL, 0x96D89736L, 0x857A0F41L,
+          0x620305BCL, 0x71A19DCBL, 0x45463552L, 0x56E4AD25L, 0x2C896460L, 0x3F2BFC17L, 0x0BCC548EL, 0x186ECCF9L,
+          0xC0D23785L, 0xD370AFF2L, 0xE797076BL, 0xF4359F1CL, 0x8E585659L, 0x9DFACE2EL, 0xA91D66B7L, 0xBABFFEC0L,
+          0x5DC6F43DL, 0x4E646C4AL, 0x7A83C4D3L, 0x69215CA4L, 0x134C95E1L, 0x00EE0D96L, 0x3409A50FL, 0x27AB3D78L,
+          0x809C2506L, 0x933EBD71L, 0xA7D915E8L, 0xB47B8D9FL, 0xCE1644DAL, 0xDDB4DCADL, 0xE9537434L, 0xFAF1EC43L,
+          0x1D88E6BEL, 0x0E2A7EC9L, 0x3ACDD650L, 0x296F4E27L, 0x53028762L, 0x40A01F15L, 0x7447B78CL, 0x67E52FFBL,
+          0xBF59D487L, 0xACFB4CF0L, 0x981CE469L, 0x8BBE7C1EL, 0xF1D3B55BL, 0xE2712D2CL, 0xD69685B5L, 0xC5341DC2L,
+          0x224D173FL, 0x31EF8F48L, 0x050827D1L, 0x16AABFA6L, 0x6CC776E3L, 0x7F65EE94L, 0x4B82460DL, 0x5820DE7AL,
+          0xFBC3FAF9L, 0xE861628EL, 0xDC86CA17L, 0xCF245260L, 0xB5499B25L, 0xA6EB0352L, 0x920CABCBL, 0x81AE33BCL,
+          0x66D73941L, 0x7575A136L, 0x419209AFL, 0x523091D8L, 0x285D589DL, 0x3BFFC0EAL, 0x0F186873L, 0x1CBAF004L,
+          0xC4060B78L, 0xD7A4930FL, 0xE3433B96L, 0xF0E1A3E1L, 0x8A8C6AA4L, 0x992EF2D3L, 0xADC95A4AL, 0xBE6BC23DL,
+          0x5912C8C0L, 0x4AB050B7L, 0x7E57F82EL, 0x6DF56059L, 0x1798A91CL, 0x043A316BL, 0x30DD99F2L, 0x237F0185L,
+          0x844819FBL, 0x97EA818CL, 0xA30D2915L, 0xB0AFB162L, 0xCAC27827L, 0xD960E050L, 0xED8748C9L, 0xFE25D0BEL,
+          0x195CDA43L, 0x0AFE4234L, 0x3E19EAADL, 0x2DBB72DAL, 0x57D6BB9FL, 0x447423E8L, 0x70938B71L, 0x63311306L,
+          0xBB8DE87AL, 0xA82F700DL, 0x9CC8D894L, 0x8F6A40E3L, 0xF50789A6L, 0xE6A511D1L, 0xD242B948L, 0xC1E0213FL,
+          0x26992BC2L, 0x353BB3B5L, 0x01DC1B2CL, 0x127E835BL, 0x68134A1EL, 0x7BB1D269L, 0x4F567AF0L, 0x5CF4E287L,
+          0x04D43CFDL, 0x1776A48AL, 0x23910C13L, 0x30339464L, 0x4A5E5D21L, 0x59FCC556L, 0x6D1B6DCFL, 0x7EB9F5B8L,
+          0x99C0FF45L, 0x8A626732L, 0xBE85CFABL, 0xAD2757DCL, 0xD74A9E99L, 0xC4E806EEL, 0xF00FAE77L, 0xE3AD3600L,
+          0x3B11CD7CL, 0x28B3550BL, 0x1C54FD92L, 0x0FF665E5L, 0x759BACA0L, 0x663934D7L, 0x52DE9C4EL, 0x417C0439L,
+          0xA6050EC4L, 0xB5A796B3L, 0x81403E2AL, 0x92E2A65DL, 0xE88F6F18L, 0xFB2DF76FL, 0xCFCA5FF6L, 0xDC68C781L,
+          0x7B5FDFFFL, 0x68FD4788L, 0x5C1AEF11L, 0x4FB87766L, 0x35D5BE23L, 0x26772654L, 0x12908ECDL, 0x013216BAL,
+          0xE64B1C47L, 0xF5E98430L, 0xC10E2CA9L, 0xD2ACB4DEL, 0xA8C17D9BL, 0xBB63E5ECL, 0x8F844D75L, 0x9C26D502L,
+          0x449A2E7EL, 0x5738B609L, 0x63DF1E90L, 0x707D86E7L, 0x0A104FA2L, 0x19B2D7D5L, 0x2D557F4CL, 0x3EF7E73BL,
+          0xD98EEDC6L, 0xCA2C75B1L, 0xFECBDD28L, 0xED69455FL, 0x97048C1AL, 0x84A6146DL, 0xB041BCF4L, 0xA3E32483L
+        },
+        {
+          0x00000000L, 0xA541927EL, 0x4F6F520DL, 0xEA2EC073L, 0x9EDEA41AL, 0x3B9F3664L, 0xD1B1F617L, 0x74F06469L,
+          0x38513EC5L, 0x9D10ACBBL, 0x773E6CC8L, 0xD27FFEB6L, 0xA68F9ADFL, 0x03CE08A1L, 0xE9E0C8D2L, 0x4CA15AACL,
+          0x70A27D8AL, 0xD5E3EFF4L, 0x3FCD2F87L, 0x9A8CBDF9L, 0xEE7CD990L, 0x4B3D4BEEL, 0xA1138B9DL, 0x045219E3L,
+          0x48F3434FL, 0xEDB2D131L, 0x079C1142L, 0xA2DD833CL, 0xD62DE755L, 0x736C752BL, 0x9942B558L, 0x3C032726L,
+          0xE144FB14L, 0x4405696AL, 0xAE2BA919L, 0x0B6A3B67L, 0x7F9A5F0EL, 0xDADBCD70L, 0x30F50D03L, 0x95B49F7DL,
+          0xD915C5D1L, 0x7C5457AFL, 0x967A97DCL, 0x333B05A2L, 0x47CB61CBL, 0xE28AF3B5L, 0x08A433C6L, 0xADE5A1B8L,
+          0x91E6869EL, 0x34A714E0L, 0xDE89D493L, 0x7BC846EDL, 0x0F382284L, 0xAA79B0FAL, 0x40577089L, 0xE516E2F7L,
+          0xA9B7B85BL, 0x0CF62A25L, 0xE6D8EA56L, 0x43997828L, 0x37691C41L, 0x92288E3FL, 0x78064E4CL, 0xDD47DC32L,
+          0xC76580D9L, 0x622412A7L, 0x880AD2D4L, 0x2D4B40AAL, 0x59BB24C3L, 0xFCFAB6BDL, 0x16D476CEL, 0xB395E4B0L,
+          0xFF34BE1CL, 0x5A752C62L, 0xB05BEC11L, 0x151A7E6FL, 0x61EA1A06L, 0xC4AB8878L, 0x2E85480BL, 0x8BC4DA75L,
+          0xB7C7FD53L, 0x12866F2DL, 0xF8A8AF5EL, 0x5DE93D20L, 0x29195949L, 0x8C58CB37L, 0x66760B44L, 0xC337993AL,
+          0x8F96C396L, 0x2AD751E8L, 0xC0F9919BL, 0x65B803E5L, 0x1148678CL, 0xB409F5F2L, 0x5E273581L, 0xFB66A7FFL,
+          0x26217BCDL, 0x8360E9B3L, 0x694E29C0L, 0xCC0FBBBEL, 0xB8FFDFD7L, 0x1DBE4DA9L, 0xF7908DDAL, 0x52D11FA4L,
+          0x1E704508L, 0xBB31D776L, 0x511F1705L, 0xF45E857BL, 0x80AEE112L, 0x25EF736CL, 0xCFC1B31FL, 0x6A802161L,
+          0x56830647L, 0xF3C29439L, 0x19EC544AL, 0xBCADC634L, 0xC85DA25DL, 0x6D1C3023L, 0x8732F050L, 0x2273622EL,
+          0x6ED23882L, 0xCB93AAFCL, 0x21BD6A8FL, 0x84FCF8F1L, 0xF00C9C98L, 0x554D0EE6L, 0xBF63CE95L, 0x1A225CEBL,
+          0x8B277743L, 0x2E66E53DL, 0xC448254EL, 0x6109B730L, 0x15F9D359L, 0xB0B84127L, 0x5A968154L, 0xFFD7132AL,
+          0xB3764986L, 0x1637DBF8L, 0xFC191B8BL, 0x595889F5L, 0x2DA8ED9CL, 0x88E97FE2L, 0x62C7BF91L, 0xC7862DEFL,
+          0xFB850AC9L, 0x5EC498B7L, 0xB4EA58C4L, 0x11ABCABAL, 0x655BAED3L, 0xC01A3CADL, 0x2A34FCDEL, 0x8F756EA0L,
+          0xC3D4340CL, 0x6695A672L, 0x8CBB6601L, 0x29FAF47FL, 0x5D0A9016L, 0xF84B0268L, 0x1265C21BL, 0xB7245065L,
+          0x6A638C57L, 0xCF221E29L, 0x250CDE5AL, 0x804D4C24L, 0xF4BD284DL, 0x51FCBA33L, 0xBBD27A40L, 0x1E93E83EL,
+          0x5232B292L, 0xF77320ECL, 0x1D5DE09FL, 0xB81C72E1L, 0xCCEC1688L, 0x69AD84F6L, 0x83834485L, 0x26C2D6FBL,
+          0x1AC1F1DDL, 0xBF8063A3L, 0x55AEA3D0L, 0xF0EF31AEL, 0x841F55C7L, 0x215EC7B9L, 0xCB7007CAL, 0x6E3195B4L,
+          0x2290CF18L, 0x87D15D66L, 0x6DFF9D15L, 0xC8BE0F6BL, 0xBC4E6B02L, 0x190FF97CL, 0xF321390FL, 0x5660AB71L,
+          0x4C42F79AL, 0xE90365E4L, 0x032DA597L, 0xA66C37E9L, 0xD29C5380L, 0x77DDC1FEL, 0x9DF3018DL, 0x38B293F3L,
+          0x7413C95FL, 0xD1525B21L, 0x3B7C9B52L, 0x9E3D092CL, 0xEACD6D45L, 0x4F8CFF3BL, 0xA5A23F48L, 0x00E3AD36L,
+          0x3CE08A10L, 0x99A1186EL, 0x738FD81DL, 0xD6CE4A63L, 0xA23E2E0AL, 0x077FBC74L, 0xED517C07L, 0x4810EE79L,
+          0x04B1B4D5L, 0xA1F026ABL, 0x4BDEE6D8L, 0xEE9F74A6L, 0x9A6F10CFL, 0x3F2E82B1L, 0xD50042C2L, 0x7041D0BCL,
+          0xAD060C8EL, 0x08479EF0L, 0xE2695E83L, 0x4728CCFDL, 0x33D8A894L, 0x96993AEAL, 0x7CB7FA99L, 0xD9F668E7L,
+          0x9557324BL, 0x3016A035L, 0xDA386046L, 0x7F79F238L, 0x0B899651L, 0xAEC8042FL, 0x44E6C45CL, 0xE1A75622L,
+          0xDDA47104L, 0x78E5E37AL, 0x92CB2309L, 0x378AB177L, 0x437AD51EL, 0xE63B4760L, 0x0C158713L, 0xA954156DL,
+          0xE5F54FC1L, 0x40B4DDBFL, 0xAA9A1DCCL, 0x0FDB8FB2L, 0x7B2BEBDBL, 0xDE6A79A5L, 0x3444B9D6L, 0x91052BA8L
+        },
+        {
+          0x00000000L, 0xDD45AAB8L, 0xBF672381L, 0x62228939L, 0x7B2231F3L, 0xA6679B4BL, 0xC4451272L, 0x1900B8CAL,
+          0xF64463E6L, 0x2B01C95EL, 0x49234067L, 0x9466EADFL, 0x8D665215L, 0x5023F8ADL, 0x32017194L, 0xEF44DB2CL,
+          0xE964B13DL, 0x34211B85L, 0x560392BCL, 0x8B463804L, 0x924680CEL, 0x4F032A76L, 0x2D21A34FL, 0xF06409F7L,
+          0x1F20D2DBL, 0xC2657863L, 0xA047F15AL, 0x7D025BE2L, 0x6402E328L, 0xB9474990L, 0xDB65C0A9L, 0x06206A11L,
+          0xD725148BL, 0x0A60BE33L, 0x6842370AL, 0xB5079DB2L, 0xAC072578L, 0x71428FC0L, 0x136006F9L, 0xCE25AC41L,
+          0x2161776DL, 0xFC24DDD5L, 0x9E0654ECL, 0x4343FE54L, 0x5A43469EL, 0x8706EC26L, 0xE524651FL, 0x3861CFA7L,
+          0x3E41A5B6L, 0xE3040F0EL, 0x81268637L, 0x5C632C8FL, 0x45639445L, 0x98263EFDL, 0xFA04B7C4L, 0x27411D7CL,
+          0xC805C650L, 0x15406CE8L, 0x7762E5D1L, 0xAA274F69L, 0xB327F7A3L, 0x6E625D1BL, 0x0C40D422L, 0xD1057E9AL,
+          0xABA65FE7L, 0x76E3F55FL, 0x14C17C66L, 0xC984D6DEL, 0xD0846E14L, 0x0DC1C4ACL, 0x6FE34D95L, 0xB2A6E72DL,
+          0x5DE23C01L, 0x80A796B9L, 0xE2851F80L, 0x3FC0B538L, 0x26C00DF2L, 0xFB85A74AL, 0x99A72E73L, 0x44E284CBL,
+          0x42C2EEDAL, 0x9F874462L, 0xFDA5CD5BL, 0x20E067E3L, 0x39E0DF29L, 0xE4A57591L, 0x8687FCA8L, 0x5BC25610L,
+          0xB4868D3CL, 0x69C32784L, 0x0BE1AEBDL, 0xD6A40405L, 0xCFA4BCCFL, 0x12E11677L, 0x70C39F4EL, 0xAD8635F6L,
+          0x7C834B6CL, 0xA1C6E1D4L, 0xC3E468EDL, 0x1EA1C255L, 0x07A17A9FL, 0xDAE4D027L, 0xB8C6591EL, 0x6583F3A6L,
+          0x8AC7288AL, 0x57828232L, 0x35A00B0BL, 0xE8E5A1B3L, 0xF1E51979L, 0x2CA0B3C1L, 0x4E823AF8L, 0x93C79040L,
+          0x95E7FA51L, 0x48A250E9L, 0x2A80D9D0L, 0xF7C57368L, 0xEEC5CBA2L, 0x3380611AL, 0x51A2E823L, 0x8CE7429BL,
+          0x63A399B7L, 0xBEE6330FL, 0xDCC4BA36L, 0x0181108EL, 0x1881A844L, 0xC5C402FCL, 0xA7E68BC5L, 0x7AA3217DL,
+          0x52A0C93FL, 0x8FE56387L, 0xEDC7EABEL, 0x30824006L, 0x2982F8CCL, 0xF4C75274L, 0x96E5DB4DL, 0x4BA071F5L,
+          0xA4E4AAD9L, 0x79A10061L, 0x1B838958L, 0xC6C623E0L, 0xDFC69B2AL, 0x02833192L, 0x60A1B8ABL, 0xBDE41213L,
+          0xBBC47802L, 0x6681D2BAL, 0x04A35B83L, 0xD9E6F13BL, 0xC0E649F1L, 0x1DA3E349L, 0x7F816A70L, 0xA2C4C0C8L,
+          0x4D801BE4L, 0x90C5B15CL, 0xF2E73865L, 0x2FA292DDL, 0x36A22A17L, 0xEBE780AFL, 0x89C50996L, 0x5480A32EL,
+          0x8585DDB4L, 0x58C0770CL, 0x3AE2FE35L, 0xE7A7548DL, 0xFEA7EC47L, 0x23E246FFL, 0x41C0CFC6L, 0x9C85657EL,
+          0x73C1BE52L, 0xAE8414EAL, 0xCCA69DD3L, 0x11E3376BL, 0x08E38FA1L, 0xD5A62519L, 0xB784AC20L, 0x6AC10698L,
+          0x6CE16C89L, 0xB1A4C631L, 0xD3864F08L, 0x0EC3E5B0L, 0x17C35D7AL, 0xCA86F7C2L, 0xA8A47EFBL, 0x75E1D443L,
+          0x9AA50F6FL, 0x47E0A5D7L, 0x25C22CEEL, 0xF8878656L, 0xE1873E9CL, 0x3CC29424L, 0x5EE01D1DL, 0x83A5B7A5L,
+          0xF90696D8L, 0x24433C60L, 0x4661B559L, 0x9B241FE1L, 0x8224A72BL, 0x5F610D93L, 0x3D4384AAL, 0xE0062E12L,
+          0x0F42F53EL, 0xD2075F86L, 0xB025D6BFL, 0x6D607C07L, 0x7460C4CDL, 0xA9256E75L, 0xCB07E74CL, 0x16424DF4L,
+          0x106227E5L, 0xCD278D5DL, 0xAF050464L, 0x7240AEDCL, 0x6B401616L, 0xB605BCAEL, 0xD4273597L, 0x09629F2FL,
+          0xE6264403L, 0x3B63EEBBL, 0x59416782L, 0x8404CD3AL, 0x9D0475F0L, 0x4041DF48L, 0x22635671L, 0xFF26FCC9L,
+          0x2E238253L, 0xF36628EBL, 0x9144A1D2L, 0x4C010B6AL, 0x5501B3A0L, 0x88441918L, 0xEA669021L, 0x37233A99L,
+          0xD867E1B5L, 0x05224B0DL, 0x6700C234L, 0xBA45688CL, 0xA345D046L, 0x7E007AFEL, 0x1C22F3C7L, 0xC167597FL,
+          0xC747336EL, 0x1A0299D6L, 0x782010EFL, 0xA565BA57L, 0xBC65029DL, 0x6120A825L, 0x0302211CL, 0xDE478BA4L,
+          0x31035088L, 0xEC46FA30L, 0x8E647309L, 0x5321D9B1L, 0x4A21617BL, 0x9764CBC3L, 0xF54642FAL, 0x2803E842L
+        },
+        {
+          0x00000000L, 0x38116FACL, 0x7022DF58L, 0x4833B0F4L, 0xE045BEB0L, 0xD854D11CL, 0x906761E8L, 0xA8760E44L,
+          0xC5670B91L, 0xFD76643DL, 0xB545D4C9L, 0x8D54BB65L, 0x2522B521L, 0x1D33DA8DL, 0x55006A79L, 0x6D1105D5L,
+          0x8F2261D3L, 0xB7330E7FL, 0xFF00BE8BL, 0xC711D127L, 0x6F67DF63L, 0x5776B0CFL, 0x1F45003BL, 0x27546F97L,
+          0x4A456A42L, 0x725405EEL, 0x3A67B51AL, 0x0276DAB6L, 0xAA00D4F2L, 0x9211BB5EL, 0xDA220BAAL, 0xE2336406L,
+          0x1BA8B557L, 0x23B9DAFBL, 0x6B8A6A0FL, 0x539B05A3L, 0xFBED0BE7L, 0xC3FC644BL, 0x8BCFD4BFL, 0xB3DEBB13L,
+          0xDECFBEC6L, 0xE6DED16AL, 0xAEED619EL, 0x96FC0E32L, 0x3E8A0076L, 0x069B6FDAL, 0x4EA8DF2EL, 0x76B9B082L,
+          0x948AD484L, 0xAC9BBB28L, 0xE4A80BDCL, 0xDCB96470L, 0x74CF6A34L, 0x4CDE0598L, 0x04EDB56CL, 0x3CFCDAC0L,
+          0x51EDDF15L, 0x69FCB0B9L, 0x21CF004DL, 0x19DE6FE1L, 0xB1A861A5L, 0x89B90E09L, 0xC18ABEFDL, 0xF99BD151L,
+          0x37516AAEL, 0x0F400502L, 0x4773B5F6L, 0x7F62DA5AL, 0xD714D41EL, 0xEF05BBB2L, 0xA7360B46L, 0x9F2764EAL,
+          0xF236613FL, 0xCA270E93L, 0x8214BE67L, 0xBA05D1CBL, 0x1273DF8FL, 0x2A62B023L, 0x625100D7L, 0x5A406F7BL,
+          0xB8730B7DL, 0x806264D1L, 0xC851D425L, 0xF040BB89L, 0x5836B5CDL, 0x6027DA61L, 0x28146A95L, 0x10050539L,
+          0x7D1400ECL, 0x45056F40L, 0x0D36DFB4L, 0x3527B018L, 0x9D51BE5CL, 0xA540D1F0L, 0xED736104L, 0xD5620EA8L,
+          0x2CF9DFF9L, 0x14E8B055L, 0x5CDB00A1L, 0x64CA6F0DL, 0xCCBC6149L, 0xF4AD0EE5L, 0xBC9EBE11L, 0x848FD1BDL,
+          0xE99ED468L, 0xD18FBBC4L, 0x99BC0B30L, 0xA1AD649CL, 0x09DB6AD8L, 0x31CA0574L, 0x79F9B580L, 0x41E8DA2CL,
+          0xA3DBBE2AL, 0x9BCAD186L, 0xD3F96172L, 0xEBE80EDEL, 0x439E009AL, 0x7B8F6F36L, 0x33BCDFC2L, 0x0BADB06EL,
+          0x66BCB5BBL, 0x5EADDA17L, 0x169E6AE3L, 0x2E8F054FL, 0x86F90B0BL, 0xBEE864A7L, 0xF6DBD453L, 0xCECABBFFL,
+          0x6EA2D55CL, 0x56B3BAF0L, 0x1E800A04L, 0x269165A8L, 0x8EE76BECL, 0xB6F60440L, 0xFEC5B4B4L, 0xC6D4DB18L,
+          0xABC5DECDL, 0x93D4B161L, 0xDBE70195L, 0xE3F66E39L, 0x4B80607DL, 0x73910FD1L, 0x3BA2BF25L, 0x03B3D089L,
+          0xE180B48FL, 0xD991DB23L, 0x91A26BD7L, 0xA9B3047BL, 0x01C50A3FL, 0x39D46593L, 0x71E7D567L, 0x49F6BACBL,
+          0x24E7BF1EL, 0x1CF6D0B2L, 0x54C56046L, 0x6CD40FEAL, 0xC4A201AEL, 0xFCB36E02L, 0xB480DEF6L, 0x8C91B15AL,
+          0x750A600BL, 0x4D1B0FA7L, 0x0528BF53L, 0x3D39D0FFL, 0x954FDEBBL, 0xAD5EB117L, 0xE56D01E3L, 0xDD7C6E4FL,
+          0xB06D6B9AL, 0x887C0436L, 0xC04FB4C2L, 0xF85EDB6EL, 0x5028D52AL, 0x6839BA86L, 0x200A0A72L, 0x181B65DEL,
+          0xFA2801D8L, 0xC2396E74L, 0x8A0ADE80L, 0xB21BB12CL, 0x1A6DBF68L, 0x227CD0C4L, 0x6A4F6030L, 0x525E0F9CL,
+          0x3F4F0A49L, 0x075E65E5L, 0x4F6DD511L, 0x777CBABDL, 0xDF0AB4F9L, 0xE71BDB55L, 0xAF286BA1L, 0x9739040DL,
+          0x59F3BFF2L, 0x61E2D05EL, 0x29D160AAL, 0x11C00F06L, 0xB9B60142L, 0x81A76EEEL, 0xC994DE1AL, 0xF185B1B6L,
+          0x9C94B463L, 0xA485DBCFL, 0xECB66B3BL, 0xD4A70497L, 0x7CD10AD3L, 0x44C0657FL, 0x0CF3D58BL, 0x34E2BA27L,
+          0xD6D1DE21L, 0xEEC0B18DL, 0xA6F30179L, 0x9EE26ED5L, 0x36946091L, 0x0E850F3DL, 0x46B6BFC9L, 0x7EA7D065L,
+          0x13B6D5B0L, 0x2BA7BA1CL, 0x63940AE8L, 0x5B856544L, 0xF3F36B00L, 0xCBE204ACL, 0x83D1B458L, 0xBBC0DBF4L,
+          0x425B0AA5L, 0x7A4A6509L, 0x3279D5FDL, 0x0A68BA51L, 0xA21EB415L, 0x9A0FDBB9L, 0xD23C6B4DL, 0xEA2D04E1L,
+          0x873C0134L, 0xBF2D6E98L, 0xF71EDE6CL, 0xCF0FB1C0L, 0x6779BF84L, 0x5F68D028L, 0x175B60DCL, 0x2F4A0F70L,
+          0xCD796B76L, 0xF56804DAL, 0xBD5BB42EL, 0x854ADB82L, 0x2D3CD5C6L, 0x152DBA6AL, 0x5D1E0A9EL, 0x650F6532L,
+          0x081E60E7L, 0x300F0F4BL, 0x783CBFBFL, 0x402DD013L, 0xE85BDE57L, 0xD04AB1FBL, 0x9879010FL, 0xA0686EA3L
+        },
+        {
+          0x00000000L, 0xEF306B19L, 0xDB8CA0C3L, 0x34BCCBDAL, 0xB2F53777L, 0x5DC55C6EL, 0x697997B4L, 0x8649FCADL,
+          0x6006181FL, 0x8F367306L, 0xBB8AB8DCL, 0x54BAD3C5L, 0xD2F32F68L, 0x3DC34471L, 0x097F8FABL, 0xE64FE4B2L,
+          0xC00C303EL, 0x2F3C5B27L, 0x1B8090FDL, 0xF4B0FBE4L, 0x72F90749L, 0x9DC96C50L, 0xA975A78AL, 0x4645CC93L,
+          0xA00A2821L, 0x4F3A4338L, 0x7B8688E2L, 0x94B6E3FBL, 0x12FF1F56L, 0xFDCF744FL, 0xC973BF95L, 0x2643D48CL,
+          0x85F4168DL, 0x6AC47D94L, 0x5E78B64EL, 0xB148DD57L, 0x370121FAL, 0xD8314AE3L, 0xEC8D8139L, 0x03BDEA20L,
+          0xE5F20E92L, 0x0AC2658BL, 0x3E7EAE51L, 0xD14EC548L, 0x570739E5L, 0xB83752FCL, 0x8C8B9926L, 0x63BBF23FL,
+          0x45F826B3L, 0xAAC84DAAL, 0x9E748670L, 0x7144ED69L, 0xF70D11C4L, 0x183D7ADDL, 0x2C81B107L, 0xC3B1DA1EL,
+          0x25FE3EACL, 0xCACE55B5L, 0xFE729E6FL, 0x1142F576L, 0x970B09DBL, 0x783B62C2L, 0x4C87A918L, 0xA3B7C201L,
+          0x0E045BEBL, 0xE13430F2L, 0xD588FB28L, 0x3AB89031L, 0xBCF16C9CL, 0x53C10785L, 0x677DCC5FL, 0x884DA746L,
+          0x6E0243F4L, 0x813228EDL, 0xB58EE337L, 0x5ABE882EL, 0xDCF77483L, 0x33C71F9AL, 0x077BD440L, 0xE84BBF59L,
+          0xCE086BD5L, 0x213800CCL, 0x1584CB16L, 0xFAB4A00FL, 0x7CFD5CA2L, 0x93CD37BBL, 0xA771FC61L, 0x48419778L,
+          0xAE0E73CAL, 0x413E18D3L, 0x7582D309L, 0x9AB2B810L, 0x1CFB44BDL, 0xF3CB2FA4L, 0xC777E47EL, 0x28478F67L,
+          0x8BF04D66L, 0x64C0267FL, 0x507CEDA5L, 0xBF4C86BCL, 0x39057A11L, 0xD6351108L, 0xE289DAD2L, 0x0DB9B1CBL,
+          0xEBF65579L, 0x04C63E60L, 0x307AF5BAL, 0xDF4A9EA3L, 0x5903620EL, 0xB6330917L, 0x828FC2CDL, 0x6DBFA9D4L,
+          0x4BFC7D58L, 0xA4CC1641L, 0x9070DD9BL, 0x7F40B682L, 0xF9094A2FL, 0x16392136L, 0x2285EAECL, 0xCDB581F5L,
+          0x2BFA6547L, 0xC4CA0E5EL, 0xF076C584L, 0x1F46AE9DL, 0x990F5230L, 0x763F3929L, 0x4283F2F3L, 0xADB399EAL,
+          0x1C08B7D6L, 0xF338DCCFL, 0xC7841715L, 0x28B47C0CL, 0xAEFD80A1L, 0x41CDEBB8L, 0x75712062L, 0x9A414B7BL,
+          0x7C0EAFC9L, 0x933EC4D0L, 0xA7820F0AL, 0x48B26413L, 0xCEFB98BEL, 0x21CBF3A7L, 0x1577387DL, 0xFA475364L,
+          0xDC0487E8L, 0x3334ECF1L, 0x0788272BL, 0xE8B84C32L, 0x6EF1B09FL, 0x81C1DB86L, 0xB57D105CL, 0x5A4D7B45L,
+          0xBC029FF7L, 0x5332F4EEL, 0x678E3F34L, 0x88BE542DL, 0x0EF7A880L, 0xE1C7C399L, 0xD57B0843L, 0x3A4B635AL,
+          0x99FCA15BL, 0x76CCCA42L, 0x42700198L, 0xAD406A81L, 0x2B09962CL, 0xC439FD35L, 0xF08536EFL, 0x1FB55DF6L,
+          0xF9FAB944L, 0x16CAD25DL, 0x22761987L, 0xCD46729EL, 0x4B0F8E33L, 0xA43FE52AL, 0x90832EF0L, 0x7FB345E9L,
+          0x59F09165L, 0xB6C0FA7CL, 0x827C31A6L, 0x6D4C5ABFL, 0xEB05A612L, 0x0435CD0BL, 0x308906D1L, 0xDFB96DC8L,
+          0x39F6897AL, 0xD6C6E263L, 0xE27A29B9L, 0x0D4A42A0L, 0x8B03BE0DL, 0x6433D514L, 0x508F1ECEL, 0xBFBF75D7L,
+          0x120CEC3DL, 0xFD3C8724L, 0xC9804CFEL, 0x26B027E7L, 0xA0F9DB4AL, 0x4FC9B053L, 0x7B757B89L, 0x94451090L,
+          0x720AF422L, 0x9D3A9F3BL, 0xA98654E1L, 0x46B63FF8L, 0xC0FFC355L, 0x2FCFA84CL, 0x1B736396L, 0xF443088FL,
+          0xD200DC03L, 0x3D30B71AL, 0x098C7CC0L, 0xE6BC17D9L, 0x60F5EB74L, 0x8FC5806DL, 0xBB794BB7L, 0x544920AEL,
+          0xB206C41CL, 0x5D36AF05L, 0x698A64DFL, 0x86BA0FC6L, 0x00F3F36BL, 0xEFC39872L, 0xDB7F53A8L, 0x344F38B1L,
+          0x97F8FAB0L, 0x78C891A9L, 0x4C745A73L, 0xA344316AL, 0x250DCDC7L, 0xCA3DA6DEL, 0xFE816D04L, 0x11B1061DL,
+          0xF7FEE2AFL, 0x18CE89B6L, 0x2C72426CL, 0xC3422975L, 0x450BD5D8L, 0xAA3BBEC1L, 0x9E87751BL, 0x71B71E02L,
+          0x57F4CA8EL, 0xB8C4A197L, 0x8C786A4DL, 0x63480154L, 0xE501FDF9L, 0x0A3196E0L, 0x3E8D5D3AL, 0xD1BD3623L,
+          0x37F2D291L, 0xD8C2B988L, 0xEC7E7252L, 0x034E194BL, 0x8507E5E6L, 0x6A378EFFL, 0x5E8B4525L, 0xB1BB2E3CL
+        },
+        {
+          0x00000000L, 0x68032CC8L, 0xD0065990L, 0xB8057558L, 0xA5E0C5D1L, 0xCDE3E919L, 0x75E69C41L, 0x1DE5B089L,
+          0x4E2DFD53L, 0x262ED19BL, 0x9E2BA4C3L, 0xF628880BL, 0xEBCD3882L, 0x83CE144AL, 0x3BCB6112L, 0x53C84DDAL,
+          0x9C5BFAA6L, 0xF458D66EL, 0x4C5DA336L, 0x245E8FFEL, 0x39BB3F77L, 0x51B813BFL, 0xE9BD66E7L, 0x81BE4A2FL,
+          0xD27607F5L, 0xBA752B3DL, 0x02705E65L, 0x6A7372ADL, 0x7796C224L, 0x1F95EEECL, 0xA7909BB4L, 0xCF93B77CL,
+          0x3D5B83BDL, 0x5558AF75L, 0xED5DDA2DL, 0x855EF6E5L, 0x98BB466CL, 0xF0B86AA4L, 0x48BD1FFCL, 0x20BE3334L,
+          0x73767EEEL, 0x1B755226L, 0xA370277EL, 0xCB730BB6L, 0xD696BB3FL, 0xBE9597F7L, 0x0690E2AFL, 0x6E93CE67L,
+          0xA100791BL, 0xC90355D3L, 0x7106208BL, 0x19050C43L, 0x04E0BCCAL, 0x6CE39002L, 0xD4E6E55AL, 0xBCE5C992L,
+          0xEF2D8448L, 0x872EA880L, 0x3F2BDDD8L, 0x5728F110L, 0x4ACD4199L, 0x22CE6D51L, 0x9ACB1809L, 0xF2C834C1L,
+          0x7AB7077AL, 0x12B42BB2L, 0xAAB15EEAL, 0xC2B27222L, 0xDF57C2ABL, 0xB754EE63L, 0x0F519B3BL, 0x6752B7F3L,
+          0x349AFA29L, 0x5C99D6E1L, 0xE49CA3B9L, 0x8C9F8F71L, 0x917A3FF8L, 0xF9791330L, 0x417C6668L, 0x297F4AA0L,
+          0xE6ECFDDCL, 0x8EEFD114L, 0x36EAA44CL, 0x5EE98884L, 0x430C380DL, 0x2B0F14C5L, 0x930A619DL, 0xFB094D55L,
+          0xA8C1008FL, 0xC0C22C47L, 0x78C7591FL, 0x10C475D7L, 0x0D21C55EL, 0x6522E996L, 0xDD279CCEL, 0xB524B006L,
+          0x47EC84C7L, 0x2FEFA80FL, 0x97EADD57L, 0xFFE9F19FL, 0xE20C4116L, 0x8A0F6DDEL, 0x320A1886L, 0x5A09344EL,
+          0x09C17994L, 0x61C2555CL, 0xD9C72004L, 0xB1C40CCCL, 0xAC21BC45L, 0xC422908DL, 0x7C27E5D5L, 0x1424C91DL,
+          0xDBB77E61L, 0xB3B452A9L, 0x0BB127F1L, 0x63B20B39L, 0x7E57BBB0L, 0x16549778L, 0xAE51E220L, 0xC652CEE8L,
+          0x959A8332L, 0xFD99AFFAL, 0x459CDAA2L, 0x2D9FF66AL, 0x307A46E3L, 0x58796A2BL, 0xE07C1F73L, 0x887F33BBL,
+          0xF56E0EF4L, 0x9D6D223CL, 0x25685764L, 0x4D6B7BACL, 0x508ECB25L, 0x388DE7EDL, 0x808892B5L, 0xE88BBE7DL,
+          0xBB43F3A7L, 0xD340DF6FL, 0x6B45AA37L, 0x034686FFL, 0x1EA33676L, 0x76A01ABEL, 0xCEA56FE6L, 0xA6A6432EL,
+          0x6935F452L, 0x0136D89AL, 0xB933ADC2L, 0xD130810AL, 0xCCD53183L, 0xA4D61D4BL, 0x1CD36813L, 0x74D044DBL,
+          0x27180901L, 0x4F1B25C9L, 0xF71E5091L, 0x9F1D7C59L, 0x82F8CCD0L, 0xEAFBE018L, 0x52FE9540L, 0x3AFDB988L,
+          0xC8358D49L, 0xA036A181L, 0x1833D4D9L, 0x7030F811L, 0x6DD54898L, 0x05D66450L, 0xBDD31108L, 0xD5D03DC0L,
+          0x8618701AL, 0xEE1B5CD2L, 0x561E298AL, 0x3E1D0542L, 0x23F8B5CBL, 0x4BFB9903L, 0xF3FEEC5BL, 0x9BFDC093L,
+          0x546E77EFL, 0x3C6D5B27L, 0x84682E7FL, 0xEC6B02B7L, 0xF18EB23EL, 0x998D9EF6L, 0x2188EBAEL, 0x498BC766L,
+          0x1A438ABCL, 0x7240A674L, 0xCA45D32CL, 0xA246FFE4L, 0xBFA34F6DL, 0xD7A063A5L, 0x6FA516FDL, 0x07A63A35L,
+          0x8FD9098EL, 0xE7DA2546L, 0x5FDF501EL, 0x37DC7CD6L, 0x2A39CC5FL, 0x423AE097L, 0xFA3F95CFL, 0x923CB907L,
+          0xC1F4F4DDL, 0xA9F7D815L, 0x11F2AD4DL, 0x79F18185L, 0x6414310CL, 0x0C171DC4L, 0xB412689CL, 0xDC114454L,
+          0x1382F328L, 0x7B81DFE0L, 0xC384AAB8L, 0xAB878670L, 0xB66236F9L, 0xDE611A31L, 0x66646F69L, 0x0E6743A1L,
+          0x5DAF0E7BL, 0x35AC22B3L, 0x8DA957EBL, 0xE5AA7B23L, 0xF84FCBAAL, 0x904CE762L, 0x2849923AL, 0x404ABEF2L,
+          0xB2828A33L, 0xDA81A6FBL, 0x6284D3A3L, 0x0A87FF6BL, 0x17624FE2L, 0x7F61632AL, 0xC7641672L, 0xAF673ABAL,
+          0xFCAF7760L, 0x94AC5BA8L, 0x2CA92EF0L, 0x44AA0238L, 0x594FB2B1L, 0x314C9E79L, 0x8949EB21L, 0xE14AC7E9L,
+          0x2ED97095L, 0x46DA5C5DL, 0xFEDF2905L, 0x96DC05CDL, 0x8B39B544L, 0xE33A998CL, 0x5B3FECD4L, 0x333CC01CL,
+          0x60F48DC6L, 0x08F7A10EL, 0xB0F2D456L, 0xD8F1F89EL, 0xC5144817L, 0xAD1764DFL, 0x15121187L, 0x7D113D4FL
+        },
+        {
+          0x00000000L, 0x493C7D27L, 0x9278FA4EL, 0xDB448769L, 0x211D826DL, 0x6821FF4AL, 0xB3657823L, 0xFA590504L,
+          0x423B04DAL, 0x0B0779FDL, 0xD043FE94L, 0x997F83B3L, 0x632686B7L, 0x2A1AFB90L, 0xF15E7CF9L, 0xB86201DEL,
+          0x847609B4L, 0xCD4A7493L, 0x160EF3FAL, 0x5F328EDDL, 0xA56B8BD9L, 0xEC57F6FEL, 0x37137197L, 0x7E2F0CB0L,
+          0xC64D0D6EL, 0x8F717049L, 0x5435F720L, 0x1D098A07L, 0xE7508F03L, 0xAE6CF224L, 0x7528754DL, 0x3C14086AL,
+          0x0D006599L, 0x443C18BEL, 0x9F789FD7L, 0xD644E2F0L, 0x2C1DE7F4L, 0x65219AD3L, 0xBE651DBAL, 0xF759609DL,
+          0x4F3B6143L, 0x06071C64L, 0xDD439B0DL, 0x947FE62AL, 0x6E26E32EL, 0x271A9E09L, 0xFC5E1960L, 0xB5626447L,
+          0x89766C2DL, 0xC04A110AL, 0x1B0E9663L, 0x5232EB44L, 0xA86BEE40L, 0xE1579367L, 0x3A13140EL, 0x732F6929L,
+          0xCB4D68F7L, 0x827115D0L, 0x593592B9L, 0x1009EF9EL, 0xEA50EA9AL, 0xA36C97BDL, 0x782810D4L, 0x31146DF3L,
+          0x1A00CB32L, 0x533CB615L, 0x8878317CL, 0xC1444C5BL, 0x3B1D495FL, 0x72213478L, 0xA965B311L, 0xE059CE36L,
+          0x583BCFE8L, 0x1107B2CFL, 0xCA4335A6L, 0x837F4881L, 0x79264D85L, 0x301A30A2L, 0xEB5EB7CBL, 0xA262CAECL,
+          0x9E76C286L, 0xD74ABFA1L, 0x0C0E38C8L, 0x453245EFL, 0xBF6B40EBL, 0xF6573DCCL, 0x2D13BAA5L, 0x642FC782L,
+          0xDC4DC65CL, 0x9571BB7BL, 0x4E353C12L, 0x07094135L, 0xFD504431L, 0xB46C3916L, 0x6F28BE7FL, 0x2614C358L,
+          0x1700AEABL, 0x5E3CD38CL, 0x857854E5L, 0xCC4429C2L, 0x361D2CC6L, 0x7F2151E1L, 0xA465D688L, 0xED59ABAFL,
+          0x553BAA71L, 0x1C07D756L, 0xC743503FL, 0x8E7F2D18L, 0x7426281CL, 0x3D1A553BL, 0xE65ED252L, 0xAF62AF75L,
+          0x9376A71FL, 0xDA4ADA38L, 0x010E5D51L, 0x48322076L, 0xB26B2572L, 0xFB575855L, 0x2013DF3CL, 0x692FA21BL,
+          0xD14DA3C5L, 0x9871DEE2L, 0x4335598BL, 0x0A0924ACL, 0xF05021A8L, 0xB96C5C8FL, 0x6228DBE6L, 0x2B14A6C1L,
+          0x34019664L, 0x7D3DEB43L, 0xA6796C2AL, 0xEF45110DL, 0x151C1409L, 0x5C20692EL, 0x8764EE47L, 0xCE589360L,
+          0x763A92BEL, 0x3F06EF99L, 0xE44268F0L, 0xAD7E15D7L, 0x572710D3L, 0x1E1B6DF4L, 0xC55FEA9DL, 0x8C6397BAL,
+          0xB0779FD0L, 0xF94BE2F7L, 0x220F659EL, 0x6B3318B9L, 0x916A1DBDL, 0xD856609AL, 0x0312E7F3L, 0x4A2E9AD4L,
+          0xF24C9B0AL, 0xBB70E62DL, 0x60346144L, 0x29081C63L, 0xD3511967L, 0x9A6D6440L, 0x4129E329L, 0x08159E0EL,
+          0x3901F3FDL, 0x703D8EDAL, 0xAB7909B3L, 0xE2457494L, 0x181C7190L, 0x51200CB7L, 0x8A648BDEL, 0xC358F6F9L,
+          0x7B3AF727L, 0x32068A00L, 0xE9420D69L, 0xA07E704EL, 0x5A27754AL, 0x131B086DL, 0xC85F8F04L, 0x8163F223L,
+          0xBD77FA49L, 0xF44B876EL, 0x2F0F0007L, 0x66337D20L, 0x9C6A7824L, 0xD5560503L, 0x0E12826AL, 0x472EFF4DL,
+          0xFF4CFE93L, 0xB67083B4L, 0x6D3404DDL, 0x240879FAL, 0xDE517CFEL, 0x976D01D9L, 0x4C2986B0L, 0x0515FB97L,
+          0x2E015D56L, 0x673D2071L, 0xBC79A718L, 0xF545DA3FL, 0x0F1CDF3BL, 0x4620A21CL, 0x9D642575L, 0xD4585852L,
+          0x6C3A598CL, 0x250624ABL, 0xFE42A3C2L, 0xB77EDEE5L, 0x4D27DBE1L, 0x041BA6C6L, 0xDF5F21AFL, 0x96635C88L,
+          0xAA7754E2L, 0xE34B29C5L, 0x380FAEACL, 0x7133D38BL, 0x8B6AD68FL, 0xC256ABA8L, 0x19122CC1L, 0x502E51E6L,
+          0xE84C5038L, 0xA1702D1FL, 0x7A34AA76L, 0x3308D751L, 0xC951D255L, 0x806DAF72L, 0x5B29281BL, 0x1215553CL,
+          0x230138CFL, 0x6A3D45E8L, 0xB179C281L, 0xF845BFA6L, 0x021CBAA2L, 0x4B20C785L, 0x906440ECL, 0xD9583DCBL,
+          0x613A3C15L, 0x28064132L, 0xF342C65BL, 0xBA7EBB7CL, 0x4027BE78L, 0x091BC35FL, 0xD25F4436L, 0x9B633911L,
+          0xA777317BL, 0xEE4B4C5CL, 0x350FCB35L, 0x7C33B612L, 0x866AB316L, 0xCF56CE31L, 0x14124958L, 0x5D2E347FL,
+          0xE54C35A1L, 0xAC704886L, 0x7734CFEFL, 0x3E08B2C8L, 0xC451B7CCL, 0x8D6DCAEBL, 0x56294D82L, 0x1F1530A5L
+        }
+      };
+
+      return private_crc32::slice_by_8(crc, data, length, CRC32_C_SLICE);
+    }
+
     inline uint32_t final(uint32_t crc) const
     {
       return crc ^ 0xFFFFFFFF;
@@ -0,0 +1,378 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_CUCKOO_FILTER_INCLUDED
+#define ETL_CUCKOO_FILTER_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "parameter_type.h"
+#include "power.h"
+#include "static_assert.h"
+#include "type_traits.h"
+
+#define ETL_IN_CUCKOO_FILTER_H
+#include "private/filter_hash.h"
+#undef ETL_IN_CUCKOO_FILTER_H
+
+///\defgroup cuckoo_filter cuckoo_filter
+/// A cuckoo filter
+///\ingroup containers
+
+namespace etl
+{
+  //***************************************************************************
+  /// A set membership filter that supports removal.
+  /// Stores a fingerprint of each key in one of two buckets of four slots.
+  /// The second bucket is found from the first and the fingerprint alone, so
+  /// fingerprints can be moved between their buckets to make space.
+  /// If an add has to move more than MAX_KICKS fingerprints, the last one
+  /// moved is held aside and the filter is full until something is removed.
+  /// The same key may be added more than once, and must then be removed as
+  /// many times.
+  /// The hash class must support the () operator and define 'argument_type'.
+  ///\tparam DESIRED_CAPACITY The desired number of keys. Rounded up to a power of two number of buckets.
+  ///\tparam THash            The hash generator class.
+  ///\tparam TFingerprint     The unsigned type of the fingerprints. Larger types give fewer false positives.
+  ///\ingroup cuckoo_filter
+  //***************************************************************************
+  template <const size_t DESIRED_CAPACITY, typename THash, typename TFingerprint = uint16_t>
+  class cuckoo_filter
+  {
+  private:
+
+    typedef typename etl::parameter_type<typename THash::argument_type>::type parameter_t;
+
+  public:
+
+    static const size_t BUCKET_SIZE       = 4;
+    static const size_t NUMBER_OF_BUCKETS = etl::power_of_2_round_up<(DESIRED_CAPACITY + BUCKET_SIZE - 1) / BUCKET_SIZE>::value;
+    static const size_t CAPACITY          = NUMBER_OF_BUCKETS * BUCKET_SIZE;
+    static const size_t MAX_KICKS         = 500;
+
+    ETL_STATIC_ASSERT(etl::is_unsigned<TFingerprint>::value, "The fingerprint type must be unsigned");
+    ETL_STATIC_ASSERT(sizeof(TFingerprint) <= sizeof(uint32_t), "The fingerprint type must not be larger than 32 bits");
+    ETL_STATIC_ASSERT(uint64_t(NUMBER_OF_BUCKETS) <= uint64_t(UINT32_MAX), "Too many buckets");
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    cuckoo_filter()
+      : random_state(1U)
+    {
+      clear();
+    }
+
+    //*************************************************************************
+    /// Clears the filter of all entries.
+    //*************************************************************************
+    void clear()
+    {
+      for (size_t i = 0; i < NUMBER_OF_BUCKETS; ++i)
+      {
+        for (size_t j = 0; j < BUCKET_SIZE; ++j)
+        {
+          buckets[i][j] = EMPTY;
+        }
+      }
+
+      stored       = 0;
+      has_victim   = false;
+      victim       = EMPTY;
+      victim_index = 0;
+    }
+
+    //*************************************************************************
+    /// Adds a key to the filter.
+    ///\param  key The key to add.
+    ///\return <b>true</b> if the key was added, <b>false</b> if the filter was full.
+    //*************************************************************************
+    bool add(parameter_t key)
+    {
+      if (has_victim)
+      {
+        return false;
+      }
+
+      uint64_t     hash        = get_hash(key);
+      TFingerprint fingerprint = get_fingerprint(hash);
+
+      place(get_index(hash), fingerprint);
+      ++stored;
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Removes a key from the filter.
+    /// Only keys that have been added should be removed. Removing a key that
+    /// was not added may remove a key with the same fingerprint.
+    ///\param  key The key to remove.
+    ///\return <b>true</b> if the key was in the filter.
+    //*************************************************************************
+    bool remove(parameter_t key)
+    {
+      uint64_t     hash        = get_hash(key);
+      TFingerprint fingerprint = get_fingerprint(hash);
+      size_t       index1      = get_index(hash);
+      size_t       index2      = get_alternate_index(index1, fingerprint);
+
+      if (erase(index1, fingerprint) || erase(index2, fingerprint))
+      {
+        --stored;
+
+        // There is now space for the victim.
+        if (has_victim)
+        {
+          has_victim = false;
+          place(victim_index, victim);
+        }
+
+        return true;
+      }
+
+      if (has_victim && (victim == fingerprint) && ((victim_index == index1) || (victim_index == index2)))
+      {
+        has_victim = false;
+        --stored;
+
+        return true;
+      }
+
+      return false;
+    }
+
+    //*************************************************************************
+    /// Tests a key to see if it exists in the filter.
+    ///\param  key The key to test.
+    ///\return <b>true</b> if the key exists in the filter.
+    //*************************************************************************
+    bool exists(parameter_t key) const
+    {
+      uint64_t     hash        = get_hash(key);
+      TFingerprint fingerprint = get_fingerprint(hash);
+      size_t       index1      = get_index(hash);
+      size_t       index2      = get_alternate_index(index1, fingerprint);
+
+      return contains(index1, fingerprint) ||
+             contains(index2, fingerprint) ||
+             (has_victim && (victim == fingerprint) && ((victim_index == index1) || (victim_index == index2)));
+    }
+
+    //*************************************************************************
+    /// Returns the number of keys in the filter.
+    //*************************************************************************
+    size_t size() const
+    {
+      return stored;
+    }
+
+    //*************************************************************************
+    /// Returns the number of fingerprint slots.
+    //*************************************************************************
+    size_t capacity() const
+    {
+      return CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Returns the percentage of slots used. Range 0 to 100.
+    //*************************************************************************
+    size_t usage() const
+    {
+      return (100 * stored) / CAPACITY;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the filter is empty.
+    //*************************************************************************
+    bool empty() const
+    {
+      return stored == 0;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the filter can not accept more keys.
+    //*************************************************************************
+    bool full() const
+    {
+      return has_victim;
+    }
+
+  private:
+
+    /// The value of an empty slot. Fingerprints are never zero.
+    static const TFingerprint EMPTY = 0;
+
+    //*************************************************************************
+    /// Gets the mixed hash for the key.
+    //*************************************************************************
+    static uint64_t get_hash(parameter_t key)
+    {
+      return private_filter_hash::mix(uint64_t(THash()(key)));
+    }
+
+    //*************************************************************************
+    /// The fingerprint is taken from the upper bits of the hash.
+    //*************************************************************************
+    static TFingerprint get_fingerprint(uint64_t hash)
+    {
+      TFingerprint fingerprint = TFingerprint(hash >> (64 - (sizeof(TFingerprint) * 8)));
+
+      return (fingerprint == EMPTY) ? TFingerprint(1) : fingerprint;
+    }
+
+    //*************************************************************************
+    /// The first bucket is taken from the lower bits of the hash.
+    //*************************************************************************
+    static size_t get_index(uint64_t hash)
+    {
+      return size_t(hash) & (NUMBER_OF_BUCKETS - 1);
+    }
+
+    //*************************************************************************
+    /// Each bucket of a fingerprint can be found from the other.
+    //*************************************************************************
+    static size_t get_alternate_index(size_t index, TFingerprint fingerprint)
+    {
+      return (index ^ size_t(uint32_t(fingerprint) * 0x5BD1E995U)) & (NUMBER_OF_BUCKETS - 1);
+    }
+
+    //*************************************************************************
+    /// Puts the fingerprint in an empty slot of a bucket.
+    //*************************************************************************
+    bool insert(size_t index, TFingerprint fingerprint)
+    {
+      for (size_t i = 0; i < BUCKET_SIZE; ++i)
+      {
+        if (buckets[index][i] == EMPTY)
+        {
+          buckets[index][i] = fingerprint;
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    //*************************************************************************
+    /// Empties one slot of a bucket that holds the fingerprint.
+    //*************************************************************************
+    bool erase(size_t index, TFingerprint fingerprint)
+    {
+      for (size_t i = 0; i < BUCKET_SIZE; ++i)
+      {
+        if (buckets[index][i] == fingerprint)
+        {
+          buckets[index][i] = EMPTY;
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    //*************************************************************************
+    /// Checks whether a bucket holds the fingerprint.
+    //*************************************************************************
+    bool contains(size_t index, TFingerprint fingerprint) const
+    {
+      bool found = false;
+
+      for (size_t i = 0; i < BUCKET_SIZE; ++i)
+      {
+        found |= (buckets[index][i] == fingerprint);
+      }
+
+      return found;
+    }
+
+    //*************************************************************************
+    /// Stores the fingerprint in one of its buckets, moving others if both
+    /// are full. If the kick limit is reached, the homeless fingerprint becomes
+    /// the victim.
+    //*************************************************************************
+    void place(size_t index, TFingerprint fingerprint)
+    {
+      if (insert(index, fingerprint))
+      {
+        return;
+      }
+
+      index = get_alternate_index(index, fingerprint);
+
+      for (size_t kick = 0; kick < MAX_KICKS; ++kick)
+      {
+        if (insert(index, fingerprint))
+        {
+          return;
+        }
+
+        // Swap with a random occupant, which then moves to its other bucket.
+        TFingerprint& slot = buckets[index][next_random() % BUCKET_SIZE];
+        TFingerprint  evicted = slot;
+
+        slot        = fingerprint;
+        fingerprint = evicted;
+        index       = get_alternate_index(index, fingerprint);
+      }
+
+      if (!insert(index, fingerprint))
+      {
+        has_victim   = true;
+        victim       = fingerprint;
+        victim_index = index;
+      }
+    }
+
+    //*************************************************************************
+    /// A xorshift generator for choosing which fingerprint to move.
+    //*************************************************************************
+    uint32_t next_random()
+    {
+      random_state ^= random_state << 13;
+      random_state ^= random_state >> 17;
+      random_state ^= random_state << 5;
+
+      return random_state;
+    }
+
+    TFingerprint buckets[NUMBER_OF_BUCKETS][BUCKET_SIZE];
+    size_t       stored;       ///< The number of keys added and not removed.
+    bool         has_victim;   ///< A fingerprint could not be placed.
+    TFingerprint victim;       ///< The fingerprint that could not be placed.
+    size_t       victim_index; ///< One of the victim's buckets.
+    uint32_t     random_state;
+  };
+}
+
+#endif
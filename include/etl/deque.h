@@ -33,6 +33,7 @@ SOFTWARE.
 
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "platform.h"
 
@@ -634,6 +635,100 @@ namespace etl
     typedef std::reverse_iterator<iterator>       reverse_iterator;
     typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
+    //*************************************************************************
+    /// A run of elements that are contiguous in the buffer.
+    //*************************************************************************
+    template <typename TPointer>
+    class basic_segment
+    {
+    public:
+
+      friend class ideque;
+
+      typedef TPointer iterator;
+
+      //***************************************************
+      basic_segment()
+        : p_data(0),
+          length(0)
+      {
+      }
+
+      //***************************************************
+      TPointer begin() const
+      {
+        return p_data;
+      }
+
+      //***************************************************
+      TPointer end() const
+      {
+        return p_data + length;
+      }
+
+      //***************************************************
+      TPointer data() const
+      {
+        return p_data;
+      }
+
+      //***************************************************
+      size_type size() const
+      {
+        return length;
+      }
+
+      //***************************************************
+      bool empty() const
+      {
+        return length == 0;
+      }
+
+    private:
+
+      //***************************************************
+      basic_segment(TPointer p_data_, size_type length_)
+        : p_data(p_data_),
+          length(length_)
+      {
+      }
+
+      TPointer  p_data;
+      size_type length;
+    };
+
+    typedef basic_segment<pointer>                   segment;
+    typedef basic_segment<const_pointer>             const_segment;
+    typedef std::pair<segment, segment>              segments;
+    typedef std::pair<const_segment, const_segment>  const_segments;
+
+    //*************************************************************************
+    /// Gets the elements as at most two contiguous runs, in order.
+    /// 'second' is empty unless the elements wrap around the end of the buffer.
+    /// Scanning the runs as arrays avoids the wrap check of the iterators.
+    //*************************************************************************
+    segments data_segments()
+    {
+      const size_t first_index = _begin.index;
+      const size_t first_size  = std::min(current_size, BUFFER_SIZE - first_index);
+
+      return segments(segment(p_buffer + first_index, first_size),
+                      segment(p_buffer, current_size - first_size));
+    }
+
+    //*************************************************************************
+    /// Gets the elements as at most two contiguous runs, in order.
+    /// 'second' is empty unless the elements wrap around the end of the buffer.
+    //*************************************************************************
+    const_segments data_segments() const
+    {
+      const size_t first_index = _begin.index;
+      const size_t first_size  = std::min(current_size, BUFFER_SIZE - first_index);
+
+      return const_segments(const_segment(p_buffer + first_index, first_size),
+                            const_segment(p_buffer, current_size - first_size));
+    }
+
     //*************************************************************************
     /// Assigns a range to the deque.
     //*************************************************************************
@@ -643,9 +738,20 @@ namespace etl
     {
       initialise();
 
-      while (range_begin != range_end)
+      if ETL_IF_CONSTEXPR(etl::is_pointer<TIterator>::value)
+      {
+        const size_t n = std::distance(range_begin, range_end);
+
+        ETL_ASSERT(n <= CAPACITY, ETL_ERROR(deque_full));
+
+        create_elements_back(range_begin, n);
+      }
+      else
       {
-        push_back(*range_begin++);
+        while (range_begin != range_end)
+        {
+          push_back(*range_begin++);
+        }
       }
     }
 
@@ -707,10 +813,7 @@ namespace etl
     //*************************************************************************
     reference operator [](size_t index)
     {
-      iterator result(_begin);
-      result += index;
-
-      return *result;
+      return p_buffer[buffer_index(index)];
     }
 
     //*************************************************************************
@@ -719,10 +822,7 @@ namespace etl
     //*************************************************************************
     const_reference operator [](size_t index) const
     {
-      iterator result(_begin);
-      result += index;
-
-      return *result;
+      return p_buffer[buffer_index(index)];
     }
 
     //*************************************************************************
@@ -887,6 +987,15 @@ namespace etl
         create_element_back(value);
         position = _end - 1;
       }
+      else if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+      {
+        // Copy the value first, as it may be one of the elements that move.
+        typename etl::aligned_storage<sizeof(T), etl::alignment_of<T>::value>::type temp;
+        ::new (static_cast<void*>(&temp)) T(value);
+
+        position = relocate_open(position);
+        memcpy(static_cast<void*>(etl::addressof(*position)), static_cast<const void*>(&temp), sizeof(T));
+      }
       else
       {
         // Are we closer to the front?
@@ -940,6 +1049,11 @@ namespace etl
         create_element_back(std::move(value));
         position = _end - 1;
       }
+      else if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+      {
+        position = relocate_open(position);
+        ::new (static_cast<void*>(etl::addressof(*position))) T(std::move(value));
+      }
       else
       {
         // Are we closer to the front?
@@ -1432,10 +1546,7 @@ namespace etl
       }
       else if (insert_position == end())
       {
-        for (difference_type i = 0; i < n; ++i)
-        {
-          create_element_back(*range_begin++);
-        }
+        create_elements_back(range_begin, n);
 
         position = _end - n;
       }
@@ -1533,6 +1644,11 @@ namespace etl
         destroy_element_back();
         position = end();
       }
+      else if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+      {
+        (*position).~T();
+        position = relocate_close(position, 1);
+      }
       else
       {
         // Are we closer to the front?
@@ -1587,6 +1703,18 @@ namespace etl
 
         position = end();
       }
+      else if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+      {
+        iterator item = position;
+
+        for (size_t i = 0; i < length; ++i)
+        {
+          (*item).~T();
+          ++item;
+        }
+
+        position = relocate_close(position, length);
+      }
       else
       {
         // Copy the smallest number of items.
@@ -1944,7 +2072,7 @@ namespace etl
     {
       if (&rhs != this)
       {
-        assign(rhs.begin(), rhs.end());
+        assign_deque(rhs);
       }
 
       return *this;
@@ -2013,6 +2141,21 @@ namespace etl
       _end   = iterator(0, *this, p_buffer);
     }
 
+    //*************************************************************************
+    /// Assigns the contents of another deque, a contiguous run at a time.
+    //*************************************************************************
+    void assign_deque(const ideque& other)
+    {
+      initialise();
+
+      ETL_ASSERT(other.size() <= CAPACITY, ETL_ERROR(deque_full));
+
+      const_segments other_segments = other.data_segments();
+
+      create_elements_back(other_segments.first.data(),  other_segments.first.size());
+      create_elements_back(other_segments.second.data(), other_segments.second.size());
+    }
+
     //*************************************************************************
     /// Fix the internal pointers after a low level memory copy.
     //*************************************************************************
@@ -2024,6 +2167,16 @@ namespace etl
       _end   = iterator(_end.index,   *this, p_buffer);
     }
 
+    //*************************************************************************
+    /// The buffer index of the element at 'index'.
+    //*************************************************************************
+    size_t buffer_index(size_t index) const
+    {
+      index += _begin.index;
+
+      return (index >= BUFFER_SIZE) ? index - BUFFER_SIZE : index;
+    }
+
     iterator _begin;   ///Iterator to the _begin item in the deque.
     iterator _end;     ///Iterator to the _end item in the deque.
     pointer  p_buffer; ///The buffer for the deque.
@@ -2107,6 +2260,170 @@ namespace etl
       ETL_INCREMENT_DEBUG_COUNT
     }
 
+    //*********************************************************************
+    /// Tests whether a range can be copied to the buffer with memcpy.
+    //*********************************************************************
+    template <typename TIterator>
+    struct is_memcpy_range : public etl::integral_constant<bool, etl::is_pointer<TIterator>::value &&
+                                                                 etl::is_trivially_copy_constructible<T>::value &&
+                                                                 etl::is_same<typename etl::remove_cv<typename etl::remove_pointer<TIterator>::type>::type, T>::value>
+    {
+    };
+
+    //*********************************************************************
+    /// Create 'n' new elements from a range at the back.
+    //*********************************************************************
+    template <typename TIterator>
+    void create_elements_back(TIterator from, size_t n)
+    {
+      create_elements_back(from, n, etl::integral_constant<bool, is_memcpy_range<TIterator>::value>());
+    }
+
+    //*********************************************************************
+    /// Create 'n' new elements from a range at the back, one at a time.
+    //*********************************************************************
+    template <typename TIterator>
+    void create_elements_back(TIterator from, size_t n, etl::false_type)
+    {
+      while (n-- != 0)
+      {
+        create_element_back(*from);
+        ++from;
+      }
+    }
+
+    //*********************************************************************
+    /// Create 'n' new elements from an array of trivially copyable elements
+    /// at the back, in at most two copies.
+    //*********************************************************************
+    template <typename TIterator>
+    void create_elements_back(TIterator from, size_t n, etl::true_type)
+    {
+      if (n == 0)
+      {
+        return;
+      }
+
+      const size_t first_index = _end.index;
+      const size_t first_size  = std::min(n, BUFFER_SIZE - first_index);
+
+      memcpy(p_buffer + first_index, from, first_size * sizeof(T));
+      memcpy(p_buffer, from + first_size, (n - first_size) * sizeof(T));
+
+      _end += n;
+      current_size += n;
+      ETL_ADD_DEBUG_COUNT(n)
+    }
+
+    //*********************************************************************
+    /// Opens an uninitialised gap before 'position' by moving the elements on
+    /// the shorter side with memmove.
+    /// For trivially relocatable types.
+    ///\return An iterator to the gap.
+    //*********************************************************************
+    iterator relocate_open(iterator position)
+    {
+      const size_t n_front = distance(_begin, position);
+      const size_t n_back  = current_size - n_front;
+
+      if (n_front < n_back)
+      {
+        // Move the front down by one.
+        relocate_elements(_begin.index, _begin.index + BUFFER_SIZE - 1, n_front, false);
+        --_begin;
+        --position;
+      }
+      else
+      {
+        // Move the back up by one.
+        relocate_elements(position.index, position.index + 1, n_back, true);
+        ++_end;
+      }
+
+      ++current_size;
+      ETL_INCREMENT_DEBUG_COUNT
+
+      return position;
+    }
+
+    //*********************************************************************
+    /// Closes the gap of 'n' destroyed elements at 'position' by moving the
+    /// elements on the shorter side with memmove.
+    /// For trivially relocatable types.
+    ///\return An iterator to the element that followed the gap.
+    //*********************************************************************
+    iterator relocate_close(iterator position, size_t n)
+    {
+      const size_t n_front = distance(_begin, position);
+      const size_t n_back  = current_size - n_front - n;
+
+      if (n_front < n_back)
+      {
+        // Move the front up.
+        relocate_elements(_begin.index, _begin.index + n, n_front, true);
+        _begin   += n;
+        position += n;
+      }
+      else
+      {
+        // Move the back down.
+        relocate_elements(position.index + n, position.index, n_back, false);
+        _end -= n;
+      }
+
+      current_size -= n;
+      ETL_SUBTRACT_DEBUG_COUNT(n)
+
+      return position;
+    }
+
+    //*********************************************************************
+    /// Moves 'n' elements from buffer index 'from' to buffer index 'to', a
+    /// contiguous run at a time. Indexes past the end of the buffer wrap.
+    /// Runs that move up are moved last first, so overlaps are safe.
+    //*********************************************************************
+    void relocate_elements(size_t from, size_t to, size_t n, bool up)
+    {
+      if (n == 0)
+      {
+        return;
+      }
+
+      if (up)
+      {
+        // One past the last of each, from 1 to BUFFER_SIZE.
+        size_t from_end = ((from + n - 1) % BUFFER_SIZE) + 1;
+        size_t to_end   = ((to + n - 1) % BUFFER_SIZE) + 1;
+
+        while (n != 0)
+        {
+          const size_t length = std::min(n, std::min(from_end, to_end));
+
+          memmove(static_cast<void*>(p_buffer + to_end - length), static_cast<const void*>(p_buffer + from_end - length), length * sizeof(T));
+
+          n -= length;
+          from_end = (from_end == length) ? BUFFER_SIZE : from_end - length;
+          to_end   = (to_end == length)   ? BUFFER_SIZE : to_end - length;
+        }
+      }
+      else
+      {
+        from %= BUFFER_SIZE;
+        to   %= BUFFER_SIZE;
+
+        while (n != 0)
+        {
+          const size_t length = std::min(n, std::min(BUFFER_SIZE - from, BUFFER_SIZE - to));
+
+          memmove(static_cast<void*>(p_buffer + to), static_cast<const void*>(p_buffer + from), length * sizeof(T));
+
+          n -= length;
+          from = (from + length == BUFFER_SIZE) ? 0 : from + length;
+          to   = (to + length == BUFFER_SIZE)   ? 0 : to + length;
+        }
+      }
+    }
+
 #if ETL_CPP11_SUPPORTED
     //*********************************************************************
     /// Create a new element with a default value at the front.
@@ -2257,7 +2574,7 @@ namespace etl
     {
       if (this != &other)
       {
-        this->assign(other.begin(), other.end());
+        this->assign_deque(other);
       }
     }
 
@@ -2321,7 +2638,7 @@ namespace etl
     {
       if (&rhs != this)
       {
-        this->assign(rhs.begin(), rhs.end());
+        this->assign_deque(rhs);
       }
 
       return *this;
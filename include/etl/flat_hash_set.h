@@ -0,0 +1,1197 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_FLAT_HASH_SET_INCLUDED
+#define ETL_FLAT_HASH_SET_INCLUDED
+
+#include <stddef.h>
+#include <new>
+
+#include "platform.h"
+
+#include "stl/algorithm.h"
+#include "stl/iterator.h"
+#include "stl/functional.h"
+#include "stl/utility.h"
+
+#include "container.h"
+#include "alignment.h"
+#include "hash.h"
+#include "type_traits.h"
+#include "parameter_type.h"
+#include "nullptr.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "debug_count.h"
+
+#define ETL_IN_FLAT_HASH_SET_H
+#include "private/flat_hash_group.h"
+#undef ETL_IN_FLAT_HASH_SET_H
+
+#undef ETL_FILE
+#define ETL_FILE "52"
+
+//*****************************************************************************
+///\defgroup flat_hash_set flat_hash_set
+/// An open addressing hash set with the capacity defined at compile time.
+/// Elements are stored in a flat array of slots with one control byte per slot.
+/// Lookups compare a group of 16 control bytes at a time, using SSE2 where available.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// Exception for the flat_hash_set.
+  ///\ingroup flat_hash_set
+  //***************************************************************************
+  class flat_hash_set_exception : public etl::exception
+  {
+  public:
+
+    flat_hash_set_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : etl::exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Full exception for the flat_hash_set.
+  ///\ingroup flat_hash_set
+  //***************************************************************************
+  class flat_hash_set_full : public etl::flat_hash_set_exception
+  {
+  public:
+
+    flat_hash_set_full(string_type file_name_, numeric_type line_number_)
+      : etl::flat_hash_set_exception(ETL_ERROR_TEXT("flat_hash_set:full", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Out of range exception for the flat_hash_set.
+  ///\ingroup flat_hash_set
+  //***************************************************************************
+  class flat_hash_set_out_of_range : public etl::flat_hash_set_exception
+  {
+  public:
+
+    flat_hash_set_out_of_range(string_type file_name_, numeric_type line_number_)
+      : etl::flat_hash_set_exception(ETL_ERROR_TEXT("flat_hash_set:range", ETL_FILE"B"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Iterator exception for the flat_hash_set.
+  ///\ingroup flat_hash_set
+  //***************************************************************************
+  class flat_hash_set_iterator : public etl::flat_hash_set_exception
+  {
+  public:
+
+    flat_hash_set_iterator(string_type file_name_, numeric_type line_number_)
+      : etl::flat_hash_set_exception(ETL_ERROR_TEXT("flat_hash_set:iterator", ETL_FILE"C"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The base class for specifically sized flat_hash_set.
+  /// Can be used as a reference type for all flat_hash_set containing a specific type.
+  ///\ingroup flat_hash_set
+  //***************************************************************************
+  template <typename TKey, typename THash = etl::hash<TKey>, typename TKeyEqual = std::equal_to<TKey> >
+  class iflat_hash_set
+  {
+  public:
+
+    typedef TKey              value_type;
+    typedef TKey              key_type;
+    typedef THash             hasher;
+    typedef TKeyEqual         key_equal;
+    typedef value_type&       reference;
+    typedef const value_type& const_reference;
+    typedef value_type*       pointer;
+    typedef const value_type* const_pointer;
+    typedef size_t            size_type;
+
+    typedef typename std::iterator_traits<pointer>::difference_type difference_type;
+
+    typedef typename etl::parameter_type<TKey>::type key_parameter_t;
+
+  protected:
+
+    typedef etl::private_flat_hash::ctrl_t ctrl_t;
+
+  public:
+
+    class const_iterator;
+
+    //*********************************************************************
+    class iterator : public std::iterator<std::forward_iterator_tag, value_type>
+    {
+    public:
+
+      friend class iflat_hash_set;
+      friend class const_iterator;
+
+      //*********************************
+      iterator()
+        : pctrl(nullptr),
+          pslot(nullptr)
+      {
+      }
+
+      //*********************************
+      iterator(const iterator& other)
+        : pctrl(other.pctrl),
+          pslot(other.pslot)
+      {
+      }
+
+      //*********************************
+      iterator& operator ++()
+      {
+        ++pctrl;
+        ++pslot;
+        skip_empty_slots();
+
+        return *this;
+      }
+
+      //*********************************
+      iterator operator ++(int)
+      {
+        iterator temp(*this);
+        operator++();
+        return temp;
+      }
+
+      //*********************************
+      iterator& operator =(const iterator& other)
+      {
+        pctrl = other.pctrl;
+        pslot = other.pslot;
+        return *this;
+      }
+
+      //*********************************
+      reference operator *()
+      {
+        return *pslot;
+      }
+
+      //*********************************
+      const_reference operator *() const
+      {
+        return *pslot;
+      }
+
+      //*********************************
+      pointer operator &()
+      {
+        return pslot;
+      }
+
+      //*********************************
+      const_pointer operator &() const
+      {
+        return pslot;
+      }
+
+      //*********************************
+      pointer operator ->()
+      {
+        return pslot;
+      }
+
+      //*********************************
+      const_pointer operator ->() const
+      {
+        return pslot;
+      }
+
+      //*********************************
+      friend bool operator == (const iterator& lhs, const iterator& rhs)
+      {
+        return lhs.pctrl == rhs.pctrl;
+      }
+
+      //*********************************
+      friend bool operator != (const iterator& lhs, const iterator& rhs)
+      {
+        return !(lhs == rhs);
+      }
+
+    private:
+
+      //*********************************
+      iterator(ctrl_t* pctrl_, pointer pslot_)
+        : pctrl(pctrl_),
+          pslot(pslot_)
+      {
+      }
+
+      //*********************************
+      /// Moves forward to the next full slot.
+      /// The sentinel control byte stops the search at end().
+      //*********************************
+      void skip_empty_slots()
+      {
+        while (etl::private_flat_hash::is_empty_or_deleted(*pctrl))
+        {
+          ++pctrl;
+          ++pslot;
+        }
+      }
+
+      ctrl_t* pctrl;
+      pointer pslot;
+    };
+
+    //*********************************************************************
+    class const_iterator : public std::iterator<std::forward_iterator_tag, const value_type>
+    {
+    public:
+
+      friend class iflat_hash_set;
+      friend class iterator;
+
+      //*********************************
+      const_iterator()
+        : pctrl(nullptr),
+          pslot(nullptr)
+      {
+      }
+
+      //*********************************
+      const_iterator(const typename iflat_hash_set::iterator& other)
+        : pctrl(other.pctrl),
+          pslot(other.pslot)
+      {
+      }
+
+      //*********************************
+      const_iterator(const const_iterator& other)
+        : pctrl(other.pctrl),
+          pslot(other.pslot)
+      {
+      }
+
+      //*********************************
+      const_iterator& operator ++()
+      {
+        ++pctrl;
+        ++pslot;
+        skip_empty_slots();
+
+        return *this;
+      }
+
+      //*********************************
+      const_iterator operator ++(int)
+      {
+        const_iterator temp(*this);
+        operator++();
+        return temp;
+      }
+
+      //*********************************
+      const_iterator& operator =(const const_iterator& other)
+      {
+        pctrl = other.pctrl;
+        pslot = other.pslot;
+        return *this;
+      }
+
+      //*********************************
+      const_reference operator *() const
+      {
+        return *pslot;
+      }
+
+      //*********************************
+      const_pointer operator &() const
+      {
+        return pslot;
+      }
+
+      //*********************************
+      const_pointer operator ->() const
+      {
+        return pslot;
+      }
+
+      //*********************************
+      friend bool operator == (const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return lhs.pctrl == rhs.pctrl;
+      }
+
+      //*********************************
+      friend bool operator != (const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return !(lhs == rhs);
+      }
+
+    private:
+
+      //*********************************
+      const_iterator(const ctrl_t* pctrl_, const_pointer pslot_)
+        : pctrl(pctrl_),
+          pslot(pslot_)
+      {
+      }
+
+      //*********************************
+      void skip_empty_slots()
+      {
+        while (etl::private_flat_hash::is_empty_or_deleted(*pctrl))
+        {
+          ++pctrl;
+          ++pslot;
+        }
+      }
+
+      const ctrl_t* pctrl;
+      const_pointer pslot;
+    };
+
+    //*********************************************************************
+    /// Returns an iterator to the beginning of the flat_hash_set.
+    ///\return An iterator to the beginning of the flat_hash_set.
+    //*********************************************************************
+    iterator begin()
+    {
+      iterator itr(pctrl, pslots);
+      itr.skip_empty_slots();
+      return itr;
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the beginning of the flat_hash_set.
+    ///\return A const iterator to the beginning of the flat_hash_set.
+    //*********************************************************************
+    const_iterator begin() const
+    {
+      const_iterator itr(pctrl, pslots);
+      itr.skip_empty_slots();
+      return itr;
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the beginning of the flat_hash_set.
+    ///\return A const iterator to the beginning of the flat_hash_set.
+    //*********************************************************************
+    const_iterator cbegin() const
+    {
+      return begin();
+    }
+
+    //*********************************************************************
+    /// Returns an iterator to the end of the flat_hash_set.
+    ///\return An iterator to the end of the flat_hash_set.
+    //*********************************************************************
+    iterator end()
+    {
+      return iterator(pctrl + number_of_slots, pslots + number_of_slots);
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the end of the flat_hash_set.
+    ///\return A const iterator to the end of the flat_hash_set.
+    //*********************************************************************
+    const_iterator end() const
+    {
+      return const_iterator(pctrl + number_of_slots, pslots + number_of_slots);
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the end of the flat_hash_set.
+    ///\return A const iterator to the end of the flat_hash_set.
+    //*********************************************************************
+    const_iterator cend() const
+    {
+      return end();
+    }
+
+    //*********************************************************************
+    /// Returns the maximum number of the slots the container can hold.
+    ///\return The maximum number of the slots the container can hold.
+    //*********************************************************************
+    size_type max_bucket_count() const
+    {
+      return number_of_slots;
+    }
+
+    //*********************************************************************
+    /// Returns the number of the slots the container holds.
+    ///\return The number of the slots the container holds.
+    //*********************************************************************
+    size_type bucket_count() const
+    {
+      return number_of_slots;
+    }
+
+    //*********************************************************************
+    /// Assigns values to the flat_hash_set.
+    /// If asserts or exceptions are enabled, emits flat_hash_set_full if the flat_hash_set does not have enough free space.
+    /// If asserts or exceptions are enabled, emits flat_hash_set_iterator if the iterators are reversed.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*********************************************************************
+    template <typename TIterator>
+    void assign(TIterator first_, TIterator last_)
+    {
+#if defined(ETL_DEBUG)
+      difference_type d = std::distance(first_, last_);
+      ETL_ASSERT(d >= 0, ETL_ERROR(flat_hash_set_iterator));
+      ETL_ASSERT(size_t(d) <= max_size(), ETL_ERROR(flat_hash_set_full));
+#endif
+
+      clear();
+
+      while (first_ != last_)
+      {
+        insert(*first_++);
+      }
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the flat_hash_set.
+    /// If asserts or exceptions are enabled, emits flat_hash_set_full if the flat_hash_set is already full.
+    ///\param value The value to insert.
+    //*********************************************************************
+    std::pair<iterator, bool> insert(const value_type& key)
+    {
+      const size_t hash = hash_of(key);
+      std::pair<size_t, bool> result = find_or_prepare_insert(key, hash);
+
+      if (result.second)
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(flat_hash_set_full));
+
+        construct_at(result.first, hash, key);
+      }
+
+      return std::pair<iterator, bool>(iterator(pctrl + result.first, pslots + result.first), result.second);
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the flat_hash_set.
+    /// If asserts or exceptions are enabled, emits flat_hash_set_full if the flat_hash_set is already full.
+    ///\param position The position to insert at.
+    ///\param value    The value to insert.
+    //*********************************************************************
+    iterator insert(const_iterator, const value_type& key)
+    {
+      return insert(key).first;
+    }
+
+    //*********************************************************************
+    /// Inserts a range of values to the flat_hash_set.
+    /// If asserts or exceptions are enabled, emits flat_hash_set_full if the flat_hash_set does not have enough free space.
+    ///\param first The first element to add.
+    ///\param last  The last + 1 element to add.
+    //*********************************************************************
+    template <class TIterator>
+    void insert(TIterator first_, TIterator last_)
+    {
+      while (first_ != last_)
+      {
+        insert(*first_++);
+      }
+    }
+
+    //*********************************************************************
+    /// Erases an element.
+    ///\param key The key to erase.
+    ///\return The number of elements erased. 0 or 1.
+    //*********************************************************************
+    size_t erase(key_parameter_t key)
+    {
+      size_t index = find_index(key, hash_of(key));
+
+      if (index == number_of_slots)
+      {
+        return 0;
+      }
+
+      erase_at(index);
+
+      return 1;
+    }
+
+    //*********************************************************************
+    /// Erases an element.
+    /// Erasing never moves the other elements, so other iterators remain valid.
+    ///\param ielement Iterator to the element.
+    //*********************************************************************
+    iterator erase(const_iterator ielement)
+    {
+      const size_t index = ielement.pctrl - pctrl;
+
+      iterator inext(pctrl + index, pslots + index);
+      ++inext;
+
+      erase_at(index);
+
+      return inext;
+    }
+
+    //*********************************************************************
+    /// Erases a range of elements.
+    /// The range includes all the elements between first and last, including the
+    /// element pointed by first, but not the one pointed to by last.
+    ///\param first Iterator to the first element.
+    ///\param last  Iterator to the last element.
+    //*********************************************************************
+    iterator erase(const_iterator first_, const_iterator last_)
+    {
+      while (first_ != last_)
+      {
+        first_ = erase(first_);
+      }
+
+      const size_t index = last_.pctrl - pctrl;
+
+      return iterator(pctrl + index, pslots + index);
+    }
+
+    //*************************************************************************
+    /// Clears the flat_hash_set.
+    //*************************************************************************
+    void clear()
+    {
+      initialise();
+    }
+
+    //*********************************************************************
+    /// Counts an element.
+    ///\param key The key to search for.
+    ///\return 1 if the key exists, otherwise 0.
+    //*********************************************************************
+    size_t count(key_parameter_t key) const
+    {
+      return (find_index(key, hash_of(key)) == number_of_slots) ? 0 : 1;
+    }
+
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator to the element if the key exists, otherwise end().
+    //*********************************************************************
+    iterator find(key_parameter_t key)
+    {
+      size_t index = find_index(key, hash_of(key));
+
+      return iterator(pctrl + index, pslots + index);
+    }
+
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator to the element if the key exists, otherwise end().
+    //*********************************************************************
+    const_iterator find(key_parameter_t key) const
+    {
+      size_t index = find_index(key, hash_of(key));
+
+      return const_iterator(pctrl + index, pslots + index);
+    }
+
+    //*********************************************************************
+    /// Returns a range containing all elements with key key in the container.
+    /// The range is defined by two iterators, the first pointing to the first
+    /// element of the wanted range and the second pointing past the last
+    /// element of the range.
+    ///\param key The key to search for.
+    ///\return An iterator pair to the range of elements if the key exists, otherwise end().
+    //*********************************************************************
+    std::pair<iterator, iterator> equal_range(key_parameter_t key)
+    {
+      iterator f = find(key);
+      iterator l = f;
+
+      if (l != end())
+      {
+        ++l;
+      }
+
+      return std::pair<iterator, iterator>(f, l);
+    }
+
+    //*********************************************************************
+    /// Returns a range containing all elements with key key in the container.
+    /// The range is defined by two iterators, the first pointing to the first
+    /// element of the wanted range and the second pointing past the last
+    /// element of the range.
+    ///\param key The key to search for.
+    ///\return A const iterator pair to the range of elements if the key exists, otherwise end().
+    //*********************************************************************
+    std::pair<const_iterator, const_iterator> equal_range(key_parameter_t key) const
+    {
+      const_iterator f = find(key);
+      const_iterator l = f;
+
+      if (l != end())
+      {
+        ++l;
+      }
+
+      return std::pair<const_iterator, const_iterator>(f, l);
+    }
+
+    //*************************************************************************
+    /// Gets the size of the flat_hash_set.
+    //*************************************************************************
+    size_type size() const
+    {
+      return current_size;
+    }
+
+    //*************************************************************************
+    /// Gets the maximum possible size of the flat_hash_set.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the flat_hash_set is empty.
+    //*************************************************************************
+    bool empty() const
+    {
+      return current_size == 0;
+    }
+
+    //*************************************************************************
+    /// Checks to see if the flat_hash_set is full.
+    //*************************************************************************
+    bool full() const
+    {
+      return current_size == MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// Returns the remaining capacity.
+    ///\return The remaining capacity.
+    //*************************************************************************
+    size_t available() const
+    {
+      return MAX_SIZE - current_size;
+    }
+
+    //*************************************************************************
+    /// Returns the load factor = size / bucket_count.
+    ///\return The load factor = size / bucket_count.
+    //*************************************************************************
+    float load_factor() const
+    {
+      return static_cast<float>(size()) / static_cast<float>(bucket_count());
+    }
+
+    //*************************************************************************
+    /// Returns the function that hashes the keys.
+    ///\return The function that hashes the keys..
+    //*************************************************************************
+    hasher hash_function() const
+    {
+      return key_hash_function;
+    }
+
+    //*************************************************************************
+    /// Returns the function that compares the keys.
+    ///\return The function that compares the keys..
+    //*************************************************************************
+    key_equal key_eq() const
+    {
+      return key_equal_function;
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    iflat_hash_set& operator = (const iflat_hash_set& rhs)
+    {
+      // Skip if doing self assignment
+      if (this != &rhs)
+      {
+        assign(rhs.cbegin(), rhs.cend());
+      }
+
+      return *this;
+    }
+
+  protected:
+
+    //*********************************************************************
+    /// Constructor.
+    //*********************************************************************
+    iflat_hash_set(ctrl_t* pctrl_, pointer pslots_, size_t number_of_slots_, size_t max_size_)
+      : pctrl(pctrl_),
+        pslots(pslots_),
+        number_of_slots(number_of_slots_),
+        MAX_SIZE(max_size_),
+        current_size(0),
+        deleted_count(0)
+    {
+      // Mark every slot as empty.
+      std::fill_n(pctrl, number_of_slots, etl::private_flat_hash::CTRL_EMPTY);
+      pctrl[number_of_slots] = etl::private_flat_hash::CTRL_SENTINEL;
+    }
+
+    //*********************************************************************
+    /// Initialise the flat_hash_set.
+    //*********************************************************************
+    void initialise()
+    {
+      if (!empty())
+      {
+        for (size_t i = 0; i < number_of_slots; ++i)
+        {
+          if (etl::private_flat_hash::is_full(pctrl[i]))
+          {
+            pslots[i].~value_type();
+            ETL_DECREMENT_DEBUG_COUNT
+          }
+        }
+      }
+
+      std::fill_n(pctrl, number_of_slots, etl::private_flat_hash::CTRL_EMPTY);
+
+      current_size  = 0;
+      deleted_count = 0;
+    }
+
+  private:
+
+    //*********************************************************************
+    /// Calculates the mixed hash for the key.
+    //*********************************************************************
+    size_t hash_of(key_parameter_t key) const
+    {
+      return etl::private_flat_hash::mix_hash(key_hash_function(key));
+    }
+
+    //*********************************************************************
+    /// Returns the slot index of the key, or number_of_slots if not found.
+    //*********************************************************************
+    size_t find_index(key_parameter_t key, size_t hash) const
+    {
+      const ctrl_t hash2 = etl::private_flat_hash::h2(hash);
+      etl::private_flat_hash::probe_sequence probe(etl::private_flat_hash::h1(hash), group_mask());
+
+      while (probe.count() <= group_mask())
+      {
+        const size_t offset = probe.offset();
+        etl::private_flat_hash::group g(pctrl + offset);
+
+        for (etl::private_flat_hash::bitmask match = g.match(hash2); match.any(); match.next())
+        {
+          const size_t index = offset + match.lowest();
+
+          if (key_equal_function(key, pslots[index]))
+          {
+            return index;
+          }
+        }
+
+        // An empty slot in the group ends the probe sequence.
+        if (g.match_empty().any())
+        {
+          break;
+        }
+
+        probe.next();
+      }
+
+      return number_of_slots;
+    }
+
+    //*********************************************************************
+    /// Finds the key, or the slot where it should be inserted.
+    ///\return The slot index, and true if the slot is free for a new element.
+    //*********************************************************************
+    std::pair<size_t, bool> find_or_prepare_insert(key_parameter_t key, size_t hash)
+    {
+      // Too many tombstones make unsuccessful lookups scan the whole table.
+      if ((current_size + deleted_count) >= ((number_of_slots * 7) / 8) && (deleted_count != 0))
+      {
+        rehash_in_place();
+      }
+
+      const ctrl_t hash2 = etl::private_flat_hash::h2(hash);
+      etl::private_flat_hash::probe_sequence probe(etl::private_flat_hash::h1(hash), group_mask());
+
+      size_t free_slot = number_of_slots;
+
+      while (probe.count() <= group_mask())
+      {
+        const size_t offset = probe.offset();
+        etl::private_flat_hash::group g(pctrl + offset);
+
+        for (etl::private_flat_hash::bitmask match = g.match(hash2); match.any(); match.next())
+        {
+          const size_t index = offset + match.lowest();
+
+          if (key_equal_function(key, pslots[index]))
+          {
+            return std::pair<size_t, bool>(index, false);
+          }
+        }
+
+        // Remember the first free slot in the probe sequence.
+        if (free_slot == number_of_slots)
+        {
+          etl::private_flat_hash::bitmask free_slots = g.match_empty_or_deleted();
+
+          if (free_slots.any())
+          {
+            free_slot = offset + free_slots.lowest();
+          }
+        }
+
+        if (g.match_empty().any())
+        {
+          break;
+        }
+
+        probe.next();
+      }
+
+      return std::pair<size_t, bool>(free_slot, true);
+    }
+
+    //*********************************************************************
+    /// Returns the first empty or deleted slot in the probe sequence for the hash.
+    //*********************************************************************
+    size_t find_first_non_full(size_t hash) const
+    {
+      etl::private_flat_hash::probe_sequence probe(etl::private_flat_hash::h1(hash), group_mask());
+
+      while (true)
+      {
+        const size_t offset = probe.offset();
+        etl::private_flat_hash::bitmask free_slots = etl::private_flat_hash::group(pctrl + offset).match_empty_or_deleted();
+
+        if (free_slots.any())
+        {
+          return offset + free_slots.lowest();
+        }
+
+        probe.next();
+      }
+    }
+
+    //*********************************************************************
+    /// Constructs a new element in a free slot.
+    //*********************************************************************
+    void construct_at(size_t index, size_t hash, const value_type& value)
+    {
+      if (pctrl[index] == etl::private_flat_hash::CTRL_DELETED)
+      {
+        --deleted_count;
+      }
+
+      ::new (pslots + index) value_type(value);
+      pctrl[index] = etl::private_flat_hash::h2(hash);
+      ++current_size;
+      ETL_INCREMENT_DEBUG_COUNT
+    }
+
+    //*********************************************************************
+    /// Destroys the element at the index.
+    //*********************************************************************
+    void erase_at(size_t index)
+    {
+      pslots[index].~value_type();
+      --current_size;
+      ETL_DECREMENT_DEBUG_COUNT
+
+      // If the group has an empty slot then no probe sequence continues past
+      // it, so the slot can be freed. Otherwise it must be marked as deleted.
+      const size_t offset = index & ~(etl::private_flat_hash::GROUP_WIDTH - 1);
+
+      if (etl::private_flat_hash::group(pctrl + offset).match_empty().any())
+      {
+        pctrl[index] = etl::private_flat_hash::CTRL_EMPTY;
+      }
+      else
+      {
+        pctrl[index] = etl::private_flat_hash::CTRL_DELETED;
+        ++deleted_count;
+      }
+    }
+
+    //*********************************************************************
+    /// Removes all of the deleted markers without using any extra storage.
+    /// Every element is either left where it is, or moved to the first free
+    /// slot of its probe sequence.
+    //*********************************************************************
+    void rehash_in_place()
+    {
+      using namespace etl::private_flat_hash;
+
+      // Deleted -> Empty, Full -> Deleted.
+      for (size_t i = 0; i < number_of_slots; ++i)
+      {
+        pctrl[i] = is_full(pctrl[i]) ? CTRL_DELETED : CTRL_EMPTY;
+      }
+
+      for (size_t i = 0; i < number_of_slots; ++i)
+      {
+        // Only elements still waiting to be placed are marked as deleted.
+        if (pctrl[i] != CTRL_DELETED)
+        {
+          continue;
+        }
+
+        const size_t hash   = hash_of(pslots[i]);
+        const size_t target = find_first_non_full(hash);
+
+        if ((target / GROUP_WIDTH) == (i / GROUP_WIDTH))
+        {
+          // Already in the right group.
+          pctrl[i] = h2(hash);
+        }
+        else if (pctrl[target] == CTRL_EMPTY)
+        {
+          ::new (pslots + target) value_type(pslots[i]);
+          pslots[i].~value_type();
+          pctrl[target] = h2(hash);
+          pctrl[i]      = CTRL_EMPTY;
+        }
+        else
+        {
+          // The target holds another element that is waiting to be placed.
+          // Swap them and process this slot again.
+          typename etl::aligned_storage<sizeof(value_type), etl::alignment_of<value_type>::value>::type temp;
+          pointer ptemp = reinterpret_cast<pointer>(&temp);
+
+          ::new (ptemp) value_type(pslots[target]);
+          pslots[target].~value_type();
+          ::new (pslots + target) value_type(pslots[i]);
+          pslots[i].~value_type();
+          ::new (pslots + i) value_type(*ptemp);
+          ptemp->~value_type();
+
+          pctrl[target] = h2(hash);
+          --i;
+        }
+      }
+
+      deleted_count = 0;
+    }
+
+    //*********************************************************************
+    /// The mask to apply to a group index.
+    //*********************************************************************
+    size_t group_mask() const
+    {
+      return (number_of_slots / etl::private_flat_hash::GROUP_WIDTH) - 1;
+    }
+
+    // Disable copy construction.
+    iflat_hash_set(const iflat_hash_set&);
+
+    /// The control bytes, plus the sentinel.
+    ctrl_t* pctrl;
+
+    /// The element slots.
+    pointer pslots;
+
+    /// The number of slots.
+    const size_t number_of_slots;
+
+    /// The maximum number of elements.
+    const size_t MAX_SIZE;
+
+    /// The number of elements.
+    size_t current_size;
+
+    /// The number of slots marked as deleted.
+    size_t deleted_count;
+
+    /// The function that creates the hashes.
+    hasher key_hash_function;
+
+    /// The function that compares the keys for equality.
+    key_equal key_equal_function;
+
+    /// For library debugging purposes only.
+    ETL_DECLARE_DEBUG_COUNT
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_FLAT_HASH_SET) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~iflat_hash_set()
+    {
+    }
+#else
+  protected:
+    ~iflat_hash_set()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  /// Equal operator.
+  /// The sets are equal if they hold the same keys, in any order.
+  ///\param lhs Reference to the first flat_hash_set.
+  ///\param rhs Reference to the second flat_hash_set.
+  ///\return <b>true</b> if the sets are equal, otherwise <b>false</b>
+  ///\ingroup flat_hash_set
+  //***************************************************************************
+  template <typename TKey, typename THash, typename TKeyEqual>
+  bool operator ==(const etl::iflat_hash_set<TKey, THash, TKeyEqual>& lhs, const etl::iflat_hash_set<TKey, THash, TKeyEqual>& rhs)
+  {
+    if (lhs.size() != rhs.size())
+    {
+      return false;
+    }
+
+    typename etl::iflat_hash_set<TKey, THash, TKeyEqual>::const_iterator itr = lhs.begin();
+
+    while (itr != lhs.end())
+    {
+      if (rhs.find(*itr) == rhs.end())
+      {
+        return false;
+      }
+
+      ++itr;
+    }
+
+    return true;
+  }
+
+  //***************************************************************************
+  /// Not equal operator.
+  ///\param lhs Reference to the first flat_hash_set.
+  ///\param rhs Reference to the second flat_hash_set.
+  ///\return <b>true</b> if the sets are not equal, otherwise <b>false</b>
+  ///\ingroup flat_hash_set
+  //***************************************************************************
+  template <typename TKey, typename THash, typename TKeyEqual>
+  bool operator !=(const etl::iflat_hash_set<TKey, THash, TKeyEqual>& lhs, const etl::iflat_hash_set<TKey, THash, TKeyEqual>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  //*************************************************************************
+  /// A templated flat_hash_set implementation that uses a fixed size buffer.
+  /// The number of slots is MAX_SIZE * 8 / 7, rounded up to a power of 2.
+  //*************************************************************************
+  template <typename TKey, const size_t MAX_SIZE_, typename THash = etl::hash<TKey>, typename TKeyEqual = std::equal_to<TKey> >
+  class flat_hash_set : public etl::iflat_hash_set<TKey, THash, TKeyEqual>
+  {
+  private:
+
+    typedef etl::iflat_hash_set<TKey, THash, TKeyEqual> base;
+
+  public:
+
+    static const size_t MAX_SIZE    = MAX_SIZE_;
+    static const size_t MAX_BUCKETS = etl::private_flat_hash::capacity<MAX_SIZE_>::value;
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    flat_hash_set()
+      : base(ctrl, reinterpret_cast<typename base::pointer>(&slots[0]), MAX_BUCKETS, MAX_SIZE)
+    {
+    }
+
+    //*************************************************************************
+    /// Copy constructor.
+    //*************************************************************************
+    flat_hash_set(const flat_hash_set& other)
+      : base(ctrl, reinterpret_cast<typename base::pointer>(&slots[0]), MAX_BUCKETS, MAX_SIZE)
+    {
+      base::assign(other.cbegin(), other.cend());
+    }
+
+    //*************************************************************************
+    /// Constructor, from an iterator range.
+    ///\tparam TIterator The iterator type.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*************************************************************************
+    template <typename TIterator>
+    flat_hash_set(TIterator first_, TIterator last_)
+      : base(ctrl, reinterpret_cast<typename base::pointer>(&slots[0]), MAX_BUCKETS, MAX_SIZE)
+    {
+      base::assign(first_, last_);
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~flat_hash_set()
+    {
+      base::initialise();
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    flat_hash_set& operator = (const flat_hash_set& rhs)
+    {
+      // Skip if doing self assignment
+      if (this != &rhs)
+      {
+        base::assign(rhs.cbegin(), rhs.cend());
+      }
+
+      return *this;
+    }
+
+  private:
+
+    typedef typename etl::aligned_storage<sizeof(typename base::value_type), etl::alignment_of<typename base::value_type>::value>::type slot_t;
+
+    /// The control bytes, plus the sentinel.
+    typename base::ctrl_t ctrl[MAX_BUCKETS + 1];
+
+    /// The element slots.
+    slot_t slots[MAX_BUCKETS];
+  };
+}
+
+#undef ETL_FILE
+
+#endif
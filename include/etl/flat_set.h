@@ -273,6 +273,92 @@ namespace etl
       }
     }
 
+    //*********************************************************************
+    /// Assigns a range of values, sorted by value, to the flat_set.
+    /// Appends each value, rather than searching for its position.
+    /// Values with a value equal to an earlier one in the range are ignored.
+    /// If asserts or exceptions are enabled, emits flat_set_full if the flat_set does not have enough free space.
+    /// If ETL_DEBUG is defined, emits flat_set_iterator if the range is not sorted.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*********************************************************************
+    template <typename TIterator>
+    void assign_sorted(TIterator first, TIterator last)
+    {
+      clear();
+      insert_sorted(first, last);
+    }
+
+    //*********************************************************************
+    /// Inserts a range of values, sorted by value, to the flat_set.
+    /// Merges the range with the existing values in time linear in size()
+    /// plus the length of the range.
+    /// Values with a value already in the flat_set, or earlier in the range, are ignored.
+    /// If asserts or exceptions are enabled, emits flat_set_full if the flat_set does not have enough free space.
+    /// If ETL_DEBUG is defined, emits flat_set_iterator if the range is not sorted.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*********************************************************************
+    template <typename TIterator>
+    void insert_sorted(TIterator first, TIterator last)
+    {
+#if defined(ETL_DEBUG)
+      if (first != last)
+      {
+        TIterator previous = first;
+        TIterator itr      = first;
+
+        while (++itr != last)
+        {
+          ETL_ASSERT(!compare(*itr, *previous), ETL_ERROR(flat_set_iterator));
+          previous = itr;
+        }
+      }
+#endif
+
+      // Move the existing entries to the back of the lookup, then merge them
+      // forwards with the range into the space in front.
+      lookup_t& lookup = refset_t::lookup;
+
+      size_t n_existing = lookup.size();
+      lookup.resize(lookup.max_size());
+      std::copy_backward(lookup.begin(), lookup.begin() + n_existing, lookup.end());
+
+      size_t write = 0;
+      size_t read  = lookup.size() - n_existing;
+
+      while (first != last)
+      {
+        // The existing values that go before the new one.
+        while ((read != lookup.size()) && !compare(*first, *lookup[read]))
+        {
+          lookup[write++] = lookup[read++];
+        }
+
+        // Not a duplicate?
+        if ((write == 0) || compare(*lookup[write - 1], *first))
+        {
+          if (write == read)
+          {
+            break;
+          }
+
+          value_type* pvalue = storage.allocate<value_type>();
+          ::new (pvalue) value_type(*first);
+          ETL_INCREMENT_DEBUG_COUNT
+          lookup[write++] = pvalue;
+        }
+
+        ++first;
+      }
+
+      // The rest of the existing values.
+      std::copy(lookup.begin() + read, lookup.end(), lookup.begin() + write);
+      lookup.resize(write + (lookup.size() - read));
+
+      ETL_ASSERT(first == last, ETL_ERROR(flat_set_full));
+    }
+
     //*************************************************************************
     /// Emplaces a value to the set.
     //*************************************************************************
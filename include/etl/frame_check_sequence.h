@@ -27,6 +27,7 @@ SOFTWARE.
 #ifndef __ETL_FRAME_CHECK_SEQUENCE__
 #define __ETL_FRAME_CHECK_SEQUENCE__
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "platform.h"
@@ -34,6 +35,8 @@ SOFTWARE.
 #include "type_traits.h"
 #include "binary.h"
 
+#include "stl/iterator.h"
+
 ETL_STATIC_ASSERT(ETL_8BIT_SUPPORT, "This file does not currently support targets with no 8bit type");
 
 ///\defgroup frame_check_sequence Frame check sequence calculation
@@ -41,6 +44,35 @@ ETL_STATIC_ASSERT(ETL_8BIT_SUPPORT, "This file does not currently support target
 
 namespace etl
 {
+  namespace private_frame_check_sequence
+  {
+    //*************************************************************************
+    /// Detects whether a policy has a block algorithm.
+    /// value_type add_block(value_type, const uint8_t*, size_t) const
+    //*************************************************************************
+    template <typename TPolicy>
+    struct has_add_block
+    {
+    private:
+
+      typedef char yes;
+      typedef struct { char c[2]; } no;
+
+      template <typename U, typename U::value_type (U::*)(typename U::value_type, const uint8_t*, size_t) const>
+      struct check;
+
+      template <typename U>
+      static yes test(check<U, &U::add_block>*);
+
+      template <typename U>
+      static no test(...);
+
+    public:
+
+      static const bool value = (sizeof(test<TPolicy>(0)) == sizeof(yes));
+    };
+  }
+
   //***************************************************************************
   /// Calculates a frame check sequence according to the specified policy.
   ///\tparam TPolicy The type used to enact the policy.
@@ -110,6 +142,17 @@ namespace etl
       frame_check = policy.add(frame_check, value_);
     }
 
+    //*************************************************************************
+    /// Adds a block of bytes.
+    /// Uses the policy's block algorithm, if it has one.
+    /// \param data   The start of the block.
+    /// \param length The number of bytes.
+    //*************************************************************************
+    void add(const uint8_t* data, size_t length)
+    {
+      add_block(data, length, etl::integral_constant<bool, private_frame_check_sequence::has_add_block<policy_type>::value>());
+    }
+
     //*************************************************************************
     /// Gets the FCS value.
     //*************************************************************************
@@ -128,6 +171,25 @@ namespace etl
 
   private:
 
+    //*************************************************************************
+    /// The policy has a block algorithm.
+    //*************************************************************************
+    void add_block(const uint8_t* data, size_t length, etl::true_type)
+    {
+      frame_check = policy.add_block(frame_check, data, length);
+    }
+
+    //*************************************************************************
+    /// The policy does not have a block algorithm.
+    //*************************************************************************
+    void add_block(const uint8_t* data, size_t length, etl::false_type)
+    {
+      while (length-- != 0)
+      {
+        frame_check = policy.add(frame_check, *data++);
+      }
+    }
+
     value_type  frame_check;
     policy_type policy;
   };
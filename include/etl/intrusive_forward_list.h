@@ -37,6 +37,10 @@ SOFTWARE.
 #include "stl/iterator.h"
 #include "stl/functional.h"
 
+#define ETL_IN_INTRUSIVE_FORWARD_LIST_H
+#include "private/list_sort.h"
+#undef ETL_IN_INTRUSIVE_FORWARD_LIST_H
+
 #include "private/minmax_push.h"
 
 #include <stddef.h>
@@ -717,118 +721,18 @@ namespace etl
     //*************************************************************************
     /// Sort using in-place merge sort algorithm.
     /// Uses a supplied predicate function or functor.
-    /// This is not my algorithm. I got it off the web somewhere.
+    /// A bottom-up merge of the natural runs, so an ordered or nearly ordered
+    /// list is sorted in close to one pass.
     //*************************************************************************
     template <typename TCompare>
     void sort(TCompare compare)
     {
-      iterator i_left;
-      iterator i_right;
-      iterator i_link;
-      iterator i_head;
-      iterator i_tail;
-      int      list_size = 1;
-      int      number_of_merges;
-      int      left_size;
-      int      right_size;
-
       if (this->is_trivial_list())
       {
         return;
       }
 
-      while (true)
-      {
-        i_left = begin();
-        i_head = before_begin();
-        i_tail = before_begin();
-
-        number_of_merges = 0;  // Count the number of merges we do in this pass.
-
-        while (i_left != end())
-        {
-          ++number_of_merges;  // There exists a merge to be done.
-          i_right = i_left;
-          left_size = 0;
-
-          // Step 'list_size' places along from left
-          for (int i = 0; i < list_size; ++i)
-          {
-            ++left_size;
-
-            ++i_right;
-
-            if (i_right == end())
-            {
-              break;
-            }
-          }
-
-          // If right hasn't fallen off end, we have two lists to merge.
-          right_size = list_size;
-
-          // Now we have two lists. Merge them.
-          while (left_size > 0 || (right_size > 0 && i_right != end()))
-          {
-            // Decide whether the next link of merge comes from left or right.
-            if (left_size == 0)
-            {
-              // Left is empty. The link must come from right.
-              i_link = i_right;
-              ++i_right;
-              --right_size;
-            }
-            else if (right_size == 0 || i_right == end())
-            {
-              // Right is empty. The link must come from left.
-              i_link = i_left;
-              ++i_left;
-              --left_size;
-            }
-            else if (!compare(*i_right, *i_left))
-            {
-              // First link of left is lower or same. The link must come from left.
-              i_link = i_left;
-              ++i_left;
-              --left_size;
-            }
-            else
-            {
-              // First link of right is lower. The link must come from right.
-              i_link  = i_right;
-              ++i_right;
-              --right_size;
-            }
-
-            // Add the next link to the merged head.
-            if (i_head == before_begin())
-            {
-              etl::link<link_type>(i_head.p_value, i_link.p_value);
-              i_head = i_link;
-              i_tail = i_link;
-            }
-            else
-            {
-              etl::link<link_type>(i_tail.p_value, i_link.p_value);
-              i_tail = i_link;
-            }
-
-            i_tail.p_value->link_type::etl_next = nullptr;
-          }
-
-          // Now left has stepped `list_size' places along, and right has too.
-          i_left = i_right;
-        }
-
-        // If we have done only one merge, we're finished.
-        if (number_of_merges <= 1)   // Allow for number_of_merges == 0, the empty head case
-        {
-            return;
-        }
-
-        // Otherwise repeat, merging lists twice the size
-        list_size *= 2;
-      }
+      this->start_link.etl_next = etl::private_list_sort::sort<link_type, &link_type::etl_next>(this->start_link.etl_next, link_compare<TCompare>(compare));
     }
 
     //*************************************************************************
@@ -1031,6 +935,25 @@ namespace etl
 
   private:
 
+    //*************************************************************************
+    /// Applies a value predicate to two links.
+    //*************************************************************************
+    template <typename TCompare>
+    struct link_compare
+    {
+      explicit link_compare(TCompare compare_)
+        : compare(compare_)
+      {
+      }
+
+      bool operator ()(const link_type& lhs, const link_type& rhs)
+      {
+        return compare(static_cast<const value_type&>(lhs), static_cast<const value_type&>(rhs));
+      }
+
+      TCompare compare;
+    };
+
     //*************************************************************************
     /// Get the next value.
     //*************************************************************************
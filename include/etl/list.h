@@ -53,6 +53,10 @@ SOFTWARE.
   #include <initializer_list>
 #endif
 
+#define ETL_IN_LIST_H
+#include "private/list_sort.h"
+#undef ETL_IN_LIST_H
+
 #include "private/minmax_push.h"
 
 #undef ETL_FILE
@@ -474,6 +478,25 @@ namespace etl
       return reinterpret_cast<const data_node_t&>(node);
     }
 
+    //*************************************************************************
+    /// Applies a value predicate to two nodes.
+    //*************************************************************************
+    template <typename TCompare>
+    struct node_compare
+    {
+      explicit node_compare(TCompare compare_)
+        : compare(compare_)
+      {
+      }
+
+      bool operator ()(const node_t& lhs, const node_t& rhs)
+      {
+        return compare(data_cast(lhs).value, data_cast(rhs).value);
+      }
+
+      TCompare compare;
+    };
+
   public:
 
     //*************************************************************************
@@ -1601,114 +1624,31 @@ namespace etl
     //*************************************************************************
     /// Sort using in-place merge sort algorithm.
     /// Uses a supplied predicate function or functor.
-    /// This is not my algorithm. I got it off the web somewhere.
+    /// A bottom-up merge of the natural runs, so an ordered or nearly ordered
+    /// list is sorted in close to one pass.
     //*************************************************************************
     template <typename TCompare>
     void sort(TCompare compare)
     {
-      iterator i_left;
-      iterator i_right;
-      iterator i_node;
-      iterator i_head;
-      iterator i_tail;
-      int   list_size = 1;
-      int   number_of_merges;
-      int   left_size;
-      int   right_size;
-
       if (is_trivial_list())
       {
         return;
       }
 
-      while (true)
-      {
-        i_left = begin();
-        i_head = end();
-        i_tail = end();
-
-        number_of_merges = 0;  // Count the number of merges we do in this pass.
-
-        while (i_left != end())
-        {
-          ++number_of_merges;  // There exists a merge to be done.
-          i_right = i_left;
-          left_size = 0;
-
-          // Step 'list_size' places along from left
-          for (int i = 0; i < list_size; ++i)
-          {
-            ++left_size;
-            ++i_right;
-
-            if (i_right == end())
-            {
-              break;
-            }
-          }
+      // Sort as a null terminated chain, then restore the backward links.
+      terminal_node.previous->next = nullptr;
 
-          // If right hasn't fallen off end, we have two lists to merge.
-          right_size = list_size;
+      node_t* p_node = etl::private_list_sort::sort<node_t, &node_t::next>(terminal_node.next, node_compare<TCompare>(compare));
+      node_t* p_last = &terminal_node;
 
-          // Now we have two lists. Merge them.
-          while (left_size > 0 || (right_size > 0 && i_right != end()))
-          {
-            // Decide whether the next node of merge comes from left or right.
-            if (left_size == 0)
-            {
-              // Left is empty. The node must come from right.
-              i_node = i_right++;
-              --right_size;
-            }
-            else if (right_size == 0 || i_right == end())
-            {
-              // Right is empty. The node must come from left.
-              i_node = i_left++;
-              --left_size;
-            }
-            else if (!compare(*i_right, *i_left))
-            {
-              // First node of left is lower or same. The node must come from left.
-              i_node = i_left++;
-              --left_size;
-            }
-            else
-            {
-              // First node of right is lower. The node must come from right.
-              i_node = i_right;
-              ++i_right;
-              --right_size;
-            }
-
-            // Add the next node to the merged head.
-            if (i_head == end())
-            {
-              join(*i_head.p_node, *i_node.p_node);
-              i_head = i_node;
-              i_tail = i_node;
-            }
-            else
-            {
-              join(*i_tail.p_node, *i_node.p_node);
-              i_tail = i_node;
-            }
-
-            join(*i_tail.p_node, terminal_node);
-          }
-
-          // Now left has stepped `list_size' places along, and right has too.
-          i_left = i_right;
-        }
-
-        // If we have done only one merge, we're finished.
-        if (number_of_merges <= 1)   // Allow for number_of_merges == 0, the empty head case
-        {
-          return;
-        }
-
-        // Otherwise repeat, merging lists twice the size
-        list_size *= 2;
+      while (p_node != nullptr)
+      {
+        join(*p_last, *p_node);
+        p_last = p_node;
+        p_node = p_node->next;
       }
+
+      join(*p_last, terminal_node);
     }
 
     //*************************************************************************
@@ -449,6 +449,67 @@ namespace etl
       swap->weight = detached->weight;
     }
 
+    //*************************************************************************
+    /// Unlinks the nodes of the tree into a list, in order, joined through
+    /// their right hand children. Takes linear time.
+    ///\return The first node of the list.
+    //*************************************************************************
+    static Node* flatten_tree(Node* root)
+    {
+      Node*  head = root;
+      Node** link = &head;
+
+      while (*link)
+      {
+        Node* position = *link;
+        Node* left     = position->children[uint_least8_t(kLeft)];
+
+        if (left)
+        {
+          // Rotate right, so that the left child comes next in the list.
+          position->children[uint_least8_t(kLeft)] = left->children[uint_least8_t(kRight)];
+          left->children[uint_least8_t(kRight)] = position;
+          *link = left;
+        }
+        else
+        {
+          link = &position->children[uint_least8_t(kRight)];
+        }
+      }
+
+      return head;
+    }
+
+    //*************************************************************************
+    /// Builds a balanced tree from the first 'n' nodes of a list joined
+    /// through their right hand children, leaving 'list' at the next node.
+    /// The middle node is the root, so the heights of the subtrees differ by
+    /// one at most, and only when the right hand one is a power of two in size.
+    ///\return The root of the tree.
+    //*************************************************************************
+    static Node* build_tree(Node*& list, size_type n)
+    {
+      if (n == 0)
+      {
+        return nullptr;
+      }
+
+      size_type n_left  = (n - 1) / 2;
+      size_type n_right = n - 1 - n_left;
+
+      Node* left = build_tree(list, n_left);
+      Node* node = list;
+      list = list->children[uint_least8_t(kRight)];
+
+      node->children[uint_least8_t(kLeft)] = left;
+      node->children[uint_least8_t(kRight)] = build_tree(list, n_right);
+
+      node->dir    = uint_least8_t(kNeither);
+      node->weight = ((n_right != n_left) && ((n_right & (n_right - 1)) == 0)) ? uint_least8_t(kRight) : uint_least8_t(kNeither);
+
+      return node;
+    }
+
     size_type current_size;   ///< The number of the used nodes.
     const size_type CAPACITY; ///< The maximum size of the map.
     Node* root_node;          ///< The node that acts as the map root.
@@ -1171,6 +1232,92 @@ namespace etl
       }
     }
 
+    //*********************************************************************
+    /// Assigns a range of values, sorted by key, to the map.
+    /// Builds a balanced tree in linear time, rather than inserting each value.
+    /// Values with a key equal to an earlier one in the range are ignored.
+    /// If asserts or exceptions are enabled, emits map_full if the map does not have enough free space.
+    /// If ETL_DEBUG is defined, emits map_iterator if the range is not sorted.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*********************************************************************
+    template <typename TIterator>
+    void assign_sorted(TIterator first, TIterator last)
+    {
+      initialise();
+      insert_sorted(first, last);
+    }
+
+    //*********************************************************************
+    /// Inserts a range of values, sorted by key, to the map.
+    /// Merges the range with the existing values and rebuilds a balanced tree,
+    /// in time linear in size() plus the length of the range.
+    /// Values with a key already in the map, or earlier in the range, are ignored.
+    /// If asserts or exceptions are enabled, emits map_full if the map does not have enough free space.
+    /// If ETL_DEBUG is defined, emits map_iterator if the range is not sorted.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*********************************************************************
+    template <typename TIterator>
+    void insert_sorted(TIterator first, TIterator last)
+    {
+#if defined(ETL_DEBUG)
+      if (first != last)
+      {
+        TIterator previous = first;
+        TIterator itr      = first;
+
+        while (++itr != last)
+        {
+          ETL_ASSERT(!kcompare((*itr).first, (*previous).first), ETL_ERROR(map_iterator));
+          previous = itr;
+        }
+      }
+#endif
+
+      // Merge the existing nodes, in order, with the new ones into one list.
+      Node*  p_existing = flatten_tree(root_node);
+      Node*  p_list     = nullptr;
+      Node** p_link     = &p_list;
+      Node*  p_last     = nullptr;
+
+      while (first != last)
+      {
+        // The existing values that go before the new one.
+        while (p_existing && !node_comp((*first).first, data_cast(*p_existing)))
+        {
+          *p_link    = p_existing;
+          p_link     = &p_existing->children[kRight];
+          p_last     = p_existing;
+          p_existing = *p_link;
+        }
+
+        // Not a duplicate?
+        if ((p_last == nullptr) || node_comp(data_cast(*p_last), (*first).first))
+        {
+          if (full())
+          {
+            break;
+          }
+
+          Data_Node& node = allocate_data_node(*first);
+          ++current_size;
+
+          *p_link = &node;
+          p_link  = &node.children[kRight];
+          p_last  = &node;
+        }
+
+        ++first;
+      }
+
+      *p_link = p_existing;
+
+      root_node = build_tree(p_list, current_size);
+
+      ETL_ASSERT(first == last, ETL_ERROR(map_full));
+    }
+
     //*********************************************************************
     /// Returns an iterator pointing to the first element in the container
     /// whose key is not considered to go before the key provided or end()
@@ -1261,7 +1408,18 @@ namespace etl
     //*************************************************************************
     void initialise()
     {
-      erase(begin(), end());
+      // Destroy the nodes in order, without rebalancing.
+      Node* p_node = flatten_tree(root_node);
+
+      while (p_node)
+      {
+        Node* p_next = p_node->children[kRight];
+        destroy_data_node(data_cast(*p_node));
+        p_node = p_next;
+      }
+
+      root_node    = nullptr;
+      current_size = 0;
     }
 
   private:
@@ -73,6 +73,8 @@ cog.outl("//********************************************************************
 #include "exception.h"
 #include "largest.h"
 #include "nullptr.h"
+#include "static_assert.h"
+#include "type_traits.h"
 
 #undef ETL_FILE
 #define ETL_FILE "35"
@@ -248,6 +250,456 @@ namespace etl
     destination.receive(source, message);
   }
   
+#if ETL_CPP11_SUPPORTED && !ETL_MESSAGE_ROUTER_CPP03_CODE
+
+  //***************************************************************************
+  /// The largest span of message ids, (max - min + 1), that is dispatched
+  /// through a dense table. Routers with a wider span use a compare chain.
+  /// Define as 0 to always use the compare chain.
+  //***************************************************************************
+#if !defined(ETL_MESSAGE_ROUTER_MAX_TABLE_SIZE)
+  #define ETL_MESSAGE_ROUTER_MAX_TABLE_SIZE 256
+#endif
+
+  namespace private_message_router
+  {
+    //*************************************************************************
+    /// A list of table indexes.
+    //*************************************************************************
+    template <size_t... INDEXES>
+    struct index_sequence
+    {
+    };
+
+    template <size_t N, size_t... INDEXES>
+    struct make_index_sequence : make_index_sequence<N - 1, N - 1, INDEXES...>
+    {
+    };
+
+    template <size_t... INDEXES>
+    struct make_index_sequence<0, INDEXES...>
+    {
+      typedef index_sequence<INDEXES...> type;
+    };
+
+    //*************************************************************************
+    /// The smallest and largest message id, size and alignment.
+    //*************************************************************************
+    template <typename T1, typename... TRest>
+    struct message_traits
+    {
+    private:
+
+      typedef message_traits<TRest...> rest;
+
+    public:
+
+      static const size_t MIN_ID    = (size_t(T1::ID) < rest::MIN_ID) ? size_t(T1::ID) : rest::MIN_ID;
+      static const size_t MAX_ID    = (size_t(T1::ID) > rest::MAX_ID) ? size_t(T1::ID) : rest::MAX_ID;
+      static const size_t SIZE      = (sizeof(T1) > rest::SIZE) ? sizeof(T1) : rest::SIZE;
+      static const size_t ALIGNMENT = (etl::alignment_of<T1>::value > rest::ALIGNMENT) ? etl::alignment_of<T1>::value : rest::ALIGNMENT;
+    };
+
+    template <typename T1>
+    struct message_traits<T1>
+    {
+      static const size_t MIN_ID    = size_t(T1::ID);
+      static const size_t MAX_ID    = size_t(T1::ID);
+      static const size_t SIZE      = sizeof(T1);
+      static const size_t ALIGNMENT = etl::alignment_of<T1>::value;
+    };
+
+    //*************************************************************************
+    /// The position of T in the list, or the size of the list if not found.
+    //*************************************************************************
+    template <typename T, typename... TTypes>
+    struct index_of;
+
+    template <typename T, typename T1, typename... TRest>
+    struct index_of<T, T1, TRest...>
+    {
+      static const size_t value = etl::is_same<T, T1>::value ? 0 : 1 + index_of<T, TRest...>::value;
+    };
+
+    template <typename T>
+    struct index_of<T>
+    {
+      static const size_t value = 0;
+    };
+
+    //*************************************************************************
+    /// Checks that no two message types share an id.
+    //*************************************************************************
+    template <typename... TTypes>
+    struct has_unique_ids;
+
+    template <size_t ID, typename... TTypes>
+    struct id_not_in;
+
+    template <size_t ID, typename T1, typename... TRest>
+    struct id_not_in<ID, T1, TRest...>
+    {
+      static const bool value = (ID != size_t(T1::ID)) && id_not_in<ID, TRest...>::value;
+    };
+
+    template <size_t ID>
+    struct id_not_in<ID>
+    {
+      static const bool value = true;
+    };
+
+    template <typename T1, typename... TRest>
+    struct has_unique_ids<T1, TRest...>
+    {
+      static const bool value = id_not_in<size_t(T1::ID), TRest...>::value && has_unique_ids<TRest...>::value;
+    };
+
+    template <>
+    struct has_unique_ids<>
+    {
+      static const bool value = true;
+    };
+
+    //*************************************************************************
+    /// Selects the entry for the message type with the id 'ID'.
+    /// TEntry<T, INDEX>::value() is the entry for the type T at position INDEX.
+    //*************************************************************************
+    template <size_t ID, size_t INDEX, typename TEntryType, template <typename, size_t> class TEntry, typename... TTypes>
+    struct select_entry;
+
+    template <size_t ID, size_t INDEX, typename TEntryType, template <typename, size_t> class TEntry, typename T1, typename... TRest>
+    struct select_entry<ID, INDEX, TEntryType, TEntry, T1, TRest...>
+    {
+      static ETL_CONSTEXPR TEntryType value()
+      {
+        return (size_t(T1::ID) == ID) ? TEntry<T1, INDEX>::value() : select_entry<ID, INDEX + 1, TEntryType, TEntry, TRest...>::value();
+      }
+    };
+
+    template <size_t ID, size_t INDEX, typename TEntryType, template <typename, size_t> class TEntry>
+    struct select_entry<ID, INDEX, TEntryType, TEntry>
+    {
+      static ETL_CONSTEXPR TEntryType value()
+      {
+        return nullptr;
+      }
+    };
+
+    //*************************************************************************
+    /// Finds the entry for a message id at run time by comparing each id in turn.
+    //*************************************************************************
+    template <size_t INDEX, typename TEntryType, template <typename, size_t> class TEntry, typename... TTypes>
+    struct search_entry;
+
+    template <size_t INDEX, typename TEntryType, template <typename, size_t> class TEntry, typename T1, typename... TRest>
+    struct search_entry<INDEX, TEntryType, TEntry, T1, TRest...>
+    {
+      static TEntryType find(size_t id)
+      {
+        return (id == size_t(T1::ID)) ? TEntry<T1, INDEX>::value() : search_entry<INDEX + 1, TEntryType, TEntry, TRest...>::find(id);
+      }
+    };
+
+    template <size_t INDEX, typename TEntryType, template <typename, size_t> class TEntry>
+    struct search_entry<INDEX, TEntryType, TEntry>
+    {
+      static TEntryType find(size_t)
+      {
+        return nullptr;
+      }
+    };
+
+    //*************************************************************************
+    /// A dense table of entries, indexed by (id - MIN_ID).
+    //*************************************************************************
+    template <typename TSequence, size_t MIN_ID, typename TEntryType, template <typename, size_t> class TEntry, typename... TTypes>
+    struct dense_table;
+
+    template <size_t... INDEXES, size_t MIN_ID, typename TEntryType, template <typename, size_t> class TEntry, typename... TTypes>
+    struct dense_table<index_sequence<INDEXES...>, MIN_ID, TEntryType, TEntry, TTypes...>
+    {
+      static ETL_CONSTEXPR TEntryType entries[sizeof...(INDEXES)] = { select_entry<MIN_ID + INDEXES, 0, TEntryType, TEntry, TTypes...>::value()... };
+    };
+
+    template <size_t... INDEXES, size_t MIN_ID, typename TEntryType, template <typename, size_t> class TEntry, typename... TTypes>
+    ETL_CONSTEXPR TEntryType dense_table<index_sequence<INDEXES...>, MIN_ID, TEntryType, TEntry, TTypes...>::entries[sizeof...(INDEXES)];
+
+    //*************************************************************************
+    /// Looks up the entry for a message id.
+    /// Returns nullptr if the id is not handled.
+    //*************************************************************************
+    template <bool USE_TABLE, typename TEntryType, template <typename, size_t> class TEntry, typename... TTypes>
+    struct lookup;
+
+    // Dense table.
+    template <typename TEntryType, template <typename, size_t> class TEntry, typename... TTypes>
+    struct lookup<true, TEntryType, TEntry, TTypes...>
+    {
+      static TEntryType find(size_t id)
+      {
+        typedef message_traits<TTypes...> traits;
+        typedef typename make_index_sequence<traits::MAX_ID - traits::MIN_ID + 1>::type sequence;
+        typedef dense_table<sequence, traits::MIN_ID, TEntryType, TEntry, TTypes...> table;
+
+        const size_t index = id - traits::MIN_ID;
+
+        return (index <= (traits::MAX_ID - traits::MIN_ID)) ? table::entries[index] : nullptr;
+      }
+    };
+
+    // Compare chain.
+    template <typename TEntryType, template <typename, size_t> class TEntry, typename... TTypes>
+    struct lookup<false, TEntryType, TEntry, TTypes...>
+    {
+      static TEntryType find(size_t id)
+      {
+        return search_entry<0, TEntryType, TEntry, TTypes...>::find(id);
+      }
+    };
+
+    //*************************************************************************
+    /// Selects the lookup method for the message types.
+    //*************************************************************************
+    template <typename TEntryType, template <typename, size_t> class TEntry, typename... TTypes>
+    struct dispatcher
+      : lookup<((message_traits<TTypes...>::MAX_ID - message_traits<TTypes...>::MIN_ID) < size_t(ETL_MESSAGE_ROUTER_MAX_TABLE_SIZE)), TEntryType, TEntry, TTypes...>
+    {
+    };
+  }
+
+  //***************************************************************************
+  /// The message router for any number of message types.
+  /// Messages are dispatched through a table built at compile time, indexed
+  /// by message id.
+  /// Define ETL_MESSAGE_ROUTER_RECEIVE_COUNTERS to count the messages
+  /// received of each type.
+  //***************************************************************************
+  template <typename TDerived, typename... TMessageTypes>
+  class message_router : public imessage_router
+  {
+  private:
+
+    ETL_STATIC_ASSERT(sizeof...(TMessageTypes) != 0, "No message types");
+    ETL_STATIC_ASSERT(private_message_router::has_unique_ids<TMessageTypes...>::value, "Message ids must be unique");
+
+  public:
+
+    //**********************************************
+    class message_packet
+    {
+    public:
+
+      //********************************************
+      explicit message_packet(const etl::imessage& msg)
+      {
+        copy_function_t copy_function = private_message_router::dispatcher<copy_function_t, copy_entry, TMessageTypes...>::find(msg.message_id);
+
+        if (copy_function != nullptr)
+        {
+          copy_function(data, msg);
+        }
+        else
+        {
+          ETL_ASSERT(false, ETL_ERROR(unhandled_message_exception));
+        }
+      }
+
+      //********************************************
+      template <typename T>
+      explicit message_packet(const T& msg)
+      {
+        ETL_STATIC_ASSERT((private_message_router::index_of<T, TMessageTypes...>::value < sizeof...(TMessageTypes)), "Unsupported type for this message packet");
+
+        void* p = data;
+        ::new (p) T(static_cast<const T&>(msg));
+      }
+
+      //********************************************
+      ~message_packet()
+      {
+        etl::imessage* pmsg = static_cast<etl::imessage*>(static_cast<void*>(data));
+
+  #if defined(ETL_MESSAGES_ARE_VIRTUAL) || defined(ETL_POLYMORPHIC_MESSAGES)
+        pmsg->~imessage();
+  #else
+        destroy_function_t destroy_function = private_message_router::dispatcher<destroy_function_t, destroy_entry, TMessageTypes...>::find(pmsg->message_id);
+
+        assert(destroy_function != nullptr);
+        destroy_function(pmsg);
+  #endif
+      }
+
+      //********************************************
+      etl::imessage& get()
+      {
+        return *static_cast<etl::imessage*>(static_cast<void*>(data));
+      }
+
+      //********************************************
+      const etl::imessage& get() const
+      {
+        return *static_cast<const etl::imessage*>(static_cast<const void*>(data));
+      }
+
+      enum
+      {
+        SIZE      = private_message_router::message_traits<TMessageTypes...>::SIZE,
+        ALIGNMENT = private_message_router::message_traits<TMessageTypes...>::ALIGNMENT
+      };
+
+    private:
+
+      typedef void (*copy_function_t)(void*, const etl::imessage&);
+      typedef void (*destroy_function_t)(etl::imessage*);
+
+      //********************************************
+      template <typename T, size_t INDEX>
+      static void copy_message(void* p, const etl::imessage& msg)
+      {
+        ::new (p) T(static_cast<const T&>(msg));
+      }
+
+      //********************************************
+      template <typename T, size_t INDEX>
+      struct copy_entry
+      {
+        static ETL_CONSTEXPR copy_function_t value()
+        {
+          return &message_packet::template copy_message<T, INDEX>;
+        }
+      };
+
+      //********************************************
+      template <typename T, size_t INDEX>
+      static void destroy_message(etl::imessage* pmsg)
+      {
+        static_cast<T*>(pmsg)->~T();
+      }
+
+      //********************************************
+      template <typename T, size_t INDEX>
+      struct destroy_entry
+      {
+        static ETL_CONSTEXPR destroy_function_t value()
+        {
+          return &message_packet::template destroy_message<T, INDEX>;
+        }
+      };
+
+      typename etl::aligned_storage<SIZE, ALIGNMENT>::type data;
+    };
+
+    //**********************************************
+    message_router(etl::message_router_id_t id_)
+      : imessage_router(id_)
+    {
+      ETL_ASSERT(id_ <= etl::imessage_router::MAX_MESSAGE_ROUTER, ETL_ERROR(etl::message_router_illegal_id));
+#if defined(ETL_MESSAGE_ROUTER_RECEIVE_COUNTERS)
+      reset_receive_counts();
+#endif
+    }
+
+    //**********************************************
+    message_router(etl::message_router_id_t id_, etl::imessage_router& successor_)
+      : imessage_router(id_, successor_)
+    {
+      ETL_ASSERT(id_ <= etl::imessage_router::MAX_MESSAGE_ROUTER, ETL_ERROR(etl::message_router_illegal_id));
+#if defined(ETL_MESSAGE_ROUTER_RECEIVE_COUNTERS)
+      reset_receive_counts();
+#endif
+    }
+
+    //**********************************************
+    void receive(const etl::imessage& msg)
+    {
+      receive(etl::null_message_router::instance(), msg);
+    }
+
+    //**********************************************
+    void receive(etl::imessage_router& source, const etl::imessage& msg)
+    {
+      receive_function_t receive_function = private_message_router::dispatcher<receive_function_t, receive_entry, TMessageTypes...>::find(msg.message_id);
+
+      if (receive_function != nullptr)
+      {
+        receive_function(*this, source, msg);
+      }
+      else
+      {
+        if (has_successor())
+        {
+          get_successor().receive(source, msg);
+        }
+        else
+        {
+          static_cast<TDerived*>(this)->on_receive_unknown(source, msg);
+        }
+      }
+    }
+
+    using imessage_router::accepts;
+
+    //**********************************************
+    bool accepts(etl::message_id_t id) const
+    {
+      return private_message_router::dispatcher<receive_function_t, receive_entry, TMessageTypes...>::find(id) != nullptr;
+    }
+
+#if defined(ETL_MESSAGE_ROUTER_RECEIVE_COUNTERS)
+    //**********************************************
+    /// The number of messages of type T received.
+    //**********************************************
+    template <typename T>
+    uint32_t get_receive_count() const
+    {
+      ETL_STATIC_ASSERT((private_message_router::index_of<T, TMessageTypes...>::value < sizeof...(TMessageTypes)), "Unsupported type for this message router");
+
+      return receive_counts[private_message_router::index_of<T, TMessageTypes...>::value];
+    }
+
+    //**********************************************
+    /// Sets all of the receive counts to zero.
+    //**********************************************
+    void reset_receive_counts()
+    {
+      for (size_t i = 0; i < sizeof...(TMessageTypes); ++i)
+      {
+        receive_counts[i] = 0;
+      }
+    }
+#endif
+
+  private:
+
+    typedef void (*receive_function_t)(message_router&, etl::imessage_router&, const etl::imessage&);
+
+    //**********************************************
+    template <typename T, size_t INDEX>
+    static void receive_message(message_router& router, etl::imessage_router& source, const etl::imessage& msg)
+    {
+#if defined(ETL_MESSAGE_ROUTER_RECEIVE_COUNTERS)
+      ++router.receive_counts[INDEX];
+#endif
+      static_cast<TDerived&>(router).on_receive(source, static_cast<const T&>(msg));
+    }
+
+    //**********************************************
+    template <typename T, size_t INDEX>
+    struct receive_entry
+    {
+      static ETL_CONSTEXPR receive_function_t value()
+      {
+        return &message_router::template receive_message<T, INDEX>;
+      }
+    };
+
+#if defined(ETL_MESSAGE_ROUTER_RECEIVE_COUNTERS)
+    uint32_t receive_counts[sizeof...(TMessageTypes)];
+#endif
+  };
+
+#else
+
   /*[[[cog
       import cog
       ################################################
@@ -607,6 +1059,8 @@ namespace etl
           cog.outl("};")
   ]]]*/
   /*[[[end]]]*/
+
+#endif
 }
 
 #undef ETL_FILE
@@ -0,0 +1,500 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2017 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_MESSAGE_TIMER_WHEEL_INCLUDED
+#define ETL_MESSAGE_TIMER_WHEEL_INCLUDED
+
+#include <stdint.h>
+#include <new>
+
+#include "platform.h"
+#include "nullptr.h"
+#include "message_types.h"
+#include "message.h"
+#include "message_router.h"
+#include "message_bus.h"
+#include "static_assert.h"
+#include "integral_limits.h"
+#include "timer.h"
+#include "atomic.h"
+
+#define ETL_IN_MESSAGE_TIMER_WHEEL_H
+#include "private/timer_wheel.h"
+#undef ETL_IN_MESSAGE_TIMER_WHEEL_H
+
+#undef ETL_FILE
+#define ETL_FILE "55"
+
+//*****************************************************************************
+// A message timer with the same interface as etl::message_timer that keeps
+// the active timers in a hierarchical timing wheel.
+// Starting and stopping a timer is O(1), regardless of the number of timers.
+// The timer id type may be 16 bit, for up to 65534 timers.
+// Uses the same lock configuration as etl::message_timer.
+//*****************************************************************************
+
+#if !defined(ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK) && !defined(ETL_MESSAGE_TIMER_USE_INTERRUPT_LOCK)
+  #error ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK or ETL_MESSAGE_TIMER_USE_INTERRUPT_LOCK not defined
+#endif
+
+#if defined(ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK) && defined(ETL_MESSAGE_TIMER_USE_INTERRUPT_LOCK)
+  #error Only define one of ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK or ETL_MESSAGE_TIMER_USE_INTERRUPT_LOCK
+#endif
+
+#if defined(ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK)
+  #define ETL_DISABLE_TIMER_UPDATES (++process_semaphore)
+  #define ETL_ENABLE_TIMER_UPDATES  (--process_semaphore)
+  #define ETL_TIMER_UPDATES_ENABLED (process_semaphore.load() == 0)
+#endif
+
+#if defined(ETL_MESSAGE_TIMER_USE_INTERRUPT_LOCK)
+  #if !defined(ETL_MESSAGE_TIMER_DISABLE_INTERRUPTS) || !defined(ETL_MESSAGE_TIMER_ENABLE_INTERRUPTS)
+    #error ETL_MESSAGE_TIMER_DISABLE_INTERRUPTS and/or ETL_MESSAGE_TIMER_ENABLE_INTERRUPTS not defined
+  #endif
+
+  #define ETL_DISABLE_TIMER_UPDATES (ETL_MESSAGE_TIMER_DISABLE_INTERRUPTS)
+  #define ETL_ENABLE_TIMER_UPDATES  (ETL_MESSAGE_TIMER_ENABLE_INTERRUPTS)
+  #define ETL_TIMER_UPDATES_ENABLED true
+#endif
+
+namespace etl
+{
+  //*************************************************************************
+  /// The configuration of a timer in a message_timer_wheel.
+  //*************************************************************************
+  template <typename TId>
+  struct message_timer_wheel_data
+  {
+    //*******************************************
+    message_timer_wheel_data()
+      : p_message(nullptr),
+        p_router(nullptr),
+        period(0),
+        expiry(0),
+        destination_router_id(etl::imessage_bus::ALL_MESSAGE_ROUTERS),
+        id(etl::integral_limits<TId>::max),
+        previous(etl::integral_limits<TId>::max),
+        next(etl::integral_limits<TId>::max),
+        slot(etl::private_timer_wheel::NO_SLOT),
+        repeating(true)
+    {
+    }
+
+    //*******************************************
+    message_timer_wheel_data(TId                      id_,
+                             const etl::imessage&     message_,
+                             etl::imessage_router&    irouter_,
+                             uint32_t                 period_,
+                             bool                     repeating_,
+                             etl::message_router_id_t destination_router_id_)
+      : p_message(&message_),
+        p_router(&irouter_),
+        period(period_),
+        expiry(0),
+        id(id_),
+        previous(etl::integral_limits<TId>::max),
+        next(etl::integral_limits<TId>::max),
+        slot(etl::private_timer_wheel::NO_SLOT),
+        repeating(repeating_)
+    {
+      if (irouter_.is_bus())
+      {
+        destination_router_id = destination_router_id_;
+      }
+      else
+      {
+        destination_router_id = etl::imessage_bus::ALL_MESSAGE_ROUTERS;
+      }
+    }
+
+    //*******************************************
+    /// Returns true if the timer is active.
+    //*******************************************
+    bool is_active() const
+    {
+      return slot != etl::private_timer_wheel::NO_SLOT;
+    }
+
+    const etl::imessage*     p_message;
+    etl::imessage_router*    p_router;
+    uint32_t                 period;
+    uint32_t                 expiry;
+    etl::message_router_id_t destination_router_id;
+    TId                      id;
+    TId                      previous;
+    TId                      next;
+    uint_least16_t           slot;
+    bool                     repeating;
+
+  private:
+
+    // Disabled.
+    message_timer_wheel_data(const message_timer_wheel_data& other);
+    message_timer_wheel_data& operator =(const message_timer_wheel_data& other);
+  };
+
+  //***************************************************************************
+  /// Interface for message timer wheel
+  /// \tparam TId The type of the timer id. The maximum value is reserved for NO_TIMER.
+  //***************************************************************************
+  template <typename TId = etl::timer::id::type>
+  class imessage_timer_wheel
+  {
+  public:
+
+    typedef TId                                 id_type;
+    typedef etl::message_timer_wheel_data<TId> timer_data_t;
+
+    enum
+    {
+      NO_TIMER = etl::integral_limits<TId>::max
+    };
+
+    //*******************************************
+    /// Register a timer.
+    //*******************************************
+    TId register_timer(const etl::imessage&     message_,
+                       etl::imessage_router&    router_,
+                       uint32_t                 period_,
+                       bool                     repeating_,
+                       etl::message_router_id_t destination_router_id_ = etl::imessage_router::ALL_MESSAGE_ROUTERS)
+    {
+      TId id = TId(NO_TIMER);
+
+      // There's no point adding null message routers.
+      if (!router_.is_null_router())
+      {
+        id = free_head;
+
+        if (id != TId(NO_TIMER))
+        {
+          free_head = timer_array[id].next;
+
+          // Create in-place.
+          new (&timer_array[id]) timer_data_t(id, message_, router_, period_, repeating_, destination_router_id_);
+          ++registered_timers;
+        }
+      }
+
+      return id;
+    }
+
+    //*******************************************
+    /// Unregister a timer.
+    //*******************************************
+    bool unregister_timer(TId id_)
+    {
+      bool result = false;
+
+      if (id_ < MAX_TIMERS)
+      {
+        timer_data_t& timer = timer_array[id_];
+
+        if (timer.id != TId(NO_TIMER))
+        {
+          if (timer.is_active())
+          {
+            ETL_DISABLE_TIMER_UPDATES;
+            active_wheel.remove(timer.id);
+            ETL_ENABLE_TIMER_UPDATES;
+          }
+
+          // Reset in-place.
+          new (&timer) timer_data_t();
+          timer.next = free_head;
+          free_head  = id_;
+          --registered_timers;
+
+          result = true;
+        }
+      }
+
+      return result;
+    }
+
+    //*******************************************
+    /// Enable/disable the timer.
+    //*******************************************
+    void enable(bool state_)
+    {
+      enabled = state_;
+    }
+
+    //*******************************************
+    /// Get the enable/disable state.
+    //*******************************************
+    bool is_running() const
+    {
+      return enabled;
+    }
+
+    //*******************************************
+    /// Clears the timer of data.
+    //*******************************************
+    void clear()
+    {
+      ETL_DISABLE_TIMER_UPDATES;
+      active_wheel.clear();
+      ETL_ENABLE_TIMER_UPDATES;
+
+      initialise_free_list();
+
+      registered_timers = 0;
+    }
+
+    //*******************************************
+    // Called by the timer service to indicate the
+    // amount of time that has elapsed since the last successful call to 'tick'.
+    // Returns true if the tick was processed,
+    // false if not.
+    //*******************************************
+    bool tick(uint32_t count)
+    {
+      if (enabled)
+      {
+        if (ETL_TIMER_UPDATES_ENABLED)
+        {
+          TId id;
+
+          while ((id = active_wheel.pop_expired(count)) != TId(NO_TIMER))
+          {
+            timer_data_t& timer = timer_array[id];
+
+            if (timer.repeating)
+            {
+              // Reinsert the timer.
+              active_wheel.insert(timer.id, timer.period);
+            }
+
+            if (timer.p_router != nullptr)
+            {
+              if (timer.p_router->is_bus())
+              {
+                // Send to a message bus.
+                etl::imessage_bus& bus = static_cast<etl::imessage_bus&>(*(timer.p_router));
+                bus.receive(timer.destination_router_id, *(timer.p_message));
+              }
+              else
+              {
+                // Send to a router.
+                timer.p_router->receive(*(timer.p_message));
+              }
+            }
+          }
+
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    //*******************************************
+    /// Starts a timer.
+    //*******************************************
+    bool start(TId id_, bool immediate_ = false)
+    {
+      bool result = false;
+
+      // Valid timer id?
+      if (id_ < MAX_TIMERS)
+      {
+        timer_data_t& timer = timer_array[id_];
+
+        // Registered timer?
+        if (timer.id != TId(NO_TIMER))
+        {
+          // Has a valid period.
+          if (timer.period != etl::timer::state::INACTIVE)
+          {
+            ETL_DISABLE_TIMER_UPDATES;
+            if (timer.is_active())
+            {
+              active_wheel.remove(timer.id);
+            }
+
+            active_wheel.insert(timer.id, immediate_ ? 0 : timer.period);
+            ETL_ENABLE_TIMER_UPDATES;
+
+            result = true;
+          }
+        }
+      }
+
+      return result;
+    }
+
+    //*******************************************
+    /// Stops a timer.
+    //*******************************************
+    bool stop(TId id_)
+    {
+      bool result = false;
+
+      // Valid timer id?
+      if (id_ < MAX_TIMERS)
+      {
+        timer_data_t& timer = timer_array[id_];
+
+        // Registered timer?
+        if (timer.id != TId(NO_TIMER))
+        {
+          if (timer.is_active())
+          {
+            ETL_DISABLE_TIMER_UPDATES;
+            active_wheel.remove(timer.id);
+            ETL_ENABLE_TIMER_UPDATES;
+          }
+
+          result = true;
+        }
+      }
+
+      return result;
+    }
+
+    //*******************************************
+    /// Sets a timer's period.
+    //*******************************************
+    bool set_period(TId id_, uint32_t period_)
+    {
+      if (stop(id_))
+      {
+        timer_array[id_].period = period_;
+        return true;
+      }
+
+      return false;
+    }
+
+    //*******************************************
+    /// Sets a timer's mode.
+    //*******************************************
+    bool set_mode(TId id_, bool repeating_)
+    {
+      if (stop(id_))
+      {
+        timer_array[id_].repeating = repeating_;
+        return true;
+      }
+
+      return false;
+    }
+
+  protected:
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    imessage_timer_wheel(timer_data_t* const timer_array_, const TId MAX_TIMERS_)
+      : timer_array(timer_array_),
+        active_wheel(timer_array_),
+        free_head(TId(NO_TIMER)),
+        enabled(false),
+#if defined(ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK)
+        process_semaphore(0),
+#endif
+        registered_timers(0),
+        MAX_TIMERS(MAX_TIMERS_)
+    {
+    }
+
+  private:
+
+    //*******************************************
+    /// Resets every timer and links them into the free list, lowest id first.
+    //*******************************************
+    void initialise_free_list()
+    {
+      free_head = TId(NO_TIMER);
+
+      for (size_t i = MAX_TIMERS; i != 0; --i)
+      {
+        timer_data_t& timer = timer_array[i - 1];
+
+        new (&timer) timer_data_t();
+        timer.next = free_head;
+        free_head  = TId(i - 1);
+      }
+    }
+
+    // The array of timer data structures.
+    timer_data_t* const timer_array;
+
+    // The wheel of active timers.
+    etl::private_timer_wheel::wheel<timer_data_t, TId> active_wheel;
+
+    // The first unregistered timer.
+    TId free_head;
+
+    volatile bool enabled;
+#if defined(ETL_MESSAGE_TIMER_USE_ATOMIC_LOCK)
+    volatile etl::timer_semaphore_t process_semaphore;
+#endif
+    volatile TId registered_timers;
+
+  public:
+
+    const TId MAX_TIMERS;
+  };
+
+  //***************************************************************************
+  /// The message timer wheel
+  /// \tparam MAX_TIMERS_ The maximum number of timers.
+  /// \tparam TId         The type of the timer id. Use uint_least16_t for more than 254 timers.
+  //***************************************************************************
+  template <const size_t MAX_TIMERS_, typename TId = etl::timer::id::type>
+  class message_timer_wheel : public etl::imessage_timer_wheel<TId>
+  {
+  public:
+
+    ETL_STATIC_ASSERT(MAX_TIMERS_ < etl::integral_limits<TId>::max, "Too many timers for the id type");
+
+    //*******************************************
+    /// Constructor.
+    //*******************************************
+    message_timer_wheel()
+      : imessage_timer_wheel<TId>(timer_array, TId(MAX_TIMERS_))
+    {
+      // The timer array is constructed after the base, so the free list is built here.
+      this->clear();
+    }
+
+  private:
+
+    etl::message_timer_wheel_data<TId> timer_array[MAX_TIMERS_];
+  };
+}
+
+#undef ETL_DISABLE_TIMER_UPDATES
+#undef ETL_ENABLE_TIMER_UPDATES
+#undef ETL_TIMER_UPDATES_ENABLED
+
+#undef ETL_FILE
+
+#endif
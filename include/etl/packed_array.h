@@ -0,0 +1,495 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_PACKED_ARRAY_INCLUDED
+#define ETL_PACKED_ARRAY_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+
+#include "platform.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "smallest.h"
+#include "static_assert.h"
+
+#undef ETL_FILE
+#define ETL_FILE "61"
+
+//*****************************************************************************
+///\defgroup packed_array packed_array
+/// A fixed size array of unsigned integers of a fixed number of bits each.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// The base class for packed_array exceptions.
+  ///\ingroup packed_array
+  //***************************************************************************
+  class packed_array_exception : public etl::exception
+  {
+  public:
+
+    packed_array_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The out of range exception.
+  ///\ingroup packed_array
+  //***************************************************************************
+  class packed_array_out_of_range : public etl::packed_array_exception
+  {
+  public:
+
+    explicit packed_array_out_of_range(string_type file_name_, numeric_type line_number_)
+      : packed_array_exception(ETL_ERROR_TEXT("packed_array:range", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// An array of SIZE unsigned values of BITS bits each.
+  /// The values are packed into 64 bit words, as many to a word as will fit,
+  /// least significant first. A value never spans two words, so each is found
+  /// with one load, a shift and a mask, and a whole word of values is read or
+  /// written at once by get_range and set_range.
+  /// Values are masked to BITS bits when stored.
+  ///\tparam BITS The number of bits for each value, 1 to 64.
+  ///\tparam SIZE The number of values.
+  ///\ingroup packed_array
+  //***************************************************************************
+  template <const size_t BITS, const size_t SIZE>
+  class packed_array
+  {
+  public:
+
+    typedef typename etl::smallest_uint_for_bits<BITS>::type value_type;
+    typedef uint64_t                                        word_type;
+    typedef size_t                                          size_type;
+
+    static const size_t WORD_BITS       = CHAR_BIT * sizeof(word_type);
+    static const size_t FIELDS_PER_WORD = WORD_BITS / ((BITS == 0) ? 1 : BITS);
+    static const size_t WORDS           = (SIZE + FIELDS_PER_WORD - 1) / FIELDS_PER_WORD;
+
+    static const value_type MAX_VALUE = value_type(word_type(~word_type(0)) >> ((WORD_BITS - BITS) % WORD_BITS));
+
+    ETL_STATIC_ASSERT((BITS > 0) && (BITS <= 64), "BITS must be from 1 to 64");
+
+    //*************************************************************************
+    /// A proxy for one value.
+    //*************************************************************************
+    class field_reference
+    {
+    public:
+
+      friend class packed_array;
+
+      //*******************************
+      /// Conversion operator.
+      //*******************************
+      operator value_type() const
+      {
+        return p_array->get(position);
+      }
+
+      //*******************************
+      /// Assignment operator.
+      //*******************************
+      field_reference& operator = (value_type value)
+      {
+        p_array->set(position, value);
+        return *this;
+      }
+
+      //*******************************
+      /// Assignment operator.
+      //*******************************
+      field_reference& operator = (const field_reference& r)
+      {
+        p_array->set(position, value_type(r));
+        return *this;
+      }
+
+    private:
+
+      //*******************************
+      /// Constructor.
+      //*******************************
+      field_reference(packed_array& array_, size_t position_)
+        : p_array(&array_),
+          position(position_)
+      {
+      }
+
+      packed_array* p_array;  ///< The array.
+      size_t        position; ///< The position in the array.
+    };
+
+    typedef field_reference reference;
+    typedef value_type      const_reference;
+
+    //*************************************************************************
+    /// Constructor. All values are zero.
+    //*************************************************************************
+    packed_array()
+    {
+      reset();
+    }
+
+    //*************************************************************************
+    /// Constructor. All values are 'value'.
+    //*************************************************************************
+    explicit packed_array(value_type value)
+    {
+      fill(value);
+    }
+
+    //*************************************************************************
+    /// Returns the value at 'position'.
+    //*************************************************************************
+    value_type get(size_t position) const
+    {
+      const size_t shift = (position % FIELDS_PER_WORD) * BITS;
+
+      return value_type((buffer[position / FIELDS_PER_WORD] >> shift) & MASK);
+    }
+
+    //*************************************************************************
+    /// Sets the value at 'position'.
+    //*************************************************************************
+    void set(size_t position, value_type value)
+    {
+      const size_t shift = (position % FIELDS_PER_WORD) * BITS;
+      word_type&   word  = buffer[position / FIELDS_PER_WORD];
+
+      word = (word & ~word_type(MASK << shift)) | word_type((word_type(value) & MASK) << shift);
+    }
+
+    //*************************************************************************
+    /// Index operator.
+    //*************************************************************************
+    field_reference operator [](size_t position)
+    {
+      return field_reference(*this, position);
+    }
+
+    //*************************************************************************
+    /// Index operator.
+    //*************************************************************************
+    value_type operator [](size_t position) const
+    {
+      return get(position);
+    }
+
+    //*************************************************************************
+    /// Returns a reference to the value at 'position'.
+    /// Emits an etl::packed_array_out_of_range if the position is out of range.
+    //*************************************************************************
+    field_reference at(size_t position)
+    {
+      ETL_ASSERT(position < SIZE, ETL_ERROR(packed_array_out_of_range));
+
+      return field_reference(*this, position);
+    }
+
+    //*************************************************************************
+    /// Returns the value at 'position'.
+    /// Emits an etl::packed_array_out_of_range if the position is out of range.
+    //*************************************************************************
+    value_type at(size_t position) const
+    {
+      ETL_ASSERT(position < SIZE, ETL_ERROR(packed_array_out_of_range));
+
+      return get(position);
+    }
+
+    //*************************************************************************
+    /// Copies 'count' values, from 'position', to 'out'.
+    /// Each whole word of values is loaded once and unpacked in a loop of
+    /// constant length.
+    ///\return The output iterator after the last value.
+    //*************************************************************************
+    template <typename TOutputIterator>
+    TOutputIterator get_range(size_t position, TOutputIterator out, size_t count) const
+    {
+      const word_type* p_word = buffer + (position / FIELDS_PER_WORD);
+      size_t           field  = position % FIELDS_PER_WORD;
+
+      // The rest of the first word.
+      if ((field != 0U) && (count != 0U))
+      {
+        word_type word = *p_word++ >> (field * BITS);
+
+        while ((field < FIELDS_PER_WORD) && (count != 0U))
+        {
+          *out = value_type(word & MASK);
+          ++out;
+          word = next(word);
+          ++field;
+          --count;
+        }
+      }
+
+      // Whole words.
+      while (count >= FIELDS_PER_WORD)
+      {
+        const word_type word = *p_word++;
+
+        for (size_t i = 0U; i < FIELDS_PER_WORD; ++i)
+        {
+          *out = value_type((word >> (i * BITS)) & MASK);
+          ++out;
+        }
+
+        count -= FIELDS_PER_WORD;
+      }
+
+      // The start of the last word.
+      if (count != 0U)
+      {
+        word_type word = *p_word;
+
+        while (count != 0U)
+        {
+          *out = value_type(word & MASK);
+          ++out;
+          word = next(word);
+          --count;
+        }
+      }
+
+      return out;
+    }
+
+    //*************************************************************************
+    /// Copies 'count' values from 'in', to 'position' onwards.
+    /// Each whole word of values is packed in a loop of constant length and
+    /// stored once.
+    ///\return The input iterator after the last value.
+    //*************************************************************************
+    template <typename TInputIterator>
+    TInputIterator set_range(size_t position, TInputIterator in, size_t count)
+    {
+      // The rest of the first word.
+      while (((position % FIELDS_PER_WORD) != 0U) && (count != 0U))
+      {
+        set(position, value_type(*in));
+        ++in;
+        ++position;
+        --count;
+      }
+
+      word_type* p_word = buffer + (position / FIELDS_PER_WORD);
+
+      // Whole words.
+      while (count >= FIELDS_PER_WORD)
+      {
+        word_type word = 0U;
+
+        for (size_t i = 0U; i < FIELDS_PER_WORD; ++i)
+        {
+          word |= word_type((word_type(*in) & MASK) << (i * BITS));
+          ++in;
+        }
+
+        *p_word++ = word;
+        count -= FIELDS_PER_WORD;
+        position += FIELDS_PER_WORD;
+      }
+
+      // The start of the last word.
+      while (count != 0U)
+      {
+        set(position, value_type(*in));
+        ++in;
+        ++position;
+        --count;
+      }
+
+      return in;
+    }
+
+    //*************************************************************************
+    /// Sets every value to 'value'.
+    //*************************************************************************
+    void fill(value_type value)
+    {
+      word_type word = 0U;
+
+      for (size_t i = 0U; i < FIELDS_PER_WORD; ++i)
+      {
+        word |= word_type((word_type(value) & MASK) << (i * BITS));
+      }
+
+      for (size_t i = 0U; i < WORDS; ++i)
+      {
+        buffer[i] = word;
+      }
+
+      clear_unused();
+    }
+
+    //*************************************************************************
+    /// Sets every value to zero.
+    //*************************************************************************
+    void reset()
+    {
+      for (size_t i = 0U; i < WORDS; ++i)
+      {
+        buffer[i] = 0U;
+      }
+    }
+
+    //*************************************************************************
+    /// The number of values.
+    //*************************************************************************
+    size_t size() const
+    {
+      return SIZE;
+    }
+
+    //*************************************************************************
+    /// The number of values.
+    //*************************************************************************
+    size_t max_size() const
+    {
+      return SIZE;
+    }
+
+    //*************************************************************************
+    /// Returns <b>true</b> if the size is zero.
+    //*************************************************************************
+    bool empty() const
+    {
+      return SIZE == 0U;
+    }
+
+    //*************************************************************************
+    /// Returns a pointer to the words.
+    //*************************************************************************
+    word_type* data()
+    {
+      return buffer;
+    }
+
+    //*************************************************************************
+    /// Returns a const pointer to the words.
+    //*************************************************************************
+    const word_type* data() const
+    {
+      return buffer;
+    }
+
+    //*************************************************************************
+    /// Swaps with another packed_array.
+    //*************************************************************************
+    void swap(packed_array& other)
+    {
+      for (size_t i = 0U; i < WORDS; ++i)
+      {
+        word_type temp  = buffer[i];
+        buffer[i]       = other.buffer[i];
+        other.buffer[i] = temp;
+      }
+    }
+
+    //*************************************************************************
+    /// Equality operator.
+    //*************************************************************************
+    friend bool operator ==(const packed_array& lhs, const packed_array& rhs)
+    {
+      // The unused bits are always zero.
+      for (size_t i = 0U; i < WORDS; ++i)
+      {
+        if (lhs.buffer[i] != rhs.buffer[i])
+        {
+          return false;
+        }
+      }
+
+      return true;
+    }
+
+    //*************************************************************************
+    /// Inequality operator.
+    //*************************************************************************
+    friend bool operator !=(const packed_array& lhs, const packed_array& rhs)
+    {
+      return !(lhs == rhs);
+    }
+
+  private:
+
+    static const word_type MASK = word_type(~word_type(0)) >> ((WORD_BITS - BITS) % WORD_BITS);
+
+    //*************************************************************************
+    /// Shifts the next value down to the bottom of the word.
+    //*************************************************************************
+    static word_type next(word_type word)
+    {
+      return (BITS < WORD_BITS) ? word_type(word >> (BITS % WORD_BITS)) : word_type(0U);
+    }
+
+    //*************************************************************************
+    /// Clears the fields after the last value in the last word.
+    //*************************************************************************
+    void clear_unused()
+    {
+      const size_t used = SIZE % FIELDS_PER_WORD;
+
+      if ((WORDS != 0U) && (used != 0U))
+      {
+        buffer[WORDS - 1U] &= word_type(~word_type(0)) >> (WORD_BITS - (used * BITS));
+      }
+    }
+
+    word_type buffer[(WORDS == 0U) ? 1U : WORDS];
+  };
+
+  //***************************************************************************
+  /// Swaps two packed_arrays.
+  ///\ingroup packed_array
+  //***************************************************************************
+  template <const size_t BITS, const size_t SIZE>
+  void swap(etl::packed_array<BITS, SIZE>& lhs, etl::packed_array<BITS, SIZE>& rhs)
+  {
+    lhs.swap(rhs);
+  }
+}
+
+#undef ETL_FILE
+
+#endif
@@ -94,4 +94,20 @@ SOFTWARE.
   #define ETL_DELETE
 #endif
 
+// The size of a cache line, used to keep data written by different threads apart.
+// May be overridden in the profile.
+#if !defined(ETL_CACHE_LINE_SIZE)
+  #define ETL_CACHE_LINE_SIZE 64
+#endif
+
+// Hints that the memory at an address will be read soon.
+// May be overridden in the profile.
+#if !defined(ETL_PREFETCH)
+  #if defined(ETL_COMPILER_GCC) || defined(__clang__)
+    #define ETL_PREFETCH(address) __builtin_prefetch(address)
+  #else
+    #define ETL_PREFETCH(address) ((void)(address))
+  #endif
+#endif
+
 #endif
@@ -0,0 +1,995 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_POOL_CONCURRENT_INCLUDED
+#define ETL_POOL_CONCURRENT_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+
+#include "stl/algorithm.h"
+
+#include "alignment.h"
+#include "atomic.h"
+#include "error_handler.h"
+#include "nullptr.h"
+#include "pool.h"
+#include "static_assert.h"
+
+#undef ETL_FILE
+#define ETL_FILE "58"
+
+#define ETL_POOL_CONCURRENT_CPP03_CODE 0
+
+//*****************************************************************************
+// The free list head is a 64 bit word where a 64 bit atomic is lock free,
+// leaving 32 bits for the tag. Otherwise it is a uintptr_t, which on a 32 bit
+// target leaves only a 16 bit tag.
+// Define as 1 or 0 in the profile to choose.
+//*****************************************************************************
+#if !defined(ETL_POOL_CONCURRENT_64BIT_HEAD)
+  #if defined(__GCC_ATOMIC_LLONG_LOCK_FREE)
+    #if (__GCC_ATOMIC_LLONG_LOCK_FREE == 2)
+      #define ETL_POOL_CONCURRENT_64BIT_HEAD 1
+    #else
+      #define ETL_POOL_CONCURRENT_64BIT_HEAD 0
+    #endif
+  #elif defined(ETL_COMPILER_MICROSOFT) && (defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64))
+    #define ETL_POOL_CONCURRENT_64BIT_HEAD 1
+  #else
+    #define ETL_POOL_CONCURRENT_64BIT_HEAD 0
+  #endif
+#endif
+
+//*****************************************************************************
+///\defgroup pool_concurrent pool_concurrent
+/// A fixed capacity pool that may be shared between threads.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  template <const size_t MAGAZINE_SIZE>
+  class pool_magazine;
+
+  //***************************************************************************
+  ///\ingroup pool_concurrent
+  /// The base for all concurrent pools.
+  /// The free items are held in a lock free stack of item indexes.
+  /// The head of the stack is one atomic word holding the index of the top
+  /// item in the lower half and a tag in the upper half. The word is 64 bits
+  /// where that is lock free; see ETL_POOL_CONCURRENT_64BIT_HEAD. The tag is incremented by
+  /// every push and pop, so a thread that was pre-empted in the middle of an
+  /// operation cannot mistake a recycled top item for the one it read.
+  /// Items that have never been allocated are not on the stack; they are
+  /// claimed in order from the untouched end of the buffer.
+  /// The links are held apart from the items so that a thread walking the
+  /// stack never reads memory that another thread has just allocated.
+  /// Items may be allocated and released directly, or through a
+  /// pool_magazine that keeps a small per-thread cache.
+  /// Uses the pool exceptions from pool.h.
+  //***************************************************************************
+  class ipool_concurrent
+  {
+  public:
+
+    typedef size_t size_type;
+
+    //*************************************************************************
+    /// Allocate storage for an object from the pool.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename T>
+    T* allocate()
+    {
+      if (sizeof(T) > ITEM_SIZE)
+      {
+        ETL_ASSERT(false, ETL_ERROR(etl::pool_element_size));
+      }
+
+      return reinterpret_cast<T*>(allocate_item());
+    }
+
+#if !ETL_CPP11_SUPPORTED || ETL_POOL_CONCURRENT_CPP03_CODE || defined(ETL_STLPORT) || defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create default.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename T>
+    T* create()
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T();
+      }
+
+      return p;
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create with 1 parameter.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename T, typename T1>
+    T* create(const T1& value1)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2>
+    T* create(const T1& value1, const T2& value2)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3>
+    T* create(const T1& value1, const T2& value2, const T3& value3)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3, typename T4>
+    T* create(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3, value4);
+      }
+
+      return p;
+    }
+#else
+    //*************************************************************************
+    /// Emplace with variadic constructor parameters.
+    //*************************************************************************
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(std::forward<Args>(args)...);
+      }
+
+      return p;
+    }
+#endif
+
+    //*************************************************************************
+    /// Destroys the object.
+    /// Undefined behaviour if the pool does not contain a 'T'.
+    /// \param p_object A pointer to the object to be destroyed.
+    //*************************************************************************
+    template <typename T>
+    void destroy(const void* const p_object)
+    {
+      if (sizeof(T) > ITEM_SIZE)
+      {
+        ETL_ASSERT(false, ETL_ERROR(etl::pool_element_size));
+      }
+
+      reinterpret_cast<T*>((const_cast<void*>(p_object)))->~T();
+      release(p_object);
+    }
+
+    //*************************************************************************
+    /// Release an object in the pool.
+    /// If asserts or exceptions are enabled and the object does not belong to this
+    /// pool then an etl::pool_object_not_in_pool is thrown.
+    /// \param p_object A pointer to the object to be released.
+    //*************************************************************************
+    void release(const void* const p_object)
+    {
+      char* p_item = (char*)p_object;
+
+      ETL_ASSERT(is_item_in_pool(p_item), ETL_ERROR(pool_object_not_in_pool));
+
+      release_items(&p_item, 1);
+    }
+
+    //*************************************************************************
+    /// Release all objects in the pool.
+    /// Must not be called while any other thread is using the pool, or while
+    /// any pool_magazine still holds items from it.
+    //*************************************************************************
+    void release_all()
+    {
+      free_head.store(make_head(NONE, 0), etl::memory_order_relaxed);
+      items_initialised.store(0, etl::memory_order_relaxed);
+      items_allocated.store(0, etl::memory_order_release);
+    }
+
+    //*************************************************************************
+    /// Check to see if the object belongs to the pool.
+    /// \param p_object A pointer to the object to be checked.
+    /// \return <b>true<\b> if it does, otherwise <b>false</b>
+    //*************************************************************************
+    bool is_in_pool(const void* p_object) const
+    {
+      return is_item_in_pool((const char*)p_object);
+    }
+
+    //*************************************************************************
+    /// Returns the maximum number of items in the pool.
+    //*************************************************************************
+    size_t max_size() const
+    {
+      return MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// Returns the number of free items in the pool.
+    /// Items held in a pool_magazine are not free.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_t available() const
+    {
+      return MAX_SIZE - size();
+    }
+
+    //*************************************************************************
+    /// Returns the number of allocated items in the pool.
+    /// Items held in a pool_magazine are counted as allocated.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_t size() const
+    {
+      return items_allocated.load(etl::memory_order_relaxed);
+    }
+
+    //*************************************************************************
+    /// Checks to see if there are no allocated items in the pool.
+    /// Due to concurrency, this is a guess.
+    /// \return <b>true</b> if there are none allocated.
+    //*************************************************************************
+    bool empty() const
+    {
+      return size() == 0;
+    }
+
+    //*************************************************************************
+    /// Checks to see if there are no free items in the pool.
+    /// Due to concurrency, this is a guess.
+    /// \return <b>true</b> if there are none free.
+    //*************************************************************************
+    bool full() const
+    {
+      return size() == MAX_SIZE;
+    }
+
+  protected:
+
+    /// The head holds an index in the lower half and a tag in the upper half.
+#if ETL_POOL_CONCURRENT_64BIT_HEAD
+    typedef uint64_t head_t;
+#else
+    typedef uintptr_t head_t;
+#endif
+
+    /// With a 64 bit head the tag is 32 bits, and only wraps after 2^32
+    /// exchanges of the head.
+    /// With a 32 bit head the tag is 16 bits and wraps after 65536 exchanges.
+    /// A thread that is pre-empted in acquire_items() while that many pops and
+    /// pushes complete may then see a recycled head as unchanged (ABA), and
+    /// install a stale link.
+    static const size_t   INDEX_BITS = sizeof(head_t) * 4;
+    static const uint32_t NONE       = uint32_t((head_t(1) << INDEX_BITS) - 1); ///< The end of the free list.
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    ipool_concurrent(char* p_buffer_, etl::atomic<uint32_t>* p_links_, uint32_t item_size_, uint32_t max_size_)
+      : p_buffer(p_buffer_),
+        p_links(p_links_),
+        free_head(make_head(NONE, 0)),
+        items_initialised(0),
+        items_allocated(0),
+        ITEM_SIZE(item_size_),
+        MAX_SIZE(max_size_)
+    {
+    }
+
+  private:
+
+    template <const size_t MAGAZINE_SIZE>
+    friend class etl::pool_magazine;
+
+    //*************************************************************************
+    /// Allocate an item from the pool.
+    //*************************************************************************
+    char* allocate_item()
+    {
+      char* p_value = nullptr;
+
+      if (acquire_items(&p_value, 1) == 0)
+      {
+        ETL_ASSERT(false, ETL_ERROR(pool_no_allocation));
+      }
+
+      return p_value;
+    }
+
+    //*************************************************************************
+    /// Takes up to 'n' free items from the pool.
+    /// The free list is used first, then any items never yet allocated.
+    /// \return The number of items written to 'p_items'.
+    //*************************************************************************
+    uint32_t acquire_items(char** p_items, uint32_t n)
+    {
+      uint32_t count = 0;
+      head_t   head  = free_head.load(etl::memory_order_acquire);
+
+      while (get_index(head) != NONE)
+      {
+        // Walk down the list for as many as we want.
+        // If the list changes under us the links may be stale, but they are
+        // always valid indexes, and the tag makes the exchange below fail.
+        uint32_t index = get_index(head);
+        count = 0;
+
+        while ((count < n) && (index != NONE))
+        {
+          p_items[count++] = p_buffer + (size_t(index) * ITEM_SIZE);
+          index = p_links[index].load(etl::memory_order_relaxed);
+        }
+
+        if (free_head.compare_exchange_weak(head, make_head(index, get_tag(head) + 1), etl::memory_order_acquire, etl::memory_order_acquire))
+        {
+          break;
+        }
+
+        count = 0;
+      }
+
+      // Not enough on the list? Claim some that have never been used.
+      if (count < n)
+      {
+        uint32_t first = items_initialised.load(etl::memory_order_relaxed);
+        uint32_t fresh;
+
+        do
+        {
+          fresh = std::min(n - count, MAX_SIZE - first);
+        } while ((fresh != 0) && !items_initialised.compare_exchange_weak(first, first + fresh, etl::memory_order_relaxed, etl::memory_order_relaxed));
+
+        for (uint32_t i = 0; i < fresh; ++i)
+        {
+          p_items[count++] = p_buffer + (size_t(first + i) * ITEM_SIZE);
+        }
+      }
+
+      if (count != 0)
+      {
+        items_allocated.fetch_add(count, etl::memory_order_relaxed);
+      }
+
+      return count;
+    }
+
+    //*************************************************************************
+    /// Pushes 'n' items back on to the free list with one exchange.
+    //*************************************************************************
+    void release_items(char* const* p_items, uint32_t n)
+    {
+      // Chain them together first.
+      uint32_t first = index_of(p_items[0]);
+      uint32_t last  = first;
+
+      for (uint32_t i = 1; i < n; ++i)
+      {
+        uint32_t index = index_of(p_items[i]);
+        p_links[last].store(index, etl::memory_order_relaxed);
+        last = index;
+      }
+
+      head_t head = free_head.load(etl::memory_order_relaxed);
+
+      do
+      {
+        p_links[last].store(get_index(head), etl::memory_order_relaxed);
+      } while (!free_head.compare_exchange_weak(head, make_head(first, get_tag(head) + 1), etl::memory_order_release, etl::memory_order_relaxed));
+
+      items_allocated.fetch_sub(n, etl::memory_order_relaxed);
+    }
+
+    //*************************************************************************
+    /// Check if the item belongs to this pool.
+    //*************************************************************************
+    bool is_item_in_pool(const char* p) const
+    {
+      // Within the range of the buffer?
+      intptr_t distance = p - p_buffer;
+      bool is_within_range = (distance >= 0) && (distance <= intptr_t((ITEM_SIZE * MAX_SIZE) - ITEM_SIZE));
+
+      // Modulus and division can be slow on some architectures, so only do this in debug.
+#if defined(ETL_DEBUG)
+      // Is the address on a valid object boundary?
+      bool is_valid_address = ((distance % ITEM_SIZE) == 0);
+#else
+      bool is_valid_address = true;
+#endif
+
+      return is_within_range && is_valid_address;
+    }
+
+    //*************************************************************************
+    /// The index of an item in the buffer.
+    //*************************************************************************
+    uint32_t index_of(const char* p) const
+    {
+      return uint32_t(size_t(p - p_buffer) / ITEM_SIZE);
+    }
+
+    //*************************************************************************
+    static head_t make_head(uint32_t index, head_t tag)
+    {
+      return (tag << INDEX_BITS) | head_t(index);
+    }
+
+    //*************************************************************************
+    static uint32_t get_index(head_t head)
+    {
+      return uint32_t(head & head_t(NONE));
+    }
+
+    //*************************************************************************
+    static head_t get_tag(head_t head)
+    {
+      return head >> INDEX_BITS;
+    }
+
+    // Disable copy construction and assignment.
+    ipool_concurrent(const ipool_concurrent&);
+    ipool_concurrent& operator =(const ipool_concurrent&);
+
+    char*                  p_buffer;
+    etl::atomic<uint32_t>* p_links;  ///< The next free item for each item on the free list.
+
+    // The shared state is kept on separate cache lines.
+    char                   padding0[ETL_CACHE_LINE_SIZE];
+    etl::atomic<head_t>    free_head;         ///< The tagged index of the first free item.
+    char                   padding1[ETL_CACHE_LINE_SIZE - sizeof(etl::atomic<head_t>)];
+    etl::atomic<uint32_t>  items_initialised; ///< The number of items ever allocated.
+    etl::atomic<uint32_t>  items_allocated;   ///< The number of items allocated.
+    char                   padding2[ETL_CACHE_LINE_SIZE - (2 * sizeof(etl::atomic<uint32_t>))];
+
+    const uint32_t ITEM_SIZE; ///< The size of allocated items.
+    const uint32_t MAX_SIZE;  ///< The maximum number of objects that can be allocated.
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_POOL) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~ipool_concurrent()
+    {
+    }
+#else
+  protected:
+    ~ipool_concurrent()
+    {
+    }
+#endif
+  };
+
+  //*************************************************************************
+  /// A templated abstract concurrent pool implementation that uses a fixed size pool.
+  ///\ingroup pool_concurrent
+  //*************************************************************************
+  template <const size_t TYPE_SIZE_, const size_t ALIGNMENT_, const size_t SIZE_>
+  class generic_pool_concurrent : public etl::ipool_concurrent
+  {
+  public:
+
+    static const size_t SIZE      = SIZE_;
+    static const size_t ALIGNMENT = ALIGNMENT_;
+    static const size_t TYPE_SIZE = TYPE_SIZE_;
+
+    ETL_STATIC_ASSERT(SIZE_ < ipool_concurrent::NONE, "Too many items for the free list index");
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    generic_pool_concurrent()
+      : etl::ipool_concurrent(reinterpret_cast<char*>(&buffer[0]), links, ELEMENT_SIZE, SIZE)
+    {
+    }
+
+    //*************************************************************************
+    /// Allocate an object from the pool.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    /// Static asserts if the specified type is too large for the pool.
+    //*************************************************************************
+    template <typename U>
+    U* allocate()
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return ipool_concurrent::allocate<U>();
+    }
+
+#if !ETL_CPP11_SUPPORTED || ETL_POOL_CONCURRENT_CPP03_CODE || defined(ETL_STLPORT) || defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create with default.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename U>
+    U* create()
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return ipool_concurrent::create<U>();
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create with 1 parameter.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename U, typename T1>
+    U* create(const T1& value1)
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return ipool_concurrent::create<U>(value1);
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create with 2 parameters.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename U, typename T1, typename T2>
+    U* create(const T1& value1, const T2& value2)
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return ipool_concurrent::create<U>(value1, value2);
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create with 3 parameters.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename U, typename T1, typename T2, typename T3>
+    U* create(const T1& value1, const T2& value2, const T3& value3)
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return ipool_concurrent::create<U>(value1, value2, value3);
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the pool and create with 4 parameters.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename U, typename T1, typename T2, typename T3, typename T4>
+    U* create(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return ipool_concurrent::create<U>(value1, value2, value3, value4);
+    }
+#else
+    //*************************************************************************
+    /// Emplace with variadic constructor parameters.
+    //*************************************************************************
+    template <typename U, typename... Args>
+    U* create(Args&&... args)
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      return ipool_concurrent::create<U>(std::forward<Args>(args)...);
+    }
+#endif
+
+    //*************************************************************************
+    /// Destroys the object.
+    /// Undefined behaviour if the pool does not contain a 'U'.
+    /// \param p_object A pointer to the object to be destroyed.
+    //*************************************************************************
+    template <typename U>
+    void destroy(const void* const p_object)
+    {
+      ETL_STATIC_ASSERT(etl::alignment_of<U>::value <= ALIGNMENT_, "Type has incompatible alignment");
+      ETL_STATIC_ASSERT(sizeof(U) <= TYPE_SIZE, "Type too large for pool");
+      reinterpret_cast<U*>((const_cast<void*>(p_object)))->~U();
+      ipool_concurrent::release(p_object);
+    }
+
+  private:
+
+    // The pool element.
+    union Element
+    {
+      char     value[TYPE_SIZE_]; ///< Storage for value type.
+      typename etl::type_with_alignment<ALIGNMENT_>::type dummy; ///< Dummy item to get correct alignment.
+    };
+
+    ///< The memory for the pool of objects.
+    typename etl::aligned_storage<sizeof(Element), etl::alignment_of<Element>::value>::type buffer[SIZE];
+
+    ///< The free list links.
+    etl::atomic<uint32_t> links[SIZE];
+
+    static const uint32_t ELEMENT_SIZE = sizeof(Element);
+
+    // Should not be copied.
+    generic_pool_concurrent(const generic_pool_concurrent&);
+    generic_pool_concurrent& operator =(const generic_pool_concurrent&);
+  };
+
+  //*************************************************************************
+  /// A templated concurrent pool implementation that uses a fixed size pool.
+  ///\ingroup pool_concurrent
+  //*************************************************************************
+  template <typename T, const size_t SIZE_>
+  class pool_concurrent : public etl::generic_pool_concurrent<sizeof(T), etl::alignment_of<T>::value, SIZE_>
+  {
+  private:
+
+    typedef etl::generic_pool_concurrent<sizeof(T), etl::alignment_of<T>::value, SIZE_> base_t;
+
+  public:
+
+    static const size_t SIZE      = base_t::SIZE;
+    static const size_t ALIGNMENT = base_t::ALIGNMENT;
+    static const size_t TYPE_SIZE = base_t::TYPE_SIZE;
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    pool_concurrent()
+    {
+    }
+
+  private:
+
+    // Should not be copied.
+    pool_concurrent(const pool_concurrent&);
+    pool_concurrent& operator =(const pool_concurrent&);
+  };
+
+  //***************************************************************************
+  ///\ingroup pool_concurrent
+  /// A small cache of free items for one thread.
+  /// Allocations and releases are served from the magazine without touching
+  /// the shared pool. An empty magazine is refilled with half of its capacity
+  /// in one exchange, and a full one returns its oldest half in one exchange.
+  /// A magazine must only be used by one thread at a time.
+  /// Items held in magazines are not available to other threads, so the pool
+  /// should be sized to allow for them.
+  /// The destructor returns any cached items to the pool.
+  ///\code
+  /// etl::pool_concurrent<Message, 256> pool;
+  ///
+  /// void worker()
+  /// {
+  ///   etl::pool_magazine<16> magazine(pool);
+  ///   Message* p = magazine.create<Message>();
+  ///   ...
+  ///   magazine.destroy<Message>(p);
+  /// }
+  ///\endcode
+  /// \tparam MAGAZINE_SIZE The number of items that may be cached.
+  //***************************************************************************
+  template <const size_t MAGAZINE_SIZE>
+  class pool_magazine
+  {
+  public:
+
+    ETL_STATIC_ASSERT(MAGAZINE_SIZE >= 2, "Magazine must hold at least two items");
+
+    typedef size_t size_type;
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    explicit pool_magazine(etl::ipool_concurrent& pool_)
+      : pool(pool_),
+        count(0)
+    {
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    /// Returns all cached items to the pool.
+    //*************************************************************************
+    ~pool_magazine()
+    {
+      flush();
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the magazine.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename T>
+    T* allocate()
+    {
+      if (sizeof(T) > pool.ITEM_SIZE)
+      {
+        ETL_ASSERT(false, ETL_ERROR(etl::pool_element_size));
+      }
+
+      return reinterpret_cast<T*>(allocate_item());
+    }
+
+#if !ETL_CPP11_SUPPORTED || ETL_POOL_CONCURRENT_CPP03_CODE || defined(ETL_STLPORT) || defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Allocate storage for an object from the magazine and create default.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename T>
+    T* create()
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T();
+      }
+
+      return p;
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the magazine and create with 1 parameter.
+    /// If asserts or exceptions are enabled and there are no more free items an
+    /// etl::pool_no_allocation if thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename T, typename T1>
+    T* create(const T1& value1)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2>
+    T* create(const T1& value1, const T2& value2)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3>
+    T* create(const T1& value1, const T2& value2, const T3& value3)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3, typename T4>
+    T* create(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3, value4);
+      }
+
+      return p;
+    }
+#else
+    //*************************************************************************
+    /// Emplace with variadic constructor parameters.
+    //*************************************************************************
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(std::forward<Args>(args)...);
+      }
+
+      return p;
+    }
+#endif
+
+    //*************************************************************************
+    /// Destroys the object.
+    /// Undefined behaviour if the pool does not contain a 'T'.
+    /// \param p_object A pointer to the object to be destroyed.
+    //*************************************************************************
+    template <typename T>
+    void destroy(const void* const p_object)
+    {
+      if (sizeof(T) > pool.ITEM_SIZE)
+      {
+        ETL_ASSERT(false, ETL_ERROR(etl::pool_element_size));
+      }
+
+      reinterpret_cast<T*>((const_cast<void*>(p_object)))->~T();
+      release(p_object);
+    }
+
+    //*************************************************************************
+    /// Release an object to the magazine.
+    /// The object may have been allocated by any magazine of the same pool,
+    /// or by the pool directly.
+    /// If asserts or exceptions are enabled and the object does not belong to the
+    /// pool then an etl::pool_object_not_in_pool is thrown.
+    /// \param p_object A pointer to the object to be released.
+    //*************************************************************************
+    void release(const void* const p_object)
+    {
+      release_item((char*)p_object);
+    }
+
+    //*************************************************************************
+    /// Returns all cached items to the pool.
+    //*************************************************************************
+    void flush()
+    {
+      if (count != 0)
+      {
+        pool.release_items(items, uint32_t(count));
+        count = 0;
+      }
+    }
+
+    //*************************************************************************
+    /// Returns the number of items cached in the magazine.
+    //*************************************************************************
+    size_t size() const
+    {
+      return count;
+    }
+
+    //*************************************************************************
+    /// Returns the maximum number of items cached in the magazine.
+    //*************************************************************************
+    size_t capacity() const
+    {
+      return MAGAZINE_SIZE;
+    }
+
+    //*************************************************************************
+    /// Returns the pool that the magazine caches.
+    //*************************************************************************
+    etl::ipool_concurrent& get_pool() const
+    {
+      return pool;
+    }
+
+  private:
+
+    static const uint32_t REFILL_SIZE = uint32_t((MAGAZINE_SIZE + 1) / 2); ///< The number of items taken when empty.
+    static const uint32_t FLUSH_SIZE  = uint32_t(MAGAZINE_SIZE / 2);       ///< The number of items returned when full.
+
+    //*************************************************************************
+    /// Allocate an item from the magazine, refilling it if empty.
+    //*************************************************************************
+    char* allocate_item()
+    {
+      if (count == 0)
+      {
+        count = pool.acquire_items(items, REFILL_SIZE);
+
+        if (count == 0)
+        {
+          ETL_ASSERT(false, ETL_ERROR(pool_no_allocation));
+          return nullptr;
+        }
+      }
+
+      return items[--count];
+    }
+
+    //*************************************************************************
+    /// Release an item to the magazine, flushing the oldest if full.
+    //*************************************************************************
+    void release_item(char* p_value)
+    {
+      // Does it belong to the pool?
+      ETL_ASSERT(pool.is_item_in_pool(p_value), ETL_ERROR(pool_object_not_in_pool));
+
+      if (count == MAGAZINE_SIZE)
+      {
+        // The most recently released are the most likely to be in the cache, so keep those.
+        pool.release_items(items, FLUSH_SIZE);
+        std::copy(items + FLUSH_SIZE, items + MAGAZINE_SIZE, items);
+        count -= FLUSH_SIZE;
+      }
+
+      items[count++] = p_value;
+    }
+
+    // Should not be copied.
+    pool_magazine(const pool_magazine&);
+    pool_magazine& operator =(const pool_magazine&);
+
+    etl::ipool_concurrent& pool;                 ///< The shared pool.
+    size_t                 count;                ///< The number of cached items.
+    char*                  items[MAGAZINE_SIZE]; ///< The cached items.
+  };
+}
+
+#undef ETL_FILE
+
+#endif
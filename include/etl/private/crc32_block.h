@@ -0,0 +1,295 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#if !defined(ETL_IN_CRC32_H) && !defined(ETL_IN_CRC32_C_H)
+#error This header is a private element of etl::crc32 & etl::crc32_c
+#endif
+
+#ifndef ETL_CRC32_BLOCK_INCLUDED
+#define ETL_CRC32_BLOCK_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../platform.h"
+
+// The x86 CRC instructions are used, if the CPU has them, unless ETL_CRC_NO_HARDWARE is defined.
+// The check is made at run time, so the code does not have to be compiled for SSE4.2.
+#if !defined(ETL_CRC_NO_HARDWARE)
+  #if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define ETL_CRC_X86_HARDWARE
+    #define ETL_CRC_TARGET(features) __attribute__((target(features)))
+    #include <cpuid.h>
+    #include <immintrin.h>
+  #elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #define ETL_CRC_X86_HARDWARE
+    #define ETL_CRC_TARGET(features)
+    #include <intrin.h>
+    #include <immintrin.h>
+  #endif
+#endif
+
+namespace etl
+{
+  namespace private_crc32
+  {
+    //*************************************************************************
+    /// Reads four bytes as a little endian value.
+    /// Compilers turn this into a single load on little endian targets.
+    //*************************************************************************
+    inline uint32_t read_le32(const uint8_t* data)
+    {
+      return uint32_t(data[0])         |
+             (uint32_t(data[1]) << 8)  |
+             (uint32_t(data[2]) << 16) |
+             (uint32_t(data[3]) << 24);
+    }
+
+    //*************************************************************************
+    /// Adds a block to a reflected 32 bit CRC, eight bytes per step.
+    /// table[0] is the byte-wise table. table[n] is the CRC of a byte
+    /// followed by n zero bytes.
+    //*************************************************************************
+    inline uint32_t slice_by_8(uint32_t crc, const uint8_t* data, size_t length, const uint32_t (*table)[256])
+    {
+      while (length >= 8)
+      {
+        const uint32_t low  = crc ^ read_le32(data);
+        const uint32_t high = read_le32(data + 4);
+
+        crc = table[7][low & 0xFF]          ^
+              table[6][(low >> 8) & 0xFF]   ^
+              table[5][(low >> 16) & 0xFF]  ^
+              table[4][low >> 24]           ^
+              table[3][high & 0xFF]         ^
+              table[2][(high >> 8) & 0xFF]  ^
+              table[1][(high >> 16) & 0xFF] ^
+              table[0][high >> 24];
+
+        data   += 8;
+        length -= 8;
+      }
+
+      while (length-- != 0)
+      {
+        crc = (crc >> 8) ^ table[0][(crc ^ *data++) & 0xFF];
+      }
+
+      return crc;
+    }
+
+#if defined(ETL_CRC_X86_HARDWARE)
+    //*************************************************************************
+    /// CPUID leaf 1 ECX feature bits.
+    //*************************************************************************
+    enum
+    {
+      CPUID_PCLMULQDQ = 1U << 1,
+      CPUID_SSE4_1    = 1U << 19,
+      CPUID_SSE4_2    = 1U << 20
+    };
+
+    //*************************************************************************
+    /// Returns CPUID leaf 1 ECX.
+    //*************************************************************************
+    inline uint32_t cpuid_features()
+    {
+#if defined(_MSC_VER) && !defined(__clang__)
+      int info[4];
+      __cpuid(info, 1);
+      return uint32_t(info[2]);
+#else
+      unsigned int eax = 0;
+      unsigned int ebx = 0;
+      unsigned int ecx = 0;
+      unsigned int edx = 0;
+
+      return (__get_cpuid(1, &eax, &ebx, &ecx, &edx) != 0) ? ecx : 0U;
+#endif
+    }
+
+    //*************************************************************************
+    /// True if the CPU has the SSE4.2 crc32 instruction.
+    //*************************************************************************
+    inline bool has_sse42()
+    {
+      static const bool supported = (cpuid_features() & CPUID_SSE4_2) != 0;
+
+      return supported;
+    }
+
+    //*************************************************************************
+    /// True if the CPU has carry-less multiply.
+    //*************************************************************************
+    inline bool has_pclmul()
+    {
+      static const bool supported = (cpuid_features() & (CPUID_PCLMULQDQ | CPUID_SSE4_1)) == (CPUID_PCLMULQDQ | CPUID_SSE4_1);
+
+      return supported;
+    }
+
+    //*************************************************************************
+    /// CRC32-C using the SSE4.2 crc32 instruction.
+    //*************************************************************************
+    ETL_CRC_TARGET("sse4.2")
+    inline uint32_t crc32_c_sse42(uint32_t crc, const uint8_t* data, size_t length)
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+      uint64_t crc64 = crc;
+
+      while (length >= 8)
+      {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+
+        data   += 8;
+        length -= 8;
+      }
+
+      crc = uint32_t(crc64);
+#endif
+
+      while (length >= 4)
+      {
+        uint32_t word;
+        memcpy(&word, data, sizeof(word));
+        crc = _mm_crc32_u32(crc, word);
+
+        data   += 4;
+        length -= 4;
+      }
+
+      while (length-- != 0)
+      {
+        crc = _mm_crc32_u8(crc, *data++);
+      }
+
+      return crc;
+    }
+
+    //*************************************************************************
+    /// CRC32 (polynomial 0x04C11DB7, reflected) using carry-less multiply.
+    /// Folds four 128 bit lanes at a time, then reduces with a Barrett reduction.
+    /// From 'Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+    /// Instruction', Intel, 2009.
+    /// 'length' must be at least 64 and a multiple of 16.
+    //*************************************************************************
+    ETL_CRC_TARGET("pclmul,sse4.1")
+    inline uint32_t crc32_pclmul(uint32_t crc, const uint8_t* data, size_t length)
+    {
+      // The fold and reduction constants for the bit reflected polynomial.
+      const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596LL, 0x0154442BD4LL);
+      const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009ELL, 0x01751997D0LL);
+      const __m128i k5k0 = _mm_set_epi64x(0x0000000000LL, 0x0163CD6124LL);
+      const __m128i poly = _mm_set_epi64x(0x01F7011641LL, 0x01DB710641LL);
+      const __m128i mask = _mm_setr_epi32(-1, 0, -1, 0);
+
+      __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00));
+      __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10));
+      __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20));
+      __m128i x4 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30));
+      __m128i x5;
+
+      x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(int(crc)));
+
+      data   += 64;
+      length -= 64;
+
+      // Fold 64 bytes at a time.
+      while (length >= 64)
+      {
+        x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+        __m128i x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+        __m128i x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+        __m128i x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+
+        x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+        x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+        x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+        x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x00)));
+        x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x10)));
+        x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x20)));
+        x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 0x30)));
+
+        data   += 64;
+        length -= 64;
+      }
+
+      // Fold the four lanes into one.
+      x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+      x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+      x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+
+      x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+      x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+      x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+
+      x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+      x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+      x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+      // Fold 16 bytes at a time.
+      while (length >= 16)
+      {
+        x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+        x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+        x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data))), x5);
+
+        data   += 16;
+        length -= 16;
+      }
+
+      // Fold 128 bits to 64 bits.
+      x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+      x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+
+      x2 = _mm_srli_si128(x1, 4);
+      x1 = _mm_and_si128(x1, mask);
+      x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+      x1 = _mm_xor_si128(x1, x2);
+
+      // Barrett reduction to 32 bits.
+      x2 = _mm_and_si128(x1, mask);
+      x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+      x2 = _mm_and_si128(x2, mask);
+      x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+      x1 = _mm_xor_si128(x1, x2);
+
+      return uint32_t(_mm_extract_epi32(x1, 1));
+    }
+#endif
+  }
+}
+
+#endif
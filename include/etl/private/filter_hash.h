@@ -0,0 +1,70 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#if !defined(ETL_IN_BLOCKED_BLOOM_FILTER_H) && !defined(ETL_IN_COUNTING_BLOOM_FILTER_H) && !defined(ETL_IN_CUCKOO_FILTER_H)
+#error This header is a private element of etl::blocked_bloom_filter, etl::counting_bloom_filter & etl::cuckoo_filter
+#endif
+
+#ifndef ETL_FILTER_HASH_INCLUDED
+#define ETL_FILTER_HASH_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace etl
+{
+  namespace private_filter_hash
+  {
+    //*************************************************************************
+    /// Spreads the bits of a hash over all 64 bits.
+    /// The finaliser from MurmurHash3.
+    //*************************************************************************
+    inline uint64_t mix(uint64_t hash)
+    {
+      hash ^= hash >> 33;
+      hash *= 0xFF51AFD7ED558CCDULL;
+      hash ^= hash >> 33;
+      hash *= 0xC4CEB9FE1A85EC53ULL;
+      hash ^= hash >> 33;
+
+      return hash;
+    }
+
+    //*************************************************************************
+    /// Maps a 32 bit value onto the range [0, n) without a division.
+    //*************************************************************************
+    inline size_t reduce(uint32_t value, size_t n)
+    {
+      return size_t((uint64_t(value) * uint64_t(n)) >> 32);
+    }
+  }
+}
+
+#endif
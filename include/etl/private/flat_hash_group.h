@@ -0,0 +1,320 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#if !defined(ETL_IN_FLAT_HASH_MAP_H) && !defined(ETL_IN_FLAT_HASH_SET_H)
+#error This header is a private element of etl::flat_hash_map & etl::flat_hash_set
+#endif
+
+#ifndef ETL_FLAT_HASH_GROUP_INCLUDED
+#define ETL_FLAT_HASH_GROUP_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../platform.h"
+#include "../power.h"
+
+// SSE2 group matching is used if the target supports it, unless ETL_FLAT_HASH_NO_SIMD is defined.
+#if !defined(ETL_FLAT_HASH_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+  #define ETL_FLAT_HASH_USE_SSE2
+  #include <emmintrin.h>
+#endif
+
+namespace etl
+{
+  namespace private_flat_hash
+  {
+    //*************************************************************************
+    /// The control byte values.
+    /// A full slot stores the low 7 bits of the hash (H2), so is always >= 0.
+    /// The sentinel terminates iteration and is never part of a group.
+    //*************************************************************************
+    typedef int8_t ctrl_t;
+
+    static const ctrl_t CTRL_EMPTY    = -128; // 0b10000000
+    static const ctrl_t CTRL_DELETED  = -2;   // 0b11111110
+    static const ctrl_t CTRL_SENTINEL = -1;   // 0b11111111
+
+    static const size_t GROUP_WIDTH = 16;
+
+    //*************************************************************************
+    inline bool is_full(ctrl_t c)
+    {
+      return c >= 0;
+    }
+
+    //*************************************************************************
+    inline bool is_empty_or_deleted(ctrl_t c)
+    {
+      return c < CTRL_SENTINEL;
+    }
+
+    //*************************************************************************
+    /// Calculates the number of slots for a table holding MAX_SIZE elements.
+    /// Keeps the maximum load factor at or below 7/8 and rounds up to a
+    /// power of 2 that is a whole number of groups.
+    //*************************************************************************
+    template <const size_t MAX_SIZE>
+    struct capacity
+    {
+    private:
+
+      static const size_t MINIMUM = MAX_SIZE + (MAX_SIZE / 7) + 1;
+
+    public:
+
+      static const size_t value = etl::power_of_2_round_up<(MINIMUM < GROUP_WIDTH) ? GROUP_WIDTH : MINIMUM>::value;
+    };
+
+    //*************************************************************************
+    /// Scrambles the user's hash so that weak hashes, such as the identity
+    /// hashes used for integral keys, still spread across the groups.
+    //*************************************************************************
+    inline size_t mix_hash(size_t hash)
+    {
+#if ETL_PLATFORM_64BIT
+      uint64_t h = static_cast<uint64_t>(hash) * UINT64_C(0x9E3779B97F4A7C15);
+      return static_cast<size_t>(h ^ (h >> 32));
+#else
+      uint32_t h = static_cast<uint32_t>(hash) * UINT32_C(0x9E3779B9);
+      return static_cast<size_t>(h ^ (h >> 16));
+#endif
+    }
+
+    //*************************************************************************
+    /// The group index where the probe sequence starts (H1).
+    //*************************************************************************
+    inline size_t h1(size_t hash)
+    {
+      return hash >> 7;
+    }
+
+    //*************************************************************************
+    /// The value stored in the control byte (H2).
+    //*************************************************************************
+    inline ctrl_t h2(size_t hash)
+    {
+      return static_cast<ctrl_t>(hash & 0x7F);
+    }
+
+    //*************************************************************************
+    /// A mask of matching positions in a group.
+    /// Bit 'n' is set if slot 'n' of the group matched.
+    //*************************************************************************
+    class bitmask
+    {
+    public:
+
+      explicit bitmask(uint32_t mask_)
+        : mask(mask_)
+      {
+      }
+
+      //***********************************
+      bool any() const
+      {
+        return mask != 0;
+      }
+
+      //***********************************
+      /// Returns the position of the lowest match.
+      //***********************************
+      size_t lowest() const
+      {
+#if defined(ETL_COMPILER_GCC) || defined(__clang__)
+        return static_cast<size_t>(__builtin_ctz(mask));
+#else
+        size_t n = 0;
+        uint32_t m = mask;
+
+        while ((m & 1U) == 0U)
+        {
+          m >>= 1;
+          ++n;
+        }
+
+        return n;
+#endif
+      }
+
+      //***********************************
+      /// Removes the lowest match.
+      //***********************************
+      void next()
+      {
+        mask &= (mask - 1);
+      }
+
+    private:
+
+      uint32_t mask;
+    };
+
+    //*************************************************************************
+    /// A group of GROUP_WIDTH control bytes.
+    //*************************************************************************
+    class group
+    {
+    public:
+
+#if defined(ETL_FLAT_HASH_USE_SSE2)
+      //***********************************
+      explicit group(const ctrl_t* pctrl)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pctrl)))
+      {
+      }
+
+      //***********************************
+      /// The slots whose H2 matches.
+      //***********************************
+      bitmask match(ctrl_t hash2) const
+      {
+        return bitmask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(hash2), ctrl))));
+      }
+
+      //***********************************
+      /// The empty slots.
+      //***********************************
+      bitmask match_empty() const
+      {
+        return match(CTRL_EMPTY);
+      }
+
+      //***********************************
+      /// The empty or deleted slots.
+      /// These are the only control values with the top bit set that can appear in a group.
+      //***********************************
+      bitmask match_empty_or_deleted() const
+      {
+        return bitmask(static_cast<uint32_t>(_mm_movemask_epi8(ctrl)));
+      }
+
+    private:
+
+      __m128i ctrl;
+#else
+      //***********************************
+      explicit group(const ctrl_t* pctrl_)
+        : pctrl(pctrl_)
+      {
+      }
+
+      //***********************************
+      /// The slots whose H2 matches.
+      //***********************************
+      bitmask match(ctrl_t hash2) const
+      {
+        uint32_t mask = 0;
+
+        for (size_t i = 0; i < GROUP_WIDTH; ++i)
+        {
+          mask |= static_cast<uint32_t>(pctrl[i] == hash2) << i;
+        }
+
+        return bitmask(mask);
+      }
+
+      //***********************************
+      /// The empty slots.
+      //***********************************
+      bitmask match_empty() const
+      {
+        return match(CTRL_EMPTY);
+      }
+
+      //***********************************
+      /// The empty or deleted slots.
+      //***********************************
+      bitmask match_empty_or_deleted() const
+      {
+        uint32_t mask = 0;
+
+        for (size_t i = 0; i < GROUP_WIDTH; ++i)
+        {
+          mask |= static_cast<uint32_t>(is_empty_or_deleted(pctrl[i])) << i;
+        }
+
+        return bitmask(mask);
+      }
+
+    private:
+
+      const ctrl_t* pctrl;
+#endif
+    };
+
+    //*************************************************************************
+    /// The sequence of groups visited for a hash.
+    /// Triangular steps visit every group once when the group count is a power of 2.
+    //*************************************************************************
+    class probe_sequence
+    {
+    public:
+
+      probe_sequence(size_t hash1, size_t group_mask_)
+        : group_mask(group_mask_),
+          index(hash1 & group_mask_),
+          step(0)
+      {
+      }
+
+      //***********************************
+      /// The index of the first slot of the current group.
+      //***********************************
+      size_t offset() const
+      {
+        return index * GROUP_WIDTH;
+      }
+
+      //***********************************
+      void next()
+      {
+        ++step;
+        index = (index + step) & group_mask;
+      }
+
+      //***********************************
+      /// The number of groups visited so far.
+      //***********************************
+      size_t count() const
+      {
+        return step;
+      }
+
+    private:
+
+      size_t group_mask;
+      size_t index;
+      size_t step;
+    };
+  }
+}
+
+#endif
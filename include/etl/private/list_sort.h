@@ -0,0 +1,180 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#if !defined(ETL_IN_LIST_H) && !defined(ETL_IN_FORWARD_LIST_H) && !defined(ETL_IN_INTRUSIVE_LIST_H) && !defined(ETL_IN_INTRUSIVE_FORWARD_LIST_H)
+#error This header is a private element of etl::list, etl::forward_list, etl::intrusive_list & etl::intrusive_forward_list
+#endif
+
+#ifndef ETL_LIST_SORT_INCLUDED
+#define ETL_LIST_SORT_INCLUDED
+
+#include <stddef.h>
+
+#include "../platform.h"
+#include "../nullptr.h"
+#include "../integral_limits.h"
+
+namespace etl
+{
+  namespace private_list_sort
+  {
+    //*************************************************************************
+    /// Merges two non-empty, sorted, null terminated chains of nodes.
+    /// Equal nodes are taken from 'left' first, so the merge is stable.
+    //*************************************************************************
+    template <typename TNode, TNode* TNode::*NEXT, typename TCompare>
+    TNode* merge(TNode* left, TNode* right, TCompare& compare)
+    {
+      TNode*  head;
+      TNode** p_tail = &head;
+
+      while (true)
+      {
+        if (compare(*right, *left))
+        {
+          *p_tail = right;
+          p_tail  = &(right->*NEXT);
+          right   = *p_tail;
+
+          if (right == nullptr)
+          {
+            *p_tail = left;
+            return head;
+          }
+        }
+        else
+        {
+          *p_tail = left;
+          p_tail  = &(left->*NEXT);
+          left    = *p_tail;
+
+          if (left == nullptr)
+          {
+            *p_tail = right;
+            return head;
+          }
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Detaches the natural run at the start of the chain.
+    /// A non-descending run is left in place. A strictly descending run is
+    /// reversed, which cannot reorder equal nodes.
+    /// On return 'head' is the first node after the run.
+    //*************************************************************************
+    template <typename TNode, TNode* TNode::*NEXT, typename TCompare>
+    TNode* take_run(TNode*& head, TCompare& compare)
+    {
+      TNode* run  = head;
+      TNode* next = run->*NEXT;
+
+      if ((next != nullptr) && compare(*next, *run))
+      {
+        run->*NEXT = nullptr;
+
+        do
+        {
+          head        = next;
+          next        = head->*NEXT;
+          head->*NEXT = run;
+          run         = head;
+        } while ((next != nullptr) && compare(*next, *run));
+      }
+      else
+      {
+        TNode* tail = run;
+
+        while ((next != nullptr) && !compare(*next, *tail))
+        {
+          tail = next;
+          next = next->*NEXT;
+        }
+
+        tail->*NEXT = nullptr;
+      }
+
+      head = next;
+
+      return run;
+    }
+
+    //*************************************************************************
+    /// Stable bottom-up merge sort of a null terminated chain of nodes.
+    /// Natural runs are merged through an array of bins, where bin 'i' holds
+    /// the merge of 2^i runs, so the chain is walked once to find the runs
+    /// and no pass re-traverses it to find split points. An ordered chain is
+    /// a single run and costs one walk with no merges.
+    /// Only the NEXT links are updated. Returns the new first node.
+    //*************************************************************************
+    template <typename TNode, TNode* TNode::*NEXT, typename TCompare>
+    TNode* sort(TNode* head, TCompare compare)
+    {
+      TNode* bins[etl::integral_limits<size_t>::bits];
+      size_t bins_used = 0;
+
+      while (head != nullptr)
+      {
+        TNode* run = take_run<TNode, NEXT>(head, compare);
+
+        // Carry the run up through the full bins. Older runs are on the left.
+        size_t i = 0;
+
+        while ((i < bins_used) && (bins[i] != nullptr))
+        {
+          run     = merge<TNode, NEXT>(bins[i], run, compare);
+          bins[i] = nullptr;
+          ++i;
+        }
+
+        if (i == bins_used)
+        {
+          ++bins_used;
+        }
+
+        bins[i] = run;
+      }
+
+      TNode* result = nullptr;
+
+      for (size_t i = 0; i < bins_used; ++i)
+      {
+        if (bins[i] != nullptr)
+        {
+          result = (result == nullptr) ? bins[i] : merge<TNode, NEXT>(bins[i], result, compare);
+        }
+      }
+
+      return result;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,96 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#if !defined(ETL_IN_QUEUE_SPSC_ATOMIC_H) && !defined(ETL_IN_QUEUE_SPSC_ISR_H)
+#error This header is a private element of etl::queue_spsc_atomic & etl::queue_spsc_isr
+#endif
+
+#ifndef ETL_QUEUE_SPSC_SPAN_INCLUDED
+#define ETL_QUEUE_SPSC_SPAN_INCLUDED
+
+#include <stddef.h>
+
+#include "../platform.h"
+#include "../array_view.h"
+
+namespace etl
+{
+  namespace private_queue_spsc
+  {
+    //*************************************************************************
+    /// Up to two contiguous regions of a queue's ring buffer.
+    /// 'second' is only non-empty when the regions wrap around the end of the buffer.
+    //*************************************************************************
+    template <typename T>
+    struct span_pair
+    {
+      //***********************************************************************
+      /// Default constructor. Both regions are empty.
+      //***********************************************************************
+      span_pair()
+      {
+      }
+
+      //***********************************************************************
+      /// Constructs the regions for 'n' elements starting at 'index' in a
+      /// buffer of 'buffer_size' elements.
+      //***********************************************************************
+      span_pair(T* p_buffer, size_t index, size_t n, size_t buffer_size)
+      {
+        size_t n_first = ((buffer_size - index) < n) ? (buffer_size - index) : n;
+
+        // Empty regions still point into the buffer, so they may be passed to memcpy.
+        first  = etl::array_view<T>(p_buffer + index, n_first);
+        second = etl::array_view<T>(p_buffer, n - n_first);
+      }
+
+      //***********************************************************************
+      /// The total number of elements in both regions.
+      //***********************************************************************
+      size_t size() const
+      {
+        return first.size() + second.size();
+      }
+
+      //***********************************************************************
+      /// Are both regions empty?
+      //***********************************************************************
+      bool empty() const
+      {
+        return size() == 0;
+      }
+
+      etl::array_view<T> first;  ///< The region starting at the current index.
+      etl::array_view<T> second; ///< The region from the start of the buffer, if wrapped.
+    };
+  }
+}
+
+#endif
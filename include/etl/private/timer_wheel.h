@@ -0,0 +1,314 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#if !defined(ETL_IN_CALLBACK_TIMER_WHEEL_H) && !defined(ETL_IN_MESSAGE_TIMER_WHEEL_H)
+#error This header is a private element of etl::callback_timer_wheel & etl::message_timer_wheel
+#endif
+
+#ifndef ETL_TIMER_WHEEL_INCLUDED
+#define ETL_TIMER_WHEEL_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../platform.h"
+#include "../binary.h"
+#include "../integral_limits.h"
+
+namespace etl
+{
+  namespace private_timer_wheel
+  {
+    //*************************************************************************
+    /// The wheel geometry.
+    /// Each level has 64 slots, each 64 times the span of the level below.
+    /// Six levels cover the full 32 bit tick range. The top level only uses
+    /// four slots.
+    //*************************************************************************
+    enum
+    {
+      SLOT_BITS       = 6,
+      SLOTS           = 1 << SLOT_BITS,
+      SLOT_MASK       = SLOTS - 1,
+      LEVELS          = 6,
+      TOP_LEVEL_SLOTS = 1 << (32 - (SLOT_BITS * (LEVELS - 1))),
+      NO_SLOT         = 0xFFFF
+    };
+
+    //*************************************************************************
+    /// A hierarchical timing wheel of timer ids.
+    /// TData must have the members:
+    /// uint32_t expiry, TId previous, TId next, uint_least16_t slot.
+    /// Inserting and removing a timer is O(1).
+    /// Advancing time costs O(1) per expired timer and per occupied slot passed.
+    /// Empty stretches of time are skipped.
+    //*************************************************************************
+    template <typename TData, typename TId>
+    class wheel
+    {
+    public:
+
+      enum
+      {
+        NO_TIMER = etl::integral_limits<TId>::max
+      };
+
+      //***********************************************************************
+      wheel(TData* ptimers_)
+        : ptimers(ptimers_),
+          now(0),
+          active(0)
+      {
+        for (size_t level = 0; level < LEVELS; ++level)
+        {
+          occupied[level] = 0;
+
+          for (size_t slot = 0; slot < SLOTS; ++slot)
+          {
+            heads[level][slot] = TId(NO_TIMER);
+          }
+        }
+      }
+
+      //***********************************************************************
+      /// Are there no active timers?
+      //***********************************************************************
+      bool empty() const
+      {
+        return active == 0;
+      }
+
+      //***********************************************************************
+      /// Adds a timer that expires 'delay' ticks from now.
+      //***********************************************************************
+      void insert(TId id, uint32_t delay)
+      {
+        ptimers[id].expiry = now + delay;
+        link(id);
+      }
+
+      //***********************************************************************
+      /// Removes an active timer.
+      //***********************************************************************
+      void remove(TId id)
+      {
+        unlink(id);
+      }
+
+      //***********************************************************************
+      /// Removes and returns the next timer that expires within 'count' ticks.
+      /// Time is advanced to the timer's expiry and 'count' reduced to match.
+      /// Returns NO_TIMER when there are none, with time advanced by all of 'count'.
+      /// Timers inserted between calls are relative to the new time.
+      //***********************************************************************
+      TId pop_expired(uint32_t& count)
+      {
+        while (true)
+        {
+          TId id = heads[0][now & SLOT_MASK];
+
+          if (id != TId(NO_TIMER))
+          {
+            unlink(id);
+            return id;
+          }
+
+          if (count == 0)
+          {
+            return TId(NO_TIMER);
+          }
+
+          uint64_t distance = distance_to_next_slot();
+          uint32_t step     = (distance < count) ? uint32_t(distance) : count;
+
+          now   += step;
+          count -= step;
+
+          if ((now & SLOT_MASK) == 0)
+          {
+            cascade();
+          }
+        }
+      }
+
+      //***********************************************************************
+      /// Removes all of the timers.
+      //***********************************************************************
+      void clear()
+      {
+        for (size_t level = 0; level < LEVELS; ++level)
+        {
+          for (size_t slot = 0; slot < SLOTS; ++slot)
+          {
+            while (heads[level][slot] != TId(NO_TIMER))
+            {
+              unlink(heads[level][slot]);
+            }
+          }
+        }
+      }
+
+    private:
+
+      //***********************************************************************
+      /// Adds a timer to the slot for its expiry.
+      //***********************************************************************
+      void link(TId id)
+      {
+        TData& timer = ptimers[id];
+
+        uint32_t delta = timer.expiry - now;
+        size_t   level = 0;
+
+        while ((level < (LEVELS - 1)) && ((delta >> (SLOT_BITS * (level + 1))) != 0))
+        {
+          ++level;
+        }
+
+        size_t slot = (timer.expiry >> (SLOT_BITS * level)) & SLOT_MASK;
+        TId&   head = heads[level][slot];
+
+        timer.previous = TId(NO_TIMER);
+        timer.next     = head;
+        timer.slot     = uint_least16_t((level * SLOTS) + slot);
+
+        if (head != TId(NO_TIMER))
+        {
+          ptimers[head].previous = id;
+        }
+
+        head = id;
+        occupied[level] |= (uint64_t(1) << slot);
+        ++active;
+      }
+
+      //***********************************************************************
+      /// Removes a timer from its slot.
+      //***********************************************************************
+      void unlink(TId id)
+      {
+        TData& timer = ptimers[id];
+
+        size_t level = timer.slot / SLOTS;
+        size_t slot  = timer.slot % SLOTS;
+
+        if (timer.previous == TId(NO_TIMER))
+        {
+          heads[level][slot] = timer.next;
+
+          if (timer.next == TId(NO_TIMER))
+          {
+            occupied[level] &= ~(uint64_t(1) << slot);
+          }
+        }
+        else
+        {
+          ptimers[timer.previous].next = timer.next;
+        }
+
+        if (timer.next != TId(NO_TIMER))
+        {
+          ptimers[timer.next].previous = timer.previous;
+        }
+
+        timer.previous = TId(NO_TIMER);
+        timer.next     = TId(NO_TIMER);
+        timer.slot     = NO_SLOT;
+        --active;
+      }
+
+      //***********************************************************************
+      /// Moves the timers in the upper level slots that start now down to the
+      /// lower levels. Called when the level 0 index wraps to zero.
+      //***********************************************************************
+      void cascade()
+      {
+        for (size_t level = 1; level < LEVELS; ++level)
+        {
+          size_t slot = (now >> (SLOT_BITS * level)) & SLOT_MASK;
+
+          while (heads[level][slot] != TId(NO_TIMER))
+          {
+            TId id = heads[level][slot];
+
+            unlink(id);
+            link(id);
+          }
+
+          if (slot != 0)
+          {
+            break;
+          }
+        }
+      }
+
+      //***********************************************************************
+      /// The number of ticks to the next time that a level 0 slot may hold
+      /// timers or an upper level slot must be cascaded.
+      /// The lowest level with any timers decides.
+      //***********************************************************************
+      uint64_t distance_to_next_slot() const
+      {
+        for (size_t level = 0; level < LEVELS; ++level)
+        {
+          if (occupied[level] != 0)
+          {
+            const size_t   shift = SLOT_BITS * level;
+            const size_t   index = (now >> shift) & SLOT_MASK;
+            const uint64_t part  = now & ((uint64_t(1) << shift) - 1);
+
+            // The slots after the current one are in this lap.
+            uint64_t later = (index == SLOT_MASK) ? 0 : (occupied[level] & (~uint64_t(0) << (index + 1)));
+
+            if (later != 0)
+            {
+              return (uint64_t(etl::count_trailing_zeros(later) - index) << shift) - part;
+            }
+
+            // The rest are in the next lap, which starts when this level's index wraps.
+            const uint64_t lap = (level == (LEVELS - 1)) ? uint64_t(TOP_LEVEL_SLOTS) : uint64_t(SLOTS);
+
+            return ((lap - index) << shift) - part;
+          }
+        }
+
+        return ~uint64_t(0);
+      }
+
+      TData* const ptimers;
+      TId          heads[LEVELS][SLOTS];
+      uint64_t     occupied[LEVELS];
+      uint32_t     now;
+      size_t       active;
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,632 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_MPMC_QUEUE_ATOMIC_INCLUDED
+#define ETL_MPMC_QUEUE_ATOMIC_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+#include "alignment.h"
+#include "parameter_type.h"
+#include "atomic.h"
+#include "memory_model.h"
+#include "integral_limits.h"
+#include "static_assert.h"
+
+#undef ETL_FILE
+#define ETL_FILE "53"
+
+#define ETL_QUEUE_MPMC_ATOMIC_FORCE_CPP03 0
+
+namespace etl
+{
+  //***************************************************************************
+  ///\ingroup queue_mpmc
+  /// The base for all queue_mpmc_atomics.
+  /// The positions are counters that wrap at a multiple of the capacity.
+  /// They are size_t, whatever the memory model, so that a thread that is
+  /// pre-empted in the middle of an operation cannot see a position repeat.
+  //***************************************************************************
+  template <const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
+  class queue_mpmc_atomic_base
+  {
+  public:
+
+    /// The type used for determining the size of queue.
+    typedef typename etl::size_type_lookup<MEMORY_MODEL>::type size_type;
+
+    //*************************************************************************
+    /// Is the queue empty?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool empty() const
+    {
+      return size() == 0;
+    }
+
+    //*************************************************************************
+    /// Is the queue full?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    bool full() const
+    {
+      return size() == MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// How many items in the queue?
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_type size() const
+    {
+      size_t read_position  = dequeue_position.load(etl::memory_order_acquire);
+      size_t write_position = enqueue_position.load(etl::memory_order_acquire);
+
+      ptrdiff_t n = difference(write_position, read_position);
+
+      if (n < 0)
+      {
+        n = 0;
+      }
+      else if (n > ptrdiff_t(MAX_SIZE))
+      {
+        n = MAX_SIZE;
+      }
+
+      return size_type(n);
+    }
+
+    //*************************************************************************
+    /// How much free space available in the queue.
+    /// Due to concurrency, this is a guess.
+    //*************************************************************************
+    size_type available() const
+    {
+      return MAX_SIZE - size();
+    }
+
+    //*************************************************************************
+    /// How many items can the queue hold.
+    //*************************************************************************
+    size_type capacity() const
+    {
+      return MAX_SIZE;
+    }
+
+    //*************************************************************************
+    /// How many items can the queue hold.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return MAX_SIZE;
+    }
+
+  protected:
+
+    queue_mpmc_atomic_base(size_type max_size_)
+      : enqueue_position(0),
+        dequeue_position(0),
+        MAX_SIZE(max_size_),
+        WRAP(((etl::integral_limits<size_t>::max / 2U) / max_size_) * max_size_),
+        MASK(((max_size_ & (max_size_ - 1)) == 0) ? max_size_ - 1 : 0)
+    {
+    }
+
+    //*************************************************************************
+    /// The position after 'position'.
+    //*************************************************************************
+    size_t next_position(size_t position) const
+    {
+      ++position;
+
+      return (position == WRAP) ? 0 : position;
+    }
+
+    //*************************************************************************
+    /// The position one lap after 'position'.
+    //*************************************************************************
+    size_t next_lap(size_t position) const
+    {
+      return ((WRAP - position) > MAX_SIZE) ? position + MAX_SIZE : MAX_SIZE - (WRAP - position);
+    }
+
+    //*************************************************************************
+    /// The signed distance from 'b' to 'a'.
+    //*************************************************************************
+    ptrdiff_t difference(size_t a, size_t b) const
+    {
+      size_t d = (a >= b) ? (a - b) : (a + (WRAP - b));
+
+      return (d > (WRAP / 2)) ? -ptrdiff_t(WRAP - d) : ptrdiff_t(d);
+    }
+
+    //*************************************************************************
+    /// The sequence of a slot that is ready to be pushed to at 'position'.
+    /// Sequences count two per position, so that 'ready to push' on the next
+    /// lap never equals 'ready to pop' on this one, even with one slot.
+    //*************************************************************************
+    static size_t push_sequence(size_t position)
+    {
+      return position * 2U;
+    }
+
+    //*************************************************************************
+    /// The sequence of a slot that is ready to be popped from at 'position'.
+    //*************************************************************************
+    static size_t pop_sequence(size_t position)
+    {
+      return (position * 2U) + 1U;
+    }
+
+    //*************************************************************************
+    /// The signed distance from sequence 'b' to sequence 'a'.
+    //*************************************************************************
+    ptrdiff_t sequence_difference(size_t a, size_t b) const
+    {
+      const size_t sequence_wrap = WRAP * 2U;
+
+      size_t d = (a >= b) ? (a - b) : (a + (sequence_wrap - b));
+
+      return (d > WRAP) ? -ptrdiff_t(sequence_wrap - d) : ptrdiff_t(d);
+    }
+
+    //*************************************************************************
+    /// The buffer index for a position.
+    //*************************************************************************
+    size_t get_index(size_t position) const
+    {
+      return (MASK != 0) ? (position & MASK) : (position % MAX_SIZE);
+    }
+
+    // The producer and consumer positions are kept on separate cache lines.
+    char                padding0[ETL_CACHE_LINE_SIZE];
+    etl::atomic<size_t> enqueue_position; ///< The next position to push to.
+    char                padding1[ETL_CACHE_LINE_SIZE - sizeof(etl::atomic<size_t>)];
+    etl::atomic<size_t> dequeue_position; ///< The next position to pop from.
+    char                padding2[ETL_CACHE_LINE_SIZE - sizeof(etl::atomic<size_t>)];
+
+    const size_type MAX_SIZE; ///< The maximum number of items in the queue.
+    const size_t    WRAP;     ///< The positions wrap to zero here, and the sequences at twice this.
+    const size_t    MASK;     ///< The index mask if MAX_SIZE is a power of 2, otherwise 0.
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_MPMC_QUEUE_ATOMIC) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~queue_mpmc_atomic_base()
+    {
+    }
+#else
+  protected:
+    ~queue_mpmc_atomic_base()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  ///\ingroup queue_mpmc
+  ///\brief This is the base for all queue_mpmc_atomics that contain a particular type.
+  ///\details Normally a reference to this type will be taken from a derived queue_mpmc_atomic.
+  ///\code
+  /// etl::queue_mpmc_atomic<int, 10> myQueue;
+  /// etl::iqueue_mpmc_atomic<int>& iQueue = myQueue;
+  ///\endcode
+  /// This queue supports concurrent access by multiple producers and multiple consumers.
+  /// It does not lock. Each slot has a sequence number that says whether it
+  /// is ready to be written or read on the current lap of the buffer.
+  /// Producers and consumers claim positions with a compare and swap.
+  /// \tparam T The type of value that the queue_mpmc_atomic holds.
+  //***************************************************************************
+  template <typename T, const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
+  class iqueue_mpmc_atomic : public queue_mpmc_atomic_base<MEMORY_MODEL>
+  {
+  private:
+
+    typedef typename etl::parameter_type<T>::type              parameter_t;
+    typedef typename etl::queue_mpmc_atomic_base<MEMORY_MODEL> base_t;
+
+  public:
+
+    typedef T                          value_type;      ///< The type stored in the queue.
+    typedef T&                         reference;       ///< A reference to the type used in the queue.
+    typedef const T&                   const_reference; ///< A const reference to the type used in the queue.
+    typedef typename base_t::size_type size_type;       ///< The type used for determining the size of the queue.
+
+    using base_t::enqueue_position;
+    using base_t::dequeue_position;
+    using base_t::MAX_SIZE;
+    using base_t::next_position;
+    using base_t::next_lap;
+    using base_t::difference;
+    using base_t::push_sequence;
+    using base_t::pop_sequence;
+    using base_t::sequence_difference;
+    using base_t::get_index;
+
+    //*************************************************************************
+    /// Push a value to the queue.
+    //*************************************************************************
+    bool push(parameter_t value)
+    {
+      cell*  p_cell;
+      size_t position;
+
+      if (claim_push(p_cell, position))
+      {
+        ::new (&p_cell->value) T(value);
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL) && !ETL_QUEUE_MPMC_ATOMIC_FORCE_CPP03
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename ... Args>
+    bool emplace(Args&&... args)
+    {
+      cell*  p_cell;
+      size_t position;
+
+      if (claim_push(p_cell, position))
+      {
+        ::new (&p_cell->value) T(std::forward<Args>(args)...);
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+#else
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1>
+    bool emplace(const T1& value1)
+    {
+      cell*  p_cell;
+      size_t position;
+
+      if (claim_push(p_cell, position))
+      {
+        ::new (&p_cell->value) T(value1);
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1, typename T2>
+    bool emplace(const T1& value1, const T2& value2)
+    {
+      cell*  p_cell;
+      size_t position;
+
+      if (claim_push(p_cell, position))
+      {
+        ::new (&p_cell->value) T(value1, value2);
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3>
+    bool emplace(const T1& value1, const T2& value2, const T3& value3)
+    {
+      cell*  p_cell;
+      size_t position;
+
+      if (claim_push(p_cell, position))
+      {
+        ::new (&p_cell->value) T(value1, value2, value3);
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Constructs a value in the queue 'in place'.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3, typename T4>
+    bool emplace(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      cell*  p_cell;
+      size_t position;
+
+      if (claim_push(p_cell, position))
+      {
+        ::new (&p_cell->value) T(value1, value2, value3, value4);
+        publish_push(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is full.
+      return false;
+    }
+#endif
+
+    //*************************************************************************
+    /// Pop a value from the queue.
+    //*************************************************************************
+    bool pop(reference value)
+    {
+      cell*  p_cell;
+      size_t position;
+
+      if (claim_pop(p_cell, position))
+      {
+        T& item = *reinterpret_cast<T*>(&p_cell->value);
+
+        value = item;
+        item.~T();
+
+        publish_pop(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is empty.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Pop a value from the queue and discard.
+    //*************************************************************************
+    bool pop()
+    {
+      cell*  p_cell;
+      size_t position;
+
+      if (claim_pop(p_cell, position))
+      {
+        reinterpret_cast<T*>(&p_cell->value)->~T();
+
+        publish_pop(p_cell, position);
+
+        return true;
+      }
+
+      // Queue is empty.
+      return false;
+    }
+
+    //*************************************************************************
+    /// Clear the queue.
+    //*************************************************************************
+    void clear()
+    {
+      while (pop())
+      {
+        // Do nothing.
+      }
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// A slot in the buffer.
+    /// 'sequence' equals push_sequence(position) when the slot is ready to be
+    /// pushed to, and pop_sequence(position) when it is ready to be popped from.
+    //*************************************************************************
+    struct cell
+    {
+      etl::atomic<size_t> sequence;
+      typename etl::aligned_storage<sizeof(T), etl::alignment_of<T>::value>::type value;
+    };
+
+    //*************************************************************************
+    /// The constructor that is called from derived classes.
+    //*************************************************************************
+    iqueue_mpmc_atomic(cell* p_buffer_, size_type max_size_)
+      : base_t(max_size_),
+        p_buffer(p_buffer_)
+    {
+      for (size_t i = 0; i < max_size_; ++i)
+      {
+        ::new (&p_buffer[i]) cell;
+        p_buffer[i].sequence.store(push_sequence(i), etl::memory_order_relaxed);
+      }
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Claims a slot to push to.
+    /// Returns false if the queue is full.
+    //*************************************************************************
+    bool claim_push(cell*& p_cell, size_t& position)
+    {
+      position = enqueue_position.load(etl::memory_order_relaxed);
+
+      while (true)
+      {
+        p_cell = &p_buffer[get_index(position)];
+
+        const ptrdiff_t diff = sequence_difference(p_cell->sequence.load(etl::memory_order_acquire), push_sequence(position));
+
+        if (diff == 0)
+        {
+          // The slot is free on this lap. Try to claim it.
+          if (enqueue_position.compare_exchange_weak(position, next_position(position), etl::memory_order_relaxed))
+          {
+            return true;
+          }
+        }
+        else if (diff < 0)
+        {
+          // The slot still holds an item from the previous lap.
+          return false;
+        }
+        else
+        {
+          // Another producer got there first.
+          position = enqueue_position.load(etl::memory_order_relaxed);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Makes a pushed value visible to the consumers.
+    //*************************************************************************
+    void publish_push(cell* p_cell, size_t position)
+    {
+      p_cell->sequence.store(pop_sequence(position), etl::memory_order_release);
+    }
+
+    //*************************************************************************
+    /// Claims a slot to pop from.
+    /// Returns false if the queue is empty.
+    //*************************************************************************
+    bool claim_pop(cell*& p_cell, size_t& position)
+    {
+      position = dequeue_position.load(etl::memory_order_relaxed);
+
+      while (true)
+      {
+        p_cell = &p_buffer[get_index(position)];
+
+        const ptrdiff_t diff = sequence_difference(p_cell->sequence.load(etl::memory_order_acquire), pop_sequence(position));
+
+        if (diff == 0)
+        {
+          // The slot has been pushed to on this lap. Try to claim it.
+          if (dequeue_position.compare_exchange_weak(position, next_position(position), etl::memory_order_relaxed))
+          {
+            return true;
+          }
+        }
+        else if (diff < 0)
+        {
+          // The slot has not been pushed to yet.
+          return false;
+        }
+        else
+        {
+          // Another consumer got there first.
+          position = dequeue_position.load(etl::memory_order_relaxed);
+        }
+      }
+    }
+
+    //*************************************************************************
+    /// Makes a popped slot available to the producers on the next lap.
+    //*************************************************************************
+    void publish_pop(cell* p_cell, size_t position)
+    {
+      p_cell->sequence.store(push_sequence(next_lap(position)), etl::memory_order_release);
+    }
+
+    // Disable copy construction and assignment.
+    iqueue_mpmc_atomic(const iqueue_mpmc_atomic&);
+    iqueue_mpmc_atomic& operator =(const iqueue_mpmc_atomic&);
+
+    cell* p_buffer; ///< The internal buffer.
+  };
+
+  //***************************************************************************
+  ///\ingroup queue_mpmc
+  /// A fixed capacity lock free mpmc queue.
+  /// This queue supports concurrent access by multiple producers and multiple consumers.
+  /// \tparam T            The type this queue should support.
+  /// \tparam SIZE         The maximum capacity of the queue.
+  /// \tparam MEMORY_MODEL The memory model for the queue. Determines the type of the size.
+  //***************************************************************************
+  template <typename T, size_t SIZE, const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
+  class queue_mpmc_atomic : public etl::iqueue_mpmc_atomic<T, MEMORY_MODEL>
+  {
+  private:
+
+    typedef etl::iqueue_mpmc_atomic<T, MEMORY_MODEL> base_t;
+
+  public:
+
+    typedef typename base_t::size_type size_type;
+
+    ETL_STATIC_ASSERT((SIZE > 0), "Size must be greater than zero");
+    ETL_STATIC_ASSERT((SIZE <= etl::integral_limits<size_type>::max), "Size too large for memory model");
+
+    static const size_type MAX_SIZE = size_type(SIZE);
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    queue_mpmc_atomic()
+      : base_t(reinterpret_cast<typename base_t::cell*>(&buffer[0]), MAX_SIZE)
+    {
+    }
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~queue_mpmc_atomic()
+    {
+      base_t::clear();
+    }
+
+  private:
+
+    queue_mpmc_atomic(const queue_mpmc_atomic&);
+    queue_mpmc_atomic& operator = (const queue_mpmc_atomic&);
+
+    /// The uninitialised slots used in the queue_mpmc_atomic.
+    typename etl::aligned_storage<sizeof(typename base_t::cell), etl::alignment_of<typename base_t::cell>::value>::type buffer[MAX_SIZE];
+  };
+}
+
+#endif
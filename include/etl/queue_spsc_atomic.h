@@ -40,6 +40,12 @@ SOFTWARE.
 #include "atomic.h"
 #include "memory_model.h"
 #include "integral_limits.h"
+#include "error_handler.h"
+#include "exception.h"
+
+#define ETL_IN_QUEUE_SPSC_ATOMIC_H
+#include "private/queue_spsc_span.h"
+#undef ETL_IN_QUEUE_SPSC_ATOMIC_H
 
 #undef ETL_FILE
 #define ETL_FILE "47"
@@ -48,9 +54,297 @@ SOFTWARE.
 
 namespace etl
 {
-  template <const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
-  class queue_spsc_atomic_base
+  //***************************************************************************
+  /// The base class for queue_spsc_atomic exceptions.
+  ///\ingroup queue_spsc_atomic
+  //***************************************************************************
+  class queue_spsc_atomic_exception : public etl::exception
   {
+  public:
+
+    queue_spsc_atomic_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The exception thrown when more items are committed or released than were
+  /// in the last span.
+  ///\ingroup queue_spsc_atomic
+  //***************************************************************************
+  class queue_spsc_atomic_span_size : public etl::queue_spsc_atomic_exception
+  {
+  public:
+
+    explicit queue_spsc_atomic_span_size(string_type file_name_, numeric_type line_number_)
+      : queue_spsc_atomic_exception(ETL_ERROR_TEXT("queue_spsc_atomic:span size", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The layouts of the queue_spsc_atomic indexes.
+  //***************************************************************************
+  struct queue_spsc_atomic_layout
+  {
+    enum
+    {
+      COMPACT,  ///< The read and write indexes are adjacent. The smallest layout.
+      SEPARATED ///< The indexes are on separate cache lines and each side caches the other's index.
+    };
+  };
+
+  namespace private_queue_spsc_atomic
+  {
+    //*************************************************************************
+    /// The read and write indexes for the COMPACT layout.
+    /// Every push and pop loads the other side's index.
+    //*************************************************************************
+    template <typename TSize, const size_t LAYOUT>
+    class indexes
+    {
+    protected:
+
+      indexes()
+        : write(0),
+          read(0)
+      {
+      }
+
+      //***********************************************************************
+      /// Called from the 'push' thread.
+      /// Is there space to advance the write index to 'next_index'?
+      //***********************************************************************
+      bool can_push(TSize next_index)
+      {
+        return next_index != read.load(etl::memory_order_acquire);
+      }
+
+      //***********************************************************************
+      /// Called from the 'pop' thread.
+      /// Is there an item at 'read_index'?
+      //***********************************************************************
+      bool can_pop(TSize read_index)
+      {
+        return read_index != write.load(etl::memory_order_acquire);
+      }
+
+      //***********************************************************************
+      /// Called from the 'push' thread.
+      /// Gets the current read index.
+      //***********************************************************************
+      TSize refresh_read()
+      {
+        return read.load(etl::memory_order_acquire);
+      }
+
+      //***********************************************************************
+      /// Called from the 'pop' thread.
+      /// Gets the current write index.
+      //***********************************************************************
+      TSize refresh_write()
+      {
+        return write.load(etl::memory_order_acquire);
+      }
+
+      //***********************************************************************
+      /// Called from the 'push' and 'pop' threads.
+      /// This layout does not keep the span sizes, so that it stays as small
+      /// as possible and neither thread writes anything but its own index.
+      //***********************************************************************
+      void set_write_span_size(TSize)
+      {
+      }
+
+      void set_read_span_size(TSize)
+      {
+      }
+
+      //***********************************************************************
+      /// Called from the 'push' thread.
+      /// Can 'n' values be committed? Checked against the free space.
+      //***********************************************************************
+      bool use_write_span(size_t n, TSize reserved)
+      {
+        TSize write_index = write.load(etl::memory_order_relaxed);
+        TSize read_index  = read.load(etl::memory_order_acquire);
+        TSize used        = (write_index >= read_index) ? TSize(write_index - read_index) : TSize(reserved - read_index + write_index);
+
+        return n <= size_t(reserved - 1 - used);
+      }
+
+      //***********************************************************************
+      /// Called from the 'pop' thread.
+      /// Can 'n' items be released? Checked against the items in the queue.
+      //***********************************************************************
+      bool use_read_span(size_t n, TSize reserved)
+      {
+        TSize read_index  = read.load(etl::memory_order_relaxed);
+        TSize write_index = write.load(etl::memory_order_acquire);
+        TSize used        = (write_index >= read_index) ? TSize(write_index - read_index) : TSize(reserved - read_index + write_index);
+
+        return n <= size_t(used);
+      }
+
+      etl::atomic<TSize> write; ///< Where to input new data.
+      etl::atomic<TSize> read;  ///< Where to get the oldest data.
+    };
+
+    //*************************************************************************
+    /// The read and write indexes for the SEPARATED layout.
+    /// The 'push' thread keeps a copy of the read index and the 'pop' thread a
+    /// copy of the write index. The copies are only refreshed when they say
+    /// that the queue is full or empty, so a push or pop that does not reach
+    /// the other side's index touches no cache line written by the other thread.
+    //*************************************************************************
+    template <typename TSize>
+    class indexes<TSize, etl::queue_spsc_atomic_layout::SEPARATED>
+    {
+    protected:
+
+      indexes()
+        : write(0),
+          read_cache(0),
+          write_span_size(0),
+          read(0),
+          write_cache(0),
+          read_span_size(0)
+      {
+      }
+
+      //***********************************************************************
+      /// Called from the 'push' thread.
+      /// Is there space to advance the write index to 'next_index'?
+      /// The read index only moves towards the write index, so a stale copy
+      /// can only under-estimate the space.
+      //***********************************************************************
+      bool can_push(TSize next_index)
+      {
+        if (next_index == read_cache)
+        {
+          read_cache = read.load(etl::memory_order_acquire);
+        }
+
+        return next_index != read_cache;
+      }
+
+      //***********************************************************************
+      /// Called from the 'pop' thread.
+      /// Is there an item at 'read_index'?
+      /// The write index only moves away from the read index, so a stale copy
+      /// can only under-estimate the number of items.
+      //***********************************************************************
+      bool can_pop(TSize read_index)
+      {
+        if (read_index == write_cache)
+        {
+          write_cache = write.load(etl::memory_order_acquire);
+        }
+
+        return read_index != write_cache;
+      }
+
+      //***********************************************************************
+      /// Called from the 'push' thread.
+      /// Gets the current read index and updates the copy.
+      //***********************************************************************
+      TSize refresh_read()
+      {
+        read_cache = read.load(etl::memory_order_acquire);
+
+        return read_cache;
+      }
+
+      //***********************************************************************
+      /// Called from the 'pop' thread.
+      /// Gets the current write index and updates the copy.
+      //***********************************************************************
+      TSize refresh_write()
+      {
+        write_cache = write.load(etl::memory_order_acquire);
+
+        return write_cache;
+      }
+
+      //***********************************************************************
+      /// Called from the 'push' thread.
+      /// Records the size of the write span that was handed out.
+      //***********************************************************************
+      void set_write_span_size(TSize n)
+      {
+        write_span_size = n;
+      }
+
+      //***********************************************************************
+      /// Called from the 'pop' thread.
+      /// Records the size of the read span that was handed out.
+      //***********************************************************************
+      void set_read_span_size(TSize n)
+      {
+        read_span_size = n;
+      }
+
+      //***********************************************************************
+      /// Called from the 'push' thread.
+      /// Can 'n' values be committed? Checked against what is left of the
+      /// last write span, which is then reduced by 'n'.
+      //***********************************************************************
+      bool use_write_span(size_t n, TSize)
+      {
+        if (n > write_span_size)
+        {
+          return false;
+        }
+
+        write_span_size -= TSize(n);
+
+        return true;
+      }
+
+      //***********************************************************************
+      /// Called from the 'pop' thread.
+      /// Can 'n' items be released? Checked against what is left of the
+      /// last read span, which is then reduced by 'n'.
+      //***********************************************************************
+      bool use_read_span(size_t n, TSize)
+      {
+        if (n > read_span_size)
+        {
+          return false;
+        }
+
+        read_span_size -= TSize(n);
+
+        return true;
+      }
+
+      // The 'push' and 'pop' sides are each on their own cache line.
+      char               padding0[ETL_CACHE_LINE_SIZE];
+      etl::atomic<TSize> write;           ///< Where to input new data.
+      TSize              read_cache;      ///< The 'push' thread's copy of 'read'.
+      TSize              write_span_size; ///< The uncommitted size of the last write span.
+      char               padding1[ETL_CACHE_LINE_SIZE];
+      etl::atomic<TSize> read;            ///< Where to get the oldest data.
+      TSize              write_cache;     ///< The 'pop' thread's copy of 'write'.
+      TSize              read_span_size;  ///< The unreleased size of the last read span.
+      char               padding2[ETL_CACHE_LINE_SIZE];
+    };
+  }
+
+  //***************************************************************************
+  /// The base for all queue_spsc_atomic.
+  /// \tparam MEMORY_MODEL The memory model for the queue. Determines the type of the internal counter variables.
+  /// \tparam LAYOUT       The layout of the indexes. See etl::queue_spsc_atomic_layout.
+  //***************************************************************************
+  template <const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE,
+            const size_t LAYOUT       = etl::queue_spsc_atomic_layout::COMPACT>
+  class queue_spsc_atomic_base : protected private_queue_spsc_atomic::indexes<typename etl::size_type_lookup<MEMORY_MODEL>::type, LAYOUT>
+  {
+  private:
+
+    typedef private_queue_spsc_atomic::indexes<typename etl::size_type_lookup<MEMORY_MODEL>::type, LAYOUT> indexes_t;
+
   public:
 
     /// The type used for determining the size of queue.
@@ -85,20 +379,9 @@ namespace etl
     size_type size() const
     {
       size_type write_index = write.load(etl::memory_order_acquire);
-      size_type read_index = read.load(etl::memory_order_acquire);
-
-      size_type n;
+      size_type read_index  = read.load(etl::memory_order_acquire);
 
-      if (write_index >= read_index)
-      {
-        n = write_index - read_index;
-      }
-      else
-      {
-        n = RESERVED - read_index + write_index - 1;
-      }
-
-      return n;
+      return items_between(read_index, write_index);
     }
 
     //*************************************************************************
@@ -129,9 +412,7 @@ namespace etl
   protected:
 
     queue_spsc_atomic_base(size_type reserved_)
-      : write(0),
-        read(0),
-        RESERVED(reserved_)
+      : RESERVED(reserved_)
     {
     }
 
@@ -150,9 +431,42 @@ namespace etl
       return index;
     }
 
-    etl::atomic<size_type> write; ///< Where to input new data.
-    etl::atomic<size_type> read;  ///< Where to get the oldest data.
-    const size_type RESERVED;     ///< The maximum number of items in the queue.
+    //*************************************************************************
+    /// Calculate the index 'n' places after 'index'.
+    //*************************************************************************
+    static size_type get_index_after(size_type index, size_t n, size_type maximum)
+    {
+      size_t result = size_t(index) + n;
+
+      if (result >= maximum)
+      {
+        result -= maximum;
+      }
+
+      return size_type(result);
+    }
+
+    //*************************************************************************
+    /// The number of items between 'read_index' and 'write_index'.
+    //*************************************************************************
+    size_type items_between(size_type read_index, size_type write_index) const
+    {
+      return (write_index >= read_index) ? size_type(write_index - read_index)
+                                         : size_type(RESERVED - read_index + write_index);
+    }
+
+    using indexes_t::write;
+    using indexes_t::read;
+    using indexes_t::can_push;
+    using indexes_t::can_pop;
+    using indexes_t::refresh_read;
+    using indexes_t::refresh_write;
+    using indexes_t::set_write_span_size;
+    using indexes_t::set_read_span_size;
+    using indexes_t::use_write_span;
+    using indexes_t::use_read_span;
+
+    const size_type RESERVED; ///< The maximum number of items in the queue.
 
   private:
 
@@ -181,15 +495,19 @@ namespace etl
   /// etl::iqueue_spsc_atomic<int>& iQueue = myQueue;
   ///\endcode
   /// This queue supports concurrent access by one producer and one consumer.
-  /// \tparam T The type of value that the queue_spsc_atomic holds.
+  /// \tparam T            The type of value that the queue_spsc_atomic holds.
+  /// \tparam MEMORY_MODEL The memory model for the queue. Determines the type of the internal counter variables.
+  /// \tparam LAYOUT       The layout of the indexes. See etl::queue_spsc_atomic_layout.
   //***************************************************************************
-  template <typename T, const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
-  class iqueue_spsc_atomic : public queue_spsc_atomic_base<MEMORY_MODEL>
+  template <typename T,
+            const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE,
+            const size_t LAYOUT       = etl::queue_spsc_atomic_layout::COMPACT>
+  class iqueue_spsc_atomic : public queue_spsc_atomic_base<MEMORY_MODEL, LAYOUT>
   {
   private:
 
-    typedef typename etl::parameter_type<T>::type              parameter_t;
-    typedef typename etl::queue_spsc_atomic_base<MEMORY_MODEL> base_t;
+    typedef typename etl::parameter_type<T>::type                      parameter_t;
+    typedef typename etl::queue_spsc_atomic_base<MEMORY_MODEL, LAYOUT> base_t;
 
   public:
 
@@ -198,6 +516,9 @@ namespace etl
     typedef const T&                   const_reference; ///< A const reference to the type used in the queue.
     typedef typename base_t::size_type size_type;       ///< The type used for determining the size of the queue.
 
+    /// Up to two contiguous regions of the queue's buffer.
+    typedef etl::private_queue_spsc::span_pair<T> span_pair_type;
+
     using base_t::write;
     using base_t::read;
     using base_t::RESERVED;
@@ -211,7 +532,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, RESERVED);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(value);
 
@@ -235,7 +556,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, RESERVED);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(std::forward<Args>(args)...);
 
@@ -258,7 +579,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, RESERVED);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(value1);
 
@@ -281,7 +602,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, RESERVED);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(value1, value2);
 
@@ -304,7 +625,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, RESERVED);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(value1, value2, value3);
 
@@ -327,7 +648,7 @@ namespace etl
       size_type write_index = write.load(etl::memory_order_relaxed);
       size_type next_index  = get_next_index(write_index, RESERVED);
 
-      if (next_index != read.load(etl::memory_order_acquire))
+      if (can_push(next_index))
       {
         ::new (&p_buffer[write_index]) T(value1, value2, value3, value4);
 
@@ -348,7 +669,7 @@ namespace etl
     {
       size_type read_index = read.load(etl::memory_order_relaxed);
 
-      if (read_index == write.load(etl::memory_order_acquire))
+      if (!can_pop(read_index))
       {
         // Queue is empty
         return false;
@@ -371,7 +692,7 @@ namespace etl
     {
       size_type read_index = read.load(etl::memory_order_relaxed);
 
-      if (read_index == write.load(etl::memory_order_acquire))
+      if (!can_pop(read_index))
       {
         // Queue is empty
         return false;
@@ -386,6 +707,139 @@ namespace etl
       return true;
     }
 
+    //*************************************************************************
+    /// Push values from a range to the queue.
+    /// Pushes as many as there is space for, then publishes them all at once.
+    /// Called from the 'push' thread.
+    ///\return The number of values pushed.
+    //*************************************************************************
+    template <typename TIterator>
+    size_type push(TIterator first, TIterator last)
+    {
+      size_type write_index = write.load(etl::memory_order_relaxed);
+      size_type read_index  = refresh_read();
+      size_type n           = size_type(RESERVED - 1 - base_t::items_between(read_index, write_index));
+      size_type count       = 0;
+
+      while ((count < n) && (first != last))
+      {
+        ::new (&p_buffer[write_index]) T(*first);
+        write_index = get_next_index(write_index, RESERVED);
+        ++first;
+        ++count;
+      }
+
+      write.store(write_index, etl::memory_order_release);
+
+      return count;
+    }
+
+    //*************************************************************************
+    /// Pop up to 'max_n' values from the queue to an output iterator.
+    /// Releases all of the popped slots at once.
+    /// Called from the 'pop' thread.
+    ///\return The number of values popped.
+    //*************************************************************************
+    template <typename TOutputIterator>
+    size_type pop(TOutputIterator destination, size_t max_n)
+    {
+      size_type read_index  = read.load(etl::memory_order_relaxed);
+      size_type write_index = refresh_write();
+      size_type n           = base_t::items_between(read_index, write_index);
+
+      if (max_n < n)
+      {
+        n = size_type(max_n);
+      }
+
+      for (size_type i = 0; i < n; ++i)
+      {
+        *destination = p_buffer[read_index];
+        ++destination;
+        p_buffer[read_index].~T();
+        read_index = get_next_index(read_index, RESERVED);
+      }
+
+      read.store(read_index, etl::memory_order_release);
+
+      return n;
+    }
+
+    //*************************************************************************
+    /// Gets the free space in the queue as up to two contiguous regions of
+    /// uninitialised storage. Write or construct values in order from the start
+    /// of 'first', then call commit() to publish them.
+    /// Called from the 'push' thread.
+    //*************************************************************************
+    span_pair_type write_span()
+    {
+      size_type write_index = write.load(etl::memory_order_relaxed);
+      size_type read_index  = refresh_read();
+
+      size_type n = RESERVED - 1 - base_t::items_between(read_index, write_index);
+
+      set_write_span_size(n);
+
+      return span_pair_type(p_buffer, write_index, n, RESERVED);
+    }
+
+    //*************************************************************************
+    /// Publishes the first 'n' values written to the last write_span().
+    /// Called from the 'push' thread.
+    /// If asserts or exceptions are enabled, emits etl::queue_spsc_atomic_span_size
+    /// if 'n' is more than is left uncommitted in the last write_span().
+    /// The COMPACT layout does not keep the span size, and checks 'n' against
+    /// the free space instead.
+    //*************************************************************************
+    void commit(size_t n)
+    {
+      ETL_ASSERT(use_write_span(n, RESERVED), ETL_ERROR(queue_spsc_atomic_span_size));
+
+      size_type write_index = write.load(etl::memory_order_relaxed);
+
+      write.store(base_t::get_index_after(write_index, n, RESERVED), etl::memory_order_release);
+    }
+
+    //*************************************************************************
+    /// Gets the items in the queue as up to two contiguous regions, oldest first.
+    /// Call release() to remove them from the queue.
+    /// Called from the 'pop' thread.
+    //*************************************************************************
+    span_pair_type read_span()
+    {
+      size_type read_index  = read.load(etl::memory_order_relaxed);
+      size_type write_index = refresh_write();
+
+      size_type n = base_t::items_between(read_index, write_index);
+
+      set_read_span_size(n);
+
+      return span_pair_type(p_buffer, read_index, n, RESERVED);
+    }
+
+    //*************************************************************************
+    /// Destroys the first 'n' items of the last read_span() and frees their space.
+    /// Called from the 'pop' thread.
+    /// If asserts or exceptions are enabled, emits etl::queue_spsc_atomic_span_size
+    /// if 'n' is more than is left unreleased in the last read_span().
+    /// The COMPACT layout does not keep the span size, and checks 'n' against
+    /// the items in the queue instead.
+    //*************************************************************************
+    void release(size_t n)
+    {
+      ETL_ASSERT(use_read_span(n, RESERVED), ETL_ERROR(queue_spsc_atomic_span_size));
+
+      size_type read_index = read.load(etl::memory_order_relaxed);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        p_buffer[read_index].~T();
+        read_index = get_next_index(read_index, RESERVED);
+      }
+
+      read.store(read_index, etl::memory_order_release);
+    }
+
     //*************************************************************************
     /// Clear the queue.
     /// Must be called from thread that pops the queue or when there is no
@@ -412,6 +866,15 @@ namespace etl
 
   private:
 
+    using base_t::can_push;
+    using base_t::can_pop;
+    using base_t::refresh_read;
+    using base_t::refresh_write;
+    using base_t::set_write_span_size;
+    using base_t::set_read_span_size;
+    using base_t::use_write_span;
+    using base_t::use_read_span;
+
     // Disable copy construction and assignment.
     iqueue_spsc_atomic(const iqueue_spsc_atomic&);
     iqueue_spsc_atomic& operator =(const iqueue_spsc_atomic&);
@@ -426,13 +889,18 @@ namespace etl
   /// \tparam T            The type this queue should support.
   /// \tparam SIZE         The maximum capacity of the queue.
   /// \tparam MEMORY_MODEL The memory model for the queue. Determines the type of the internal counter variables.
+  /// \tparam LAYOUT       The layout of the indexes. etl::queue_spsc_atomic_layout::SEPARATED avoids false sharing
+  ///                      between the producer and consumer at the cost of three cache lines of padding.
   //***************************************************************************
-  template <typename T, size_t SIZE, const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
-  class queue_spsc_atomic : public iqueue_spsc_atomic<T, MEMORY_MODEL>
+  template <typename T,
+            size_t SIZE,
+            const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE,
+            const size_t LAYOUT       = etl::queue_spsc_atomic_layout::COMPACT>
+  class queue_spsc_atomic : public iqueue_spsc_atomic<T, MEMORY_MODEL, LAYOUT>
   {
   private:
 
-    typedef typename etl::iqueue_spsc_atomic<T, MEMORY_MODEL> base_t;
+    typedef typename etl::iqueue_spsc_atomic<T, MEMORY_MODEL, LAYOUT> base_t;
 
   public:
 
@@ -39,6 +39,12 @@ SOFTWARE.
 #include "parameter_type.h"
 #include "memory_model.h"
 #include "integral_limits.h"
+#include "error_handler.h"
+#include "exception.h"
+
+#define ETL_IN_QUEUE_SPSC_ISR_H
+#include "private/queue_spsc_span.h"
+#undef ETL_IN_QUEUE_SPSC_ISR_H
 
 #undef ETL_FILE
 #define ETL_FILE "46"
@@ -47,6 +53,35 @@ SOFTWARE.
 
 namespace etl
 {
+  //***************************************************************************
+  /// The base class for queue_spsc_isr exceptions.
+  ///\ingroup queue_spsc
+  //***************************************************************************
+  class queue_spsc_isr_exception : public etl::exception
+  {
+  public:
+
+    queue_spsc_isr_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The exception thrown when more items are committed or released than were
+  /// in the last span.
+  ///\ingroup queue_spsc
+  //***************************************************************************
+  class queue_spsc_isr_span_size : public etl::queue_spsc_isr_exception
+  {
+  public:
+
+    explicit queue_spsc_isr_span_size(string_type file_name_, numeric_type line_number_)
+      : queue_spsc_isr_exception(ETL_ERROR_TEXT("queue_spsc_isr:span size", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
   template <typename T, const size_t MEMORY_MODEL = etl::memory_model::MEMORY_MODEL_LARGE>
   class queue_spsc_isr_base
   {
@@ -63,6 +98,9 @@ namespace etl
     typedef T&       reference;       ///< A reference to the type used in the queue.
     typedef const T& const_reference; ///< A const reference to the type used in the queue.
 
+    /// Up to two contiguous regions of the queue's buffer.
+    typedef etl::private_queue_spsc::span_pair<T> span_pair_type;
+
     //*************************************************************************
     /// Push a value to the queue from an ISR.
     //*************************************************************************
@@ -100,6 +138,68 @@ namespace etl
       return pop_implementation();
     }
 
+    //*************************************************************************
+    /// Push values from a range to the queue from an ISR.
+    ///\return The number of values pushed.
+    //*************************************************************************
+    template <typename TIterator>
+    size_type push_from_isr(TIterator first, TIterator last)
+    {
+      return push_implementation(first, last);
+    }
+
+    //*************************************************************************
+    /// Pop up to 'max_n' values from the queue to an output iterator from an ISR.
+    ///\return The number of values popped.
+    //*************************************************************************
+    template <typename TOutputIterator>
+    size_type pop_from_isr(TOutputIterator destination, size_t max_n)
+    {
+      return pop_implementation(destination, max_n);
+    }
+
+    //*************************************************************************
+    /// Gets the free space in the queue from an ISR.
+    /// See write_span().
+    //*************************************************************************
+    span_pair_type write_span_from_isr()
+    {
+      return write_span_implementation();
+    }
+
+    //*************************************************************************
+    /// Publishes the first 'n' values written to the last write_span_from_isr().
+    /// If asserts or exceptions are enabled, emits etl::queue_spsc_isr_span_size
+    /// if 'n' is more than is left uncommitted in the last write_span_from_isr().
+    //*************************************************************************
+    void commit_from_isr(size_t n)
+    {
+      ETL_ASSERT(n <= write_span_size, ETL_ERROR(queue_spsc_isr_span_size));
+
+      commit_implementation(n);
+    }
+
+    //*************************************************************************
+    /// Gets the items in the queue from an ISR.
+    /// See read_span().
+    //*************************************************************************
+    span_pair_type read_span_from_isr()
+    {
+      return read_span_implementation();
+    }
+
+    //*************************************************************************
+    /// Destroys the first 'n' items of the last read_span_from_isr() and frees their space.
+    /// If asserts or exceptions are enabled, emits etl::queue_spsc_isr_span_size
+    /// if 'n' is more than is left unreleased in the last read_span_from_isr().
+    //*************************************************************************
+    void release_from_isr(size_t n)
+    {
+      ETL_ASSERT(n <= read_span_size, ETL_ERROR(queue_spsc_isr_span_size));
+
+      release_implementation(n);
+    }
+
     //*************************************************************************
     /// How much free space available in the queue.
     /// Called from ISR.
@@ -170,6 +270,8 @@ namespace etl
         write_index(0),
         read_index(0),
         current_size(0),
+        write_span_size(0),
+        read_span_size(0),
         MAX_SIZE(max_size_)
     {
     }
@@ -349,6 +451,112 @@ namespace etl
       return true;
     }
 
+    //*************************************************************************
+    /// Push values from a range to the queue.
+    //*************************************************************************
+    template <typename TIterator>
+    size_type push_implementation(TIterator first, TIterator last)
+    {
+      size_type count = 0;
+
+      while ((current_size != MAX_SIZE) && (first != last))
+      {
+        ::new (&p_buffer[write_index]) T(*first);
+
+        write_index = get_next_index(write_index, MAX_SIZE);
+
+        ++current_size;
+        ++first;
+        ++count;
+      }
+
+      return count;
+    }
+
+    //*************************************************************************
+    /// Pop up to 'max_n' values from the queue to an output iterator.
+    //*************************************************************************
+    template <typename TOutputIterator>
+    size_type pop_implementation(TOutputIterator destination, size_t max_n)
+    {
+      size_type count = 0;
+
+      while ((current_size != 0) && (count < max_n))
+      {
+        *destination = p_buffer[read_index];
+        ++destination;
+        p_buffer[read_index].~T();
+
+        read_index = get_next_index(read_index, MAX_SIZE);
+
+        --current_size;
+        ++count;
+      }
+
+      return count;
+    }
+
+    //*************************************************************************
+    /// Gets the free space in the queue.
+    //*************************************************************************
+    span_pair_type write_span_implementation()
+    {
+      write_span_size = MAX_SIZE - current_size;
+
+      return span_pair_type(p_buffer, write_index, write_span_size, MAX_SIZE);
+    }
+
+    //*************************************************************************
+    /// Publishes 'n' values written to the free space.
+    //*************************************************************************
+    void commit_implementation(size_t n)
+    {
+      write_span_size -= size_type(n);
+      write_index   = get_index_after(write_index, n, MAX_SIZE);
+      current_size += size_type(n);
+    }
+
+    //*************************************************************************
+    /// Gets the items in the queue.
+    //*************************************************************************
+    span_pair_type read_span_implementation()
+    {
+      read_span_size = current_size;
+
+      return span_pair_type(p_buffer, read_index, read_span_size, MAX_SIZE);
+    }
+
+    //*************************************************************************
+    /// Destroys 'n' items from the front of the queue.
+    //*************************************************************************
+    void release_implementation(size_t n)
+    {
+      read_span_size -= size_type(n);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        p_buffer[read_index].~T();
+        read_index = get_next_index(read_index, MAX_SIZE);
+      }
+
+      current_size -= size_type(n);
+    }
+
+    //*************************************************************************
+    /// Calculate the index 'n' places after 'index'.
+    //*************************************************************************
+    static size_type get_index_after(size_type index, size_t n, size_type maximum)
+    {
+      size_t result = size_t(index) + n;
+
+      if (result >= maximum)
+      {
+        result -= maximum;
+      }
+
+      return size_type(result);
+    }
+
     //*************************************************************************
     /// Calculate the next index.
     //*************************************************************************
@@ -364,11 +572,13 @@ namespace etl
       return index;
     }
 
-    T* p_buffer;              ///< The internal buffer.
-    size_type write_index;    ///< Where to input new data.
-    size_type read_index;     ///< Where to get the oldest data.
-    size_type current_size;   ///< The current size of the queue.
-    const size_type MAX_SIZE; ///< The maximum number of items in the queue.
+    T* p_buffer;               ///< The internal buffer.
+    size_type write_index;     ///< Where to input new data.
+    size_type read_index;      ///< Where to get the oldest data.
+    size_type current_size;    ///< The current size of the queue.
+    size_type write_span_size; ///< The uncommitted size of the last write span.
+    size_type read_span_size;  ///< The unreleased size of the last read span.
+    const size_type MAX_SIZE;  ///< The maximum number of items in the queue.
 
   private:
 
@@ -413,6 +623,7 @@ namespace etl
     typedef typename base_t::reference       reference;       ///< A reference to the type used in the queue.
     typedef typename base_t::const_reference const_reference; ///< A const reference to the type used in the queue.
     typedef typename base_t::size_type       size_type;       ///< The type used for determining the size of the queue.
+    typedef typename base_t::span_pair_type  span_pair_type;  ///< Up to two contiguous regions of the queue's buffer.
 
     //*************************************************************************
     /// Push a value to the queue.
@@ -538,6 +749,104 @@ namespace etl
       return result;
     }
 
+    //*************************************************************************
+    /// Push values from a range to the queue.
+    /// Pushes as many as there is space for.
+    ///\return The number of values pushed.
+    //*************************************************************************
+    template <typename TIterator>
+    size_type push(TIterator first, TIterator last)
+    {
+      TAccess::lock();
+
+      size_type result = this->push_implementation(first, last);
+
+      TAccess::unlock();
+
+      return result;
+    }
+
+    //*************************************************************************
+    /// Pop up to 'max_n' values from the queue to an output iterator.
+    ///\return The number of values popped.
+    //*************************************************************************
+    template <typename TOutputIterator>
+    size_type pop(TOutputIterator destination, size_t max_n)
+    {
+      TAccess::lock();
+
+      size_type result = this->pop_implementation(destination, max_n);
+
+      TAccess::unlock();
+
+      return result;
+    }
+
+    //*************************************************************************
+    /// Gets the free space in the queue as up to two contiguous regions of
+    /// uninitialised storage. Write or construct values in order from the start
+    /// of 'first', then call commit() to publish them.
+    /// The interrupts are only disabled while the regions are found, so the
+    /// buffer may be filled by a copy or DMA while the ISR is popping.
+    //*************************************************************************
+    span_pair_type write_span()
+    {
+      TAccess::lock();
+
+      span_pair_type result = this->write_span_implementation();
+
+      TAccess::unlock();
+
+      return result;
+    }
+
+    //*************************************************************************
+    /// Publishes the first 'n' values written to the last write_span().
+    /// If asserts or exceptions are enabled, emits etl::queue_spsc_isr_span_size
+    /// if 'n' is more than is left uncommitted in the last write_span().
+    //*************************************************************************
+    void commit(size_t n)
+    {
+      ETL_ASSERT(n <= this->write_span_size, ETL_ERROR(queue_spsc_isr_span_size));
+
+      TAccess::lock();
+
+      this->commit_implementation(n);
+
+      TAccess::unlock();
+    }
+
+    //*************************************************************************
+    /// Gets the items in the queue as up to two contiguous regions, oldest first.
+    /// Call release() to remove them from the queue.
+    //*************************************************************************
+    span_pair_type read_span()
+    {
+      TAccess::lock();
+
+      span_pair_type result = this->read_span_implementation();
+
+      TAccess::unlock();
+
+      return result;
+    }
+
+    //*************************************************************************
+    /// Destroys the first 'n' items of the last read_span() and frees their space.
+    /// If asserts or exceptions are enabled, emits etl::queue_spsc_isr_span_size
+    /// if 'n' is more than is left unreleased in the last read_span().
+    //*************************************************************************
+    void release(size_t n)
+    {
+      ETL_ASSERT(n <= this->read_span_size, ETL_ERROR(queue_spsc_isr_span_size));
+
+      TAccess::lock();
+
+      this->release_implementation(n);
+
+      TAccess::unlock();
+    }
+
     //*************************************************************************
     /// Clear the queue.
     //*************************************************************************
@@ -37,6 +37,7 @@ SOFTWARE.
 #include "exception.h"
 #include "error_handler.h"
 #include "debug_count.h"
+#include "algorithm.h"
 #include "vector.h"
 
 #undef ETL_FILE
@@ -72,6 +73,20 @@ namespace etl
     }
   };
 
+  //***************************************************************************
+  ///\ingroup reference_flat_multimap
+  /// Iterator exception.
+  //***************************************************************************
+  class flat_multimap_iterator : public flat_multimap_exception
+  {
+  public:
+
+    flat_multimap_iterator(string_type file_name_, numeric_type line_number_)
+      : flat_multimap_exception(ETL_ERROR_TEXT("flat_multimap:iterator", ETL_FILE"C"), file_name_, line_number_)
+    {
+    }
+  };
+
   //***************************************************************************
   /// The base class for specifically sized reference_flat_multimaps.
   /// Can be used as a reference type for all reference_flat_multimaps containing a specific type.
@@ -318,6 +333,16 @@ namespace etl
         return comp(key, element.first);
       }
 
+      bool operator ()(const value_type* element, key_type key) const
+      {
+        return comp(element->first, key);
+      }
+
+      bool operator ()(key_type key, const value_type* element) const
+      {
+        return comp(key, element->first);
+      }
+
       key_compare comp;
     };
 
@@ -614,7 +639,7 @@ namespace etl
     //*********************************************************************
     iterator lower_bound(key_parameter_t key)
     {
-      return std::lower_bound(begin(), end(), key, compare);
+      return iterator(search_t::lower_bound(lookup.begin(), lookup.end(), key, compare));
     }
 
     //*********************************************************************
@@ -624,7 +649,7 @@ namespace etl
     //*********************************************************************
     const_iterator lower_bound(key_parameter_t key) const
     {
-      return std::lower_bound(cbegin(), cend(), key, compare);
+      return const_iterator(search_t::lower_bound(lookup.cbegin(), lookup.cend(), key, compare));
     }
 
     //*********************************************************************
@@ -634,7 +659,7 @@ namespace etl
     //*********************************************************************
     iterator upper_bound(key_parameter_t key)
     {
-      return std::upper_bound(begin(), end(), key, compare);
+      return iterator(search_t::upper_bound(lookup.begin(), lookup.end(), key, compare));
     }
 
     //*********************************************************************
@@ -644,7 +669,7 @@ namespace etl
     //*********************************************************************
     const_iterator upper_bound(key_parameter_t key) const
     {
-      return std::upper_bound(begin(), end(), key, compare);
+      return const_iterator(search_t::upper_bound(lookup.cbegin(), lookup.cend(), key, compare));
     }
 
     //*********************************************************************
@@ -654,9 +679,9 @@ namespace etl
     //*********************************************************************
     std::pair<iterator, iterator> equal_range(key_parameter_t key)
     {
-      iterator i_lower = std::lower_bound(begin(), end(), key, compare);
+      typename lookup_t::iterator i_lower = search_t::lower_bound(lookup.begin(), lookup.end(), key, compare);
 
-      return std::make_pair(i_lower, std::upper_bound(i_lower, end(), key, compare));
+      return std::make_pair(iterator(i_lower), iterator(search_t::upper_bound(i_lower, lookup.end(), key, compare)));
     }
 
     //*********************************************************************
@@ -666,9 +691,9 @@ namespace etl
     //*********************************************************************
     std::pair<const_iterator, const_iterator> equal_range(key_parameter_t key) const
     {
-      const_iterator i_lower = std::lower_bound(cbegin(), cend(), key, compare);
+      typename lookup_t::const_iterator i_lower = search_t::lower_bound(lookup.cbegin(), lookup.cend(), key, compare);
 
-      return std::make_pair(i_lower, std::upper_bound(i_lower, cend(), key, compare));
+      return std::make_pair(const_iterator(i_lower), const_iterator(search_t::upper_bound(i_lower, lookup.cend(), key, compare)));
     }
 
     //*************************************************************************
@@ -762,13 +787,17 @@ namespace etl
       return result;
     }
 
+    /// The sorted pointers to the values.
+    lookup_t& lookup;
+
   private:
 
     // Disable copy construction and assignment.
     ireference_flat_multimap(const ireference_flat_multimap&);
     ireference_flat_multimap& operator = (const ireference_flat_multimap&);
 
-    lookup_t&  lookup;
+    /// Branchless for keys that are cheap to compare.
+    typedef etl::private_algorithm::sorted_search<etl::use_branchless_search<TKey>::value> search_t;
 
     Compare compare;
 
@@ -41,6 +41,7 @@ SOFTWARE.
 #include "stl/utility.h"
 
 #include "type_traits.h"
+#include "algorithm.h"
 #include "vector.h"
 #include "pool.h"
 #include "error_handler.h"
@@ -462,7 +463,7 @@ namespace etl
 
       ETL_ASSERT(!lookup.full(), ETL_ERROR(flat_multiset_full));
 
-      iterator i_element = std::lower_bound(begin(), end(), value, compare);
+      iterator i_element = lower_bound(value);
 
       if (i_element == end())
       {
@@ -566,7 +567,7 @@ namespace etl
     //*********************************************************************
     iterator find(parameter_t key)
     {
-      iterator itr = std::lower_bound(begin(), end(), key, compare);
+      iterator itr = lower_bound(key);
 
       if (itr != end())
       {
@@ -590,7 +591,7 @@ namespace etl
     //*********************************************************************
     const_iterator find(parameter_t key) const
     {
-      const_iterator itr = std::lower_bound(begin(), end(), key, compare);
+      const_iterator itr = lower_bound(key);
 
       if (itr != end())
       {
@@ -626,7 +627,7 @@ namespace etl
     //*********************************************************************
     iterator lower_bound(parameter_t key)
     {
-      return std::lower_bound(begin(), end(), key, compare);
+      return iterator(search_t::lower_bound(lookup.begin(), lookup.end(), key, compare));
     }
 
     //*********************************************************************
@@ -636,7 +637,7 @@ namespace etl
     //*********************************************************************
     const_iterator lower_bound(parameter_t key) const
     {
-      return std::lower_bound(cbegin(), cend(), key, compare);
+      return const_iterator(search_t::lower_bound(lookup.cbegin(), lookup.cend(), key, compare));
     }
 
     //*********************************************************************
@@ -646,7 +647,7 @@ namespace etl
     //*********************************************************************
     iterator upper_bound(parameter_t key)
     {
-      return std::upper_bound(begin(), end(), key, compare);
+      return iterator(search_t::upper_bound(lookup.begin(), lookup.end(), key, compare));
     }
 
     //*********************************************************************
@@ -656,7 +657,7 @@ namespace etl
     //*********************************************************************
     const_iterator upper_bound(parameter_t key) const
     {
-      return std::upper_bound(cbegin(), cend(), key, compare);
+      return const_iterator(search_t::upper_bound(lookup.cbegin(), lookup.cend(), key, compare));
     }
 
     //*********************************************************************
@@ -666,7 +667,9 @@ namespace etl
     //*********************************************************************
     std::pair<iterator, iterator> equal_range(parameter_t key)
     {
-      return std::equal_range(begin(), end(), key, compare);
+      typename lookup_t::iterator i_lower = search_t::lower_bound(lookup.begin(), lookup.end(), key, compare);
+
+      return std::make_pair(iterator(i_lower), iterator(search_t::upper_bound(i_lower, lookup.end(), key, compare)));
     }
 
     //*********************************************************************
@@ -676,7 +679,9 @@ namespace etl
     //*********************************************************************
     std::pair<const_iterator, const_iterator> equal_range(parameter_t key) const
     {
-      return std::equal_range(begin(), end(), key, compare);
+      typename lookup_t::const_iterator i_lower = search_t::lower_bound(lookup.cbegin(), lookup.cend(), key, compare);
+
+      return std::make_pair(const_iterator(i_lower), const_iterator(search_t::upper_bound(i_lower, lookup.cend(), key, compare)));
     }
 
     //*************************************************************************
@@ -775,15 +780,45 @@ namespace etl
       return result;
     }
 
+    /// The sorted pointers to the values.
+    lookup_t& lookup;
+
   private:
 
     // Disable copy construction.
     ireference_flat_multiset(const ireference_flat_multiset&);
     ireference_flat_multiset& operator =(const ireference_flat_multiset&);
 
-    lookup_t& lookup;
+    //*********************************************************************
+    /// How to compare elements and keys.
+    /// The lookup holds pointers to the elements.
+    //*********************************************************************
+    class Compare
+    {
+    public:
+
+      bool operator ()(const value_type& lhs, const value_type& rhs) const
+      {
+        return comp(lhs, rhs);
+      }
+
+      bool operator ()(const value_type* element, const value_type& key) const
+      {
+        return comp(*element, key);
+      }
+
+      bool operator ()(const value_type& key, const value_type* element) const
+      {
+        return comp(key, *element);
+      }
+
+      key_compare comp;
+    };
+
+    /// Branchless for keys that are cheap to compare.
+    typedef etl::private_algorithm::sorted_search<etl::use_branchless_search<T>::value> search_t;
 
-    TKeyCompare compare;
+    Compare compare;
 
     //*************************************************************************
     /// Destructor.
@@ -0,0 +1,789 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_SLAB_ALLOCATOR_INCLUDED
+#define ETL_SLAB_ALLOCATOR_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "platform.h"
+
+#include "stl/utility.h"
+
+#include "error_handler.h"
+#include "exception.h"
+#include "alignment.h"
+#include "largest.h"
+#include "nullptr.h"
+#include "pool.h"
+#include "static_assert.h"
+#include "type_traits.h"
+
+#undef ETL_FILE
+#define ETL_FILE "59"
+
+#define ETL_SLAB_ALLOCATOR_CPP03_CODE 0
+
+//*****************************************************************************
+///\defgroup slab_allocator slab_allocator
+/// A set of fixed capacity pools of different item sizes.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// The base class for slab_allocator exceptions.
+  ///\ingroup slab_allocator
+  //***************************************************************************
+  class slab_allocator_exception : public etl::exception
+  {
+  public:
+
+    slab_allocator_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The exception thrown when no size class can hold the requested type.
+  ///\ingroup slab_allocator
+  //***************************************************************************
+  class slab_allocator_no_class : public etl::slab_allocator_exception
+  {
+  public:
+
+    slab_allocator_no_class(string_type file_name_, numeric_type line_number_)
+      : slab_allocator_exception(ETL_ERROR_TEXT("slab_allocator:no class", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The exception thrown when an object is released which does not belong to
+  /// any of the size classes.
+  ///\ingroup slab_allocator
+  //***************************************************************************
+  class slab_allocator_not_in_slab : public etl::slab_allocator_exception
+  {
+  public:
+
+    slab_allocator_not_in_slab(string_type file_name_, numeric_type line_number_)
+      : slab_allocator_exception(ETL_ERROR_TEXT("slab_allocator:not in slab", ETL_FILE"B"), file_name_, line_number_)
+    {
+    }
+  };
+
+  namespace private_slab_allocator
+  {
+    //*************************************************************************
+    /// The largest power of two that divides SIZE, limited to the largest
+    /// alignment that etl::type_with_alignment can supply.
+    //*************************************************************************
+    template <const size_t SIZE>
+    struct natural_alignment
+    {
+      static const size_t LOWEST_BIT = SIZE & (~SIZE + 1);
+      static const size_t MAXIMUM    = etl::largest_alignment<int64_t, double, void*>::value;
+
+      static const size_t value = (LOWEST_BIT < MAXIMUM) ? LOWEST_BIT : MAXIMUM;
+    };
+
+    //*************************************************************************
+    /// The description of one size class, as seen by islab_allocator.
+    //*************************************************************************
+    struct class_info
+    {
+      etl::ipool* p_pool;
+      size_t      item_size;
+      size_t      alignment;
+    };
+  }
+
+  //***************************************************************************
+  /// Defines one size class of a slab_allocator.
+  /// \tparam ITEM_SIZE_ The largest object that the class can hold.
+  /// \tparam COUNT_     The number of objects in the class.
+  /// \tparam ALIGNMENT_ The alignment of the objects. Defaults to the largest power of two that divides ITEM_SIZE_.
+  ///\ingroup slab_allocator
+  //***************************************************************************
+  template <const size_t ITEM_SIZE_, const size_t COUNT_, const size_t ALIGNMENT_ = private_slab_allocator::natural_alignment<ITEM_SIZE_>::value>
+  struct slab_class
+  {
+    ETL_STATIC_ASSERT(ITEM_SIZE_ != 0, "Item size must not be zero");
+    ETL_STATIC_ASSERT(COUNT_ != 0, "Count must not be zero");
+
+    static const size_t ITEM_SIZE = ITEM_SIZE_;
+    static const size_t COUNT     = COUNT_;
+    static const size_t ALIGNMENT = ALIGNMENT_;
+
+    typedef etl::generic_pool<ITEM_SIZE_, ALIGNMENT_, COUNT_> pool_type;
+  };
+
+  //***************************************************************************
+  ///\ingroup slab_allocator
+  /// The base for all slab_allocators.
+  /// Each size class is an etl::ipool. An object is allocated from the
+  /// smallest class that is large enough and aligned enough for it.
+  /// A class that is full does not overflow in to a larger one, so the
+  /// occupancy of each class can be sized independently.
+  /// Objects are released to the class whose buffer contains them, so an
+  /// object may be destroyed through a pointer to its base.
+  //***************************************************************************
+  class islab_allocator
+  {
+  public:
+
+    typedef size_t size_type;
+
+    //*************************************************************************
+    /// Allocate storage for an object from the tightest class.
+    /// If asserts or exceptions are enabled and there is no class for a 'T' an
+    /// etl::slab_allocator_no_class is thrown, and if the class has no more free
+    /// items an etl::pool_no_allocation is thrown, otherwise a nullptr is returned.
+    //*************************************************************************
+    template <typename T>
+    T* allocate()
+    {
+      size_t index = class_index(sizeof(T), etl::alignment_of<T>::value);
+
+      if (index == N_CLASSES)
+      {
+        ETL_ASSERT(false, ETL_ERROR(etl::slab_allocator_no_class));
+        return nullptr;
+      }
+
+      return p_classes[index].p_pool->template allocate<T>();
+    }
+
+#if !ETL_CPP11_SUPPORTED || ETL_SLAB_ALLOCATOR_CPP03_CODE || defined(ETL_STLPORT) || defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Allocate storage for an object and create default.
+    //*************************************************************************
+    template <typename T>
+    T* create()
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T();
+      }
+
+      return p;
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object and create with 1 parameter.
+    //*************************************************************************
+    template <typename T, typename T1>
+    T* create(const T1& value1)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2>
+    T* create(const T1& value1, const T2& value2)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3>
+    T* create(const T1& value1, const T2& value2, const T3& value3)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3, typename T4>
+    T* create(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3, value4);
+      }
+
+      return p;
+    }
+#else
+    //*************************************************************************
+    /// Emplace with variadic constructor parameters.
+    //*************************************************************************
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(std::forward<Args>(args)...);
+      }
+
+      return p;
+    }
+#endif
+
+    //*************************************************************************
+    /// Destroys the object.
+    /// \param p_object A pointer to the object to be destroyed.
+    //*************************************************************************
+    template <typename T>
+    void destroy(const T* const p_object)
+    {
+      p_object->~T();
+      release(p_object);
+    }
+
+    //*************************************************************************
+    /// Release an object to the class that owns it.
+    /// If asserts or exceptions are enabled and the object does not belong to any
+    /// class then an etl::slab_allocator_not_in_slab is thrown.
+    /// \param p_object A pointer to the object to be released.
+    //*************************************************************************
+    void release(const void* const p_object)
+    {
+      size_t index = owner_of(p_object);
+
+      if (index == N_CLASSES)
+      {
+        ETL_ASSERT(false, ETL_ERROR(etl::slab_allocator_not_in_slab));
+      }
+      else
+      {
+        p_classes[index].p_pool->release(p_object);
+      }
+    }
+
+    //*************************************************************************
+    /// Release all objects in all classes.
+    //*************************************************************************
+    void release_all()
+    {
+      for (size_t i = 0; i < N_CLASSES; ++i)
+      {
+        p_classes[i].p_pool->release_all();
+      }
+    }
+
+    //*************************************************************************
+    /// Check to see if the object belongs to any of the classes.
+    //*************************************************************************
+    bool is_in_pool(const void* p_object) const
+    {
+      return owner_of(p_object) != N_CLASSES;
+    }
+
+    //*************************************************************************
+    /// Checks to see if there are no free items in the class for a 'T'.
+    /// Returns <b>true</b> if there is no class for a 'T'.
+    //*************************************************************************
+    template <typename T>
+    bool full() const
+    {
+      size_t index = class_index(sizeof(T), etl::alignment_of<T>::value);
+
+      return (index == N_CLASSES) || p_classes[index].p_pool->full();
+    }
+
+    //*************************************************************************
+    /// Gets the class that a 'T' would be allocated from.
+    /// Returns number_of_classes() if there is none.
+    //*************************************************************************
+    template <typename T>
+    size_t class_of() const
+    {
+      return class_index(sizeof(T), etl::alignment_of<T>::value);
+    }
+
+    //*************************************************************************
+    /// Gets the smallest class that holds 'size' bytes at 'alignment'.
+    /// Returns number_of_classes() if there is none.
+    //*************************************************************************
+    size_t class_index(size_t size, size_t alignment) const
+    {
+      size_t index = 0;
+
+      while ((index < N_CLASSES) &&
+             ((p_classes[index].item_size < size) || ((p_classes[index].alignment % alignment) != 0)))
+      {
+        ++index;
+      }
+
+      return index;
+    }
+
+    //*************************************************************************
+    /// Returns the number of size classes.
+    //*************************************************************************
+    size_t number_of_classes() const
+    {
+      return N_CLASSES;
+    }
+
+    //*************************************************************************
+    /// Returns the item size of a class.
+    //*************************************************************************
+    size_t item_size(size_t index) const
+    {
+      return p_classes[index].item_size;
+    }
+
+    //*************************************************************************
+    /// Returns the alignment of a class.
+    //*************************************************************************
+    size_t alignment(size_t index) const
+    {
+      return p_classes[index].alignment;
+    }
+
+    //*************************************************************************
+    /// Returns the maximum number of items in a class.
+    //*************************************************************************
+    size_t max_size(size_t index) const
+    {
+      return p_classes[index].p_pool->max_size();
+    }
+
+    //*************************************************************************
+    /// Returns the number of allocated items in a class.
+    //*************************************************************************
+    size_t size(size_t index) const
+    {
+      return p_classes[index].p_pool->size();
+    }
+
+    //*************************************************************************
+    /// Returns the number of free items in a class.
+    //*************************************************************************
+    size_t available(size_t index) const
+    {
+      return p_classes[index].p_pool->available();
+    }
+
+    //*************************************************************************
+    /// Returns the pool for a class.
+    //*************************************************************************
+    etl::ipool& get_pool(size_t index) const
+    {
+      return *p_classes[index].p_pool;
+    }
+
+    //*************************************************************************
+    /// Returns the maximum number of items in all classes.
+    //*************************************************************************
+    size_t max_size() const
+    {
+      size_t n = 0;
+
+      for (size_t i = 0; i < N_CLASSES; ++i)
+      {
+        n += max_size(i);
+      }
+
+      return n;
+    }
+
+    //*************************************************************************
+    /// Returns the number of allocated items in all classes.
+    //*************************************************************************
+    size_t size() const
+    {
+      size_t n = 0;
+
+      for (size_t i = 0; i < N_CLASSES; ++i)
+      {
+        n += size(i);
+      }
+
+      return n;
+    }
+
+    //*************************************************************************
+    /// Returns the number of free items in all classes.
+    //*************************************************************************
+    size_t available() const
+    {
+      return max_size() - size();
+    }
+
+    //*************************************************************************
+    /// Checks to see if there are no allocated items in any class.
+    //*************************************************************************
+    bool empty() const
+    {
+      return size() == 0;
+    }
+
+    //*************************************************************************
+    /// Checks to see if there are no free items in any class.
+    //*************************************************************************
+    bool full() const
+    {
+      return available() == 0;
+    }
+
+    //*************************************************************************
+    /// Returns the number of bytes reserved for items in a class.
+    //*************************************************************************
+    size_t capacity_bytes(size_t index) const
+    {
+      return max_size(index) * item_size(index);
+    }
+
+    //*************************************************************************
+    /// Returns the number of bytes reserved for items in all classes.
+    //*************************************************************************
+    size_t capacity_bytes() const
+    {
+      size_t n = 0;
+
+      for (size_t i = 0; i < N_CLASSES; ++i)
+      {
+        n += capacity_bytes(i);
+      }
+
+      return n;
+    }
+
+  protected:
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    islab_allocator(const private_slab_allocator::class_info* p_classes_, size_t n_classes_)
+      : p_classes(p_classes_),
+        N_CLASSES(n_classes_)
+    {
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Gets the class whose buffer contains the object.
+    //*************************************************************************
+    size_t owner_of(const void* p_object) const
+    {
+      size_t index = 0;
+
+      while ((index < N_CLASSES) && !p_classes[index].p_pool->is_in_pool(p_object))
+      {
+        ++index;
+      }
+
+      return index;
+    }
+
+    // Disable copy construction and assignment.
+    islab_allocator(const islab_allocator&);
+    islab_allocator& operator =(const islab_allocator&);
+
+    const private_slab_allocator::class_info* p_classes;
+    const size_t N_CLASSES;
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_SLAB_ALLOCATOR) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~islab_allocator()
+    {
+    }
+#else
+  protected:
+    ~islab_allocator()
+    {
+    }
+#endif
+  };
+
+  namespace private_slab_allocator
+  {
+    //*************************************************************************
+    /// Is the next class larger?
+    //*************************************************************************
+    template <typename C1, typename C2>
+    struct is_ascending
+    {
+      static const bool value = (C1::ITEM_SIZE < C2::ITEM_SIZE);
+    };
+
+    template <typename C1>
+    struct is_ascending<C1, void>
+    {
+      static const bool value = true;
+    };
+
+    //*************************************************************************
+    /// The pools for the classes, one after another.
+    //*************************************************************************
+    template <typename C1, typename C2, typename C3, typename C4, typename C5, typename C6, typename C7, typename C8>
+    struct pool_list
+    {
+      ETL_STATIC_ASSERT((is_ascending<C1, C2>::value), "Classes must be in ascending order of size");
+
+      static const size_t N_CLASSES = 1 + pool_list<C2, C3, C4, C5, C6, C7, C8, void>::N_CLASSES;
+
+      void get_info(class_info* p_info)
+      {
+        p_info->p_pool    = &head;
+        p_info->item_size = C1::ITEM_SIZE;
+        p_info->alignment = C1::ALIGNMENT;
+
+        tail.get_info(p_info + 1);
+      }
+
+      typename C1::pool_type                      head;
+      pool_list<C2, C3, C4, C5, C6, C7, C8, void> tail;
+    };
+
+    template <>
+    struct pool_list<void, void, void, void, void, void, void, void>
+    {
+      static const size_t N_CLASSES = 0;
+
+      void get_info(class_info*)
+      {
+      }
+    };
+
+    //*************************************************************************
+    /// The index of the smallest class that can hold a 'T'.
+    //*************************************************************************
+    template <typename T, typename C1, typename C2, typename C3, typename C4, typename C5, typename C6, typename C7, typename C8>
+    struct class_for
+    {
+      static const bool FITS = (sizeof(T) <= C1::ITEM_SIZE) && ((C1::ALIGNMENT % etl::alignment_of<T>::value) == 0);
+
+      static const size_t value = FITS ? 0 : 1 + class_for<T, C2, C3, C4, C5, C6, C7, C8, void>::value;
+    };
+
+    template <typename T>
+    struct class_for<T, void, void, void, void, void, void, void, void>
+    {
+      static const size_t value = 0;
+    };
+  }
+
+  //***************************************************************************
+  ///\ingroup slab_allocator
+  /// A set of up to eight fixed capacity pools of different item sizes, held
+  /// in one object.
+  /// The classes must be given in ascending order of item size.
+  /// An object is allocated from the smallest class that can hold it, chosen
+  /// at compile time.
+  ///\code
+  /// etl::slab_allocator<etl::slab_class<16,  64>,
+  ///                     etl::slab_class<64,  16>,
+  ///                     etl::slab_class<512, 2> > slab;
+  ///
+  /// Small* p = slab.create<Small>(); // From the 16 byte class.
+  ///\endcode
+  //***************************************************************************
+  template <typename C1,
+            typename C2 = void, typename C3 = void, typename C4 = void,
+            typename C5 = void, typename C6 = void, typename C7 = void, typename C8 = void>
+  class slab_allocator : public etl::islab_allocator
+  {
+  private:
+
+    typedef private_slab_allocator::pool_list<C1, C2, C3, C4, C5, C6, C7, C8> pool_list_t;
+
+  public:
+
+    static const size_t N_CLASSES = pool_list_t::N_CLASSES;
+
+    //*************************************************************************
+    /// The class that a 'T' is allocated from.
+    //*************************************************************************
+    template <typename T>
+    struct class_for
+    {
+      static const size_t value = private_slab_allocator::class_for<T, C1, C2, C3, C4, C5, C6, C7, C8>::value;
+    };
+
+    //*************************************************************************
+    /// Constructor
+    //*************************************************************************
+    slab_allocator()
+      : etl::islab_allocator(classes, N_CLASSES)
+    {
+      pools.get_info(classes);
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object from the tightest class.
+    /// Static asserts if no class can hold a 'T'.
+    //*************************************************************************
+    template <typename T>
+    T* allocate()
+    {
+      ETL_STATIC_ASSERT(class_for<T>::value < N_CLASSES, "No class can hold the type");
+      return get_pool(class_for<T>::value).template allocate<T>();
+    }
+
+#if !ETL_CPP11_SUPPORTED || ETL_SLAB_ALLOCATOR_CPP03_CODE || defined(ETL_STLPORT) || defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Allocate storage for an object and create default.
+    //*************************************************************************
+    template <typename T>
+    T* create()
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T();
+      }
+
+      return p;
+    }
+
+    //*************************************************************************
+    /// Allocate storage for an object and create with 1 parameter.
+    //*************************************************************************
+    template <typename T, typename T1>
+    T* create(const T1& value1)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2>
+    T* create(const T1& value1, const T2& value2)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3>
+    T* create(const T1& value1, const T2& value2, const T3& value3)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3);
+      }
+
+      return p;
+    }
+
+    template <typename T, typename T1, typename T2, typename T3, typename T4>
+    T* create(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(value1, value2, value3, value4);
+      }
+
+      return p;
+    }
+#else
+    //*************************************************************************
+    /// Emplace with variadic constructor parameters.
+    //*************************************************************************
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+      T* p = allocate<T>();
+
+      if (p)
+      {
+        ::new (p) T(std::forward<Args>(args)...);
+      }
+
+      return p;
+    }
+#endif
+
+    //*************************************************************************
+    /// Checks to see if there are no free items in the class for a 'T'.
+    //*************************************************************************
+    template <typename T>
+    bool full() const
+    {
+      ETL_STATIC_ASSERT(class_for<T>::value < N_CLASSES, "No class can hold the type");
+      return get_pool(class_for<T>::value).full();
+    }
+
+    using etl::islab_allocator::full;
+
+  private:
+
+    // Should not be copied.
+    slab_allocator(const slab_allocator&);
+    slab_allocator& operator =(const slab_allocator&);
+
+    pool_list_t                        pools;              ///< The storage for all classes.
+    private_slab_allocator::class_info classes[N_CLASSES]; ///< The description of each class.
+  };
+}
+
+#undef ETL_FILE
+
+#endif
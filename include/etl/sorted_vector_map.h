@@ -0,0 +1,1268 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_SORTED_VECTOR_MAP_INCLUDED
+#define ETL_SORTED_VECTOR_MAP_INCLUDED
+
+#include <stddef.h>
+
+#include "platform.h"
+#include "algorithm.h"
+#include "vector.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "type_traits.h"
+#include "parameter_type.h"
+#include "nullptr.h"
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+  #include <initializer_list>
+#endif
+
+#include "stl/algorithm.h"
+#include "stl/iterator.h"
+#include "stl/functional.h"
+#include "stl/utility.h"
+
+#undef ETL_FILE
+#define ETL_FILE "56"
+
+//*****************************************************************************
+///\defgroup sorted_vector_map sorted_vector_map
+/// A flat map with the capacity defined at compile time.
+/// The keys and the mapped values are held in two separate contiguous arrays,
+/// kept in key order, so that searches only touch the densely packed keys.
+/// Has insertion of O(N) and lookup of O(logN)
+/// Duplicate entries are not allowed.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// Exception for the sorted_vector_map.
+  ///\ingroup sorted_vector_map
+  //***************************************************************************
+  class sorted_vector_map_exception : public etl::exception
+  {
+  public:
+
+    sorted_vector_map_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : etl::exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Full exception for the sorted_vector_map.
+  ///\ingroup sorted_vector_map
+  //***************************************************************************
+  class sorted_vector_map_full : public etl::sorted_vector_map_exception
+  {
+  public:
+
+    sorted_vector_map_full(string_type file_name_, numeric_type line_number_)
+      : etl::sorted_vector_map_exception(ETL_ERROR_TEXT("sorted_vector_map:full", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Out of bounds exception for the sorted_vector_map.
+  ///\ingroup sorted_vector_map
+  //***************************************************************************
+  class sorted_vector_map_out_of_bounds : public etl::sorted_vector_map_exception
+  {
+  public:
+
+    sorted_vector_map_out_of_bounds(string_type file_name_, numeric_type line_number_)
+      : etl::sorted_vector_map_exception(ETL_ERROR_TEXT("sorted_vector_map:bounds", ETL_FILE"B"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The base class for specifically sized sorted_vector_maps.
+  /// Can be used as a reference type for all sorted_vector_maps containing a specific type.
+  /// The interface matches etl::iflat_map, except that the iterators return a
+  /// proxy holding references to the key and the mapped value, rather than a
+  /// reference to a stored std::pair.
+  ///\ingroup sorted_vector_map
+  //***************************************************************************
+  template <typename TKey, typename TMapped, typename TKeyCompare = std::less<TKey> >
+  class isorted_vector_map
+  {
+  public:
+
+    typedef std::pair<const TKey, TMapped> value_type;
+    typedef TKey                           key_type;
+    typedef TMapped                        mapped_type;
+    typedef TKeyCompare                    key_compare;
+    typedef size_t                         size_type;
+    typedef ptrdiff_t                      difference_type;
+
+  protected:
+
+    typedef typename etl::parameter_type<TKey>::type key_parameter_t;
+
+  private:
+
+    typedef etl::ivector<TKey>    key_storage_t;
+    typedef etl::ivector<TMapped> mapped_storage_t;
+
+    /// Branchless for keys that are cheap to compare.
+    typedef etl::private_algorithm::sorted_search<etl::use_branchless_search<TKey>::value> search_t;
+
+    //*************************************************************************
+    /// What the iterators return.
+    /// Has the 'first' and 'second' members of a value_type, but refers to the
+    /// elements of the key and the mapped arrays.
+    //*************************************************************************
+    template <typename TMappedRef>
+    class element_reference
+    {
+    public:
+
+      element_reference(const TKey& first_, TMappedRef& second_)
+        : first(first_),
+          second(second_)
+      {
+      }
+
+      element_reference(const element_reference& other)
+        : first(other.first),
+          second(other.second)
+      {
+      }
+
+      operator value_type() const
+      {
+        return value_type(first, second);
+      }
+
+      friend bool operator ==(const element_reference& lhs, const element_reference& rhs)
+      {
+        return (lhs.first == rhs.first) && (lhs.second == rhs.second);
+      }
+
+      friend bool operator !=(const element_reference& lhs, const element_reference& rhs)
+      {
+        return !(lhs == rhs);
+      }
+
+      friend bool operator <(const element_reference& lhs, const element_reference& rhs)
+      {
+        return (lhs.first < rhs.first) || (!(rhs.first < lhs.first) && (lhs.second < rhs.second));
+      }
+
+      const TKey& first;
+      TMappedRef& second;
+
+    private:
+
+      // Disable assignment.
+      element_reference& operator =(const element_reference&);
+    };
+
+    //*************************************************************************
+    /// Gives operator -> something to point at, as the iterators return the
+    /// references by value.
+    //*************************************************************************
+    template <typename TReference>
+    class arrow_proxy
+    {
+    public:
+
+      explicit arrow_proxy(const TReference& reference_)
+        : reference(reference_)
+      {
+      }
+
+      TReference* operator ->()
+      {
+        return &reference;
+      }
+
+    private:
+
+      TReference reference;
+    };
+
+  public:
+
+    typedef element_reference<TMapped>       reference;
+    typedef element_reference<const TMapped> const_reference;
+    typedef arrow_proxy<reference>           pointer;
+    typedef arrow_proxy<const_reference>     const_pointer;
+
+    class const_iterator;
+
+    //*************************************************************************
+    /// iterator.
+    /// Steps through the key and the mapped arrays together.
+    //*************************************************************************
+    class iterator : public std::iterator<std::random_access_iterator_tag, value_type, difference_type, pointer, reference>
+    {
+    public:
+
+      friend class isorted_vector_map;
+      friend class const_iterator;
+
+      iterator()
+        : p_key(nullptr),
+          p_mapped(nullptr)
+      {
+      }
+
+      reference operator *() const
+      {
+        return reference(*p_key, *p_mapped);
+      }
+
+      pointer operator ->() const
+      {
+        return pointer(**this);
+      }
+
+      reference operator [](difference_type n) const
+      {
+        return reference(p_key[n], p_mapped[n]);
+      }
+
+      iterator& operator ++()
+      {
+        ++p_key;
+        ++p_mapped;
+        return *this;
+      }
+
+      iterator operator ++(int)
+      {
+        iterator temp(*this);
+        ++*this;
+        return temp;
+      }
+
+      iterator& operator --()
+      {
+        --p_key;
+        --p_mapped;
+        return *this;
+      }
+
+      iterator operator --(int)
+      {
+        iterator temp(*this);
+        --*this;
+        return temp;
+      }
+
+      iterator& operator +=(difference_type n)
+      {
+        p_key    += n;
+        p_mapped += n;
+        return *this;
+      }
+
+      iterator& operator -=(difference_type n)
+      {
+        p_key    -= n;
+        p_mapped -= n;
+        return *this;
+      }
+
+      friend iterator operator +(iterator lhs, difference_type n)
+      {
+        return lhs += n;
+      }
+
+      friend iterator operator +(difference_type n, iterator rhs)
+      {
+        return rhs += n;
+      }
+
+      friend iterator operator -(iterator lhs, difference_type n)
+      {
+        return lhs -= n;
+      }
+
+      friend difference_type operator -(const iterator& lhs, const iterator& rhs)
+      {
+        return lhs.p_key - rhs.p_key;
+      }
+
+      friend bool operator ==(const iterator& lhs, const iterator& rhs)
+      {
+        return lhs.p_key == rhs.p_key;
+      }
+
+      friend bool operator !=(const iterator& lhs, const iterator& rhs)
+      {
+        return lhs.p_key != rhs.p_key;
+      }
+
+      friend bool operator <(const iterator& lhs, const iterator& rhs)
+      {
+        return lhs.p_key < rhs.p_key;
+      }
+
+      friend bool operator >(const iterator& lhs, const iterator& rhs)
+      {
+        return lhs.p_key > rhs.p_key;
+      }
+
+      friend bool operator <=(const iterator& lhs, const iterator& rhs)
+      {
+        return lhs.p_key <= rhs.p_key;
+      }
+
+      friend bool operator >=(const iterator& lhs, const iterator& rhs)
+      {
+        return lhs.p_key >= rhs.p_key;
+      }
+
+    private:
+
+      iterator(const TKey* p_key_, TMapped* p_mapped_)
+        : p_key(p_key_),
+          p_mapped(p_mapped_)
+      {
+      }
+
+      const TKey* p_key;
+      TMapped*    p_mapped;
+    };
+
+    //*************************************************************************
+    /// const_iterator.
+    /// Steps through the key and the mapped arrays together.
+    //*************************************************************************
+    class const_iterator : public std::iterator<std::random_access_iterator_tag, const value_type, difference_type, const_pointer, const_reference>
+    {
+    public:
+
+      friend class isorted_vector_map;
+
+      const_iterator()
+        : p_key(nullptr),
+          p_mapped(nullptr)
+      {
+      }
+
+      const_iterator(const typename isorted_vector_map::iterator& other)
+        : p_key(other.p_key),
+          p_mapped(other.p_mapped)
+      {
+      }
+
+      const_reference operator *() const
+      {
+        return const_reference(*p_key, *p_mapped);
+      }
+
+      const_pointer operator ->() const
+      {
+        return const_pointer(**this);
+      }
+
+      const_reference operator [](difference_type n) const
+      {
+        return const_reference(p_key[n], p_mapped[n]);
+      }
+
+      const_iterator& operator ++()
+      {
+        ++p_key;
+        ++p_mapped;
+        return *this;
+      }
+
+      const_iterator operator ++(int)
+      {
+        const_iterator temp(*this);
+        ++*this;
+        return temp;
+      }
+
+      const_iterator& operator --()
+      {
+        --p_key;
+        --p_mapped;
+        return *this;
+      }
+
+      const_iterator operator --(int)
+      {
+        const_iterator temp(*this);
+        --*this;
+        return temp;
+      }
+
+      const_iterator& operator +=(difference_type n)
+      {
+        p_key    += n;
+        p_mapped += n;
+        return *this;
+      }
+
+      const_iterator& operator -=(difference_type n)
+      {
+        p_key    -= n;
+        p_mapped -= n;
+        return *this;
+      }
+
+      friend const_iterator operator +(const_iterator lhs, difference_type n)
+      {
+        return lhs += n;
+      }
+
+      friend const_iterator operator +(difference_type n, const_iterator rhs)
+      {
+        return rhs += n;
+      }
+
+      friend const_iterator operator -(const_iterator lhs, difference_type n)
+      {
+        return lhs -= n;
+      }
+
+      friend difference_type operator -(const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return lhs.p_key - rhs.p_key;
+      }
+
+      friend bool operator ==(const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return lhs.p_key == rhs.p_key;
+      }
+
+      friend bool operator !=(const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return lhs.p_key != rhs.p_key;
+      }
+
+      friend bool operator <(const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return lhs.p_key < rhs.p_key;
+      }
+
+      friend bool operator >(const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return lhs.p_key > rhs.p_key;
+      }
+
+      friend bool operator <=(const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return lhs.p_key <= rhs.p_key;
+      }
+
+      friend bool operator >=(const const_iterator& lhs, const const_iterator& rhs)
+      {
+        return lhs.p_key >= rhs.p_key;
+      }
+
+    private:
+
+      const_iterator(const TKey* p_key_, const TMapped* p_mapped_)
+        : p_key(p_key_),
+          p_mapped(p_mapped_)
+      {
+      }
+
+      const TKey*    p_key;
+      const TMapped* p_mapped;
+    };
+
+    typedef std::reverse_iterator<iterator>       reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    //*********************************************************************
+    /// Returns an iterator to the beginning of the sorted_vector_map.
+    ///\return An iterator to the beginning of the sorted_vector_map.
+    //*********************************************************************
+    iterator begin()
+    {
+      return iterator(keys.data(), mapped.data());
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the beginning of the sorted_vector_map.
+    ///\return A const iterator to the beginning of the sorted_vector_map.
+    //*********************************************************************
+    const_iterator begin() const
+    {
+      return const_iterator(keys.data(), mapped.data());
+    }
+
+    //*********************************************************************
+    /// Returns an iterator to the end of the sorted_vector_map.
+    ///\return An iterator to the end of the sorted_vector_map.
+    //*********************************************************************
+    iterator end()
+    {
+      return begin() + difference_type(size());
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the end of the sorted_vector_map.
+    ///\return A const iterator to the end of the sorted_vector_map.
+    //*********************************************************************
+    const_iterator end() const
+    {
+      return begin() + difference_type(size());
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the beginning of the sorted_vector_map.
+    ///\return A const iterator to the beginning of the sorted_vector_map.
+    //*********************************************************************
+    const_iterator cbegin() const
+    {
+      return begin();
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the end of the sorted_vector_map.
+    ///\return A const iterator to the end of the sorted_vector_map.
+    //*********************************************************************
+    const_iterator cend() const
+    {
+      return end();
+    }
+
+    //*********************************************************************
+    /// Returns an reverse iterator to the reverse beginning of the sorted_vector_map.
+    ///\return Iterator to the reverse beginning of the sorted_vector_map.
+    //*********************************************************************
+    reverse_iterator rbegin()
+    {
+      return reverse_iterator(end());
+    }
+
+    //*********************************************************************
+    /// Returns a const reverse iterator to the reverse beginning of the sorted_vector_map.
+    ///\return Const iterator to the reverse beginning of the sorted_vector_map.
+    //*********************************************************************
+    const_reverse_iterator rbegin() const
+    {
+      return const_reverse_iterator(end());
+    }
+
+    //*********************************************************************
+    /// Returns a reverse iterator to the end + 1 of the sorted_vector_map.
+    ///\return Reverse iterator to the end + 1 of the sorted_vector_map.
+    //*********************************************************************
+    reverse_iterator rend()
+    {
+      return reverse_iterator(begin());
+    }
+
+    //*********************************************************************
+    /// Returns a const reverse iterator to the end + 1 of the sorted_vector_map.
+    ///\return Const reverse iterator to the end + 1 of the sorted_vector_map.
+    //*********************************************************************
+    const_reverse_iterator rend() const
+    {
+      return const_reverse_iterator(begin());
+    }
+
+    //*********************************************************************
+    /// Returns a const reverse iterator to the reverse beginning of the sorted_vector_map.
+    ///\return Const reverse iterator to the reverse beginning of the sorted_vector_map.
+    //*********************************************************************
+    const_reverse_iterator crbegin() const
+    {
+      return const_reverse_iterator(end());
+    }
+
+    //*********************************************************************
+    /// Returns a const reverse iterator to the end + 1 of the sorted_vector_map.
+    ///\return Const reverse iterator to the end + 1 of the sorted_vector_map.
+    //*********************************************************************
+    const_reverse_iterator crend() const
+    {
+      return const_reverse_iterator(begin());
+    }
+
+    //*********************************************************************
+    /// Returns a reference to the value at index 'key'
+    ///\param key The key.
+    ///\return A reference to the value at index 'key'
+    //*********************************************************************
+    mapped_type& operator [](key_parameter_t key)
+    {
+      return insert(value_type(key, mapped_type())).first->second;
+    }
+
+    //*********************************************************************
+    /// Returns a reference to the value at index 'key'
+    /// If asserts or exceptions are enabled, emits an etl::sorted_vector_map_out_of_bounds if the key is not in the map.
+    ///\param key The key.
+    ///\return A reference to the value at index 'key'
+    //*********************************************************************
+    mapped_type& at(key_parameter_t key)
+    {
+      size_t index = find_index(key);
+
+      ETL_ASSERT(index != size(), ETL_ERROR(sorted_vector_map_out_of_bounds));
+
+      return mapped[index];
+    }
+
+    //*********************************************************************
+    /// Returns a const reference to the value at index 'key'
+    /// If asserts or exceptions are enabled, emits an etl::sorted_vector_map_out_of_bounds if the key is not in the map.
+    ///\param key The key.
+    ///\return A const reference to the value at index 'key'
+    //*********************************************************************
+    const mapped_type& at(key_parameter_t key) const
+    {
+      size_t index = find_index(key);
+
+      ETL_ASSERT(index != size(), ETL_ERROR(sorted_vector_map_out_of_bounds));
+
+      return mapped[index];
+    }
+
+    //*********************************************************************
+    /// Assigns values to the sorted_vector_map.
+    /// If ETL_THROW_EXCEPTIONS & ETL_DEBUG are defined, emits sorted_vector_map_full if the sorted_vector_map does not have enough free space.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*********************************************************************
+    template <typename TIterator>
+    void assign(TIterator first, TIterator last)
+    {
+#if defined(ETL_DEBUG)
+      difference_type d = std::distance(first, last);
+      ETL_ASSERT(d <= difference_type(capacity()), ETL_ERROR(sorted_vector_map_full));
+#endif
+
+      clear();
+
+      while (first != last)
+      {
+        insert(*first++);
+      }
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the sorted_vector_map.
+    /// If asserts or exceptions are enabled, emits sorted_vector_map_full if the sorted_vector_map is already full.
+    ///\param value The value to insert.
+    //*********************************************************************
+    std::pair<iterator, bool> insert(const value_type& value)
+    {
+      size_t index = lower_bound_index(value.first);
+
+      std::pair<iterator, bool> result(begin() + difference_type(index), false);
+
+      // Doesn't already exist?
+      if ((index == size()) || compare(value.first, keys[index]))
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(sorted_vector_map_full));
+
+        keys.insert(keys.begin() + index, value.first);
+        mapped.insert(mapped.begin() + index, value.second);
+        result.second = true;
+      }
+
+      return result;
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the sorted_vector_map.
+    /// If asserts or exceptions are enabled, emits sorted_vector_map_full if the sorted_vector_map is already full.
+    ///\param position The position to insert at.
+    ///\param value    The value to insert.
+    //*********************************************************************
+    iterator insert(iterator position, const value_type& value)
+    {
+      return insert(value).first;
+    }
+
+    //*********************************************************************
+    /// Inserts a range of values to the sorted_vector_map.
+    /// If asserts or exceptions are enabled, emits sorted_vector_map_full if the sorted_vector_map does not have enough free space.
+    ///\param first The first element to add.
+    ///\param last  The last + 1 element to add.
+    //*********************************************************************
+    template <class TIterator>
+    void insert(TIterator first, TIterator last)
+    {
+      while (first != last)
+      {
+        insert(*first++);
+      }
+    }
+
+    //*************************************************************************
+    /// Emplaces a value to the map.
+    //*************************************************************************
+    std::pair<iterator, bool> emplace(const value_type& value)
+    {
+      return insert(value);
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Emplaces a value to the map.
+    /// The mapped value is only constructed if the key is not already present.
+    //*************************************************************************
+    template <typename ... Args>
+    std::pair<iterator, bool> emplace(const key_type& key, Args && ... args)
+    {
+      size_t index = lower_bound_index(key);
+
+      std::pair<iterator, bool> result(begin() + difference_type(index), false);
+
+      // Doesn't already exist?
+      if ((index == size()) || compare(key, keys[index]))
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(sorted_vector_map_full));
+
+        keys.insert(keys.begin() + index, key);
+        mapped.emplace(mapped.begin() + index, std::forward<Args>(args)...);
+        result.second = true;
+      }
+
+      return result;
+    }
+
+#else
+
+    //*************************************************************************
+    /// Emplaces a value to the map.
+    /// The mapped value is only constructed if the key is not already present.
+    //*************************************************************************
+    template <typename T1>
+    std::pair<iterator, bool> emplace(const key_type& key, const T1& value1)
+    {
+      size_t index = lower_bound_index(key);
+
+      std::pair<iterator, bool> result(begin() + difference_type(index), false);
+
+      // Doesn't already exist?
+      if ((index == size()) || compare(key, keys[index]))
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(sorted_vector_map_full));
+
+        keys.insert(keys.begin() + index, key);
+        mapped.emplace(mapped.begin() + index, value1);
+        result.second = true;
+      }
+
+      return result;
+    }
+
+    //*************************************************************************
+    /// Emplaces a value to the map.
+    /// The mapped value is only constructed if the key is not already present.
+    //*************************************************************************
+    template <typename T1, typename T2>
+    std::pair<iterator, bool> emplace(const key_type& key, const T1& value1, const T2& value2)
+    {
+      size_t index = lower_bound_index(key);
+
+      std::pair<iterator, bool> result(begin() + difference_type(index), false);
+
+      // Doesn't already exist?
+      if ((index == size()) || compare(key, keys[index]))
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(sorted_vector_map_full));
+
+        keys.insert(keys.begin() + index, key);
+        mapped.emplace(mapped.begin() + index, value1, value2);
+        result.second = true;
+      }
+
+      return result;
+    }
+
+    //*************************************************************************
+    /// Emplaces a value to the map.
+    /// The mapped value is only constructed if the key is not already present.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3>
+    std::pair<iterator, bool> emplace(const key_type& key, const T1& value1, const T2& value2, const T3& value3)
+    {
+      size_t index = lower_bound_index(key);
+
+      std::pair<iterator, bool> result(begin() + difference_type(index), false);
+
+      // Doesn't already exist?
+      if ((index == size()) || compare(key, keys[index]))
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(sorted_vector_map_full));
+
+        keys.insert(keys.begin() + index, key);
+        mapped.emplace(mapped.begin() + index, value1, value2, value3);
+        result.second = true;
+      }
+
+      return result;
+    }
+
+    //*************************************************************************
+    /// Emplaces a value to the map.
+    /// The mapped value is only constructed if the key is not already present.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3, typename T4>
+    std::pair<iterator, bool> emplace(const key_type& key, const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      size_t index = lower_bound_index(key);
+
+      std::pair<iterator, bool> result(begin() + difference_type(index), false);
+
+      // Doesn't already exist?
+      if ((index == size()) || compare(key, keys[index]))
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(sorted_vector_map_full));
+
+        keys.insert(keys.begin() + index, key);
+        mapped.emplace(mapped.begin() + index, value1, value2, value3, value4);
+        result.second = true;
+      }
+
+      return result;
+    }
+
+#endif // ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+
+    //*********************************************************************
+    /// Erases an element.
+    ///\param key The key to erase.
+    ///\return The number of elements erased. 0 or 1.
+    //*********************************************************************
+    size_t erase(key_parameter_t key)
+    {
+      size_t index = find_index(key);
+
+      if (index == size())
+      {
+        return 0;
+      }
+      else
+      {
+        keys.erase(keys.begin() + index);
+        mapped.erase(mapped.begin() + index);
+        return 1;
+      }
+    }
+
+    //*********************************************************************
+    /// Erases an element.
+    ///\param i_element Iterator to the element.
+    //*********************************************************************
+    void erase(iterator i_element)
+    {
+      size_t index = index_of(i_element);
+
+      keys.erase(keys.begin() + index);
+      mapped.erase(mapped.begin() + index);
+    }
+
+    //*********************************************************************
+    /// Erases a range of elements.
+    /// The range includes all the elements between first and last, including the
+    /// element pointed by first, but not the one pointed by last.
+    ///\param first Iterator to the first element.
+    ///\param last  Iterator to the last element.
+    //*********************************************************************
+    void erase(iterator first, iterator last)
+    {
+      size_t first_index = index_of(first);
+      size_t last_index  = index_of(last);
+
+      keys.erase(keys.begin() + first_index, keys.begin() + last_index);
+      mapped.erase(mapped.begin() + first_index, mapped.begin() + last_index);
+    }
+
+    //*************************************************************************
+    /// Clears the sorted_vector_map.
+    //*************************************************************************
+    void clear()
+    {
+      keys.clear();
+      mapped.clear();
+    }
+
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator pointing to the element or end() if not found.
+    //*********************************************************************
+    iterator find(key_parameter_t key)
+    {
+      return begin() + difference_type(find_index(key));
+    }
+
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator pointing to the element or end() if not found.
+    //*********************************************************************
+    const_iterator find(key_parameter_t key) const
+    {
+      return begin() + difference_type(find_index(key));
+    }
+
+    //*********************************************************************
+    /// Counts an element.
+    ///\param key The key to search for.
+    ///\return 1 if the key exists, otherwise 0.
+    //*********************************************************************
+    size_t count(key_parameter_t key) const
+    {
+      return (find_index(key) == size()) ? 0 : 1;
+    }
+
+    //*********************************************************************
+    /// Finds the lower bound of a key
+    ///\param key The key to search for.
+    ///\return An iterator.
+    //*********************************************************************
+    iterator lower_bound(key_parameter_t key)
+    {
+      return begin() + difference_type(lower_bound_index(key));
+    }
+
+    //*********************************************************************
+    /// Finds the lower bound of a key
+    ///\param key The key to search for.
+    ///\return An iterator.
+    //*********************************************************************
+    const_iterator lower_bound(key_parameter_t key) const
+    {
+      return begin() + difference_type(lower_bound_index(key));
+    }
+
+    //*********************************************************************
+    /// Finds the upper bound of a key
+    ///\param key The key to search for.
+    ///\return An iterator.
+    //*********************************************************************
+    iterator upper_bound(key_parameter_t key)
+    {
+      return begin() + difference_type(upper_bound_index(key));
+    }
+
+    //*********************************************************************
+    /// Finds the upper bound of a key
+    ///\param key The key to search for.
+    ///\return An iterator.
+    //*********************************************************************
+    const_iterator upper_bound(key_parameter_t key) const
+    {
+      return begin() + difference_type(upper_bound_index(key));
+    }
+
+    //*********************************************************************
+    /// Finds the range of equal elements of a key
+    ///\param key The key to search for.
+    ///\return An iterator pair.
+    //*********************************************************************
+    std::pair<iterator, iterator> equal_range(key_parameter_t key)
+    {
+      return std::pair<iterator, iterator>(lower_bound(key), upper_bound(key));
+    }
+
+    //*********************************************************************
+    /// Finds the range of equal elements of a key
+    ///\param key The key to search for.
+    ///\return An iterator pair.
+    //*********************************************************************
+    std::pair<const_iterator, const_iterator> equal_range(key_parameter_t key) const
+    {
+      return std::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    /// The source is already in order, so the arrays are copied directly.
+    //*************************************************************************
+    isorted_vector_map& operator = (const isorted_vector_map& rhs)
+    {
+      if (&rhs != this)
+      {
+        ETL_ASSERT(rhs.size() <= capacity(), ETL_ERROR(sorted_vector_map_full));
+
+        keys.assign(rhs.keys.begin(), rhs.keys.end());
+        mapped.assign(rhs.mapped.begin(), rhs.mapped.end());
+      }
+
+      return *this;
+    }
+
+    //*************************************************************************
+    /// Gets the current size of the sorted_vector_map.
+    ///\return The current size of the sorted_vector_map.
+    //*************************************************************************
+    size_type size() const
+    {
+      return keys.size();
+    }
+
+    //*************************************************************************
+    /// Checks the 'empty' state of the sorted_vector_map.
+    ///\return <b>true</b> if empty.
+    //*************************************************************************
+    bool empty() const
+    {
+      return keys.empty();
+    }
+
+    //*************************************************************************
+    /// Checks the 'full' state of the sorted_vector_map.
+    ///\return <b>true</b> if full.
+    //*************************************************************************
+    bool full() const
+    {
+      return keys.full();
+    }
+
+    //*************************************************************************
+    /// Returns the capacity of the sorted_vector_map.
+    ///\return The capacity of the sorted_vector_map.
+    //*************************************************************************
+    size_type capacity() const
+    {
+      return keys.capacity();
+    }
+
+    //*************************************************************************
+    /// Returns the maximum possible size of the sorted_vector_map.
+    ///\return The maximum size of the sorted_vector_map.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return keys.max_size();
+    }
+
+    //*************************************************************************
+    /// Returns the remaining capacity.
+    ///\return The remaining capacity.
+    //*************************************************************************
+    size_t available() const
+    {
+      return keys.available();
+    }
+
+  protected:
+
+    //*********************************************************************
+    /// Constructor.
+    //*********************************************************************
+    isorted_vector_map(key_storage_t& keys_, mapped_storage_t& mapped_)
+      : keys(keys_),
+        mapped(mapped_)
+    {
+    }
+
+  private:
+
+    // Disable copy construction.
+    isorted_vector_map(const isorted_vector_map&);
+
+    //*********************************************************************
+    /// The index of the first key that is not less than 'key'.
+    /// Only the key array is touched by the search.
+    //*********************************************************************
+    size_t lower_bound_index(key_parameter_t key) const
+    {
+      return search_t::lower_bound(keys.begin(), keys.end(), key, compare) - keys.begin();
+    }
+
+    //*********************************************************************
+    /// The index of the first key that is greater than 'key'.
+    //*********************************************************************
+    size_t upper_bound_index(key_parameter_t key) const
+    {
+      return search_t::upper_bound(keys.begin(), keys.end(), key, compare) - keys.begin();
+    }
+
+    //*********************************************************************
+    /// The index of 'key', or size() if it is not present.
+    //*********************************************************************
+    size_t find_index(key_parameter_t key) const
+    {
+      size_t index = lower_bound_index(key);
+
+      if ((index != size()) && compare(key, keys[index]))
+      {
+        index = size();
+      }
+
+      return index;
+    }
+
+    //*********************************************************************
+    /// The array index of an iterator.
+    //*********************************************************************
+    size_t index_of(const_iterator itr) const
+    {
+      return itr.p_key - keys.data();
+    }
+
+    key_storage_t&    keys;
+    mapped_storage_t& mapped;
+
+    TKeyCompare compare;
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_SORTED_VECTOR_MAP) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~isorted_vector_map()
+    {
+    }
+#else
+  protected:
+    ~isorted_vector_map()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  /// Equal operator.
+  ///\param lhs Reference to the first sorted_vector_map.
+  ///\param rhs Reference to the second sorted_vector_map.
+  ///\return <b>true</b> if the maps are equal, otherwise <b>false</b>
+  ///\ingroup sorted_vector_map
+  //***************************************************************************
+  template <typename TKey, typename TMapped, typename TKeyCompare>
+  bool operator ==(const etl::isorted_vector_map<TKey, TMapped, TKeyCompare>& lhs, const etl::isorted_vector_map<TKey, TMapped, TKeyCompare>& rhs)
+  {
+    return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  //***************************************************************************
+  /// Not equal operator.
+  ///\param lhs Reference to the first sorted_vector_map.
+  ///\param rhs Reference to the second sorted_vector_map.
+  ///\return <b>true</b> if the maps are not equal, otherwise <b>false</b>
+  ///\ingroup sorted_vector_map
+  //***************************************************************************
+  template <typename TKey, typename TMapped, typename TKeyCompare>
+  bool operator !=(const etl::isorted_vector_map<TKey, TMapped, TKeyCompare>& lhs, const etl::isorted_vector_map<TKey, TMapped, TKeyCompare>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  //***************************************************************************
+  /// A sorted_vector_map implementation that uses a fixed size buffer.
+  ///\tparam TKey      The key type.
+  ///\tparam TValue    The value type.
+  ///\tparam MAX_SIZE_ The maximum number of elements that can be stored.
+  ///\tparam TCompare  The type to compare keys. Default = std::less<TKey>
+  ///\ingroup sorted_vector_map
+  //***************************************************************************
+  template <typename TKey, typename TValue, const size_t MAX_SIZE_, typename TCompare = std::less<TKey> >
+  class sorted_vector_map : public etl::isorted_vector_map<TKey, TValue, TCompare>
+  {
+  public:
+
+    static const size_t MAX_SIZE = MAX_SIZE_;
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    sorted_vector_map()
+      : etl::isorted_vector_map<TKey, TValue, TCompare>(key_storage, mapped_storage)
+    {
+    }
+
+    //*************************************************************************
+    /// Copy constructor.
+    //*************************************************************************
+    sorted_vector_map(const sorted_vector_map& other)
+      : etl::isorted_vector_map<TKey, TValue, TCompare>(key_storage, mapped_storage)
+    {
+      etl::isorted_vector_map<TKey, TValue, TCompare>::operator =(other);
+    }
+
+    //*************************************************************************
+    /// Constructor, from an iterator range.
+    ///\tparam TIterator The iterator type.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*************************************************************************
+    template <typename TIterator>
+    sorted_vector_map(TIterator first, TIterator last)
+      : etl::isorted_vector_map<TKey, TValue, TCompare>(key_storage, mapped_storage)
+    {
+      this->assign(first, last);
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Construct from initializer_list.
+    //*************************************************************************
+    sorted_vector_map(std::initializer_list<typename etl::isorted_vector_map<TKey, TValue, TCompare>::value_type> init)
+      : etl::isorted_vector_map<TKey, TValue, TCompare>(key_storage, mapped_storage)
+    {
+      this->assign(init.begin(), init.end());
+    }
+#endif
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~sorted_vector_map()
+    {
+      this->clear();
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    sorted_vector_map& operator = (const sorted_vector_map& rhs)
+    {
+      etl::isorted_vector_map<TKey, TValue, TCompare>::operator =(rhs);
+
+      return *this;
+    }
+
+  private:
+
+    /// The keys, in order.
+    etl::vector<TKey, MAX_SIZE> key_storage;
+
+    /// The mapped values, in the same order as the keys.
+    etl::vector<TValue, MAX_SIZE> mapped_storage;
+  };
+}
+
+#undef ETL_FILE
+
+#endif
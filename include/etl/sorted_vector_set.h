@@ -0,0 +1,669 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_SORTED_VECTOR_SET_INCLUDED
+#define ETL_SORTED_VECTOR_SET_INCLUDED
+
+#include <stddef.h>
+
+#include "platform.h"
+#include "algorithm.h"
+#include "vector.h"
+#include "error_handler.h"
+#include "exception.h"
+#include "type_traits.h"
+#include "parameter_type.h"
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+  #include <initializer_list>
+#endif
+
+#include "stl/algorithm.h"
+#include "stl/iterator.h"
+#include "stl/functional.h"
+#include "stl/utility.h"
+
+#undef ETL_FILE
+#define ETL_FILE "57"
+
+//*****************************************************************************
+///\defgroup sorted_vector_set sorted_vector_set
+/// A flat set with the capacity defined at compile time.
+/// The keys are held by value in one contiguous array, kept in order.
+/// Has insertion of O(N) and lookup of O(logN)
+/// Duplicate entries are not allowed.
+///\ingroup containers
+//*****************************************************************************
+
+namespace etl
+{
+  //***************************************************************************
+  /// Exception for the sorted_vector_set.
+  ///\ingroup sorted_vector_set
+  //***************************************************************************
+  class sorted_vector_set_exception : public etl::exception
+  {
+  public:
+
+    sorted_vector_set_exception(string_type reason_, string_type file_name_, numeric_type line_number_)
+      : etl::exception(reason_, file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// Full exception for the sorted_vector_set.
+  ///\ingroup sorted_vector_set
+  //***************************************************************************
+  class sorted_vector_set_full : public etl::sorted_vector_set_exception
+  {
+  public:
+
+    sorted_vector_set_full(string_type file_name_, numeric_type line_number_)
+      : etl::sorted_vector_set_exception(ETL_ERROR_TEXT("sorted_vector_set:full", ETL_FILE"A"), file_name_, line_number_)
+    {
+    }
+  };
+
+  //***************************************************************************
+  /// The base class for specifically sized sorted_vector_sets.
+  /// Can be used as a reference type for all sorted_vector_sets containing a specific type.
+  /// The interface matches etl::iflat_set.
+  ///\ingroup sorted_vector_set
+  //***************************************************************************
+  template <typename T, typename TKeyCompare = std::less<T> >
+  class isorted_vector_set
+  {
+  private:
+
+    typedef etl::ivector<T> storage_t;
+
+    /// Branchless for keys that are cheap to compare.
+    typedef etl::private_algorithm::sorted_search<etl::use_branchless_search<T>::value> search_t;
+
+  public:
+
+    typedef T                 key_type;
+    typedef T                 value_type;
+    typedef TKeyCompare       key_compare;
+    typedef value_type&       reference;
+    typedef const value_type& const_reference;
+    typedef value_type*       pointer;
+    typedef const value_type* const_pointer;
+    typedef size_t            size_type;
+
+    // The elements of a set may not be modified in place, so both iterators are const.
+    typedef const value_type* iterator;
+    typedef const value_type* const_iterator;
+
+    typedef std::reverse_iterator<iterator>       reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+    typedef ptrdiff_t                             difference_type;
+
+  protected:
+
+    typedef typename etl::parameter_type<T>::type parameter_t;
+
+  public:
+
+    //*********************************************************************
+    /// Returns an iterator to the beginning of the sorted_vector_set.
+    ///\return An iterator to the beginning of the sorted_vector_set.
+    //*********************************************************************
+    const_iterator begin() const
+    {
+      return keys.data();
+    }
+
+    //*********************************************************************
+    /// Returns an iterator to the end of the sorted_vector_set.
+    ///\return An iterator to the end of the sorted_vector_set.
+    //*********************************************************************
+    const_iterator end() const
+    {
+      return keys.data() + keys.size();
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the beginning of the sorted_vector_set.
+    ///\return A const iterator to the beginning of the sorted_vector_set.
+    //*********************************************************************
+    const_iterator cbegin() const
+    {
+      return begin();
+    }
+
+    //*********************************************************************
+    /// Returns a const_iterator to the end of the sorted_vector_set.
+    ///\return A const iterator to the end of the sorted_vector_set.
+    //*********************************************************************
+    const_iterator cend() const
+    {
+      return end();
+    }
+
+    //*********************************************************************
+    /// Returns a reverse iterator to the reverse beginning of the sorted_vector_set.
+    ///\return Iterator to the reverse beginning of the sorted_vector_set.
+    //*********************************************************************
+    const_reverse_iterator rbegin() const
+    {
+      return const_reverse_iterator(end());
+    }
+
+    //*********************************************************************
+    /// Returns a reverse iterator to the end + 1 of the sorted_vector_set.
+    ///\return Reverse iterator to the end + 1 of the sorted_vector_set.
+    //*********************************************************************
+    const_reverse_iterator rend() const
+    {
+      return const_reverse_iterator(begin());
+    }
+
+    //*********************************************************************
+    /// Returns a const reverse iterator to the reverse beginning of the sorted_vector_set.
+    ///\return Const reverse iterator to the reverse beginning of the sorted_vector_set.
+    //*********************************************************************
+    const_reverse_iterator crbegin() const
+    {
+      return const_reverse_iterator(end());
+    }
+
+    //*********************************************************************
+    /// Returns a const reverse iterator to the end + 1 of the sorted_vector_set.
+    ///\return Const reverse iterator to the end + 1 of the sorted_vector_set.
+    //*********************************************************************
+    const_reverse_iterator crend() const
+    {
+      return const_reverse_iterator(begin());
+    }
+
+    //*********************************************************************
+    /// Assigns values to the sorted_vector_set.
+    /// If ETL_THROW_EXCEPTIONS & ETL_DEBUG are defined, emits sorted_vector_set_full if the sorted_vector_set does not have enough free space.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*********************************************************************
+    template <typename TIterator>
+    void assign(TIterator first, TIterator last)
+    {
+#if defined(ETL_DEBUG)
+      difference_type d = std::distance(first, last);
+      ETL_ASSERT(d <= difference_type(capacity()), ETL_ERROR(sorted_vector_set_full));
+#endif
+
+      clear();
+
+      while (first != last)
+      {
+        insert(*first++);
+      }
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the sorted_vector_set.
+    /// If asserts or exceptions are enabled, emits sorted_vector_set_full if the sorted_vector_set is already full.
+    ///\param value The value to insert.
+    //*********************************************************************
+    std::pair<iterator, bool> insert(parameter_t value)
+    {
+      size_t index = lower_bound_index(value);
+
+      std::pair<iterator, bool> result(begin() + index, false);
+
+      // Doesn't already exist?
+      if ((index == size()) || compare(value, keys[index]))
+      {
+        ETL_ASSERT(!full(), ETL_ERROR(sorted_vector_set_full));
+
+        keys.insert(keys.begin() + index, value);
+        result.second = true;
+      }
+
+      return result;
+    }
+
+    //*********************************************************************
+    /// Inserts a value to the sorted_vector_set.
+    /// If asserts or exceptions are enabled, emits sorted_vector_set_full if the sorted_vector_set is already full.
+    ///\param position The position to insert at.
+    ///\param value    The value to insert.
+    //*********************************************************************
+    iterator insert(iterator position, parameter_t value)
+    {
+      return insert(value).first;
+    }
+
+    //*********************************************************************
+    /// Inserts a range of values to the sorted_vector_set.
+    /// If asserts or exceptions are enabled, emits sorted_vector_set_full if the sorted_vector_set does not have enough free space.
+    ///\param first The first element to add.
+    ///\param last  The last + 1 element to add.
+    //*********************************************************************
+    template <class TIterator>
+    void insert(TIterator first, TIterator last)
+    {
+      while (first != last)
+      {
+        insert(*first++);
+      }
+    }
+
+    //*************************************************************************
+    /// Emplaces a value to the set.
+    //*************************************************************************
+    std::pair<iterator, bool> emplace(parameter_t value)
+    {
+      return insert(value);
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Emplaces a value to the set.
+    //*************************************************************************
+    template <typename ... Args>
+    std::pair<iterator, bool> emplace(Args && ... args)
+    {
+      return insert(value_type(std::forward<Args>(args)...));
+    }
+#else
+    //*************************************************************************
+    /// Emplaces a value to the set.
+    //*************************************************************************
+    template <typename T1>
+    std::pair<iterator, bool> emplace(const T1& value1)
+    {
+      return insert(value_type(value1));
+    }
+
+    //*************************************************************************
+    /// Emplaces a value to the set.
+    //*************************************************************************
+    template <typename T1, typename T2>
+    std::pair<iterator, bool> emplace(const T1& value1, const T2& value2)
+    {
+      return insert(value_type(value1, value2));
+    }
+
+    //*************************************************************************
+    /// Emplaces a value to the set.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3>
+    std::pair<iterator, bool> emplace(const T1& value1, const T2& value2, const T3& value3)
+    {
+      return insert(value_type(value1, value2, value3));
+    }
+
+    //*************************************************************************
+    /// Emplaces a value to the set.
+    //*************************************************************************
+    template <typename T1, typename T2, typename T3, typename T4>
+    std::pair<iterator, bool> emplace(const T1& value1, const T2& value2, const T3& value3, const T4& value4)
+    {
+      return insert(value_type(value1, value2, value3, value4));
+    }
+#endif // ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+
+    //*********************************************************************
+    /// Erases an element.
+    ///\param key The key to erase.
+    ///\return The number of elements erased. 0 or 1.
+    //*********************************************************************
+    size_t erase(parameter_t key)
+    {
+      size_t index = find_index(key);
+
+      if (index == size())
+      {
+        return 0;
+      }
+      else
+      {
+        keys.erase(keys.begin() + index);
+        return 1;
+      }
+    }
+
+    //*********************************************************************
+    /// Erases an element.
+    ///\param i_element Iterator to the element.
+    //*********************************************************************
+    void erase(iterator i_element)
+    {
+      keys.erase(keys.begin() + (i_element - begin()));
+    }
+
+    //*********************************************************************
+    /// Erases a range of elements.
+    /// The range includes all the elements between first and last, including the
+    /// element pointed by first, but not the one pointed by last.
+    ///\param first Iterator to the first element.
+    ///\param last  Iterator to the last element.
+    //*********************************************************************
+    void erase(iterator first, iterator last)
+    {
+      keys.erase(keys.begin() + (first - begin()), keys.begin() + (last - begin()));
+    }
+
+    //*************************************************************************
+    /// Clears the sorted_vector_set.
+    //*************************************************************************
+    void clear()
+    {
+      keys.clear();
+    }
+
+    //*********************************************************************
+    /// Finds an element.
+    ///\param key The key to search for.
+    ///\return An iterator pointing to the element or end() if not found.
+    //*********************************************************************
+    const_iterator find(parameter_t key) const
+    {
+      return begin() + find_index(key);
+    }
+
+    //*********************************************************************
+    /// Counts an element.
+    ///\param key The key to search for.
+    ///\return 1 if the key exists, otherwise 0.
+    //*********************************************************************
+    size_t count(parameter_t key) const
+    {
+      return (find_index(key) == size()) ? 0 : 1;
+    }
+
+    //*********************************************************************
+    /// Finds the lower bound of a key
+    ///\param key The key to search for.
+    ///\return An iterator.
+    //*********************************************************************
+    const_iterator lower_bound(parameter_t key) const
+    {
+      return begin() + lower_bound_index(key);
+    }
+
+    //*********************************************************************
+    /// Finds the upper bound of a key
+    ///\param key The key to search for.
+    ///\return An iterator.
+    //*********************************************************************
+    const_iterator upper_bound(parameter_t key) const
+    {
+      return search_t::upper_bound(begin(), end(), key, compare);
+    }
+
+    //*********************************************************************
+    /// Finds the range of equal elements of a key
+    ///\param key The key to search for.
+    ///\return An iterator pair.
+    //*********************************************************************
+    std::pair<const_iterator, const_iterator> equal_range(parameter_t key) const
+    {
+      return std::pair<const_iterator, const_iterator>(lower_bound(key), upper_bound(key));
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    /// The source is already in order, so the array is copied directly.
+    //*************************************************************************
+    isorted_vector_set& operator = (const isorted_vector_set& rhs)
+    {
+      if (&rhs != this)
+      {
+        ETL_ASSERT(rhs.size() <= capacity(), ETL_ERROR(sorted_vector_set_full));
+
+        keys.assign(rhs.keys.begin(), rhs.keys.end());
+      }
+
+      return *this;
+    }
+
+    //*************************************************************************
+    /// Gets the current size of the sorted_vector_set.
+    ///\return The current size of the sorted_vector_set.
+    //*************************************************************************
+    size_type size() const
+    {
+      return keys.size();
+    }
+
+    //*************************************************************************
+    /// Checks the 'empty' state of the sorted_vector_set.
+    ///\return <b>true</b> if empty.
+    //*************************************************************************
+    bool empty() const
+    {
+      return keys.empty();
+    }
+
+    //*************************************************************************
+    /// Checks the 'full' state of the sorted_vector_set.
+    ///\return <b>true</b> if full.
+    //*************************************************************************
+    bool full() const
+    {
+      return keys.full();
+    }
+
+    //*************************************************************************
+    /// Returns the capacity of the sorted_vector_set.
+    ///\return The capacity of the sorted_vector_set.
+    //*************************************************************************
+    size_type capacity() const
+    {
+      return keys.capacity();
+    }
+
+    //*************************************************************************
+    /// Returns the maximum possible size of the sorted_vector_set.
+    ///\return The maximum size of the sorted_vector_set.
+    //*************************************************************************
+    size_type max_size() const
+    {
+      return keys.max_size();
+    }
+
+    //*************************************************************************
+    /// Returns the remaining capacity.
+    ///\return The remaining capacity.
+    //*************************************************************************
+    size_t available() const
+    {
+      return keys.available();
+    }
+
+  protected:
+
+    //*********************************************************************
+    /// Constructor.
+    //*********************************************************************
+    isorted_vector_set(storage_t& keys_)
+      : keys(keys_)
+    {
+    }
+
+  private:
+
+    // Disable copy construction.
+    isorted_vector_set(const isorted_vector_set&);
+
+    //*********************************************************************
+    /// The index of the first key that is not less than 'key'.
+    //*********************************************************************
+    size_t lower_bound_index(parameter_t key) const
+    {
+      return search_t::lower_bound(begin(), end(), key, compare) - begin();
+    }
+
+    //*********************************************************************
+    /// The index of 'key', or size() if it is not present.
+    //*********************************************************************
+    size_t find_index(parameter_t key) const
+    {
+      size_t index = lower_bound_index(key);
+
+      if ((index != size()) && compare(key, keys[index]))
+      {
+        index = size();
+      }
+
+      return index;
+    }
+
+    storage_t& keys;
+
+    TKeyCompare compare;
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+#if defined(ETL_POLYMORPHIC_SORTED_VECTOR_SET) || defined(ETL_POLYMORPHIC_CONTAINERS)
+  public:
+    virtual ~isorted_vector_set()
+    {
+    }
+#else
+  protected:
+    ~isorted_vector_set()
+    {
+    }
+#endif
+  };
+
+  //***************************************************************************
+  /// Equal operator.
+  ///\param lhs Reference to the first sorted_vector_set.
+  ///\param rhs Reference to the second sorted_vector_set.
+  ///\return <b>true</b> if the sets are equal, otherwise <b>false</b>
+  ///\ingroup sorted_vector_set
+  //***************************************************************************
+  template <typename T, typename TKeyCompare>
+  bool operator ==(const etl::isorted_vector_set<T, TKeyCompare>& lhs, const etl::isorted_vector_set<T, TKeyCompare>& rhs)
+  {
+    return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+  }
+
+  //***************************************************************************
+  /// Not equal operator.
+  ///\param lhs Reference to the first sorted_vector_set.
+  ///\param rhs Reference to the second sorted_vector_set.
+  ///\return <b>true</b> if the sets are not equal, otherwise <b>false</b>
+  ///\ingroup sorted_vector_set
+  //***************************************************************************
+  template <typename T, typename TKeyCompare>
+  bool operator !=(const etl::isorted_vector_set<T, TKeyCompare>& lhs, const etl::isorted_vector_set<T, TKeyCompare>& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+  //***************************************************************************
+  /// A sorted_vector_set implementation that uses a fixed size buffer.
+  ///\tparam T         The value type.
+  ///\tparam MAX_SIZE_ The maximum number of elements that can be stored.
+  ///\tparam TCompare  The type to compare keys. Default = std::less<T>
+  ///\ingroup sorted_vector_set
+  //***************************************************************************
+  template <typename T, const size_t MAX_SIZE_, typename TCompare = std::less<T> >
+  class sorted_vector_set : public etl::isorted_vector_set<T, TCompare>
+  {
+  public:
+
+    static const size_t MAX_SIZE = MAX_SIZE_;
+
+    //*************************************************************************
+    /// Constructor.
+    //*************************************************************************
+    sorted_vector_set()
+      : etl::isorted_vector_set<T, TCompare>(storage)
+    {
+    }
+
+    //*************************************************************************
+    /// Copy constructor.
+    //*************************************************************************
+    sorted_vector_set(const sorted_vector_set& other)
+      : etl::isorted_vector_set<T, TCompare>(storage)
+    {
+      etl::isorted_vector_set<T, TCompare>::operator =(other);
+    }
+
+    //*************************************************************************
+    /// Constructor, from an iterator range.
+    ///\tparam TIterator The iterator type.
+    ///\param first The iterator to the first element.
+    ///\param last  The iterator to the last element + 1.
+    //*************************************************************************
+    template <typename TIterator>
+    sorted_vector_set(TIterator first, TIterator last)
+      : etl::isorted_vector_set<T, TCompare>(storage)
+    {
+      this->assign(first, last);
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+    //*************************************************************************
+    /// Construct from initializer_list.
+    //*************************************************************************
+    sorted_vector_set(std::initializer_list<T> init)
+      : etl::isorted_vector_set<T, TCompare>(storage)
+    {
+      this->assign(init.begin(), init.end());
+    }
+#endif
+
+    //*************************************************************************
+    /// Destructor.
+    //*************************************************************************
+    ~sorted_vector_set()
+    {
+      this->clear();
+    }
+
+    //*************************************************************************
+    /// Assignment operator.
+    //*************************************************************************
+    sorted_vector_set& operator = (const sorted_vector_set& rhs)
+    {
+      etl::isorted_vector_set<T, TCompare>::operator =(rhs);
+
+      return *this;
+    }
+
+  private:
+
+    /// The keys, in order.
+    etl::vector<T, MAX_SIZE> storage;
+  };
+}
+
+#undef ETL_FILE
+
+#endif
@@ -314,6 +314,16 @@ namespace etl
   template <typename T> struct is_trivially_copy_assignable : etl::is_pod<T> {};
 #endif
 
+  /// is_trivially_relocatable
+  /// True if an object may be moved to new storage with memcpy, without calling
+  /// its copy constructor or its destructor.
+  /// By default, types that are trivially copy constructible and trivially destructible.
+  /// Specialise for other types that hold no pointers to themselves.
+  /// Containers use memmove to shift these types on insert and erase.
+  ///\ingroup type_traits
+  template <typename T> struct is_trivially_relocatable : etl::integral_constant<bool, etl::is_trivially_copy_constructible<T>::value &&
+                                                                                      etl::is_trivially_destructible<T>::value> {};
+
   /// conditional
   ///\ingroup type_traits
   template <bool B, typename T, typename F>  struct conditional { typedef T type; };
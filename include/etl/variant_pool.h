@@ -104,8 +104,47 @@ namespace etl
     }
   };
 
+  namespace private_variant_pool
+  {
+    //*************************************************************************
+    /// Asks the storage whether it can supply an item for a 'T'.
+    /// Storage with several item sizes, such as etl::islab_allocator, answers
+    /// per type through 'full<T>()'.
+    //*************************************************************************
+    template <typename TStorage>
+    struct storage_traits
+    {
+      template <typename T>
+      static bool full(const TStorage& storage)
+      {
+        return storage.template full<T>();
+      }
+    };
+
+    //*************************************************************************
+    /// An etl::ipool has one item size, so is either full or not.
+    //*************************************************************************
+    template <>
+    struct storage_traits<etl::ipool>
+    {
+      template <typename T>
+      static bool full(const etl::ipool& storage)
+      {
+        return storage.full();
+      }
+    };
+  }
+
   //***************************************************************************
-  template <const size_t MAX_SIZE_,
+  /// A variant pool that creates its objects in external storage.
+  /// The storage may be an etl::ipool or an etl::islab_allocator, and may be
+  /// shared with other users.
+  ///\code
+  /// etl::slab_allocator<etl::slab_class<16, 32>, etl::slab_class<256, 4> > slab;
+  /// etl::variant_pool_ext<etl::islab_allocator, Small, Large> pool(slab);
+  ///\endcode
+  //***************************************************************************
+  template <typename TStorage,
             typename T1, 
             typename T2 = void, 
             typename T3 = void, 
@@ -122,16 +161,17 @@ namespace etl
             typename T14 = void, 
             typename T15 = void, 
             typename T16 = void>
-  class variant_pool
+  class variant_pool_ext
   {
   public:
 
-    static const size_t MAX_SIZE = MAX_SIZE_;
+    typedef TStorage storage_type;
 
     //*************************************************************************
-    /// Default constructor.
+    /// Constructor.
     //*************************************************************************
-    variant_pool()
+    explicit variant_pool_ext(TStorage& pool_)
+      : pool(pool_)
     {
     }
 
@@ -146,7 +186,7 @@ namespace etl
 
       T* p = nullptr;
 
-      if (pool.full())
+      if (is_full<T>())
       {
         ETL_ASSERT(false, ETL_ERROR(etl::variant_pool_cannot_create));
       }
@@ -173,7 +213,7 @@ namespace etl
 
       T* p = nullptr;
 
-      if (pool.full())
+      if (is_full<T>())
       {
         ETL_ASSERT(false, ETL_ERROR(etl::variant_pool_cannot_create));
       }
@@ -200,7 +240,7 @@ namespace etl
 
       T* p = nullptr;
 
-      if (pool.full())
+      if (is_full<T>())
       {
         ETL_ASSERT(false, ETL_ERROR(etl::variant_pool_cannot_create));
       }
@@ -227,7 +267,7 @@ namespace etl
 
       T* p = nullptr;
 
-      if (pool.full())
+      if (is_full<T>())
       {
         ETL_ASSERT(false, ETL_ERROR(etl::variant_pool_cannot_create));
       }
@@ -254,7 +294,7 @@ namespace etl
 
       T* p = nullptr;
 
-      if (pool.full())
+      if (is_full<T>())
       {
         ETL_ASSERT(false, ETL_ERROR(etl::variant_pool_cannot_create));
       }
@@ -281,7 +321,7 @@ namespace etl
 
       T* p = nullptr;
 
-      if (pool.full())
+      if (is_full<T>())
       {
         ETL_ASSERT(false, ETL_ERROR(etl::variant_pool_cannot_create));
       }
@@ -344,7 +384,7 @@ namespace etl
     //*************************************************************************
     size_t max_size() const
     {
-      return MAX_SIZE;
+      return pool.max_size();
     }
 
     //*************************************************************************
@@ -381,6 +421,59 @@ namespace etl
       return pool.full();
     }
 
+  private:
+
+    //*************************************************************************
+    /// Can the storage supply an item for a 'T'?
+    //*************************************************************************
+    template <typename T>
+    bool is_full() const
+    {
+      return etl::private_variant_pool::storage_traits<TStorage>::template full<T>(pool);
+    }
+
+    variant_pool_ext(const variant_pool_ext&);
+    variant_pool_ext& operator =(const variant_pool_ext&);
+
+    // The storage.
+    TStorage& pool;
+  };
+
+  //***************************************************************************
+  /// A variant pool with its own storage, sized for the largest type.
+  //***************************************************************************
+  template <const size_t MAX_SIZE_,
+            typename T1, 
+            typename T2 = void, 
+            typename T3 = void, 
+            typename T4 = void, 
+            typename T5 = void, 
+            typename T6 = void, 
+            typename T7 = void, 
+            typename T8 = void, 
+            typename T9 = void, 
+            typename T10 = void, 
+            typename T11 = void, 
+            typename T12 = void, 
+            typename T13 = void, 
+            typename T14 = void, 
+            typename T15 = void, 
+            typename T16 = void>
+  class variant_pool
+    : public etl::variant_pool_ext<etl::ipool, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, T16>
+  {
+  public:
+
+    static const size_t MAX_SIZE = MAX_SIZE_;
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    variant_pool()
+      : etl::variant_pool_ext<etl::ipool, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, T16>(storage)
+    {
+    }
+
   private:
 
     variant_pool(const variant_pool&);
@@ -389,7 +482,7 @@ namespace etl
     // The pool.
     etl::generic_pool<etl::largest<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, T16>::size,
                       etl::largest<T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15, T16>::alignment,
-                      MAX_SIZE> pool;
+                      MAX_SIZE> storage;
   };
 }
 
@@ -41,7 +41,7 @@ cog.outl("#endif")
 /*[[[cog
 import cog
 cog.outl("//***************************************************************************")
-cog.outl("// THIS FILE HAS BEEN AUTO GENERATED. DO NOT EDIT THIS FILE.")
+cog.outl("// This file has been auto generated. Do not edit this file.")
 cog.outl("//***************************************************************************")
 ]]]*/
 /*[[[end]]]*/
@@ -66,6 +66,9 @@ cog.outl("//********************************************************************
 #include <stdint.h>
 
 #include "platform.h"
+
+#include "stl/utility.h"
+
 #include "error_handler.h"
 #include "exception.h"
 #include "largest.h"
@@ -75,8 +78,6 @@ cog.outl("//********************************************************************
 #include "type_lookup.h"
 #include "pool.h"
 
-#include "stl/utility.h"
-
 #undef ETL_FILE
 #define ETL_FILE "40"
 
@@ -115,10 +116,49 @@ namespace etl
     }
   };
 
+  namespace private_variant_pool
+  {
+    //*************************************************************************
+    /// Asks the storage whether it can supply an item for a 'T'.
+    /// Storage with several item sizes, such as etl::islab_allocator, answers
+    /// per type through 'full<T>()'.
+    //*************************************************************************
+    template <typename TStorage>
+    struct storage_traits
+    {
+      template <typename T>
+      static bool full(const TStorage& storage)
+      {
+        return storage.template full<T>();
+      }
+    };
+
+    //*************************************************************************
+    /// An etl::ipool has one item size, so is either full or not.
+    //*************************************************************************
+    template <>
+    struct storage_traits<etl::ipool>
+    {
+      template <typename T>
+      static bool full(const etl::ipool& storage)
+      {
+        return storage.full();
+      }
+    };
+  }
+
+  //***************************************************************************
+  /// A variant pool that creates its objects in external storage.
+  /// The storage may be an etl::ipool or an etl::islab_allocator, and may be
+  /// shared with other users.
+  ///\code
+  /// etl::slab_allocator<etl::slab_class<16, 32>, etl::slab_class<256, 4> > slab;
+  /// etl::variant_pool_ext<etl::islab_allocator, Small, Large> pool(slab);
+  ///\endcode
   //***************************************************************************
   /*[[[cog
   import cog
-  cog.outl("template <const size_t MAX_SIZE_,")
+  cog.outl("template <typename TStorage,")
   cog.outl("          typename T1, ")
   for n in range(2, int(NTypes)):
       cog.outl("          typename T%s = void, " % n)
@@ -128,20 +168,21 @@ namespace etl
   cog.outl("          typename T%s = void>" % int(NTypes))
   ]]]*/
   /*[[[end]]]*/
-  class variant_pool
+  class variant_pool_ext
   {
   public:
 
-    static const size_t MAX_SIZE = MAX_SIZE_;
+    typedef TStorage storage_type;
 
     //*************************************************************************
-    /// Default constructor.
+    /// Constructor.
     //*************************************************************************
-    variant_pool()
+    explicit variant_pool_ext(TStorage& pool_)
+      : pool(pool_)
     {
     }
 
-#if !ETL_CPP11_SUPPORTED || defined(ETL_STLPORT)
+#if !ETL_CPP11_SUPPORTED || defined(ETL_STLPORT) || defined(ETL_NO_STL)
     //*************************************************************************
     /// Creates the object. Default constructor.
     //*************************************************************************
@@ -162,7 +203,7 @@ namespace etl
 
       T* p = nullptr;
 
-      if (pool.full())
+      if (is_full<T>())
       {
         ETL_ASSERT(false, ETL_ERROR(etl::variant_pool_cannot_create));
       }
@@ -199,7 +240,7 @@ namespace etl
 
       T* p = nullptr;
 
-      if (pool.full())
+      if (is_full<T>())
       {
         ETL_ASSERT(false, ETL_ERROR(etl::variant_pool_cannot_create));
       }
@@ -236,7 +277,7 @@ namespace etl
 
       T* p = nullptr;
 
-      if (pool.full())
+      if (is_full<T>())
       {
         ETL_ASSERT(false, ETL_ERROR(etl::variant_pool_cannot_create));
       }
@@ -273,7 +314,7 @@ namespace etl
 
       T* p = nullptr;
 
-      if (pool.full())
+      if (is_full<T>())
       {
         ETL_ASSERT(false, ETL_ERROR(etl::variant_pool_cannot_create));
       }
@@ -310,7 +351,7 @@ namespace etl
 
       T* p = nullptr;
 
-      if (pool.full())
+      if (is_full<T>())
       {
         ETL_ASSERT(false, ETL_ERROR(etl::variant_pool_cannot_create));
       }
@@ -347,7 +388,7 @@ namespace etl
 
       T* p = nullptr;
 
-      if (pool.full())
+      if (is_full<T>())
       {
         ETL_ASSERT(false, ETL_ERROR(etl::variant_pool_cannot_create));
       }
@@ -409,7 +450,7 @@ namespace etl
     //*************************************************************************
     size_t max_size() const
     {
-      return MAX_SIZE;
+      return pool.max_size();
     }
 
     //*************************************************************************
@@ -446,6 +487,74 @@ namespace etl
       return pool.full();
     }
 
+  private:
+
+    //*************************************************************************
+    /// Can the storage supply an item for a 'T'?
+    //*************************************************************************
+    template <typename T>
+    bool is_full() const
+    {
+      return etl::private_variant_pool::storage_traits<TStorage>::template full<T>(pool);
+    }
+
+    variant_pool_ext(const variant_pool_ext&);
+    variant_pool_ext& operator =(const variant_pool_ext&);
+
+    // The storage.
+    TStorage& pool;
+  };
+
+  //***************************************************************************
+  /// A variant pool with its own storage, sized for the largest type.
+  //***************************************************************************
+  /*[[[cog
+  import cog
+  cog.outl("template <const size_t MAX_SIZE_,")
+  cog.outl("          typename T1, ")
+  for n in range(2, int(NTypes)):
+      cog.outl("          typename T%s = void, " % n)
+      if n % 16 == 0:
+          cog.outl("")
+          cog.out("          ")
+  cog.outl("          typename T%s = void>" % int(NTypes))
+  ]]]*/
+  /*[[[end]]]*/
+  class variant_pool
+    /*[[[cog
+    import cog
+    cog.out(": public etl::variant_pool_ext<etl::ipool, ")
+    for n in range(1, int(NTypes)):
+        cog.out("T%s, " % n)
+        if n % 16 == 0:
+            cog.outl("")
+            cog.out("                                    ")
+    cog.outl("T%s>" % int(NTypes))
+    ]]]*/
+    /*[[[end]]]*/
+  {
+  public:
+
+    static const size_t MAX_SIZE = MAX_SIZE_;
+
+    //*************************************************************************
+    /// Default constructor.
+    //*************************************************************************
+    variant_pool()
+      /*[[[cog
+      import cog
+      cog.out(": etl::variant_pool_ext<etl::ipool, ")
+      for n in range(1, int(NTypes)):
+          cog.out("T%s, " % n)
+          if n % 16 == 0:
+              cog.outl("")
+              cog.out("                                  ")
+      cog.outl("T%s>(storage)" % int(NTypes))
+      ]]]*/
+      /*[[[end]]]*/
+    {
+    }
+
   private:
 
     variant_pool(const variant_pool&);
@@ -469,7 +578,7 @@ namespace etl
             cog.outl("")
             cog.out("                  ")
     cog.outl("T%s>::alignment," % int(NTypes))
-    cog.outl("                  MAX_SIZE> pool;")
+    cog.outl("                  MAX_SIZE> storage;")
     ]]]*/
     /*[[[end]]]*/
   };
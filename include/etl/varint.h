@@ -0,0 +1,355 @@
+///\file
+
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_VARINT_INCLUDED
+#define ETL_VARINT_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string.h>
+
+#include "platform.h"
+#include "type_traits.h"
+#include "integral_limits.h"
+#include "endianness.h"
+#include "binary.h"
+#include "static_assert.h"
+
+#include "stl/iterator.h"
+
+///\defgroup varint varint
+/// Variable length integer encoding.
+///\ingroup utilities
+
+namespace etl
+{
+  //***************************************************************************
+  /// Maps signed integers to unsigned, so that values close to zero have few
+  /// significant bits. 0, -1, 1, -2, 2 ... become 0, 1, 2, 3, 4 ...
+  ///\ingroup varint
+  //***************************************************************************
+  struct zigzag
+  {
+    //*************************************************************************
+    /// Encodes a signed value.
+    //*************************************************************************
+    template <typename T>
+    static typename etl::make_unsigned<T>::type encode(T value)
+    {
+      ETL_STATIC_ASSERT(etl::is_signed<T>::value && etl::is_integral<T>::value, "Only signed integral types are supported");
+
+      typedef typename etl::make_unsigned<T>::type U;
+
+      const U sign = U(0) - (U(value) >> ((CHAR_BIT * sizeof(T)) - 1));
+
+      return U(U(value) << 1) ^ sign;
+    }
+
+    //*************************************************************************
+    /// Decodes to a signed value.
+    //*************************************************************************
+    template <typename T>
+    static typename etl::make_signed<T>::type decode(T value)
+    {
+      ETL_STATIC_ASSERT(etl::is_unsigned<T>::value, "Only unsigned integral types are supported");
+
+      typedef typename etl::make_signed<T>::type S;
+
+      return S(T(value >> 1) ^ T(T(0) - (value & 1U)));
+    }
+
+    //*************************************************************************
+    /// Encodes a range of signed values.
+    ///\return The output iterator, one past the last value.
+    //*************************************************************************
+    template <typename TInputIterator, typename TOutputIterator>
+    static TOutputIterator encode(TInputIterator first, TInputIterator last, TOutputIterator out)
+    {
+      while (first != last)
+      {
+        *out = encode(*first);
+        ++first;
+        ++out;
+      }
+
+      return out;
+    }
+
+    //*************************************************************************
+    /// Decodes a range of unsigned values.
+    ///\return The output iterator, one past the last value.
+    //*************************************************************************
+    template <typename TInputIterator, typename TOutputIterator>
+    static TOutputIterator decode(TInputIterator first, TInputIterator last, TOutputIterator out)
+    {
+      while (first != last)
+      {
+        *out = decode(*first);
+        ++first;
+        ++out;
+      }
+
+      return out;
+    }
+  };
+
+  //***************************************************************************
+  /// Encodes and decodes unsigned integers as LEB128 variable length integers.
+  /// Each byte holds seven bits, least significant first, with the top bit set
+  /// on all but the last byte.
+  /// Signed values should be mapped with etl::zigzag first.
+  /// As with etl::bit_stream, the caller supplies the buffer. Functions return
+  /// the number of bytes used, or zero if the buffer was too short or the
+  /// encoding was invalid.
+  ///\ingroup varint
+  //***************************************************************************
+  struct varint
+  {
+    //*************************************************************************
+    /// The largest number of bytes needed to encode a 'T'.
+    //*************************************************************************
+    template <typename T>
+    struct max_size
+    {
+      static const size_t value = ((CHAR_BIT * sizeof(T)) + 6) / 7;
+    };
+
+    //*************************************************************************
+    /// Returns the number of bytes needed to encode the value.
+    //*************************************************************************
+    template <typename T>
+    static size_t size(T value)
+    {
+      ETL_STATIC_ASSERT(etl::is_unsigned<T>::value, "Only unsigned integral types are supported");
+
+      const size_t bits = 64U - etl::count_leading_zeros(uint64_t(value) | 1U);
+
+      return (bits + 6U) / 7U;
+    }
+
+    //*************************************************************************
+    /// Encodes one value.
+    ///\return The number of bytes written, or zero if 'length' is too short.
+    //*************************************************************************
+    template <typename T>
+    static size_t encode(T value, unsigned char* buffer, size_t length)
+    {
+      ETL_STATIC_ASSERT(etl::is_unsigned<T>::value, "Only unsigned integral types are supported");
+
+      if (length < size(value))
+      {
+        return 0U;
+      }
+
+      unsigned char* p = buffer;
+
+      while (value >= 0x80U)
+      {
+        *p++ = static_cast<unsigned char>(value | 0x80U);
+        value >>= 7;
+      }
+
+      *p++ = static_cast<unsigned char>(value);
+
+      return size_t(p - buffer);
+    }
+
+    //*************************************************************************
+    /// Encodes a range of values.
+    ///\return The number of bytes written, or zero if 'length' is too short for all of them.
+    //*************************************************************************
+    template <typename TIterator>
+    static size_t encode(TIterator first, TIterator last, unsigned char* buffer, size_t length)
+    {
+      size_t used = 0U;
+
+      while (first != last)
+      {
+        size_t n = encode(*first, buffer + used, length - used);
+
+        if (n == 0U)
+        {
+          return 0U;
+        }
+
+        used += n;
+        ++first;
+      }
+
+      return used;
+    }
+
+    //*************************************************************************
+    /// Decodes one value.
+    /// Where eight bytes are available, a value of more than one byte is
+    /// decoded by finding the terminating byte and gathering the seven bit
+    /// groups without a loop.
+    ///\return The number of bytes read, or zero if the buffer ended before the
+    /// last byte or the value does not fit in a 'T'.
+    //*************************************************************************
+    template <typename T>
+    static size_t decode(const unsigned char* buffer, size_t length, T& value)
+    {
+      ETL_STATIC_ASSERT(etl::is_unsigned<T>::value, "Only unsigned integral types are supported");
+
+      // Small values are the common case, and a predicted branch on the first
+      // byte is quicker than finding the terminator.
+      if ((length != 0U) && (buffer[0] < 0x80U))
+      {
+        value = T(buffer[0]);
+        return 1U;
+      }
+
+      uint64_t result = 0U;
+      size_t   n      = 0U;
+
+      if (length >= sizeof(uint64_t))
+      {
+        n = decode_word(buffer, result);
+      }
+
+      if (n == 0U)
+      {
+        n = decode_bytes(buffer, length, result);
+      }
+
+      if ((n == 0U) || (n > max_size<T>::value) || (result > uint64_t(etl::integral_limits<T>::max)))
+      {
+        return 0U;
+      }
+
+      value = T(result);
+
+      return n;
+    }
+
+    //*************************************************************************
+    /// Decodes 'count' values to 'out', which must define a value_type.
+    ///\return The number of bytes read, or zero if any value could not be decoded.
+    //*************************************************************************
+    template <typename TIterator>
+    static size_t decode(const unsigned char* buffer, size_t length, TIterator out, size_t count)
+    {
+      typedef typename std::iterator_traits<TIterator>::value_type value_t;
+
+      size_t used = 0U;
+
+      while (count != 0U)
+      {
+        value_t value;
+        size_t  n = decode(buffer + used, length - used, value);
+
+        if (n == 0U)
+        {
+          return 0U;
+        }
+
+        *out = value;
+        ++out;
+        used += n;
+        --count;
+      }
+
+      return used;
+    }
+
+  private:
+
+    //*************************************************************************
+    /// Decodes a value of up to eight bytes from the next eight bytes.
+    ///\return The number of bytes, or zero if there is no terminator in them.
+    //*************************************************************************
+    static size_t decode_word(const unsigned char* buffer, uint64_t& result)
+    {
+      uint64_t word;
+      memcpy(&word, buffer, sizeof(word));
+
+      // Least significant byte first.
+      if (etl::endianness::value() == etl::endian::big)
+      {
+        word = etl::reverse_bytes(word);
+      }
+
+      const uint64_t stops = ~word & 0x8080808080808080ULL;
+
+      if (stops == 0U)
+      {
+        return 0U;
+      }
+
+      const size_t bits = etl::count_trailing_zeros(stops) + 1U;
+
+      if (bits < 64U)
+      {
+        word &= (uint64_t(1U) << bits) - 1U;
+      }
+
+      // Gather the seven bit groups.
+      word &= 0x7F7F7F7F7F7F7F7FULL;
+      word = ((word & 0x7F007F007F007F00ULL) >> 1) | (word & 0x007F007F007F007FULL);
+      word = ((word & 0x3FFF00003FFF0000ULL) >> 2) | (word & 0x00003FFF00003FFFULL);
+      word = ((word & 0x0FFFFFFF00000000ULL) >> 4) | (word & 0x000000000FFFFFFFULL);
+
+      result = word;
+
+      return bits / CHAR_BIT;
+    }
+
+    //*************************************************************************
+    /// Decodes a value a byte at a time.
+    ///\return The number of bytes, or zero if the buffer ends first or the
+    /// value has more than 64 bits.
+    //*************************************************************************
+    static size_t decode_bytes(const unsigned char* buffer, size_t length, uint64_t& result)
+    {
+      const size_t max_bytes = max_size<uint64_t>::value;
+
+      result = 0U;
+
+      for (size_t n = 0U; (n < length) && (n < max_bytes); ++n)
+      {
+        const unsigned char b = buffer[n];
+
+        result |= uint64_t(b & 0x7FU) << (7U * n);
+
+        if ((b & 0x80U) == 0U)
+        {
+          // The last of ten bytes may only hold the top bit.
+          return ((n == (max_bytes - 1U)) && (b > 1U)) ? 0U : n + 1U;
+        }
+      }
+
+      return 0U;
+    }
+  };
+}
+
+#endif
@@ -36,6 +36,7 @@ SOFTWARE.
 #include <stddef.h>
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 
 #include "platform.h"
 #include "algorithm.h"
@@ -538,6 +539,19 @@ namespace etl
       {
         create_back(value);
       }
+      else if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+      {
+        // The value may be one of the elements that move.
+        const_pointer p_value = etl::addressof(value);
+
+        if ((p_value >= position) && (p_value < p_end))
+        {
+          ++p_value;
+        }
+
+        relocate_up(position, 1);
+        ::new (etl::addressof(*position)) T(*p_value);
+      }
       else
       {
         create_back(back());
@@ -563,6 +577,11 @@ namespace etl
       {
         create_back(std::move(value));
       }
+      else if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+      {
+        relocate_up(position, 1);
+        ::new (etl::addressof(*position)) T(std::move(value));
+      }
       else
       {
         create_back(std::move(back()));
@@ -593,9 +612,17 @@ namespace etl
       else
       {
         p = etl::addressof(*position);
-        create_back(back());
-        std::copy_backward(position, p_end - 2, p_end - 1);
-        (*position).~T();
+
+        if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+        {
+          relocate_up(position, 1);
+        }
+        else
+        {
+          create_back(back());
+          std::copy_backward(position, p_end - 2, p_end - 1);
+          (*position).~T();
+        }
       }
 
       ::new (p) T(std::forward<Args>(args)...);
@@ -618,9 +645,17 @@ namespace etl
       else
       {
         p = etl::addressof(*position);
-        create_back(back());
-        std::copy_backward(position, p_end - 2, p_end - 1);
-        (*position).~T();
+
+        if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+        {
+          relocate_up(position, 1);
+        }
+        else
+        {
+          create_back(back());
+          std::copy_backward(position, p_end - 2, p_end - 1);
+          (*position).~T();
+        }
       }
 
       ::new (p) T(value1);
@@ -643,9 +678,17 @@ namespace etl
       else
       {
         p = etl::addressof(*position);
-        create_back(back());
-        std::copy_backward(position, p_end - 2, p_end - 1);
-        (*position).~T();
+
+        if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+        {
+          relocate_up(position, 1);
+        }
+        else
+        {
+          create_back(back());
+          std::copy_backward(position, p_end - 2, p_end - 1);
+          (*position).~T();
+        }
       }
 
       ::new (p) T(value1, value2);
@@ -668,9 +711,17 @@ namespace etl
       else
       {
         p = etl::addressof(*position);
-        create_back(back());
-        std::copy_backward(position, p_end - 2, p_end - 1);
-        (*position).~T();
+
+        if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+        {
+          relocate_up(position, 1);
+        }
+        else
+        {
+          create_back(back());
+          std::copy_backward(position, p_end - 2, p_end - 1);
+          (*position).~T();
+        }
       }
 
       ::new (p) T(value1, value2, value3);
@@ -693,9 +744,17 @@ namespace etl
       else
       {
         p = etl::addressof(*position);
-        create_back(back());
-        std::copy_backward(position, p_end - 2, p_end - 1);
-        (*position).~T();
+
+        if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+        {
+          relocate_up(position, 1);
+        }
+        else
+        {
+          create_back(back());
+          std::copy_backward(position, p_end - 2, p_end - 1);
+          (*position).~T();
+        }
       }
 
       ::new (p) T(value1, value2, value3, value4);
@@ -715,6 +774,22 @@ namespace etl
     {
       ETL_ASSERT((size() + n) <= CAPACITY, ETL_ERROR(vector_full));
 
+      if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+      {
+        // The value may be one of the elements that move.
+        const_pointer p_value = etl::addressof(value);
+
+        if ((p_value >= position) && (p_value < p_end))
+        {
+          p_value += n;
+        }
+
+        relocate_up(position, n);
+        etl::uninitialized_fill_n(position, n, *p_value);
+
+        return;
+      }
+
       size_t insert_n = n;
       size_t insert_begin = std::distance(begin(), position);
       size_t insert_end = insert_begin + insert_n;
@@ -745,7 +820,7 @@ namespace etl
       ETL_ADD_DEBUG_COUNT(construct_old_n)
 
         // Copy old.
-        etl::copy_n(p_buffer + insert_begin, copy_old_n, p_buffer + insert_end);
+      std::copy_backward(p_buffer + insert_begin, p_buffer + insert_begin + copy_old_n, p_buffer + insert_end + copy_old_n);
 
       // Construct new.
       etl::uninitialized_fill_n(p_end, construct_new_n, value);
@@ -772,6 +847,14 @@ namespace etl
 
       ETL_ASSERT((size() + count) <= CAPACITY, ETL_ERROR(vector_full));
 
+      if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+      {
+        relocate_up(position, count);
+        etl::uninitialized_copy(first, last, position);
+
+        return;
+      }
+
       size_t insert_n = count;
       size_t insert_begin = std::distance(begin(), position);
       size_t insert_end = insert_begin + insert_n;
@@ -802,7 +885,7 @@ namespace etl
       ETL_ADD_DEBUG_COUNT(construct_old_n)
 
         // Copy old.
-        etl::copy_n(p_buffer + insert_begin, copy_old_n, p_buffer + insert_end);
+      std::copy_backward(p_buffer + insert_begin, p_buffer + insert_begin + copy_old_n, p_buffer + insert_end + copy_old_n);
 
       // Construct new.
       etl::uninitialized_copy_n(first + copy_new_n, construct_new_n, p_end);
@@ -821,8 +904,16 @@ namespace etl
     //*********************************************************************
     iterator erase(iterator i_element)
     {
-      std::copy(i_element + 1, end(), i_element);
-      destroy_back();
+      if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+      {
+        (*i_element).~T();
+        relocate_down(i_element, 1);
+      }
+      else
+      {
+        std::copy(i_element + 1, end(), i_element);
+        destroy_back();
+      }
 
       return i_element;
     }
@@ -841,6 +932,11 @@ namespace etl
       {
         clear();
       }
+      else if ETL_IF_CONSTEXPR(etl::is_trivially_relocatable<T>::value)
+      {
+        etl::destroy(first, last);
+        relocate_down(first, std::distance(first, last));
+      }
       else
       {
         std::copy(last, end(), first);
@@ -1018,6 +1114,30 @@ namespace etl
       ETL_DECREMENT_DEBUG_COUNT
     }
 
+    //*********************************************************************
+    /// Opens a gap of 'n' uninitialised elements at 'position' by moving the
+    /// elements after it up with memmove.
+    /// For trivially relocatable types.
+    //*********************************************************************
+    void relocate_up(iterator position, size_t n)
+    {
+      memmove(static_cast<void*>(position + n), static_cast<const void*>(position), size_t(p_end - position) * sizeof(T));
+      p_end += n;
+      ETL_ADD_DEBUG_COUNT(n)
+    }
+
+    //*********************************************************************
+    /// Closes the gap of 'n' destroyed elements at 'position' by moving the
+    /// elements after it down with memmove.
+    /// For trivially relocatable types.
+    //*********************************************************************
+    void relocate_down(iterator position, size_t n)
+    {
+      memmove(static_cast<void*>(position), static_cast<const void*>(position + n), size_t(p_end - (position + n)) * sizeof(T));
+      p_end -= n;
+      ETL_SUBTRACT_DEBUG_COUNT(n)
+    }
+
     // Disable copy construction.
     ivector(const ivector&);
 
@@ -0,0 +1,292 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef ETL_BENCHMARK_INCLUDED
+#define ETL_BENCHMARK_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace benchmark
+{
+  //***************************************************************************
+  /// Stops the compiler from optimising away a value.
+  //***************************************************************************
+  template <typename T>
+  inline void do_not_optimise(const T& value)
+  {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+  }
+
+  //***************************************************************************
+  /// One line of the results.
+  //***************************************************************************
+  struct result
+  {
+    std::string group;          ///< The container family, e.g. "map".
+    std::string implementation; ///< The type under test, e.g. "etl::map".
+    std::string operation;      ///< The operation timed, e.g. "insert".
+    std::string value_type;     ///< The key or element type.
+    size_t      size;           ///< The number of elements.
+    size_t      operations;     ///< The number of operations in one repetition.
+    double      ns_min;         ///< The fastest repetition, in nanoseconds per operation.
+    double      ns_median;      ///< The median repetition, in nanoseconds per operation.
+  };
+
+  //***************************************************************************
+  /// Describes a benchmark before it is run.
+  //***************************************************************************
+  struct info
+  {
+    const char* group;
+    const char* implementation;
+    const char* operation;
+    const char* value_type;
+    size_t      size;
+    size_t      operations;
+  };
+
+  //***************************************************************************
+  /// Times benchmarks and collects the results.
+  //***************************************************************************
+  class runner
+  {
+  public:
+
+    runner(size_t repetitions_, const std::string& filter_)
+      : repetitions(repetitions_),
+        filter(filter_)
+    {
+    }
+
+    //*************************************************************************
+    /// Runs 'body' once per repetition, calling 'setup' before each one.
+    /// Only 'body' is timed.
+    //*************************************************************************
+    void run(const info& details, const std::function<void()>& setup, const std::function<void()>& body)
+    {
+      if (!selected(details))
+      {
+        return;
+      }
+
+      std::vector<double> times;
+      times.reserve(repetitions);
+
+      for (size_t i = 0; i < repetitions; ++i)
+      {
+        setup();
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        body();
+        std::chrono::steady_clock::time_point stop = std::chrono::steady_clock::now();
+
+        double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+        times.push_back(ns / static_cast<double>(details.operations));
+      }
+
+      std::sort(times.begin(), times.end());
+
+      result r;
+      r.group          = details.group;
+      r.implementation = details.implementation;
+      r.operation      = details.operation;
+      r.value_type     = details.value_type;
+      r.size           = details.size;
+      r.operations     = details.operations;
+      r.ns_min         = times.front();
+      r.ns_median      = times[times.size() / 2];
+
+      results.push_back(r);
+    }
+
+    //*************************************************************************
+    /// Runs 'body' once per repetition, with no setup.
+    //*************************************************************************
+    void run(const info& details, const std::function<void()>& body)
+    {
+      run(details, [] {}, body);
+    }
+
+    //*************************************************************************
+    const std::vector<result>& get_results() const
+    {
+      return results;
+    }
+
+  private:
+
+    //*************************************************************************
+    /// A benchmark is selected if its name contains the filter text.
+    /// The name is "group/implementation/operation/value_type/size".
+    //*************************************************************************
+    bool selected(const info& details) const
+    {
+      if (filter.empty())
+      {
+        return true;
+      }
+
+      std::string name = std::string(details.group) + "/" + details.implementation + "/" + details.operation + "/" + details.value_type + "/" + std::to_string(details.size);
+
+      return name.find(filter) != std::string::npos;
+    }
+
+    size_t              repetitions;
+    std::string         filter;
+    std::vector<result> results;
+  };
+
+  //***************************************************************************
+  /// The registered benchmark suites.
+  //***************************************************************************
+  typedef void (*suite_function)(runner&);
+
+  struct suite
+  {
+    const char*    name;
+    suite_function function;
+  };
+
+  inline std::vector<suite>& suites()
+  {
+    static std::vector<suite> all;
+    return all;
+  }
+
+  struct registrar
+  {
+    registrar(const char* name, suite_function function)
+    {
+      suite s = { name, function };
+      suites().push_back(s);
+    }
+  };
+
+  //***************************************************************************
+  /// Generates the test values for each value type.
+  /// The same seed is used every run so that results are comparable.
+  //***************************************************************************
+  template <typename T>
+  struct values;
+
+  template <>
+  struct values<uint32_t>
+  {
+    static const char* name() { return "uint32_t"; }
+
+    static std::vector<uint32_t> generate(size_t n, uint32_t seed = 1)
+    {
+      std::mt19937 rng(seed);
+      std::vector<uint32_t> v(n);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        v[i] = static_cast<uint32_t>(rng());
+      }
+
+      return v;
+    }
+  };
+
+  template <>
+  struct values<uint64_t>
+  {
+    static const char* name() { return "uint64_t"; }
+
+    static std::vector<uint64_t> generate(size_t n, uint32_t seed = 1)
+    {
+      std::mt19937_64 rng(seed);
+      std::vector<uint64_t> v(n);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        v[i] = static_cast<uint64_t>(rng());
+      }
+
+      return v;
+    }
+  };
+
+  template <>
+  struct values<std::string>
+  {
+    static const char* name() { return "string"; }
+
+    static std::vector<std::string> generate(size_t n, uint32_t seed = 1)
+    {
+      std::mt19937 rng(seed);
+      std::vector<std::string> v(n);
+
+      for (size_t i = 0; i < n; ++i)
+      {
+        // Long enough to defeat the small string optimisation.
+        v[i] = "benchmark_key_" + std::to_string(rng()) + "_" + std::to_string(i);
+      }
+
+      return v;
+    }
+  };
+
+  //***************************************************************************
+  /// Unique values with no duplicates.
+  //***************************************************************************
+  template <typename T>
+  std::vector<T> unique_values(size_t n, uint32_t seed = 1)
+  {
+    std::vector<T> v = values<T>::generate(n * 2, seed);
+    std::sort(v.begin(), v.end());
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+    std::shuffle(v.begin(), v.end(), std::mt19937(seed));
+    v.resize(std::min(n, v.size()));
+
+    return v;
+  }
+}
+
+//*****************************************************************************
+/// Defines and registers a benchmark suite.
+//*****************************************************************************
+#define ETL_BENCHMARK_SUITE(name) \
+  static void name(benchmark::runner& runner); \
+  static benchmark::registrar name##_registrar(#name, name); \
+  static void name(benchmark::runner& runner)
+
+#endif
@@ -0,0 +1,246 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+#include "benchmark.h"
+
+#include "etl/map.h"
+#include "etl/btree_map.h"
+#include "etl/flat_map.h"
+#include "etl/sorted_vector_map.h"
+#include "etl/unordered_map.h"
+#include "etl/flat_hash_map.h"
+
+namespace
+{
+  typedef uint32_t mapped_t;
+
+  //***************************************************************************
+  /// The hash used by the ETL hash containers.
+  /// etl::hash has no specialisation for std::string, so use the STL's.
+  //***************************************************************************
+  template <typename TKey>
+  struct key_hash
+  {
+    typedef etl::hash<TKey> type;
+  };
+
+  template <>
+  struct key_hash<std::string>
+  {
+    typedef std::hash<std::string> type;
+  };
+
+  //***************************************************************************
+  template <typename TContainer, typename TKey>
+  void insert(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<TKey>& keys)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+
+    benchmark::info details = { group, implementation, "insert", benchmark::values<TKey>::name(), keys.size(), keys.size() };
+
+    runner.run(details,
+               [&] { container->clear(); },
+               [&]
+               {
+                 for (size_t i = 0; i < keys.size(); ++i)
+                 {
+                   container->insert(typename TContainer::value_type(keys[i], mapped_t(i)));
+                 }
+               });
+  }
+
+  //***************************************************************************
+  /// Builds the container from already sorted values in one call.
+  //***************************************************************************
+  template <typename TContainer, typename TKey>
+  void assign_sorted(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<TKey>& keys)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+
+    std::vector<std::pair<TKey, mapped_t> > values;
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+      values.push_back(std::pair<TKey, mapped_t>(keys[i], mapped_t(i)));
+    }
+
+    benchmark::info details = { group, implementation, "assign_sorted", benchmark::values<TKey>::name(), keys.size(), keys.size() };
+
+    runner.run(details,
+               [&] { container->clear(); },
+               [&] { container->assign_sorted(values.begin(), values.end()); });
+  }
+
+  //***************************************************************************
+  template <typename TContainer, typename TKey>
+  void fill(TContainer& container, const std::vector<TKey>& keys)
+  {
+    container.clear();
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+      container.insert(typename TContainer::value_type(keys[i], mapped_t(i)));
+    }
+  }
+
+  //***************************************************************************
+  template <typename TContainer, typename TKey>
+  void find(benchmark::runner& runner, const char* group, const char* implementation, const char* operation, const std::vector<TKey>& keys, const std::vector<TKey>& lookups)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+    fill(*container, keys);
+
+    benchmark::info details = { group, implementation, operation, benchmark::values<TKey>::name(), keys.size(), lookups.size() };
+
+    runner.run(details,
+               [&]
+               {
+                 size_t found = 0;
+
+                 for (size_t i = 0; i < lookups.size(); ++i)
+                 {
+                   found += (container->find(lookups[i]) != container->end()) ? 1 : 0;
+                 }
+
+                 benchmark::do_not_optimise(found);
+               });
+  }
+
+  //***************************************************************************
+  template <typename TContainer, typename TKey>
+  void erase(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<TKey>& keys)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+
+    benchmark::info details = { group, implementation, "erase", benchmark::values<TKey>::name(), keys.size(), keys.size() };
+
+    runner.run(details,
+               [&] { fill(*container, keys); },
+               [&]
+               {
+                 for (size_t i = 0; i < keys.size(); ++i)
+                 {
+                   container->erase(keys[i]);
+                 }
+               });
+  }
+
+  //***************************************************************************
+  template <typename TContainer, typename TKey>
+  void iterate(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<TKey>& keys)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+    fill(*container, keys);
+
+    benchmark::info details = { group, implementation, "iterate", benchmark::values<TKey>::name(), keys.size(), keys.size() };
+
+    runner.run(details,
+               [&]
+               {
+                 size_t sum = 0;
+
+                 for (typename TContainer::const_iterator itr = container->begin(); itr != container->end(); ++itr)
+                 {
+                   sum += itr->second;
+                 }
+
+                 benchmark::do_not_optimise(sum);
+               });
+  }
+
+  //***************************************************************************
+  /// Runs every operation for one container type.
+  //***************************************************************************
+  template <typename TContainer, typename TKey>
+  void run_container(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<TKey>& keys, const std::vector<TKey>& misses)
+  {
+    insert<TContainer>(runner, group, implementation, keys);
+    find<TContainer>(runner, group, implementation, "find_hit", keys, keys);
+    find<TContainer>(runner, group, implementation, "find_miss", keys, misses);
+    erase<TContainer>(runner, group, implementation, keys);
+    iterate<TContainer>(runner, group, implementation, keys);
+  }
+
+  //***************************************************************************
+  template <typename TKey, const size_t SIZE>
+  void run_size(benchmark::runner& runner)
+  {
+    typedef typename key_hash<TKey>::type hash_t;
+
+    // Keys that are present, and keys that are not.
+    std::vector<TKey> all    = benchmark::unique_values<TKey>(SIZE * 2);
+    std::vector<TKey> keys(all.begin(), all.begin() + (all.size() / 2));
+    std::vector<TKey> misses(all.begin() + (all.size() / 2), all.end());
+
+    run_container<std::map<TKey, mapped_t> >(runner, "map", "std::map", keys, misses);
+    run_container<etl::map<TKey, mapped_t, SIZE> >(runner, "map", "etl::map", keys, misses);
+    run_container<etl::btree_map<TKey, mapped_t, SIZE> >(runner, "map", "etl::btree_map", keys, misses);
+
+    run_container<std::map<TKey, mapped_t> >(runner, "flat_map", "std::map", keys, misses);
+    run_container<etl::flat_map<TKey, mapped_t, SIZE> >(runner, "flat_map", "etl::flat_map", keys, misses);
+    run_container<etl::sorted_vector_map<TKey, mapped_t, SIZE> >(runner, "flat_map", "etl::sorted_vector_map", keys, misses);
+
+    // Building from sorted keys, one at a time and in bulk.
+    std::vector<TKey> sorted(keys);
+    std::sort(sorted.begin(), sorted.end());
+
+    insert<std::map<TKey, mapped_t> >(runner, "sorted_map", "std::map", sorted);
+    insert<etl::map<TKey, mapped_t, SIZE> >(runner, "sorted_map", "etl::map", sorted);
+    assign_sorted<etl::map<TKey, mapped_t, SIZE> >(runner, "sorted_map", "etl::map", sorted);
+    insert<etl::flat_map<TKey, mapped_t, SIZE> >(runner, "sorted_map", "etl::flat_map", sorted);
+    assign_sorted<etl::flat_map<TKey, mapped_t, SIZE> >(runner, "sorted_map", "etl::flat_map", sorted);
+
+    run_container<std::unordered_map<TKey, mapped_t, hash_t> >(runner, "unordered_map", "std::unordered_map", keys, misses);
+    run_container<etl::unordered_map<TKey, mapped_t, SIZE, SIZE, hash_t> >(runner, "unordered_map", "etl::unordered_map", keys, misses);
+    run_container<etl::flat_hash_map<TKey, mapped_t, SIZE, hash_t> >(runner, "unordered_map", "etl::flat_hash_map", keys, misses);
+  }
+
+  //***************************************************************************
+  template <typename TKey>
+  void run_all_sizes(benchmark::runner& runner)
+  {
+    run_size<TKey, 16>(runner);
+    run_size<TKey, 256>(runner);
+    run_size<TKey, 4096>(runner);
+    run_size<TKey, 65536>(runner);
+  }
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(associative_containers)
+{
+  run_all_sizes<uint32_t>(runner);
+  run_all_sizes<uint64_t>(runner);
+  run_all_sizes<std::string>(runner);
+}
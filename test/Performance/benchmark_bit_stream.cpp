@@ -0,0 +1,180 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include <vector>
+
+#include "benchmark.h"
+
+#include "etl/bit_stream.h"
+#include "etl/bit_packer.h"
+#include "etl/varint.h"
+
+namespace
+{
+  const size_t N_FIELDS = 4096;
+
+  //***************************************************************************
+  template <typename T>
+  void run_width(benchmark::runner& runner, uint_least8_t width, const char* value_type)
+  {
+    std::vector<uint64_t> source = benchmark::values<uint64_t>::generate(N_FIELDS);
+    std::vector<T> values(source.begin(), source.end());
+    std::vector<T> results(N_FIELDS);
+    std::vector<unsigned char> storage(((N_FIELDS * width) + 7) / 8);
+
+    etl::bit_stream stream(storage.data(), storage.size());
+
+    benchmark::info put_details = { "bit_stream", "etl::bit_stream", "put", value_type, width, N_FIELDS };
+    runner.run(put_details, [&]
+    {
+      stream.restart();
+
+      for (size_t i = 0; i < N_FIELDS; ++i)
+      {
+        stream.put(values[i], width);
+      }
+
+      benchmark::do_not_optimise(storage[0]);
+    });
+
+    benchmark::info get_details = { "bit_stream", "etl::bit_stream", "get", value_type, width, N_FIELDS };
+    runner.run(get_details, [&]
+    {
+      stream.restart();
+
+      for (size_t i = 0; i < N_FIELDS; ++i)
+      {
+        stream.get(results[i], width);
+      }
+
+      benchmark::do_not_optimise(results[0]);
+    });
+
+    benchmark::info put_array_details = { "bit_stream", "etl::bit_stream", "put_array", value_type, width, N_FIELDS };
+    runner.run(put_array_details, [&]
+    {
+      stream.restart();
+      stream.put_array(values.data(), N_FIELDS, width);
+      benchmark::do_not_optimise(storage[0]);
+    });
+
+    benchmark::info get_array_details = { "bit_stream", "etl::bit_stream", "get_array", value_type, width, N_FIELDS };
+    runner.run(get_array_details, [&]
+    {
+      stream.restart();
+      stream.get_array(results.data(), N_FIELDS, width);
+      benchmark::do_not_optimise(results[0]);
+    });
+  }
+
+  //***************************************************************************
+  void run_bit_packer(benchmark::runner& runner, size_t bits)
+  {
+    std::vector<uint64_t> source = benchmark::values<uint64_t>::generate(N_FIELDS);
+    std::vector<uint32_t> values(N_FIELDS);
+    std::vector<uint32_t> results(N_FIELDS);
+    std::vector<uint32_t> packed((N_FIELDS / 32) * bits);
+
+    for (size_t i = 0; i < N_FIELDS; ++i)
+    {
+      values[i] = uint32_t(source[i] >> (64 - bits));
+    }
+
+    benchmark::info pack_details = { "bit_codec", "etl::bit_packer", "pack", "uint32_t", bits, N_FIELDS };
+    runner.run(pack_details, [&]
+    {
+      for (size_t block = 0; block < (N_FIELDS / 32); ++block)
+      {
+        etl::bit_pack(values.data() + (block * 32), packed.data() + (block * bits), bits);
+      }
+
+      benchmark::do_not_optimise(packed[0]);
+    });
+
+    benchmark::info unpack_details = { "bit_codec", "etl::bit_packer", "unpack", "uint32_t", bits, N_FIELDS };
+    runner.run(unpack_details, [&]
+    {
+      for (size_t block = 0; block < (N_FIELDS / 32); ++block)
+      {
+        etl::bit_unpack(packed.data() + (block * bits), results.data() + (block * 32), bits);
+      }
+
+      benchmark::do_not_optimise(results[0]);
+    });
+  }
+
+  //***************************************************************************
+  void run_varint(benchmark::runner& runner, size_t bits)
+  {
+    std::vector<uint64_t> source = benchmark::values<uint64_t>::generate(N_FIELDS);
+    std::vector<uint64_t> values(N_FIELDS);
+    std::vector<uint64_t> results(N_FIELDS);
+    std::vector<unsigned char> buffer(N_FIELDS * etl::varint::max_size<uint64_t>::value);
+
+    for (size_t i = 0; i < N_FIELDS; ++i)
+    {
+      values[i] = source[i] >> (64 - bits);
+    }
+
+    size_t used = 0;
+
+    benchmark::info encode_details = { "bit_codec", "etl::varint", "encode", "uint64_t", bits, N_FIELDS };
+    runner.run(encode_details, [&]
+    {
+      used = etl::varint::encode(values.begin(), values.end(), buffer.data(), buffer.size());
+      benchmark::do_not_optimise(used);
+    });
+
+    benchmark::info decode_details = { "bit_codec", "etl::varint", "decode", "uint64_t", bits, N_FIELDS };
+    runner.run(decode_details, [&]
+    {
+      benchmark::do_not_optimise(etl::varint::decode(buffer.data(), used, results.begin(), N_FIELDS));
+    });
+  }
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(bit_stream)
+{
+  run_width<uint16_t>(runner, 5,  "uint16_t");
+  run_width<uint16_t>(runner, 12, "uint16_t");
+  run_width<uint32_t>(runner, 24, "uint32_t");
+  run_width<uint64_t>(runner, 47, "uint64_t");
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(bit_codec)
+{
+  run_bit_packer(runner, 5);
+  run_bit_packer(runner, 12);
+  run_bit_packer(runner, 24);
+
+  run_varint(runner, 7);
+  run_varint(runner, 21);
+  run_varint(runner, 56);
+}
@@ -0,0 +1,102 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include <bitset>
+#include <memory>
+
+#include "benchmark.h"
+
+#include "etl/bitset.h"
+
+namespace
+{
+  //***************************************************************************
+  /// Sets one bit in every 'spacing'.
+  //***************************************************************************
+  template <typename TBitset>
+  void fill(TBitset& bits, size_t spacing)
+  {
+    bits.reset();
+
+    for (size_t i = 0; i < bits.size(); i += spacing)
+    {
+      bits.set(i);
+    }
+  }
+
+  //***************************************************************************
+  template <const size_t SIZE>
+  void count(benchmark::runner& runner, size_t spacing)
+  {
+    std::unique_ptr<std::bitset<SIZE> > std_bits(new std::bitset<SIZE>);
+    std::unique_ptr<etl::bitset<SIZE> > etl_bits(new etl::bitset<SIZE>);
+
+    fill(*std_bits, spacing);
+    fill(*etl_bits, spacing);
+
+    benchmark::info std_details = { "bitset", "std::bitset", "count", "bit", SIZE, 1 };
+    runner.run(std_details, [&] { benchmark::do_not_optimise(std_bits->count()); });
+
+    benchmark::info etl_details = { "bitset", "etl::bitset", "count", "bit", SIZE, 1 };
+    runner.run(etl_details, [&] { benchmark::do_not_optimise(etl_bits->count()); });
+  }
+
+  //***************************************************************************
+  /// Visits every set bit.
+  //***************************************************************************
+  template <const size_t SIZE>
+  void find_next(benchmark::runner& runner, const char* operation, size_t spacing)
+  {
+    std::unique_ptr<etl::bitset<SIZE> > bits(new etl::bitset<SIZE>);
+
+    fill(*bits, spacing);
+
+    benchmark::info details = { "bitset", "etl::bitset", operation, "bit", SIZE, bits->count() };
+
+    runner.run(details,
+               [&]
+               {
+                 size_t sum = 0;
+
+                 for (size_t i = bits->find_first(true); i != etl::ibitset::npos; i = bits->find_next(true, i + 1))
+                 {
+                   sum += i;
+                 }
+
+                 benchmark::do_not_optimise(sum);
+               });
+  }
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(bitset)
+{
+  count<65536>(runner, 3);
+  find_next<65536>(runner, "find_next_dense", 3);
+  find_next<65536>(runner, "find_next_sparse", 1000);
+}
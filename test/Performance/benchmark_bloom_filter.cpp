@@ -0,0 +1,125 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include "benchmark.h"
+
+#include "etl/bloom_filter.h"
+#include "etl/blocked_bloom_filter.h"
+#include "etl/murmur3.h"
+
+namespace
+{
+  //***************************************************************************
+  /// Independent hashes for the classic filter.
+  //***************************************************************************
+  template <const uint32_t SEED>
+  struct key_hash
+  {
+    typedef uint32_t argument_type;
+
+    size_t operator ()(argument_type key) const
+    {
+      return etl::murmur3<uint32_t>(reinterpret_cast<const uint8_t*>(&key), reinterpret_cast<const uint8_t*>(&key) + sizeof(key), SEED).value();
+    }
+  };
+
+  //***************************************************************************
+  /// 8 bits per key.
+  //***************************************************************************
+  template <const size_t WIDTH>
+  void run_width(benchmark::runner& runner)
+  {
+    typedef etl::bloom_filter<WIDTH, key_hash<1>, key_hash<2>, key_hash<3> > classic_t;
+    typedef etl::blocked_bloom_filter<WIDTH, key_hash<1>, 6>                  blocked_t;
+
+    const size_t N_KEYS    = WIDTH / 8;
+    const size_t N_LOOKUPS = 65536;
+
+    std::vector<uint32_t> all = benchmark::unique_values<uint32_t>(N_KEYS + N_LOOKUPS);
+    std::vector<uint32_t> keys(all.begin(), all.begin() + N_KEYS);
+
+    // Half hits, half misses.
+    std::vector<uint32_t> lookups(all.begin() + (N_KEYS / 2), all.begin() + (N_KEYS / 2) + N_LOOKUPS);
+
+    std::unique_ptr<classic_t> classic(new classic_t);
+    std::unique_ptr<blocked_t> blocked(new blocked_t);
+
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+      classic->add(keys[i]);
+      blocked->add(keys[i]);
+    }
+
+    benchmark::info classic_details = { "bloom_filter", "etl::bloom_filter", "exists", "uint32_t", WIDTH, N_LOOKUPS };
+    runner.run(classic_details, [&]
+    {
+      size_t found = 0;
+
+      for (size_t i = 0; i < lookups.size(); ++i)
+      {
+        found += classic->exists(lookups[i]) ? 1 : 0;
+      }
+
+      benchmark::do_not_optimise(found);
+    });
+
+    benchmark::info blocked_details = { "bloom_filter", "etl::blocked_bloom_filter", "exists", "uint32_t", WIDTH, N_LOOKUPS };
+    runner.run(blocked_details, [&]
+    {
+      size_t found = 0;
+
+      for (size_t i = 0; i < lookups.size(); ++i)
+      {
+        found += blocked->exists(lookups[i]) ? 1 : 0;
+      }
+
+      benchmark::do_not_optimise(found);
+    });
+
+    std::vector<char> results(N_LOOKUPS);
+
+    benchmark::info batch_details = { "bloom_filter", "etl::blocked_bloom_filter", "exists_batch", "uint32_t", WIDTH, N_LOOKUPS };
+    runner.run(batch_details, [&]
+    {
+      blocked->exists(lookups.begin(), lookups.end(), results.begin());
+      benchmark::do_not_optimise(results[0]);
+    });
+  }
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(bloom_filter)
+{
+  run_width<65536>(runner);
+  run_width<(1 << 20)>(runner);
+  run_width<(1 << 24)>(runner);
+  run_width<(1 << 27)>(runner);
+}
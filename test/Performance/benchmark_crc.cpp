@@ -0,0 +1,95 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "benchmark.h"
+
+#include "etl/crc32.h"
+#include "etl/crc32_c.h"
+
+namespace
+{
+  //***************************************************************************
+  /// Adds the bytes one at a time.
+  //***************************************************************************
+  template <typename TCrc>
+  void add_bytes(benchmark::runner& runner, const char* implementation, const std::vector<uint8_t>& data)
+  {
+    benchmark::info details = { "crc", implementation, "add_bytes", "uint8_t", data.size(), data.size() };
+
+    runner.run(details,
+               [&]
+               {
+                 TCrc crc(data.begin(), data.end());
+                 benchmark::do_not_optimise(crc.value());
+               });
+  }
+
+  //***************************************************************************
+  /// Adds the bytes as one block.
+  //***************************************************************************
+  template <typename TCrc>
+  void add_block(benchmark::runner& runner, const char* implementation, const std::vector<uint8_t>& data)
+  {
+    benchmark::info details = { "crc", implementation, "add_block", "uint8_t", data.size(), data.size() };
+
+    runner.run(details,
+               [&]
+               {
+                 TCrc crc;
+                 crc.add(data.data(), data.size());
+                 benchmark::do_not_optimise(crc.value());
+               });
+  }
+
+  //***************************************************************************
+  void run_size(benchmark::runner& runner, size_t size)
+  {
+    std::vector<uint32_t> words = benchmark::values<uint32_t>::generate(size);
+    std::vector<uint8_t>  data(size);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+      data[i] = uint8_t(words[i]);
+    }
+
+    add_bytes<etl::crc32>(runner, "etl::crc32", data);
+    add_block<etl::crc32>(runner, "etl::crc32", data);
+
+    add_bytes<etl::crc32_c>(runner, "etl::crc32_c", data);
+    add_block<etl::crc32_c>(runner, "etl::crc32_c", data);
+  }
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(crc)
+{
+  // A small message, an ethernet frame and a large buffer.
+  run_size(runner, 64);
+  run_size(runner, 1500);
+  run_size(runner, 65536);
+}
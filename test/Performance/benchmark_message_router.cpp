@@ -0,0 +1,128 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include <memory>
+
+#include "benchmark.h"
+
+#include "etl/message_router.h"
+
+namespace
+{
+  //***************************************************************************
+  /// Messages with sparse ids.
+  //***************************************************************************
+  template <const size_t N>
+  struct Message : public etl::message<etl::message_id_t(3 + (N * 15))>
+  {
+    uint32_t value;
+  };
+
+  //***************************************************************************
+  /// A router for 16 message types.
+  //***************************************************************************
+  class Router : public etl::message_router<Router,
+                                            Message<0>,  Message<1>,  Message<2>,  Message<3>,
+                                            Message<4>,  Message<5>,  Message<6>,  Message<7>,
+                                            Message<8>,  Message<9>,  Message<10>, Message<11>,
+                                            Message<12>, Message<13>, Message<14>, Message<15> >
+  {
+  public:
+
+    Router()
+      : message_router(1),
+        sum(0)
+    {
+    }
+
+    template <const size_t N>
+    void on_receive(etl::imessage_router&, const Message<N>& msg)
+    {
+      sum += msg.value + N;
+    }
+
+    void on_receive_unknown(etl::imessage_router&, const etl::imessage&)
+    {
+    }
+
+    size_t sum;
+  };
+
+  //***************************************************************************
+  /// Fills 'messages' with a random sequence of the 16 message types.
+  //***************************************************************************
+  template <const size_t N>
+  void add_messages(std::vector<std::unique_ptr<etl::imessage> >& messages, const std::vector<uint32_t>& selectors)
+  {
+    for (size_t i = 0; i < selectors.size(); ++i)
+    {
+      if ((selectors[i] % 16) == N)
+      {
+        Message<N>* p_message = new Message<N>();
+        p_message->value = selectors[i];
+        messages[i].reset(p_message);
+      }
+    }
+  }
+
+  //***************************************************************************
+  void receive(benchmark::runner& runner, const std::vector<uint32_t>& selectors)
+  {
+    std::vector<std::unique_ptr<etl::imessage> > messages(selectors.size());
+
+    add_messages<0>(messages, selectors);  add_messages<1>(messages, selectors);
+    add_messages<2>(messages, selectors);  add_messages<3>(messages, selectors);
+    add_messages<4>(messages, selectors);  add_messages<5>(messages, selectors);
+    add_messages<6>(messages, selectors);  add_messages<7>(messages, selectors);
+    add_messages<8>(messages, selectors);  add_messages<9>(messages, selectors);
+    add_messages<10>(messages, selectors); add_messages<11>(messages, selectors);
+    add_messages<12>(messages, selectors); add_messages<13>(messages, selectors);
+    add_messages<14>(messages, selectors); add_messages<15>(messages, selectors);
+
+    Router router;
+
+    benchmark::info details = { "message_router", "etl::message_router", "receive", "sparse_ids", 16, messages.size() };
+
+    runner.run(details,
+               [&]
+               {
+                 for (size_t i = 0; i < messages.size(); ++i)
+                 {
+                   router.receive(*messages[i]);
+                 }
+
+                 benchmark::do_not_optimise(router.sum);
+               });
+  }
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(message_router)
+{
+  receive(runner, benchmark::values<uint32_t>::generate(65536));
+}
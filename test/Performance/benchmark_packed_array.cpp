@@ -0,0 +1,138 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include "benchmark.h"
+
+#include "etl/packed_array.h"
+
+namespace
+{
+  //***************************************************************************
+  // A plain byte array with the same interface as packed_array.
+  //***************************************************************************
+  template <const size_t SIZE>
+  struct byte_array
+  {
+    typedef uint8_t value_type;
+
+    value_type get(size_t position) const
+    {
+      return buffer[position];
+    }
+
+    void set(size_t position, value_type value)
+    {
+      buffer[position] = value;
+    }
+
+    template <typename TOutputIterator>
+    TOutputIterator get_range(size_t position, TOutputIterator out, size_t count) const
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        *out++ = buffer[position + i];
+      }
+
+      return out;
+    }
+
+    value_type buffer[SIZE];
+  };
+
+  //***************************************************************************
+  template <typename TArray>
+  void run_array(benchmark::runner& runner, const char* implementation, size_t size, const std::vector<uint32_t>& indexes)
+  {
+    std::unique_ptr<TArray> array(new TArray());
+    std::vector<uint8_t> results(size);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+      array->set(i, uint8_t(i & 0x7F));
+    }
+
+    benchmark::info get_details = { "packed_array", implementation, "get_random", "7 bits", size, indexes.size() };
+    runner.run(get_details, [&]
+    {
+      size_t sum = 0;
+
+      for (size_t i = 0; i < indexes.size(); ++i)
+      {
+        sum += array->get(indexes[i]);
+      }
+
+      benchmark::do_not_optimise(sum);
+    });
+
+    benchmark::info set_details = { "packed_array", implementation, "set_random", "7 bits", size, indexes.size() };
+    runner.run(set_details, [&]
+    {
+      for (size_t i = 0; i < indexes.size(); ++i)
+      {
+        array->set(indexes[i], uint8_t(i & 0x7F));
+      }
+
+      benchmark::do_not_optimise(array->get(0));
+    });
+
+    benchmark::info range_details = { "packed_array", implementation, "get_range", "7 bits", size, size };
+    runner.run(range_details, [&]
+    {
+      array->get_range(0, results.data(), size);
+      benchmark::do_not_optimise(results[0]);
+    });
+  }
+
+  //***************************************************************************
+  template <const size_t SIZE>
+  void run_size(benchmark::runner& runner)
+  {
+    const size_t N_LOOKUPS = 65536;
+
+    std::vector<uint32_t> indexes = benchmark::values<uint32_t>::generate(N_LOOKUPS);
+
+    for (size_t i = 0; i < indexes.size(); ++i)
+    {
+      indexes[i] %= SIZE;
+    }
+
+    run_array<byte_array<SIZE> >(runner, "uint8_t[]", SIZE, indexes);
+    run_array<etl::packed_array<7, SIZE> >(runner, "etl::packed_array", SIZE, indexes);
+  }
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(packed_array)
+{
+  run_size<65536>(runner);
+  run_size<1048576>(runner);
+  run_size<16777216>(runner);
+}
@@ -0,0 +1,255 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "benchmark.h"
+
+#include "etl/pool.h"
+#include "etl/pool_concurrent.h"
+
+namespace
+{
+  /// A typical small message.
+  struct message
+  {
+    uint32_t id;
+    uint32_t data[7];
+  };
+
+  const size_t POOL_SIZE = 2048;
+  const size_t BATCH     = 16;
+
+  typedef etl::pool<message, POOL_SIZE>            pool_t;
+  typedef etl::pool_concurrent<message, POOL_SIZE> pool_concurrent_t;
+
+  //***************************************************************************
+  /// An etl::pool shared with a mutex, as it has to be without pool_concurrent.
+  //***************************************************************************
+  class locked_pool
+  {
+  public:
+
+    template <typename T>
+    T* allocate()
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      return pool.allocate<T>();
+    }
+
+    void release(const void* p)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pool.release(p);
+    }
+
+  private:
+
+    std::mutex mutex;
+    pool_t     pool;
+  };
+
+  //***************************************************************************
+  /// Each thread has its own magazine on the shared pool.
+  //***************************************************************************
+  template <const size_t MAGAZINE_SIZE>
+  class magazine_pool
+  {
+  public:
+
+    typedef etl::pool_magazine<MAGAZINE_SIZE> magazine_t;
+
+    class local
+    {
+    public:
+
+      explicit local(magazine_pool& owner)
+        : magazine(owner.pool)
+      {
+      }
+
+      template <typename T>
+      T* allocate()
+      {
+        return magazine.template allocate<T>();
+      }
+
+      void release(const void* p)
+      {
+        magazine.release(p);
+      }
+
+    private:
+
+      magazine_t magazine;
+    };
+
+  private:
+
+    pool_concurrent_t pool;
+  };
+
+  //***************************************************************************
+  /// The thread's view of the pool.
+  /// Pools are used directly; magazine pools through a per-thread magazine.
+  //***************************************************************************
+  template <typename TPool>
+  struct thread_view
+  {
+    typedef TPool& type;
+
+    static TPool& make(TPool& pool)
+    {
+      return pool;
+    }
+  };
+
+  template <const size_t MAGAZINE_SIZE>
+  struct thread_view<magazine_pool<MAGAZINE_SIZE> >
+  {
+    typedef typename magazine_pool<MAGAZINE_SIZE>::local type;
+
+    static magazine_pool<MAGAZINE_SIZE>& make(magazine_pool<MAGAZINE_SIZE>& pool)
+    {
+      return pool;
+    }
+  };
+
+  //***************************************************************************
+  /// Allocates a batch of messages, touches them, then releases them.
+  //***************************************************************************
+  template <typename TView>
+  uint32_t churn(TView& view, size_t rounds)
+  {
+    message* held[BATCH];
+    uint32_t sum = 0;
+
+    for (size_t r = 0; r < rounds; ++r)
+    {
+      for (size_t i = 0; i < BATCH; ++i)
+      {
+        held[i] = view.template allocate<message>();
+        held[i]->id = uint32_t(i);
+      }
+
+      for (size_t i = 0; i < BATCH; ++i)
+      {
+        sum += held[i]->id;
+        view.release(held[i]);
+      }
+    }
+
+    return sum;
+  }
+
+  //***************************************************************************
+  /// 'size' is the number of threads.
+  //***************************************************************************
+  template <typename TPool>
+  void contention(benchmark::runner& runner, const char* implementation, size_t n_threads)
+  {
+    const size_t ROUNDS_PER_THREAD = 20000;
+
+    std::unique_ptr<TPool> pool(new TPool);
+
+    benchmark::info details = { "pool_contention", implementation, "allocate_release", "message", n_threads, n_threads * ROUNDS_PER_THREAD * BATCH * 2 };
+
+    runner.run(details,
+               [&]
+               {
+                 std::atomic<bool>        start(false);
+                 std::vector<std::thread> threads;
+
+                 for (size_t t = 0; t < n_threads; ++t)
+                 {
+                   threads.push_back(std::thread([&]
+                   {
+                     typename thread_view<TPool>::type view(thread_view<TPool>::make(*pool));
+
+                     while (!start.load())
+                     {
+                       std::this_thread::yield();
+                     }
+
+                     benchmark::do_not_optimise(churn(view, ROUNDS_PER_THREAD));
+                   }));
+                 }
+
+                 start.store(true);
+
+                 for (size_t t = 0; t < threads.size(); ++t)
+                 {
+                   threads[t].join();
+                 }
+               });
+  }
+
+  //***************************************************************************
+  /// The cost with no contention at all.
+  //***************************************************************************
+  template <typename TPool>
+  void single_thread(benchmark::runner& runner, const char* implementation)
+  {
+    const size_t ROUNDS = 20000;
+
+    std::unique_ptr<TPool> pool(new TPool);
+    typename thread_view<TPool>::type view(thread_view<TPool>::make(*pool));
+
+    benchmark::info details = { "pool", implementation, "allocate_release", "message", BATCH, ROUNDS * BATCH * 2 };
+
+    runner.run(details,
+               [&]
+               {
+                 benchmark::do_not_optimise(churn(view, ROUNDS));
+               });
+  }
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(pool)
+{
+  single_thread<pool_t>(runner, "etl::pool");
+  single_thread<locked_pool>(runner, "etl::pool+mutex");
+  single_thread<pool_concurrent_t>(runner, "etl::pool_concurrent");
+  single_thread<magazine_pool<32> >(runner, "etl::pool_magazine<32>");
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(pool_contention)
+{
+  for (size_t n_threads = 1; n_threads <= 32; n_threads *= 2)
+  {
+    contention<locked_pool>(runner, "etl::pool+mutex", n_threads);
+    contention<pool_concurrent_t>(runner, "etl::pool_concurrent", n_threads);
+    contention<magazine_pool<32> >(runner, "etl::pool_magazine<32>", n_threads);
+  }
+}
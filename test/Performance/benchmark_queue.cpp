@@ -0,0 +1,413 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include <atomic>
+#include <memory>
+#include <queue>
+#include <thread>
+
+#include "benchmark.h"
+
+#include "etl/queue.h"
+#include "etl/queue_spsc_atomic.h"
+#include "etl/queue_spsc_isr.h"
+#include "etl/queue_mpmc_mutex.h"
+#include "etl/queue_mpmc_atomic.h"
+
+namespace
+{
+  //***************************************************************************
+  /// Interrupt control for etl::queue_spsc_isr.
+  /// There are no interrupts here, so this just measures the queue overhead.
+  //***************************************************************************
+  struct access
+  {
+    static void lock()   {}
+    static void unlock() {}
+  };
+
+  //***************************************************************************
+  /// Adapts the different push/pop styles.
+  /// The ETL concurrent queues return the popped value through a reference.
+  //***************************************************************************
+  template <typename TQueue>
+  struct queue_access
+  {
+    template <typename T>
+    static void push(TQueue& queue, const T& value)
+    {
+      queue.push(value);
+    }
+
+    template <typename T>
+    static void pop(TQueue& queue, T& value)
+    {
+      queue.pop(value);
+    }
+  };
+
+  template <typename T>
+  struct queue_access<std::queue<T> >
+  {
+    static void push(std::queue<T>& queue, const T& value)
+    {
+      queue.push(value);
+    }
+
+    static void pop(std::queue<T>& queue, T& value)
+    {
+      value = queue.front();
+      queue.pop();
+    }
+  };
+
+  template <typename T, const size_t SIZE>
+  struct queue_access<etl::queue<T, SIZE> >
+  {
+    static void push(etl::queue<T, SIZE>& queue, const T& value)
+    {
+      queue.push(value);
+    }
+
+    static void pop(etl::queue<T, SIZE>& queue, T& value)
+    {
+      value = queue.front();
+      queue.pop();
+    }
+  };
+
+  //***************************************************************************
+  /// Fills the queue, then empties it.
+  //***************************************************************************
+  template <typename TQueue, typename T>
+  void fill_drain(benchmark::runner& runner, const char* implementation, const std::vector<T>& data)
+  {
+    std::unique_ptr<TQueue> queue(new TQueue);
+
+    benchmark::info details = { "queue", implementation, "fill_drain", benchmark::values<T>::name(), data.size(), data.size() * 2 };
+
+    runner.run(details,
+               [&]
+               {
+                 T value = T();
+
+                 for (size_t i = 0; i < data.size(); ++i)
+                 {
+                   queue_access<TQueue>::push(*queue, data[i]);
+                 }
+
+                 for (size_t i = 0; i < data.size(); ++i)
+                 {
+                   queue_access<TQueue>::pop(*queue, value);
+                 }
+
+                 benchmark::do_not_optimise(value);
+               });
+  }
+
+  //***************************************************************************
+  /// Pushes and pops alternately with the queue half full.
+  //***************************************************************************
+  template <typename TQueue, typename T>
+  void push_pop(benchmark::runner& runner, const char* implementation, const std::vector<T>& data)
+  {
+    std::unique_ptr<TQueue> queue(new TQueue);
+
+    for (size_t i = 0; i < (data.size() / 2); ++i)
+    {
+      queue_access<TQueue>::push(*queue, data[i]);
+    }
+
+    benchmark::info details = { "queue", implementation, "push_pop", benchmark::values<T>::name(), data.size(), data.size() * 2 };
+
+    runner.run(details,
+               [&]
+               {
+                 T value = T();
+
+                 for (size_t i = 0; i < data.size(); ++i)
+                 {
+                   queue_access<TQueue>::push(*queue, data[i]);
+                   queue_access<TQueue>::pop(*queue, value);
+                 }
+
+                 benchmark::do_not_optimise(value);
+               });
+  }
+
+  //***************************************************************************
+  template <typename T, const size_t SIZE>
+  void run_size(benchmark::runner& runner)
+  {
+    std::vector<T> data = benchmark::values<T>::generate(SIZE);
+
+    fill_drain<std::queue<T> >(runner, "std::queue", data);
+    fill_drain<etl::queue<T, SIZE> >(runner, "etl::queue", data);
+    fill_drain<etl::queue_spsc_atomic<T, SIZE> >(runner, "etl::queue_spsc_atomic", data);
+    fill_drain<etl::queue_spsc_isr<T, SIZE, access> >(runner, "etl::queue_spsc_isr", data);
+    fill_drain<etl::queue_mpmc_mutex<T, SIZE> >(runner, "etl::queue_mpmc_mutex", data);
+    fill_drain<etl::queue_mpmc_atomic<T, SIZE> >(runner, "etl::queue_mpmc_atomic", data);
+
+    push_pop<std::queue<T> >(runner, "std::queue", data);
+    push_pop<etl::queue<T, SIZE> >(runner, "etl::queue", data);
+    push_pop<etl::queue_spsc_atomic<T, SIZE> >(runner, "etl::queue_spsc_atomic", data);
+    push_pop<etl::queue_spsc_atomic<T, SIZE, etl::memory_model::MEMORY_MODEL_LARGE, etl::queue_spsc_atomic_layout::SEPARATED> >(runner, "etl::queue_spsc_atomic(separated)", data);
+    push_pop<etl::queue_spsc_isr<T, SIZE, access> >(runner, "etl::queue_spsc_isr", data);
+    push_pop<etl::queue_mpmc_mutex<T, SIZE> >(runner, "etl::queue_mpmc_mutex", data);
+    push_pop<etl::queue_mpmc_atomic<T, SIZE> >(runner, "etl::queue_mpmc_atomic", data);
+  }
+
+  //***************************************************************************
+  template <typename T>
+  void run_all_sizes(benchmark::runner& runner)
+  {
+    run_size<T, 16>(runner);
+    run_size<T, 256>(runner);
+    run_size<T, 4096>(runner);
+    run_size<T, 65536>(runner);
+  }
+}
+
+namespace
+{
+  //***************************************************************************
+  /// Every thread pushes then pops, so the queue is shared by all of them.
+  /// 'size' is the number of threads.
+  //***************************************************************************
+  template <typename TQueue>
+  void contention(benchmark::runner& runner, const char* implementation, size_t n_threads)
+  {
+    const size_t OPERATIONS_PER_THREAD = 100000;
+
+    std::unique_ptr<TQueue> queue(new TQueue);
+
+    benchmark::info details = { "queue_contention", implementation, "push_pop", "uint32_t", n_threads, n_threads * OPERATIONS_PER_THREAD * 2 };
+
+    runner.run(details,
+               [&]
+               {
+                 std::atomic<bool>        start(false);
+                 std::vector<std::thread> threads;
+
+                 for (size_t t = 0; t < n_threads; ++t)
+                 {
+                   threads.push_back(std::thread([&]
+                   {
+                     while (!start.load())
+                     {
+                       std::this_thread::yield();
+                     }
+
+                     uint32_t value = 0;
+
+                     for (size_t i = 0; i < OPERATIONS_PER_THREAD; ++i)
+                     {
+                       while (!queue->push(uint32_t(i)))
+                       {
+                         std::this_thread::yield();
+                       }
+
+                       while (!queue->pop(value))
+                       {
+                         std::this_thread::yield();
+                       }
+                     }
+
+                     benchmark::do_not_optimise(value);
+                   }));
+                 }
+
+                 start.store(true);
+
+                 for (size_t t = 0; t < threads.size(); ++t)
+                 {
+                   threads[t].join();
+                 }
+               });
+  }
+}
+
+namespace
+{
+  //***************************************************************************
+  /// One thread pushes while another pops.
+  //***************************************************************************
+  template <typename TQueue>
+  void producer_consumer(benchmark::runner& runner, const char* implementation, size_t size)
+  {
+    const size_t OPERATIONS = 1000000;
+
+    std::unique_ptr<TQueue> queue(new TQueue);
+
+    benchmark::info details = { "queue_spsc_threads", implementation, "push_pop", "uint32_t", size, OPERATIONS * 2 };
+
+    runner.run(details,
+               [&]
+               {
+                 std::thread producer([&]
+                 {
+                   for (size_t i = 0; i < OPERATIONS; ++i)
+                   {
+                     while (!queue->push(uint32_t(i)))
+                     {
+                       std::this_thread::yield();
+                     }
+                   }
+                 });
+
+                 uint32_t value = 0;
+
+                 for (size_t i = 0; i < OPERATIONS; ++i)
+                 {
+                   while (!queue->pop(value))
+                   {
+                     std::this_thread::yield();
+                   }
+                 }
+
+                 producer.join();
+
+                 benchmark::do_not_optimise(value);
+               });
+  }
+
+  //***************************************************************************
+  /// One thread pushes batches through the write span while another pops
+  /// them through the read span.
+  //***************************************************************************
+  template <typename TQueue>
+  void producer_consumer_spans(benchmark::runner& runner, const char* implementation, size_t size)
+  {
+    typedef typename TQueue::span_pair_type span_pair_type;
+
+    const size_t OPERATIONS = 1000000;
+
+    std::unique_ptr<TQueue> queue(new TQueue);
+
+    benchmark::info details = { "queue_spsc_threads", implementation, "push_pop_span", "uint32_t", size, OPERATIONS * 2 };
+
+    runner.run(details,
+               [&]
+               {
+                 std::thread producer([&]
+                 {
+                   size_t written = 0;
+
+                   while (written < OPERATIONS)
+                   {
+                     span_pair_type free_space = queue->write_span();
+                     size_t         n          = std::min(free_space.size(), OPERATIONS - written);
+
+                     for (size_t i = 0; i < n; ++i)
+                     {
+                       (i < free_space.first.size()) ? (free_space.first[i] = uint32_t(written + i))
+                                                     : (free_space.second[i - free_space.first.size()] = uint32_t(written + i));
+                     }
+
+                     queue->commit(n);
+                     written += n;
+
+                     if (n == 0)
+                     {
+                       std::this_thread::yield();
+                     }
+                   }
+                 });
+
+                 uint32_t sum  = 0;
+                 size_t   read = 0;
+
+                 while (read < OPERATIONS)
+                 {
+                   span_pair_type items = queue->read_span();
+
+                   for (size_t i = 0; i < items.first.size(); ++i)
+                   {
+                     sum += items.first[i];
+                   }
+
+                   for (size_t i = 0; i < items.second.size(); ++i)
+                   {
+                     sum += items.second[i];
+                   }
+
+                   queue->release(items.size());
+                   read += items.size();
+
+                   if (items.empty())
+                   {
+                     std::this_thread::yield();
+                   }
+                 }
+
+                 producer.join();
+
+                 benchmark::do_not_optimise(sum);
+               });
+  }
+
+  //***************************************************************************
+  template <const size_t SIZE>
+  void run_spsc_layouts(benchmark::runner& runner)
+  {
+    typedef etl::queue_spsc_atomic<uint32_t, SIZE> compact_t;
+    typedef etl::queue_spsc_atomic<uint32_t, SIZE, etl::memory_model::MEMORY_MODEL_LARGE, etl::queue_spsc_atomic_layout::SEPARATED> separated_t;
+
+    producer_consumer<compact_t>(runner, "etl::queue_spsc_atomic", SIZE);
+    producer_consumer<separated_t>(runner, "etl::queue_spsc_atomic(separated)", SIZE);
+
+    producer_consumer_spans<compact_t>(runner, "etl::queue_spsc_atomic", SIZE);
+    producer_consumer_spans<separated_t>(runner, "etl::queue_spsc_atomic(separated)", SIZE);
+  }
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(queue_spsc_threads)
+{
+  run_spsc_layouts<16>(runner);
+  run_spsc_layouts<256>(runner);
+  run_spsc_layouts<4096>(runner);
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(queue_contention)
+{
+  for (size_t n_threads = 1; n_threads <= 32; n_threads *= 2)
+  {
+    contention<etl::queue_mpmc_mutex<uint32_t, 1024> >(runner, "etl::queue_mpmc_mutex", n_threads);
+    contention<etl::queue_mpmc_atomic<uint32_t, 1024> >(runner, "etl::queue_mpmc_atomic", n_threads);
+  }
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(queues)
+{
+  run_all_sizes<uint32_t>(runner);
+  run_all_sizes<uint64_t>(runner);
+  run_all_sizes<std::string>(runner);
+}
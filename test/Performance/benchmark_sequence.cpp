@@ -0,0 +1,366 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include <deque>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "benchmark.h"
+
+#include "etl/vector.h"
+#include "etl/deque.h"
+#include "etl/list.h"
+#include "etl/array.h"
+#include "etl/algorithm.h"
+
+namespace
+{
+  //***************************************************************************
+  /// Something to accumulate so that iteration is not optimised away.
+  //***************************************************************************
+  inline size_t weight(uint32_t value)           { return value; }
+  inline size_t weight(uint64_t value)           { return static_cast<size_t>(value); }
+  inline size_t weight(const std::string& value) { return value.size(); }
+
+  //***************************************************************************
+  template <typename TContainer, typename T>
+  void push_back(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<T>& data)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+
+    benchmark::info details = { group, implementation, "push_back", benchmark::values<T>::name(), data.size(), data.size() };
+
+    runner.run(details,
+               [&] { container->clear(); },
+               [&]
+               {
+                 for (size_t i = 0; i < data.size(); ++i)
+                 {
+                   container->push_back(data[i]);
+                 }
+               });
+  }
+
+  //***************************************************************************
+  template <typename TContainer, typename T>
+  void push_front(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<T>& data)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+
+    benchmark::info details = { group, implementation, "push_front", benchmark::values<T>::name(), data.size(), data.size() };
+
+    runner.run(details,
+               [&] { container->clear(); },
+               [&]
+               {
+                 for (size_t i = 0; i < data.size(); ++i)
+                 {
+                   container->push_front(data[i]);
+                 }
+               });
+  }
+
+  //***************************************************************************
+  template <typename TContainer, typename T>
+  void pop_front(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<T>& data)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+
+    benchmark::info details = { group, implementation, "pop_front", benchmark::values<T>::name(), data.size(), data.size() };
+
+    runner.run(details,
+               [&] { container->assign(data.begin(), data.end()); },
+               [&]
+               {
+                 while (!container->empty())
+                 {
+                   container->pop_front();
+                 }
+               });
+  }
+
+  //***************************************************************************
+  template <typename TContainer, typename T>
+  void iterate(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<T>& data)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+    container->assign(data.begin(), data.end());
+
+    benchmark::info details = { group, implementation, "iterate", benchmark::values<T>::name(), data.size(), data.size() };
+
+    runner.run(details,
+               [&]
+               {
+                 size_t sum = 0;
+
+                 for (typename TContainer::const_iterator itr = container->begin(); itr != container->end(); ++itr)
+                 {
+                   sum += weight(*itr);
+                 }
+
+                 benchmark::do_not_optimise(sum);
+               });
+  }
+
+  //***************************************************************************
+  /// Iterates an etl::deque a contiguous run at a time.
+  //***************************************************************************
+  template <typename TContainer, typename T>
+  void iterate_segments(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<T>& data)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+    container->assign(data.begin(), data.end());
+
+    // Start half way through the buffer, so that the elements wrap.
+    for (size_t i = 0; i < (data.size() / 2); ++i)
+    {
+      container->pop_front();
+      container->push_back(data[i]);
+    }
+
+    benchmark::info details = { group, implementation, "iterate_segments", benchmark::values<T>::name(), data.size(), data.size() };
+
+    runner.run(details,
+               [&]
+               {
+                 size_t sum = 0;
+                 typename TContainer::const_segments segments = static_cast<const TContainer&>(*container).data_segments();
+
+                 for (typename TContainer::const_segment::iterator itr = segments.first.begin(); itr != segments.first.end(); ++itr)
+                 {
+                   sum += weight(*itr);
+                 }
+
+                 for (typename TContainer::const_segment::iterator itr = segments.second.begin(); itr != segments.second.end(); ++itr)
+                 {
+                   sum += weight(*itr);
+                 }
+
+                 benchmark::do_not_optimise(sum);
+               });
+  }
+
+  //***************************************************************************
+  template <typename TContainer, typename T>
+  void copy(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<T>& data)
+  {
+    std::unique_ptr<TContainer> source(new TContainer);
+    std::unique_ptr<TContainer> destination(new TContainer);
+    source->assign(data.begin(), data.end());
+
+    benchmark::info details = { group, implementation, "copy", benchmark::values<T>::name(), data.size(), data.size() };
+
+    runner.run(details,
+               [&]
+               {
+                 *destination = *source;
+                 benchmark::do_not_optimise(destination->front());
+               });
+  }
+
+  //***************************************************************************
+  template <typename TContainer, typename T>
+  void insert_middle(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<T>& data)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+
+    benchmark::info details = { group, implementation, "insert_middle", benchmark::values<T>::name(), data.size(), data.size() };
+
+    runner.run(details,
+               [&] { container->clear(); },
+               [&]
+               {
+                 for (size_t i = 0; i < data.size(); ++i)
+                 {
+                   container->insert(container->begin() + (container->size() / 2), data[i]);
+                 }
+               });
+  }
+
+  //***************************************************************************
+  template <typename TContainer, typename T>
+  void erase_front(benchmark::runner& runner, const char* group, const char* implementation, const std::vector<T>& data)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+
+    benchmark::info details = { group, implementation, "erase_front", benchmark::values<T>::name(), data.size(), data.size() };
+
+    runner.run(details,
+               [&] { container->assign(data.begin(), data.end()); },
+               [&]
+               {
+                 while (!container->empty())
+                 {
+                   container->erase(container->begin());
+                 }
+               });
+  }
+
+  //***************************************************************************
+  template <typename TContainer, typename T>
+  void sort(benchmark::runner& runner, const char* group, const char* implementation, const char* operation, const std::vector<T>& data)
+  {
+    std::unique_ptr<TContainer> container(new TContainer);
+
+    benchmark::info details = { group, implementation, operation, benchmark::values<T>::name(), data.size(), data.size() };
+
+    runner.run(details,
+               [&] { container->assign(data.begin(), data.end()); },
+               [&] { container->sort(); });
+  }
+
+  //***************************************************************************
+  /// Compares the sort algorithms on a copy of the data.
+  //***************************************************************************
+  template <typename T, const size_t SIZE>
+  void sort_algorithms(benchmark::runner& runner, const std::vector<T>& data)
+  {
+    std::vector<T> work;
+    std::unique_ptr<etl::array<T, (SIZE / 2) + 1> > buffer(new etl::array<T, (SIZE / 2) + 1>);
+
+    benchmark::info std_sort = { "sort", "std::sort", "sort", benchmark::values<T>::name(), data.size(), data.size() };
+    runner.run(std_sort, [&] { work = data; }, [&] { std::sort(work.begin(), work.end()); });
+
+    benchmark::info etl_sort = { "sort", "etl::sort", "sort", benchmark::values<T>::name(), data.size(), data.size() };
+    runner.run(etl_sort, [&] { work = data; }, [&] { etl::sort(work.begin(), work.end()); });
+
+    benchmark::info std_stable_sort = { "sort", "std::stable_sort", "stable_sort", benchmark::values<T>::name(), data.size(), data.size() };
+    runner.run(std_stable_sort, [&] { work = data; }, [&] { std::stable_sort(work.begin(), work.end()); });
+
+    benchmark::info etl_stable_sort = { "sort", "etl::stable_sort", "stable_sort", benchmark::values<T>::name(), data.size(), data.size() };
+    runner.run(etl_stable_sort, [&] { work = data; }, [&] { etl::stable_sort(work.begin(), work.end(), *buffer); });
+  }
+
+  //***************************************************************************
+  template <typename T, const size_t SIZE>
+  void run_vector(benchmark::runner& runner)
+  {
+    std::vector<T> data = benchmark::values<T>::generate(SIZE);
+
+    push_back<std::vector<T> >(runner, "vector", "std::vector", data);
+    push_back<etl::vector<T, SIZE> >(runner, "vector", "etl::vector", data);
+
+    iterate<std::vector<T> >(runner, "vector", "std::vector", data);
+    iterate<etl::vector<T, SIZE> >(runner, "vector", "etl::vector", data);
+
+    // Quadratic, so only for the smaller sizes.
+    if (SIZE <= 4096)
+    {
+      insert_middle<std::vector<T> >(runner, "vector", "std::vector", data);
+      insert_middle<etl::vector<T, SIZE> >(runner, "vector", "etl::vector", data);
+
+      erase_front<std::vector<T> >(runner, "vector", "std::vector", data);
+      erase_front<etl::vector<T, SIZE> >(runner, "vector", "etl::vector", data);
+    }
+
+    sort_algorithms<T, SIZE>(runner, data);
+  }
+
+  //***************************************************************************
+  template <typename T, const size_t SIZE>
+  void run_deque(benchmark::runner& runner)
+  {
+    std::vector<T> data = benchmark::values<T>::generate(SIZE);
+
+    push_back<std::deque<T> >(runner, "deque", "std::deque", data);
+    push_back<etl::deque<T, SIZE> >(runner, "deque", "etl::deque", data);
+
+    push_front<std::deque<T> >(runner, "deque", "std::deque", data);
+    push_front<etl::deque<T, SIZE> >(runner, "deque", "etl::deque", data);
+
+    pop_front<std::deque<T> >(runner, "deque", "std::deque", data);
+    pop_front<etl::deque<T, SIZE> >(runner, "deque", "etl::deque", data);
+
+    iterate<std::deque<T> >(runner, "deque", "std::deque", data);
+    iterate<etl::deque<T, SIZE> >(runner, "deque", "etl::deque", data);
+    iterate_segments<etl::deque<T, SIZE> >(runner, "deque", "etl::deque", data);
+
+    copy<std::deque<T> >(runner, "deque", "std::deque", data);
+    copy<etl::deque<T, SIZE> >(runner, "deque", "etl::deque", data);
+  }
+
+  //***************************************************************************
+  template <typename T, const size_t SIZE>
+  void run_list(benchmark::runner& runner)
+  {
+    std::vector<T> data = benchmark::values<T>::generate(SIZE);
+
+    push_back<std::list<T> >(runner, "list", "std::list", data);
+    push_back<etl::list<T, SIZE> >(runner, "list", "etl::list", data);
+
+    push_front<std::list<T> >(runner, "list", "std::list", data);
+    push_front<etl::list<T, SIZE> >(runner, "list", "etl::list", data);
+
+    iterate<std::list<T> >(runner, "list", "std::list", data);
+    iterate<etl::list<T, SIZE> >(runner, "list", "etl::list", data);
+
+    sort<std::list<T> >(runner, "list", "std::list", "sort", data);
+    sort<etl::list<T, SIZE> >(runner, "list", "etl::list", "sort", data);
+
+    // Ordered, except for one value in every hundred.
+    std::vector<T> nearly_sorted(data);
+    std::sort(nearly_sorted.begin(), nearly_sorted.end());
+
+    for (size_t i = 0; (i + 50) < nearly_sorted.size(); i += 100)
+    {
+      std::swap(nearly_sorted[i], nearly_sorted[i + 50]);
+    }
+
+    sort<std::list<T> >(runner, "list", "std::list", "sort_nearly_sorted", nearly_sorted);
+    sort<etl::list<T, SIZE> >(runner, "list", "etl::list", "sort_nearly_sorted", nearly_sorted);
+  }
+
+  //***************************************************************************
+  template <typename T>
+  void run_all_sizes(benchmark::runner& runner)
+  {
+    run_vector<T, 16>(runner);
+    run_vector<T, 256>(runner);
+    run_vector<T, 4096>(runner);
+    run_vector<T, 65536>(runner);
+
+    run_deque<T, 16>(runner);
+    run_deque<T, 256>(runner);
+    run_deque<T, 4096>(runner);
+    run_deque<T, 65536>(runner);
+
+    run_list<T, 16>(runner);
+    run_list<T, 256>(runner);
+    run_list<T, 4096>(runner);
+    run_list<T, 65536>(runner);
+  }
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(sequence_containers)
+{
+  run_all_sizes<uint32_t>(runner);
+  run_all_sizes<uint64_t>(runner);
+  run_all_sizes<std::string>(runner);
+}
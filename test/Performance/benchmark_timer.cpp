@@ -0,0 +1,148 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include <memory>
+
+#include "benchmark.h"
+
+#define ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK
+
+#include "etl/callback_timer.h"
+#include "etl/callback_timer_wheel.h"
+
+namespace
+{
+  size_t callbacks = 0;
+
+  void on_timer()
+  {
+    ++callbacks;
+  }
+
+  //***************************************************************************
+  /// Registers SIZE repeating timers with random periods.
+  //***************************************************************************
+  template <typename TController>
+  void register_timers(TController& controller, const std::vector<uint32_t>& periods)
+  {
+    controller.clear();
+
+    for (size_t i = 0; i < periods.size(); ++i)
+    {
+      controller.register_timer(on_timer, periods[i], etl::timer::mode::REPEATING);
+    }
+
+    controller.enable(true);
+  }
+
+  //***************************************************************************
+  /// Starts every timer, then stops every timer.
+  //***************************************************************************
+  template <typename TController, typename TId>
+  void start_stop(benchmark::runner& runner, const char* implementation, const std::vector<uint32_t>& periods)
+  {
+    std::unique_ptr<TController> controller(new TController);
+    register_timers(*controller, periods);
+
+    benchmark::info details = { "timer", implementation, "start_stop", "callback", periods.size(), periods.size() * 2 };
+
+    runner.run(details,
+               [&]
+               {
+                 for (size_t i = 0; i < periods.size(); ++i)
+                 {
+                   controller->start(TId(i));
+                 }
+
+                 for (size_t i = 0; i < periods.size(); ++i)
+                 {
+                   controller->stop(TId(i));
+                 }
+               });
+  }
+
+  //***************************************************************************
+  /// Ticks one unit at a time with every timer running.
+  //***************************************************************************
+  template <typename TController, typename TId>
+  void tick(benchmark::runner& runner, const char* implementation, const std::vector<uint32_t>& periods)
+  {
+    const size_t TICKS = 1000;
+
+    std::unique_ptr<TController> controller(new TController);
+    register_timers(*controller, periods);
+
+    for (size_t i = 0; i < periods.size(); ++i)
+    {
+      controller->start(TId(i));
+    }
+
+    benchmark::info details = { "timer", implementation, "tick", "callback", periods.size(), TICKS };
+
+    runner.run(details,
+               [&]
+               {
+                 for (size_t i = 0; i < TICKS; ++i)
+                 {
+                   controller->tick(1);
+                 }
+
+                 benchmark::do_not_optimise(callbacks);
+               });
+  }
+
+  //***************************************************************************
+  template <const size_t SIZE>
+  void run_size(benchmark::runner& runner)
+  {
+    std::vector<uint32_t> periods = benchmark::values<uint32_t>::generate(SIZE);
+
+    for (size_t i = 0; i < periods.size(); ++i)
+    {
+      periods[i] = 1U + (periods[i] % 10000U);
+    }
+
+    // etl::callback_timer ids are 8 bit.
+    if (SIZE < 255)
+    {
+      start_stop<etl::callback_timer<SIZE>, etl::timer::id::type>(runner, "etl::callback_timer", periods);
+      tick<etl::callback_timer<SIZE>, etl::timer::id::type>(runner, "etl::callback_timer", periods);
+    }
+
+    start_stop<etl::callback_timer_wheel<SIZE, uint16_t>, uint16_t>(runner, "etl::callback_timer_wheel", periods);
+    tick<etl::callback_timer_wheel<SIZE, uint16_t>, uint16_t>(runner, "etl::callback_timer_wheel", periods);
+  }
+}
+
+//*****************************************************************************
+ETL_BENCHMARK_SUITE(timers)
+{
+  run_size<16>(runner);
+  run_size<254>(runner);
+  run_size<4096>(runner);
+}
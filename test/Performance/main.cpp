@@ -0,0 +1,216 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+https://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+//*****************************************************************************
+// Benchmarks the ETL containers against their STL equivalents.
+//
+// Usage: etl_benchmarks [--format=csv|json] [--repetitions=N] [--filter=TEXT] [--output=FILE]
+//
+//   --format       Output format. Default csv.
+//   --repetitions  Times each benchmark is repeated. The minimum and median are reported. Default 5.
+//   --filter       Only run benchmarks whose name contains TEXT.
+//                  Names are "group/implementation/operation/value_type/size".
+//   --output       Write the results to FILE instead of stdout.
+//
+// Save the output for each ETL release and compare the ns_min columns to find regressions.
+//*****************************************************************************
+
+#include <stdlib.h>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "benchmark.h"
+
+#include "etl/version.h"
+
+namespace
+{
+  //***************************************************************************
+  /// Escapes a string for JSON output.
+  //***************************************************************************
+  std::string json_string(const std::string& text)
+  {
+    std::string escaped = "\"";
+
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+      if ((text[i] == '"') || (text[i] == '\\'))
+      {
+        escaped += '\\';
+      }
+
+      escaped += text[i];
+    }
+
+    escaped += "\"";
+
+    return escaped;
+  }
+
+  //***************************************************************************
+  std::string etl_version()
+  {
+    return std::to_string(ETL_VERSION_MAJOR) + "." + std::to_string(ETL_VERSION_MINOR) + "." + std::to_string(ETL_VERSION_PATCH);
+  }
+
+  //***************************************************************************
+  void write_csv(std::ostream& os, const std::vector<benchmark::result>& results)
+  {
+    os << "etl_version,group,implementation,operation,value_type,size,operations,ns_min,ns_median\n";
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+      const benchmark::result& r = results[i];
+
+      os << etl_version() << ','
+         << r.group << ','
+         << r.implementation << ','
+         << r.operation << ','
+         << r.value_type << ','
+         << r.size << ','
+         << r.operations << ','
+         << r.ns_min << ','
+         << r.ns_median << '\n';
+    }
+  }
+
+  //***************************************************************************
+  void write_json(std::ostream& os, const std::vector<benchmark::result>& results)
+  {
+    os << "{\n  \"etl_version\": " << json_string(etl_version()) << ",\n  \"results\": [\n";
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+      const benchmark::result& r = results[i];
+
+      os << "    { "
+         << "\"group\": "          << json_string(r.group)          << ", "
+         << "\"implementation\": " << json_string(r.implementation) << ", "
+         << "\"operation\": "      << json_string(r.operation)      << ", "
+         << "\"value_type\": "     << json_string(r.value_type)     << ", "
+         << "\"size\": "           << r.size                        << ", "
+         << "\"operations\": "     << r.operations                  << ", "
+         << "\"ns_min\": "         << r.ns_min                      << ", "
+         << "\"ns_median\": "      << r.ns_median
+         << ((i + 1) < results.size() ? " },\n" : " }\n");
+    }
+
+    os << "  ]\n}\n";
+  }
+
+  //***************************************************************************
+  bool starts_with(const std::string& text, const std::string& prefix, std::string& remainder)
+  {
+    if (text.compare(0, prefix.size(), prefix) == 0)
+    {
+      remainder = text.substr(prefix.size());
+      return true;
+    }
+
+    return false;
+  }
+}
+
+//*****************************************************************************
+int main(int argc, char* argv[])
+{
+  std::string format = "csv";
+  std::string filter;
+  std::string output;
+  size_t      repetitions = 5;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    std::string arg = argv[i];
+    std::string value;
+
+    if (starts_with(arg, "--format=", value))
+    {
+      format = value;
+    }
+    else if (starts_with(arg, "--repetitions=", value))
+    {
+      repetitions = static_cast<size_t>(std::max(1, atoi(value.c_str())));
+    }
+    else if (starts_with(arg, "--filter=", value))
+    {
+      filter = value;
+    }
+    else if (starts_with(arg, "--output=", value))
+    {
+      output = value;
+    }
+    else
+    {
+      std::cerr << "Usage: " << argv[0] << " [--format=csv|json] [--repetitions=N] [--filter=TEXT] [--output=FILE]\n";
+      return (arg == "--help") ? 0 : 1;
+    }
+  }
+
+  if ((format != "csv") && (format != "json"))
+  {
+    std::cerr << "Unknown format '" << format << "'\n";
+    return 1;
+  }
+
+  benchmark::runner runner(repetitions, filter);
+
+  for (size_t i = 0; i < benchmark::suites().size(); ++i)
+  {
+    std::cerr << "Running " << benchmark::suites()[i].name << "\n";
+    benchmark::suites()[i].function(runner);
+  }
+
+  std::ofstream file;
+
+  if (!output.empty())
+  {
+    file.open(output.c_str());
+
+    if (!file)
+    {
+      std::cerr << "Cannot open '" << output << "'\n";
+      return 1;
+    }
+  }
+
+  std::ostream& os = output.empty() ? std::cout : file;
+
+  if (format == "json")
+  {
+    write_json(os, runner.get_results());
+  }
+  else
+  {
+    write_csv(os, runner.get_results());
+  }
+
+  return 0;
+}
@@ -44,11 +44,17 @@ SOFTWARE.
 #define ETL_CALLBACK_TIMER_USE_ATOMIC_LOCK
 
 #define ETL_POLYMORPHIC_BITSET
+#define ETL_POLYMORPHIC_BTREE_MAP
+#define ETL_POLYMORPHIC_BTREE_SET
 #define ETL_POLYMORPHIC_DEQUE
+#define ETL_POLYMORPHIC_FLAT_HASH_MAP
+#define ETL_POLYMORPHIC_FLAT_HASH_SET
 #define ETL_POLYMORPHIC_FLAT_MAP
 #define ETL_POLYMORPHIC_FLAT_MULTIMAP
 #define ETL_POLYMORPHIC_FLAT_SET
 #define ETL_POLYMORPHIC_FLAT_MULTISET
+#define ETL_POLYMORPHIC_SORTED_VECTOR_MAP
+#define ETL_POLYMORPHIC_SORTED_VECTOR_SET
 #define ETL_POLYMORPHIC_FORWARD_LIST
 #define ETL_POLYMORPHIC_LIST
 #define ETL_POLYMORPHIC_MAP
@@ -66,7 +72,9 @@ SOFTWARE.
 #define ETL_POLYMORPHIC_UNORDERED_SET
 #define ETL_POLYMORPHIC_UNORDERED_MULTISET
 #define ETL_POLYMORPHIC_STRINGS
+#define ETL_POLYMORPHIC_ARENA
 #define ETL_POLYMORPHIC_POOL
+#define ETL_POLYMORPHIC_SLAB_ALLOCATOR
 #define ETL_POLYMORPHIC_VECTOR
 
 //#define ETL_POLYMORPHIC_CONTAINERS
@@ -30,12 +30,15 @@ SOFTWARE.
 
 #include "etl/algorithm.h"
 #include "etl/container.h"
+#include "etl/array.h"
 
 #include <vector>
 #include <list>
 #include <algorithm>
 #include <functional>
 #include <numeric>
+#include <string>
+#include <random>
 
 namespace
 {
@@ -610,6 +613,51 @@ namespace
       CHECK_EQUAL(std::end(data1), p);
     }
 
+    //=========================================================================
+    TEST(branchless_lower_bound_upper_bound)
+    {
+      // Every size up to 40, with runs of duplicates, searching for every value and the gaps between.
+      for (size_t size = 0; size <= 40; ++size)
+      {
+        std::vector<int> data;
+
+        for (size_t i = 0; i < size; ++i)
+        {
+          data.push_back(int(2 * (i / 3)));
+        }
+
+        for (int value = -1; value <= int(size) + 1; ++value)
+        {
+          CHECK(std::lower_bound(data.begin(), data.end(), value) == etl::branchless_lower_bound(data.begin(), data.end(), value));
+          CHECK(std::upper_bound(data.begin(), data.end(), value) == etl::branchless_upper_bound(data.begin(), data.end(), value));
+        }
+      }
+    }
+
+    //=========================================================================
+    TEST(branchless_lower_bound_upper_bound_compare)
+    {
+      int data[] = { 9, 8, 8, 6, 5, 5, 5, 2, 1 };
+
+      for (int value = 0; value <= 10; ++value)
+      {
+        CHECK_EQUAL(std::lower_bound(std::begin(data), std::end(data), value, std::greater<int>()),
+                    etl::branchless_lower_bound(std::begin(data), std::end(data), value, std::greater<int>()));
+        CHECK_EQUAL(std::upper_bound(std::begin(data), std::end(data), value, std::greater<int>()),
+                    etl::branchless_upper_bound(std::begin(data), std::end(data), value, std::greater<int>()));
+      }
+    }
+
+    //=========================================================================
+    TEST(use_branchless_search)
+    {
+      CHECK(etl::use_branchless_search<int>::value);
+      CHECK(etl::use_branchless_search<double>::value);
+      CHECK(etl::use_branchless_search<const char*>::value);
+      CHECK(!etl::use_branchless_search<std::string>::value);
+      CHECK(!etl::use_branchless_search<StructData>::value);
+    }
+
     //=========================================================================
     TEST(for_each_if)
     {
@@ -909,5 +957,237 @@ namespace
         CHECK(is_same);
       }
     }
+
+    //=========================================================================
+    TEST(sort_patterns)
+    {
+      const size_t SIZE = 10000;
+
+      std::mt19937 rng(1);
+      std::vector<std::vector<int> > tests;
+
+      std::vector<int> ascending(SIZE);
+      std::iota(ascending.begin(), ascending.end(), 0);
+      tests.push_back(ascending);
+
+      std::vector<int> descending(ascending.rbegin(), ascending.rend());
+      tests.push_back(descending);
+
+      tests.push_back(std::vector<int>(SIZE, 42));
+
+      std::vector<int> organ_pipe(SIZE);
+      for (size_t i = 0; i < SIZE; ++i)
+      {
+        organ_pipe[i] = int((i < (SIZE / 2)) ? i : SIZE - i);
+      }
+      tests.push_back(organ_pipe);
+
+      std::vector<int> few_unique(SIZE);
+      for (size_t i = 0; i < SIZE; ++i)
+      {
+        few_unique[i] = int(rng() % 4);
+      }
+      tests.push_back(few_unique);
+
+      std::vector<int> random(SIZE);
+      for (size_t i = 0; i < SIZE; ++i)
+      {
+        random[i] = int(rng());
+      }
+      tests.push_back(random);
+
+      std::vector<int> nearly_sorted = ascending;
+      for (size_t i = 0; i < 10; ++i)
+      {
+        std::swap(nearly_sorted[rng() % SIZE], nearly_sorted[rng() % SIZE]);
+      }
+      tests.push_back(nearly_sorted);
+
+      for (size_t t = 0; t < tests.size(); ++t)
+      {
+        std::vector<int> data1 = tests[t];
+        std::vector<int> data2 = tests[t];
+        std::vector<int> data3 = tests[t];
+        std::vector<int> data4 = tests[t];
+
+        std::sort(data1.begin(), data1.end());
+        etl::sort(data2.begin(), data2.end());
+        CHECK(data1 == data2);
+
+        std::sort(data3.begin(), data3.end(), std::greater<int>());
+        etl::sort(data4.begin(), data4.end(), std::greater<int>());
+        CHECK(data3 == data4);
+      }
+    }
+
+    //=========================================================================
+    TEST(sort_all_sizes)
+    {
+      std::mt19937 rng(2);
+
+      for (size_t size = 0; size < 300; ++size)
+      {
+        std::vector<int> data1(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+          data1[i] = int(rng() % 100);
+        }
+
+        std::vector<int> data2 = data1;
+
+        std::sort(data1.begin(), data1.end());
+        etl::sort(data2.begin(), data2.end());
+
+        CHECK(data1 == data2);
+      }
+    }
+
+    //=========================================================================
+    TEST(sort_strings)
+    {
+      std::mt19937 rng(3);
+      std::vector<std::string> data1(1000);
+
+      for (size_t i = 0; i < data1.size(); ++i)
+      {
+        data1[i] = "string " + std::to_string(rng() % 500);
+      }
+
+      std::vector<std::string> data2 = data1;
+
+      std::sort(data1.begin(), data1.end());
+      etl::sort(data2.begin(), data2.end());
+
+      CHECK(data1 == data2);
+    }
+
+    //=========================================================================
+    TEST(sort_list)
+    {
+      std::vector<int> data(100, 0);
+      std::iota(data.begin(), data.end(), 1);
+      std::random_shuffle(data.begin(), data.end());
+
+      std::list<int> data1(data.begin(), data.end());
+      std::list<int> data2(data.begin(), data.end());
+
+      data1.sort();
+      etl::sort(data2.begin(), data2.end());
+
+      CHECK(data1 == data2);
+    }
+
+    //=========================================================================
+    TEST(stable_sort)
+    {
+      std::mt19937 rng(4);
+      std::vector<StructData> data(1000);
+
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        data[i].a = int(rng() % 50);
+        data[i].b = int(i);
+      }
+
+      std::vector<StructData> compare = data;
+      std::stable_sort(compare.begin(), compare.end(), StructDataPredicate());
+
+      // Buffer large enough for a single pass.
+      etl::array<StructData, 500> large_buffer;
+      std::vector<StructData> data1 = data;
+      etl::stable_sort(data1.begin(), data1.end(), large_buffer, StructDataPredicate());
+      CHECK(std::equal(compare.begin(), compare.end(), data1.begin()));
+
+      // Buffer smaller than the runs being merged.
+      etl::array<StructData, 10> small_buffer;
+      std::vector<StructData> data2 = data;
+      etl::stable_sort(data2.begin(), data2.end(), small_buffer, StructDataPredicate());
+      CHECK(std::equal(compare.begin(), compare.end(), data2.begin()));
+
+      // No buffer.
+      std::vector<StructData> data3 = data;
+      etl::stable_sort(data3.begin(), data3.end(), StructDataPredicate());
+      CHECK(std::equal(compare.begin(), compare.end(), data3.begin()));
+    }
+
+    //=========================================================================
+    TEST(stable_sort_default)
+    {
+      std::vector<int> data(1000, 0);
+      std::iota(data.begin(), data.end(), 1);
+      std::random_shuffle(data.begin(), data.end());
+
+      std::vector<int> data1 = data;
+      std::vector<int> data2 = data;
+      std::vector<int> data3 = data;
+
+      etl::array<int, 100> buffer;
+
+      std::stable_sort(data1.begin(), data1.end());
+      etl::stable_sort(data2.begin(), data2.end(), buffer);
+      etl::stable_sort(data3.begin(), data3.end());
+
+      CHECK(data1 == data2);
+      CHECK(data1 == data3);
+    }
+
+    //=========================================================================
+    TEST(partial_sort)
+    {
+      std::vector<int> data(1000, 0);
+      std::iota(data.begin(), data.end(), 1);
+
+      for (size_t middle = 0; middle <= data.size(); middle += 100)
+      {
+        std::random_shuffle(data.begin(), data.end());
+
+        std::vector<int> data1 = data;
+        std::vector<int> data2 = data;
+
+        std::partial_sort(data1.begin(), data1.begin() + middle, data1.end());
+        etl::partial_sort(data2.begin(), data2.begin() + middle, data2.end());
+
+        CHECK(std::equal(data1.begin(), data1.begin() + middle, data2.begin()));
+
+        std::partial_sort(data1.begin(), data1.begin() + middle, data1.end(), std::greater<int>());
+        etl::partial_sort(data2.begin(), data2.begin() + middle, data2.end(), std::greater<int>());
+
+        CHECK(std::equal(data1.begin(), data1.begin() + middle, data2.begin()));
+      }
+    }
+
+    //=========================================================================
+    TEST(nth_element)
+    {
+      std::mt19937 rng(5);
+      std::vector<int> data(1000);
+
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        data[i] = int(rng() % 200);
+      }
+
+      std::vector<int> sorted = data;
+      std::sort(sorted.begin(), sorted.end());
+
+      for (size_t n = 0; n < data.size(); n += 37)
+      {
+        std::vector<int> data1 = data;
+        etl::nth_element(data1.begin(), data1.begin() + n, data1.end());
+
+        CHECK_EQUAL(sorted[n], data1[n]);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+          CHECK(!(data1[n] < data1[i]));
+        }
+
+        for (size_t i = n + 1; i < data1.size(); ++i)
+        {
+          CHECK(!(data1[i] < data1[n]));
+        }
+      }
+    }
   };
 }
@@ -0,0 +1,266 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <stdint.h>
+#include <string>
+
+#include "etl/arena.h"
+
+#if defined(ETL_ARENA_MEMORY_RESOURCE)
+  #include <vector>
+#endif
+
+namespace
+{
+  struct Data
+  {
+    Data()
+      : a(0),
+        b(0)
+    {
+    }
+
+    Data(int a_, int b_ = 2)
+      : a(a_),
+        b(b_)
+    {
+    }
+
+    int a;
+    int b;
+  };
+
+  typedef etl::arena<64> Arena;
+
+  SUITE(test_arena)
+  {
+    //*************************************************************************
+    TEST(test_default_constructor)
+    {
+      Arena arena;
+
+      CHECK(arena.empty());
+      CHECK(!arena.full());
+      CHECK_EQUAL(0U, arena.size());
+      CHECK_EQUAL(64U, arena.capacity());
+      CHECK_EQUAL(64U, arena.max_size());
+      CHECK_EQUAL(64U, arena.available());
+      CHECK_EQUAL(0U, arena.high_water_mark());
+      CHECK_EQUAL(0U, uintptr_t(arena.allocate(1)) % size_t(etl::iarena::DEFAULT_ALIGNMENT));
+    }
+
+    //*************************************************************************
+    TEST(test_allocate_aligned)
+    {
+      Arena arena;
+
+      char* p1 = static_cast<char*>(arena.allocate(1, 1));
+      CHECK_EQUAL(1U, arena.size());
+
+      // Three bytes of padding.
+      char* p2 = static_cast<char*>(arena.allocate(4, 4));
+      CHECK_EQUAL(0U, uintptr_t(p2) % 4);
+      CHECK_EQUAL(p1 + 4, p2);
+      CHECK_EQUAL(8U, arena.size());
+
+      // Already aligned.
+      char* p3 = static_cast<char*>(arena.allocate(1, 8));
+      CHECK_EQUAL(0U, uintptr_t(p3) % 8);
+      CHECK_EQUAL(p2 + 4, p3);
+      CHECK_EQUAL(9U, arena.size());
+
+      CHECK(arena.is_in_arena(p1));
+      CHECK(arena.is_in_arena(p3));
+      CHECK(!arena.is_in_arena(&arena));
+    }
+
+    //*************************************************************************
+    TEST(test_allocate_typed)
+    {
+      Arena arena;
+
+      arena.allocate(1, 1);
+
+      uint32_t* p = arena.allocate<uint32_t>(4);
+      CHECK(p != nullptr);
+      CHECK_EQUAL(0U, uintptr_t(p) % etl::alignment_of<uint32_t>::value);
+      CHECK_EQUAL(4U + (4U * sizeof(uint32_t)), arena.size());
+
+      // Too many to ever fit.
+      CHECK_THROW(arena.allocate<uint32_t>(size_t(-1) / 2), etl::arena_no_allocation);
+    }
+
+    //*************************************************************************
+    TEST(test_allocate_exhausted)
+    {
+      Arena arena;
+
+      CHECK(arena.allocate(60, 1) != nullptr);
+      CHECK_EQUAL(4U, arena.available());
+
+      // Fits without padding, but not with it.
+      CHECK_THROW(arena.allocate(4, 8), etl::arena_no_allocation);
+      CHECK_EQUAL(60U, arena.size());
+
+      CHECK(arena.allocate(4, 4) != nullptr);
+      CHECK(arena.full());
+
+      CHECK_THROW(arena.allocate(1, 1), etl::arena_no_allocation);
+    }
+
+    //*************************************************************************
+    TEST(test_create)
+    {
+      Arena arena;
+
+      Data* p1 = arena.create<Data>();
+      Data* p2 = arena.create<Data>(1);
+      Data* p3 = arena.create<Data>(3, 4);
+      std::string* p4 = arena.create<std::string>(3, 'x');
+
+      CHECK_EQUAL(0, p1->a);
+      CHECK_EQUAL(0, p1->b);
+      CHECK_EQUAL(1, p2->a);
+      CHECK_EQUAL(2, p2->b);
+      CHECK_EQUAL(3, p3->a);
+      CHECK_EQUAL(4, p3->b);
+      CHECK_EQUAL(std::string("xxx"), *p4);
+
+      p4->~basic_string();
+    }
+
+    //*************************************************************************
+    TEST(test_rewind)
+    {
+      Arena arena;
+
+      arena.allocate(8);
+      etl::iarena::marker_type marker = arena.get_marker();
+      CHECK_EQUAL(8U, marker);
+
+      void* p1 = arena.allocate(16);
+      arena.allocate(16);
+      CHECK_EQUAL(40U, arena.size());
+
+      arena.rewind(marker);
+      CHECK_EQUAL(8U, arena.size());
+      CHECK_EQUAL(40U, arena.high_water_mark());
+
+      // The same memory is handed out again.
+      CHECK_EQUAL(p1, arena.allocate(16));
+
+      // Can't rewind forwards.
+      CHECK_THROW(arena.rewind(arena.get_marker() + 1), etl::arena_invalid_marker);
+      CHECK_EQUAL(24U, arena.size());
+    }
+
+    //*************************************************************************
+    TEST(test_reset)
+    {
+      Arena arena;
+
+      void* p1 = arena.allocate(32);
+      arena.allocate(16);
+
+      arena.reset();
+      CHECK(arena.empty());
+      CHECK_EQUAL(64U, arena.available());
+      CHECK_EQUAL(48U, arena.high_water_mark());
+      CHECK_EQUAL(p1, arena.allocate(32));
+    }
+
+    //*************************************************************************
+    TEST(test_scope)
+    {
+      Arena arena;
+      arena.allocate(8);
+
+      {
+        etl::arena_scope outer(arena);
+        arena.allocate(8);
+
+        {
+          etl::arena_scope inner(arena);
+          CHECK_EQUAL(16U, inner.get_marker());
+          arena.allocate(16);
+          CHECK_EQUAL(32U, arena.size());
+        }
+
+        CHECK_EQUAL(16U, arena.size());
+      }
+
+      CHECK_EQUAL(8U, arena.size());
+    }
+
+    //*************************************************************************
+    TEST(test_interface)
+    {
+      Arena arena;
+      etl::iarena& iarena = arena;
+
+      Data* p = iarena.create<Data>(5, 6);
+      CHECK_EQUAL(5, p->a);
+      CHECK_EQUAL(6, p->b);
+      CHECK_EQUAL(sizeof(Data), iarena.size());
+
+      iarena.reset();
+      CHECK(arena.empty());
+    }
+
+#if defined(ETL_ARENA_MEMORY_RESOURCE)
+    //*************************************************************************
+    TEST(test_memory_resource)
+    {
+      etl::arena<256> arena;
+      etl::arena_memory_resource resource(arena);
+
+      CHECK_EQUAL(&arena, &resource.get_arena());
+
+      {
+        std::pmr::vector<int> v(&resource);
+        v.reserve(16);
+        v.push_back(1);
+
+        CHECK(arena.is_in_arena(v.data()));
+        CHECK_EQUAL(16U * sizeof(int), arena.size());
+      }
+
+      // Deallocation does not release anything.
+      CHECK_EQUAL(16U * sizeof(int), arena.size());
+
+      CHECK_THROW(resource.allocate(1024), std::bad_alloc);
+
+      etl::arena_memory_resource other(arena);
+      CHECK(resource.is_equal(resource));
+      CHECK(!resource.is_equal(other));
+    }
+#endif
+  };
+}
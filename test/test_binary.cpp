@@ -62,6 +62,34 @@ size_t test_parity(T value)
   return count & 1;
 }
 
+//***********************************
+template <typename T>
+size_t test_trailing_zeros(T value)
+{
+  size_t count = 0;
+
+  while ((count < etl::integral_limits<T>::bits) && ((value & (T(1) << count)) == 0))
+  {
+    ++count;
+  }
+
+  return count;
+}
+
+//***********************************
+template <typename T>
+size_t test_leading_zeros(T value)
+{
+  size_t count = 0;
+
+  while ((count < etl::integral_limits<T>::bits) && ((value & (T(1) << (etl::integral_limits<T>::bits - 1 - count))) == 0))
+  {
+    ++count;
+  }
+
+  return count;
+}
+
 // Power of 2.
 uint64_t test_power_of_2(int power)
 {
@@ -797,6 +825,136 @@ namespace
       }
     }
 
+    //*************************************************************************
+    TEST(test_count_trailing_zeros_8)
+    {
+      for (size_t i = 0; i <= std::numeric_limits<uint8_t>::max(); ++i)
+      {
+        CHECK_EQUAL(test_trailing_zeros(uint8_t(i)), etl::count_trailing_zeros(uint8_t(i)));
+        CHECK_EQUAL(test_trailing_zeros(uint8_t(i)), etl::count_trailing_zeros(int8_t(i)));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_count_trailing_zeros_16)
+    {
+      for (size_t i = 0; i <= std::numeric_limits<uint16_t>::max(); ++i)
+      {
+        CHECK_EQUAL(test_trailing_zeros(uint16_t(i)), etl::count_trailing_zeros(uint16_t(i)));
+        CHECK_EQUAL(test_trailing_zeros(uint16_t(i)), etl::count_trailing_zeros(int16_t(i)));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_count_trailing_zeros_32)
+    {
+      etl::fnv_1a_32 hash;
+
+      CHECK_EQUAL(32U, etl::count_trailing_zeros(uint32_t(0)));
+
+      for (size_t i = 0; i < 100000; ++i)
+      {
+        hash.add(1);
+
+        // Shift to give a range of trailing zeros.
+        uint32_t value = hash.value() << (i % 32);
+
+        CHECK_EQUAL(test_trailing_zeros(value), etl::count_trailing_zeros(value));
+        CHECK_EQUAL(test_trailing_zeros(value), etl::count_trailing_zeros(int32_t(value)));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_count_trailing_zeros_64)
+    {
+      etl::fnv_1a_64 hash;
+
+      CHECK_EQUAL(64U, etl::count_trailing_zeros(uint64_t(0)));
+
+      for (size_t i = 0; i < 100000; ++i)
+      {
+        hash.add(1);
+
+        uint64_t value = hash.value() << (i % 64);
+
+        CHECK_EQUAL(test_trailing_zeros(value), etl::count_trailing_zeros(value));
+        CHECK_EQUAL(test_trailing_zeros(value), etl::count_trailing_zeros(int64_t(value)));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_count_leading_zeros_8)
+    {
+      for (size_t i = 0; i <= std::numeric_limits<uint8_t>::max(); ++i)
+      {
+        CHECK_EQUAL(test_leading_zeros(uint8_t(i)), etl::count_leading_zeros(uint8_t(i)));
+        CHECK_EQUAL(test_leading_zeros(uint8_t(i)), etl::count_leading_zeros(int8_t(i)));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_count_leading_zeros_16)
+    {
+      for (size_t i = 0; i <= std::numeric_limits<uint16_t>::max(); ++i)
+      {
+        CHECK_EQUAL(test_leading_zeros(uint16_t(i)), etl::count_leading_zeros(uint16_t(i)));
+        CHECK_EQUAL(test_leading_zeros(uint16_t(i)), etl::count_leading_zeros(int16_t(i)));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_count_leading_zeros_32)
+    {
+      etl::fnv_1a_32 hash;
+
+      CHECK_EQUAL(32U, etl::count_leading_zeros(uint32_t(0)));
+
+      for (size_t i = 0; i < 100000; ++i)
+      {
+        hash.add(1);
+
+        uint32_t value = hash.value() >> (i % 32);
+
+        CHECK_EQUAL(test_leading_zeros(value), etl::count_leading_zeros(value));
+        CHECK_EQUAL(test_leading_zeros(value), etl::count_leading_zeros(int32_t(value)));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_count_leading_zeros_64)
+    {
+      etl::fnv_1a_64 hash;
+
+      CHECK_EQUAL(64U, etl::count_leading_zeros(uint64_t(0)));
+
+      for (size_t i = 0; i < 100000; ++i)
+      {
+        hash.add(1);
+
+        uint64_t value = hash.value() >> (i % 64);
+
+        CHECK_EQUAL(test_leading_zeros(value), etl::count_leading_zeros(value));
+        CHECK_EQUAL(test_leading_zeros(value), etl::count_leading_zeros(int64_t(value)));
+      }
+    }
+
+#if ETL_CPP11_SUPPORTED && ETL_BINARY_USE_BUILTINS
+    //*************************************************************************
+    TEST(test_bit_functions_compile_time)
+    {
+#if ETL_BINARY_USE_BUILTIN_POPCOUNT
+      static_assert(etl::count_bits(uint32_t(0xF0F0F0F0)) == 16, "count_bits");
+      static_assert(etl::count_bits(uint64_t(0xFFFFFFFFFFFFFFFF)) == 64, "count_bits");
+      static_assert(etl::parity(uint32_t(0x00000007)) == 1, "parity");
+#endif
+      static_assert(etl::count_trailing_zeros(uint32_t(0x00010000)) == 16, "count_trailing_zeros");
+      static_assert(etl::count_trailing_zeros(uint64_t(0)) == 64, "count_trailing_zeros");
+      static_assert(etl::count_leading_zeros(uint16_t(0x0010)) == 11, "count_leading_zeros");
+      static_assert(etl::count_leading_zeros(uint64_t(1)) == 63, "count_leading_zeros");
+      static_assert(etl::reverse_bytes(uint32_t(0x12345678)) == 0x78563412, "reverse_bytes");
+    }
+#endif
+
     //*************************************************************************
     TEST(test_fold_bits)
     {
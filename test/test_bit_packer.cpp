@@ -0,0 +1,237 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <stdint.h>
+#include <vector>
+
+#include "etl/bit_packer.h"
+
+namespace
+{
+  //***************************************************************************
+  // Random values of 'bits' bits.
+  //***************************************************************************
+  template <typename TWord>
+  std::vector<TWord> make_values(size_t count, size_t bits, TWord reference, uint64_t seed)
+  {
+    std::vector<TWord> values;
+    uint64_t x = seed | 1;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+
+      TWord value = (bits == 0) ? TWord(0) : TWord(x >> (64 - bits));
+      values.push_back(TWord(value + reference));
+    }
+
+    return values;
+  }
+
+  //***************************************************************************
+  // The reference packer, one bit at a time.
+  //***************************************************************************
+  template <typename TWord>
+  std::vector<TWord> reference_pack(const std::vector<TWord>& values, size_t bits, TWord reference)
+  {
+    const size_t word_bits = sizeof(TWord) * 8;
+    std::vector<TWord> packed(bits, 0);
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+      TWord value = TWord(values[i] - reference);
+
+      for (size_t b = 0; b < bits; ++b)
+      {
+        size_t position = (i * bits) + b;
+
+        if ((value >> b) & 1)
+        {
+          packed[position / word_bits] |= TWord(TWord(1) << (position % word_bits));
+        }
+      }
+    }
+
+    return packed;
+  }
+
+  //***************************************************************************
+  template <typename TWord>
+  bool check_width(size_t bits, TWord reference)
+  {
+    const size_t word_bits = sizeof(TWord) * 8;
+
+    std::vector<TWord> values   = make_values<TWord>(word_bits, bits, reference, 0x9E3779B97F4A7C15ULL + bits);
+    std::vector<TWord> expected = reference_pack(values, bits, reference);
+
+    // A guard word after the packed words.
+    std::vector<TWord> packed(bits + 1, TWord(0xA5A5A5A5A5A5A5A5ULL));
+    std::vector<TWord> unpacked(word_bits, 0);
+
+    etl::bit_pack(values.data(), packed.data(), bits, reference);
+    etl::bit_unpack(packed.data(), unpacked.data(), bits, reference);
+
+    bool ok = (packed[bits] == TWord(0xA5A5A5A5A5A5A5A5ULL));
+    packed.pop_back();
+
+    return ok &&
+           (packed == expected) &&
+           (unpacked == values) &&
+           (etl::bit_pack_width(values.data(), values.size(), reference) <= bits);
+  }
+
+  SUITE(test_bit_packer)
+  {
+    //*************************************************************************
+    TEST(test_pack_unpack_32)
+    {
+      const uint32_t values[32] = { 0, 1, 2, 3, 4, 5, 6, 7, 7, 6, 5, 4, 3, 2, 1, 0,
+                                    1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 5, 6, 7 };
+      uint32_t packed[3];
+      uint32_t unpacked[32];
+
+      etl::bit_packer<3>::pack(values, packed);
+
+      // The first values are at the bottom of the first word.
+      CHECK_EQUAL(0U, packed[0] & 0x7);
+      CHECK_EQUAL(1U, (packed[0] >> 3) & 0x7);
+      CHECK_EQUAL(2U, (packed[0] >> 6) & 0x7);
+
+      etl::bit_packer<3>::unpack(packed, unpacked);
+      CHECK_ARRAY_EQUAL(values, unpacked, 32);
+    }
+
+    //*************************************************************************
+    TEST(test_pack_unpack_64)
+    {
+      std::vector<uint64_t> values = make_values<uint64_t>(64, 45, 0, 1234);
+      std::vector<uint64_t> packed(45);
+      std::vector<uint64_t> unpacked(64);
+
+      etl::bit_packer<45>::pack(values.data(), packed.data());
+      etl::bit_packer<45>::unpack(packed.data(), unpacked.data());
+
+      CHECK(packed == reference_pack(values, 45, uint64_t(0)));
+      CHECK(values == unpacked);
+    }
+
+    //*************************************************************************
+    TEST(test_all_widths_32)
+    {
+      for (size_t bits = 0; bits <= 32; ++bits)
+      {
+        CHECK(check_width<uint32_t>(bits, 0U));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_all_widths_64)
+    {
+      for (size_t bits = 0; bits <= 64; ++bits)
+      {
+        CHECK(check_width<uint64_t>(bits, 0U));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_frame_of_reference)
+    {
+      for (size_t bits = 0; bits <= 20; ++bits)
+      {
+        CHECK(check_width<uint32_t>(bits, 1000000U));
+        CHECK(check_width<uint64_t>(bits, 0x123456789ULL));
+      }
+
+      uint32_t values[32];
+
+      for (size_t i = 0; i < 32; ++i)
+      {
+        values[i] = 5000U + uint32_t(i);
+      }
+
+      uint32_t packed[5];
+      uint32_t unpacked[32];
+
+      CHECK_EQUAL(5U, etl::bit_pack_width(values, 32, 5000U));
+      etl::bit_packer<5>::pack(values, packed, 5000U);
+      etl::bit_packer<5>::unpack(packed, unpacked, 5000U);
+      CHECK_ARRAY_EQUAL(values, unpacked, 32);
+    }
+
+    //*************************************************************************
+    TEST(test_zero_bits)
+    {
+      uint32_t values[32] = { 0 };
+      uint32_t unpacked[32];
+      uint32_t guard = 0x12345678U;
+
+      CHECK_EQUAL(0U, etl::bit_pack_width(values, 32));
+
+      etl::bit_packer<0>::pack(values, &guard);
+      CHECK_EQUAL(0x12345678U, guard);
+
+      etl::bit_packer<0>::unpack(&guard, unpacked, 7U);
+
+      for (size_t i = 0; i < 32; ++i)
+      {
+        CHECK_EQUAL(7U, unpacked[i]);
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_bit_pack_width)
+    {
+      const uint32_t values32[] = { 1, 2, 3, 0x1000 };
+      const uint64_t values64[] = { 1, 0x8000000000000000ULL };
+
+      CHECK_EQUAL(13U, etl::bit_pack_width(values32, 4));
+      CHECK_EQUAL(2U, etl::bit_pack_width(values32, 3));
+      CHECK_EQUAL(0U, etl::bit_pack_width(values32, 0));
+      CHECK_EQUAL(64U, etl::bit_pack_width(values64, 2));
+      CHECK_EQUAL(1U, etl::bit_pack_width(values64, 1));
+    }
+
+    //*************************************************************************
+    TEST(test_invalid_width)
+    {
+      uint32_t values32[32] = { 0 };
+      uint32_t packed32[33];
+      uint64_t values64[64] = { 0 };
+      uint64_t packed64[65];
+
+      CHECK_THROW(etl::bit_pack(values32, packed32, 33U), etl::bit_packer_invalid_width);
+      CHECK_THROW(etl::bit_unpack(packed32, values32, 33U), etl::bit_packer_invalid_width);
+      CHECK_THROW(etl::bit_pack(values64, packed64, 65U), etl::bit_packer_invalid_width);
+      CHECK_THROW(etl::bit_unpack(packed64, values64, 65U), etl::bit_packer_invalid_width);
+    }
+  };
+}
@@ -32,6 +32,7 @@ SOFTWARE.
 
 #include <array>
 #include <numeric>
+#include <vector>
 
 namespace
 {
@@ -55,6 +56,27 @@ namespace
     os << object.i << "," << object.d << "," << (int)object.c;
     return os;
   }
+
+  //***********************************
+  // Writes one bit at a time, most significant first, as a reference.
+  void reference_put(std::vector<unsigned char>& data, size_t& bit_index, uint64_t value, size_t width)
+  {
+    for (size_t i = width; i != 0; --i)
+    {
+      unsigned char mask = 0x80 >> (bit_index % 8);
+
+      if ((value >> (i - 1)) & 1U)
+      {
+        data[bit_index / 8] |= mask;
+      }
+      else
+      {
+        data[bit_index / 8] &= ~mask;
+      }
+
+      ++bit_index;
+    }
+  }
 }
 
 namespace etl
@@ -1003,6 +1025,20 @@ namespace
         CHECK_EQUAL(41U, bit_stream.size());
         CHECK_EQUAL(324U, bit_stream.bits());
       }
+      else if (sizeof(long double) == 16)
+      {
+        bit_stream.put(ld);
+        CHECK_EQUAL(38U, bit_stream.size());
+        CHECK_EQUAL(302U, bit_stream.bits());
+
+        bit_stream.put(c2, 7);
+        CHECK_EQUAL(39U, bit_stream.size());
+        CHECK_EQUAL(309U, bit_stream.bits());
+
+        bit_stream.put(ll, 47);
+        CHECK_EQUAL(45U, bit_stream.size());
+        CHECK_EQUAL(356U, bit_stream.bits());
+      }
       else
       {
         assert(false);
@@ -1053,6 +1089,275 @@ namespace
       CHECK_EQUAL(int(ll), int(rll));
     }
 
+    //*************************************************************************
+    TEST(put_get_array_zero_count_full_stream)
+    {
+      std::vector<unsigned char> storage(2);
+
+      uint8_t values[2] = { 0x12, 0x34 };
+
+      etl::bit_stream bit_stream(storage.data(), storage.size());
+
+      CHECK(bit_stream.put_array(values, 2, 8));
+      CHECK(bit_stream.at_end());
+
+      // Nothing to put or get, so the end of the buffer must not be touched.
+      CHECK(bit_stream.put_array(values, 0, 8));
+      CHECK(bit_stream.put_array(values, 0, 5));
+      CHECK_EQUAL(16U, bit_stream.bits());
+
+      bit_stream.restart();
+
+      uint8_t rvalues[2];
+
+      CHECK(bit_stream.get_array(rvalues, 2, 8));
+      CHECK(bit_stream.at_end());
+      CHECK(bit_stream.get_array(rvalues, 0, 8));
+      CHECK(bit_stream.get_array(rvalues, 0, 5));
+      CHECK_EQUAL(0x12, int(rvalues[0]));
+      CHECK_EQUAL(0x34, int(rvalues[1]));
+    }
+
+    //*************************************************************************
+    TEST(put_get_array)
+    {
+      std::array<unsigned char, 20> storage;
+      std::array<unsigned char, 20> compare_data = { 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0 };
+
+      uint8_t  nibbles[16] = { 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0xA, 0xB, 0xC, 0xD, 0xE, 0xF, 0x0 };
+      uint32_t words[3]    = { 0x12345678, 0x9ABCDEF0, 0x0FEDCBA9 };
+
+      etl::bit_stream bit_stream(storage.data(), storage.size());
+
+      CHECK(bit_stream.put_array(nibbles, 16, 4));
+      CHECK_EQUAL(8U, bit_stream.size());
+
+      for (size_t i = 0; i < 8; ++i)
+      {
+        CHECK_EQUAL(int(compare_data[i]), int(storage[i]));
+      }
+
+      CHECK(bit_stream.put_array(words, 3));
+      CHECK_EQUAL(20U, bit_stream.size());
+      CHECK(bit_stream.at_end());
+
+      // Not enough space.
+      CHECK(!bit_stream.put_array(words, 1));
+
+      bit_stream.restart();
+
+      uint8_t  rnibbles[16];
+      uint32_t rwords[3];
+
+      CHECK(bit_stream.get_array(rnibbles, 16, 4));
+      CHECK(bit_stream.get_array(rwords, 3));
+      CHECK(bit_stream.at_end());
+
+      CHECK_ARRAY_EQUAL(nibbles, rnibbles, 16);
+      CHECK_ARRAY_EQUAL(words, rwords, 3);
+
+      // Not enough data.
+      CHECK(!bit_stream.get_array(rwords, 1));
+    }
+
+    //*************************************************************************
+    TEST(put_get_array_signed)
+    {
+      std::array<unsigned char, 32> storage;
+
+      int16_t values[10] = { -512, -100, -1, 0, 1, 100, 511, -256, 255, -3 };
+      int64_t values64[2] = { -140737488355328LL, 140737488355327LL };
+
+      etl::bit_stream bit_stream(storage.data(), storage.size());
+
+      // Start part way through a byte.
+      CHECK(bit_stream.put(true));
+      CHECK(bit_stream.put_array(values, 10, 10));
+      CHECK(bit_stream.put_array(values64, 2, 48));
+
+      bit_stream.restart();
+
+      bool     b;
+      int16_t  rvalues[10];
+      int64_t  rvalues64[2];
+
+      CHECK(bit_stream.get(b));
+      CHECK(b);
+      CHECK(bit_stream.get_array(rvalues, 10, 10));
+      CHECK(bit_stream.get_array(rvalues64, 2, 48));
+
+      CHECK_ARRAY_EQUAL(values, rvalues, 10);
+      CHECK_ARRAY_EQUAL(values64, rvalues64, 2);
+    }
+
+    //*************************************************************************
+    TEST(put_get_matches_reference)
+    {
+      // Every field width, at every bit offset, including the last bytes of the buffer.
+      std::vector<unsigned char> storage(64);
+      std::vector<unsigned char> reference(64);
+
+      std::vector<uint64_t> values;
+      std::vector<size_t>   widths;
+
+      uint64_t seed = 0x123456789ABCDEF1ULL;
+      size_t   total = 0;
+
+      for (size_t i = 0; total < (storage.size() * 8); ++i)
+      {
+        seed = (seed * 6364136223846793005ULL) + 1442695040888963407ULL;
+
+        size_t width = std::min(size_t(1 + (i % 64)), (storage.size() * 8) - total);
+
+        values.push_back(seed);
+        widths.push_back(width);
+        total += width;
+      }
+
+      etl::bit_stream bit_stream(storage.data(), storage.size());
+      size_t bit_index = 0;
+
+      for (size_t i = 0; i < values.size(); ++i)
+      {
+        CHECK(bit_stream.put(values[i], uint_least8_t(widths[i])));
+        reference_put(reference, bit_index, values[i], widths[i]);
+        CHECK_EQUAL(bit_index, bit_stream.bits());
+      }
+
+      CHECK(bit_stream.at_end());
+      CHECK(storage == reference);
+
+      bit_stream.restart();
+
+      for (size_t i = 0; i < values.size(); ++i)
+      {
+        uint64_t value;
+        uint64_t mask = (widths[i] == 64) ? ~uint64_t(0) : ((uint64_t(1) << widths[i]) - 1);
+
+        CHECK(bit_stream.get(value, uint_least8_t(widths[i])));
+        CHECK_EQUAL(values[i] & mask, value);
+      }
+
+      CHECK(bit_stream.at_end());
+    }
+
+    //*************************************************************************
+    TEST(put_get_array_matches_reference)
+    {
+      for (size_t width = 1; width <= 32; ++width)
+      {
+        const size_t COUNT = 37;
+
+        std::vector<unsigned char> storage(((3 + (COUNT * width)) + 7) / 8);
+        std::vector<unsigned char> reference(storage.size());
+
+        uint32_t values[COUNT];
+        uint32_t mask = (width == 32) ? 0xFFFFFFFFU : ((1U << width) - 1);
+
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+          values[i] = uint32_t(i * 2654435761U);
+        }
+
+        etl::bit_stream bit_stream(storage.data(), storage.size());
+        size_t bit_index = 0;
+
+        CHECK(bit_stream.put(uint8_t(5), 3));
+        reference_put(reference, bit_index, 5, 3);
+
+        CHECK(bit_stream.put_array(values, COUNT, uint_least8_t(width)));
+
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+          reference_put(reference, bit_index, values[i], width);
+        }
+
+        CHECK_EQUAL(bit_index, bit_stream.bits());
+        CHECK(storage == reference);
+
+        bit_stream.restart();
+
+        uint8_t  header;
+        uint32_t rvalues[COUNT];
+
+        CHECK(bit_stream.get(header, 3));
+        CHECK(bit_stream.get_array(rvalues, COUNT, uint_least8_t(width)));
+        CHECK_EQUAL(5, int(header));
+        CHECK_EQUAL(bit_index, bit_stream.bits());
+
+        for (size_t i = 0; i < COUNT; ++i)
+        {
+          CHECK_EQUAL(values[i] & mask, rvalues[i]);
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST(put_rewrite_field_after_restart)
+    {
+      // Patch a header in an already encoded frame; the payload must be kept.
+      std::array<unsigned char, 9> storage;
+
+      etl::bit_stream bit_stream(storage.data(), storage.size());
+
+      CHECK(bit_stream.put(uint8_t(0), 8));
+
+      for (uint8_t i = 0; i < 8; ++i)
+      {
+        CHECK(bit_stream.put(uint8_t(0xA0 + i), 8));
+      }
+
+      bit_stream.restart();
+      CHECK(bit_stream.put(uint8_t(8), 8));
+
+      CHECK_EQUAL(0x08, int(storage[0]));
+
+      for (size_t i = 0; i < 8; ++i)
+      {
+        CHECK_EQUAL(int(0xA0 + i), int(storage[i + 1]));
+      }
+
+      // A field that is not byte aligned keeps the bits of its last byte.
+      bit_stream.restart();
+      CHECK(bit_stream.put(uint8_t(0), 4));
+      CHECK(bit_stream.put(uint16_t(0x0123), 12));
+
+      CHECK_EQUAL(0x01, int(storage[0]));
+      CHECK_EQUAL(0x23, int(storage[1]));
+      CHECK_EQUAL(0xA1, int(storage[2]));
+      CHECK_EQUAL(0xA7, int(storage[8]));
+    }
+
+    //*************************************************************************
+    TEST(put_get_float_remaining)
+    {
+      std::array<unsigned char, 13> storage;
+
+      etl::bit_stream bit_stream(storage.data(), storage.size());
+
+      CHECK(bit_stream.put(uint8_t(1), 1));
+      CHECK(bit_stream.put(2.5f));
+      CHECK(bit_stream.put(-1.25));
+      CHECK_EQUAL(97U, bit_stream.bits());
+
+      // Big endian IEEE 754, one bit along.
+      CHECK_EQUAL(0xA0, int(storage[0])); // 1 0100000
+      CHECK_EQUAL(0x10, int(storage[1])); // 0 0010000
+
+      bit_stream.restart();
+
+      uint8_t b;
+      float   f;
+      double  d;
+
+      CHECK(bit_stream.get(b, 1));
+      CHECK(bit_stream.get(f));
+      CHECK(bit_stream.get(d));
+      CHECK_EQUAL(2.5f, f);
+      CHECK_EQUAL(-1.25, d);
+      CHECK_EQUAL(97U, bit_stream.bits());
+    }
+
     //*************************************************************************
     TEST(put_get_object_global)
     {
@@ -775,6 +775,51 @@ namespace
     }
 
 
+    //*************************************************************************
+    TEST(test_find_next_large)
+    {
+      std::bitset<1000> compare;
+      etl::bitset<1000> data;
+
+      // Sparse, with runs of empty and full elements.
+      for (size_t i = 0; i < data.size(); ++i)
+      {
+        bool state = ((i % 97) == 0) || ((i >= 300) && (i < 450)) || (i == 999);
+        compare.set(i, state);
+        data.set(i, state);
+      }
+
+      for (size_t start = 0; start <= data.size(); ++start)
+      {
+        for (int s = 0; s < 2; ++s)
+        {
+          const bool state = (s == 1);
+
+          size_t expected = etl::ibitset::npos;
+
+          for (size_t i = start; i < compare.size(); ++i)
+          {
+            if (compare.test(i) == state)
+            {
+              expected = i;
+              break;
+            }
+          }
+
+          CHECK_EQUAL(expected, data.find_next(state, start));
+        }
+      }
+
+      data.reset();
+      CHECK_EQUAL(etl::ibitset::npos, data.find_first(true));
+      CHECK_EQUAL(0U, data.find_first(false));
+
+      data.set();
+      CHECK_EQUAL(etl::ibitset::npos, data.find_first(false));
+      CHECK_EQUAL(999U, data.find_next(true, 999));
+      CHECK_EQUAL(etl::ibitset::npos, data.find_next(true, 1000));
+    }
+
     //*************************************************************************
     TEST(test_swap)
     {
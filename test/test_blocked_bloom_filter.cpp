@@ -0,0 +1,222 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <vector>
+#include <stdint.h>
+
+#include "etl/blocked_bloom_filter.h"
+
+#include "etl/fnv_1.h"
+#include "etl/char_traits.h"
+
+namespace
+{
+  struct text_hash_t
+  {
+    typedef const char* argument_type;
+
+    size_t operator ()(argument_type text) const
+    {
+      return etl::fnv_1a_32(text, text + etl::char_traits<char>::length(text));
+    }
+  };
+
+  // Deliberately weak, to check that the hash is mixed before use.
+  struct identity_hash_t
+  {
+    typedef uint32_t argument_type;
+
+    size_t operator ()(argument_type value) const
+    {
+      return value;
+    }
+  };
+
+  std::vector<const char*> exist_text     = { "The", "rain", "in", "Spain", "falls", "mainly", "on", "the", "plain" };
+  std::vector<const char*> not_exist_text = { "My", "hovercraft", "is", "full", "of", "eels" };
+
+  typedef etl::blocked_bloom_filter<1024, text_hash_t> Bloom;
+  typedef etl::blocked_bloom_filter<65536, identity_hash_t, 6> IntBloom;
+
+  SUITE(test_blocked_bloom_filter)
+  {
+    //*************************************************************************
+    TEST(test_width)
+    {
+      CHECK_EQUAL(2U, size_t(Bloom::NUMBER_OF_BLOCKS));
+      CHECK_EQUAL(1024U, size_t(Bloom::WIDTH));
+      CHECK_EQUAL(8U, size_t(Bloom::N_HASHES));
+
+      // Rounded up to whole blocks.
+      typedef etl::blocked_bloom_filter<600, text_hash_t> Bloom600;
+      Bloom600 bloom;
+      CHECK_EQUAL(1024U, bloom.width());
+    }
+
+    //*************************************************************************
+    TEST(test_add_exists)
+    {
+      Bloom bloom;
+
+      CHECK_EQUAL(0U, bloom.count());
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        bloom.add(exist_text[i]);
+      }
+
+      // No false negatives.
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        CHECK(bloom.exists(exist_text[i]));
+      }
+
+      // There should be no false positives for this set.
+      for (size_t i = 0; i < not_exist_text.size(); ++i)
+      {
+        CHECK(!bloom.exists(not_exist_text[i]));
+      }
+
+      // Every key sets up to N_HASHES bits.
+      CHECK(bloom.count() > 0U);
+      CHECK(bloom.count() <= (exist_text.size() * size_t(Bloom::N_HASHES)));
+      CHECK(bloom.usage() > 0U);
+      CHECK(bloom.usage() < 100U);
+    }
+
+    //*************************************************************************
+    TEST(test_one_hash)
+    {
+      etl::blocked_bloom_filter<512, text_hash_t, 1> bloom;
+
+      bloom.add("The");
+      CHECK_EQUAL(1U, bloom.count());
+      CHECK(bloom.exists("The"));
+    }
+
+    //*************************************************************************
+    TEST(test_clear)
+    {
+      Bloom bloom;
+
+      bloom.add(exist_text.begin(), exist_text.end());
+      CHECK(bloom.count() > 0U);
+
+      bloom.clear();
+      CHECK_EQUAL(0U, bloom.count());
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        CHECK(!bloom.exists(exist_text[i]));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_copy)
+    {
+      Bloom bloom1;
+      bloom1.add(exist_text.begin(), exist_text.end());
+
+      Bloom bloom2(bloom1);
+      Bloom bloom3;
+      bloom3 = bloom1;
+
+      CHECK_EQUAL(bloom1.count(), bloom2.count());
+      CHECK_EQUAL(bloom1.count(), bloom3.count());
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        CHECK(bloom2.exists(exist_text[i]));
+        CHECK(bloom3.exists(exist_text[i]));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_batch)
+    {
+      static IntBloom bloom;
+
+      std::vector<uint32_t> keys;
+
+      for (uint32_t i = 0; i < 1000; ++i)
+      {
+        keys.push_back(i * 7919U);
+      }
+
+      bloom.add(keys.begin(), keys.end());
+
+      // The batch results match the single key results, including a part batch.
+      std::vector<uint32_t> lookups;
+
+      for (uint32_t i = 0; i < 2003; ++i)
+      {
+        lookups.push_back(i * 3U);
+      }
+
+      std::vector<char> results(lookups.size() + 1, 2);
+      std::vector<char>::iterator end = bloom.exists(lookups.begin(), lookups.end(), results.begin());
+
+      CHECK(end == (results.begin() + lookups.size()));
+      CHECK_EQUAL(2, results.back());
+
+      for (size_t i = 0; i < lookups.size(); ++i)
+      {
+        CHECK_EQUAL(bloom.exists(lookups[i]), results[i] != 0);
+      }
+
+      for (size_t i = 0; i < keys.size(); ++i)
+      {
+        CHECK(bloom.exists(keys[i]));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_false_positive_rate)
+    {
+      // 8 bits per key with 6 hashes. The ideal rate is about 2.2%.
+      static IntBloom bloom;
+
+      for (uint32_t i = 0; i < 8192; ++i)
+      {
+        bloom.add(i);
+      }
+
+      size_t false_positives = 0;
+
+      for (uint32_t i = 8192; i < (8192 + 100000); ++i)
+      {
+        false_positives += bloom.exists(i) ? 1 : 0;
+      }
+
+      // Blocking costs a little accuracy, even with a sequential key set.
+      CHECK(false_positives < 4000U);
+    }
+  };
+}
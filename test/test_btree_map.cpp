@@ -0,0 +1,557 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <map>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <utility>
+#include <stdlib.h>
+
+#include "data.h"
+
+#include "etl/btree_map.h"
+
+namespace
+{
+  SUITE(test_btree_map)
+  {
+    static const size_t SIZE = 10;
+
+    typedef TestDataNDC<std::string> NDC;
+
+    typedef std::pair<std::string, NDC> ElementNDC;
+
+    typedef etl::btree_map<std::string, NDC, SIZE>  DataNDC;
+    typedef etl::ibtree_map<std::string, NDC>       IDataNDC;
+    typedef std::map<std::string, NDC>              Compare_DataNDC;
+
+    // Large enough for several levels of nodes.
+    static const size_t BIG = 2000;
+
+    typedef etl::btree_map<int, int, BIG>  DataInt;
+    typedef std::map<int, int>             Compare_DataInt;
+
+    //*************************************************************************
+    // A value large enough that each node holds the minimum of three,
+    // so that small maps are several levels deep.
+    //*************************************************************************
+    struct Large
+    {
+      Large(int value_ = 0)
+        : value(value_)
+      {
+      }
+
+      bool operator ==(const Large& other) const
+      {
+        return value == other.value;
+      }
+
+      int  value;
+      char padding[ETL_BTREE_NODE_SIZE / 2];
+    };
+
+    typedef etl::btree_map<int, Large, 200> DataLarge;
+
+    std::vector<ElementNDC> initial_data;
+    std::vector<ElementNDC> excess_data;
+    std::vector<ElementNDC> different_data;
+
+    //*************************************************************************
+    template <typename T1, typename T2>
+    bool Check_Equal(T1 begin1, T1 end1, T2 begin2)
+    {
+      while (begin1 != end1)
+      {
+        if ((begin1->first != begin2->first) || !(begin1->second == begin2->second))
+        {
+          return false;
+        }
+
+        ++begin1;
+        ++begin2;
+      }
+
+      return true;
+    }
+
+    //*************************************************************************
+    template <typename TData, typename TCompare>
+    bool Check_Same(const TData& data, const TCompare& compare)
+    {
+      return (data.size() == compare.size()) && Check_Equal(data.begin(), data.end(), compare.begin());
+    }
+
+    //*************************************************************************
+    struct SetupFixture
+    {
+      SetupFixture()
+      {
+        initial_data.clear();
+        excess_data.clear();
+        different_data.clear();
+
+        for (int i = 0; i < 10; ++i)
+        {
+          std::string key(1, char('A' + ((i * 7) % 10)));
+          initial_data.push_back(ElementNDC(key, NDC(key, i)));
+          excess_data.push_back(ElementNDC(key, NDC(key, i)));
+
+          std::string other(1, char('K' + i));
+          different_data.push_back(ElementNDC(other, NDC(other, i)));
+        }
+
+        excess_data.push_back(ElementNDC("Z", NDC("Z")));
+      }
+    };
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_default_constructor)
+    {
+      DataNDC data;
+
+      CHECK_EQUAL(0U, data.size());
+      CHECK(data.empty());
+      CHECK_EQUAL(SIZE, data.max_size());
+      CHECK_EQUAL(SIZE, data.capacity());
+      CHECK_EQUAL(SIZE, data.available());
+      CHECK(data.begin() == data.end());
+      CHECK(data.rbegin() == data.rend());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_constructor_range)
+    {
+      Compare_DataNDC compare(initial_data.begin(), initial_data.end());
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      CHECK(data.full());
+      CHECK(Check_Same(data, compare));
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+    //*************************************************************************
+    TEST(test_constructor_initializer_list)
+    {
+      DataInt data = { { 3, 30 }, { 1, 10 }, { 2, 20 } };
+
+      CHECK_EQUAL(3U, data.size());
+      CHECK_EQUAL(10, data[1]);
+      CHECK_EQUAL(20, data[2]);
+      CHECK_EQUAL(30, data[3]);
+    }
+#endif
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_destruct_via_ibtree_map)
+    {
+      int current_count = NDC::get_instance_count();
+
+      DataNDC* p = new DataNDC(initial_data.begin(), initial_data.end());
+      CHECK_EQUAL(int(current_count + initial_data.size()), NDC::get_instance_count());
+
+      IDataNDC* pi = p;
+      delete pi;
+
+      CHECK_EQUAL(current_count, NDC::get_instance_count());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_copy_constructor)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+      DataNDC other(data);
+
+      CHECK(data == other);
+
+      other.erase("A");
+      CHECK(data != other);
+      CHECK_EQUAL(SIZE, data.size());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_assignment)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+      DataNDC other(different_data.begin(), different_data.end());
+
+      other = data;
+      CHECK(data == other);
+
+      IDataNDC& idata  = data;
+      IDataNDC& iother = other;
+      iother.clear();
+      iother = idata;
+      CHECK(data == other);
+
+      other = other;
+      CHECK(data == other);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_index_and_at)
+    {
+      DataInt data;
+
+      data[2] = 20;
+      data[1] = 10;
+      data[2] = 21;
+
+      CHECK_EQUAL(2U, data.size());
+      CHECK_EQUAL(10, data.at(1));
+      CHECK_EQUAL(21, data.at(2));
+
+      const DataInt& cdata = data;
+      CHECK_EQUAL(21, cdata.at(2));
+
+      CHECK_THROW(data.at(3), etl::btree_map_out_of_bounds);
+      CHECK_THROW(cdata.at(3), etl::btree_map_out_of_bounds);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_value)
+    {
+      DataNDC data;
+      Compare_DataNDC compare;
+
+      for (size_t i = 0; i < initial_data.size(); ++i)
+      {
+        std::pair<DataNDC::iterator, bool> result = data.insert(initial_data[i]);
+        compare.insert(initial_data[i]);
+
+        CHECK(result.second);
+        CHECK_EQUAL(initial_data[i].first, result.first->first);
+        CHECK(Check_Same(data, compare));
+      }
+
+      // Already present.
+      std::pair<DataNDC::iterator, bool> result = data.insert(ElementNDC("A", NDC("X")));
+      CHECK(!result.second);
+      CHECK_EQUAL(std::string("A"), result.first->second.value);
+
+      CHECK_THROW(data.insert(ElementNDC("Z", NDC("Z"))), etl::btree_map_full);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_range_excess)
+    {
+      DataNDC data;
+
+      CHECK_THROW(data.insert(excess_data.begin(), excess_data.end()), etl::btree_map_full);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase_single)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+      Compare_DataNDC compare(initial_data.begin(), initial_data.end());
+
+      DataNDC::iterator itr = data.find("E");
+      DataNDC::iterator next = data.erase(itr);
+      compare.erase("E");
+
+      CHECK_EQUAL(std::string("F"), next->first);
+      CHECK(Check_Same(data, compare));
+
+      DataNDC::const_iterator citr = data.find("J");
+      next = data.erase(citr);
+      compare.erase("J");
+
+      CHECK(next == data.end());
+      CHECK(Check_Same(data, compare));
+
+      CHECK_EQUAL(1U, data.erase("A"));
+      CHECK_EQUAL(0U, data.erase("A"));
+      compare.erase("A");
+      CHECK(Check_Same(data, compare));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase_range)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+      Compare_DataNDC compare(initial_data.begin(), initial_data.end());
+
+      DataNDC::iterator next = data.erase(data.find("C"), data.find("H"));
+      compare.erase(compare.find("C"), compare.find("H"));
+
+      CHECK_EQUAL(std::string("H"), next->first);
+      CHECK(Check_Same(data, compare));
+
+      next = data.erase(data.begin(), data.end());
+      CHECK(next == data.end());
+      CHECK(data.empty());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_clear)
+    {
+      int current_count = NDC::get_instance_count();
+
+      DataNDC data(initial_data.begin(), initial_data.end());
+      data.clear();
+
+      CHECK(data.empty());
+      CHECK_EQUAL(current_count, NDC::get_instance_count());
+
+      // The nodes are available again.
+      data.assign(different_data.begin(), different_data.end());
+      CHECK(data.full());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_find_count_bounds)
+    {
+      DataInt data;
+      Compare_DataInt compare;
+
+      for (int i = 0; i < 1000; i += 2)
+      {
+        data[i]    = i;
+        compare[i] = i;
+      }
+
+      const DataInt& cdata = data;
+
+      for (int i = -1; i < 1002; ++i)
+      {
+        CHECK_EQUAL(compare.count(i), data.count(i));
+        CHECK_EQUAL((compare.find(i) == compare.end()), (data.find(i) == data.end()));
+        CHECK_EQUAL((compare.find(i) == compare.end()), (cdata.find(i) == cdata.end()));
+
+        CHECK_EQUAL(std::distance(compare.begin(), compare.lower_bound(i)), std::distance(data.begin(), data.lower_bound(i)));
+        CHECK_EQUAL(std::distance(compare.begin(), compare.upper_bound(i)), std::distance(data.begin(), data.upper_bound(i)));
+        CHECK_EQUAL(std::distance(compare.begin(), compare.lower_bound(i)), std::distance(cdata.begin(), cdata.lower_bound(i)));
+        CHECK_EQUAL(std::distance(compare.begin(), compare.upper_bound(i)), std::distance(cdata.begin(), cdata.upper_bound(i)));
+
+        std::pair<DataInt::iterator, DataInt::iterator> range = data.equal_range(i);
+        CHECK_EQUAL(compare.count(i), size_t(std::distance(range.first, range.second)));
+
+        std::pair<DataInt::const_iterator, DataInt::const_iterator> crange = cdata.equal_range(i);
+        CHECK(range.first == crange.first);
+      }
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_iterate_both_ways)
+    {
+      DataInt data;
+      Compare_DataInt compare;
+
+      for (int i = 0; i < int(BIG); ++i)
+      {
+        int key = (i * 7919) % int(BIG);
+        data[key]    = i;
+        compare[key] = i;
+      }
+
+      CHECK(Check_Same(data, compare));
+      CHECK(std::equal(data.rbegin(), data.rend(), compare.rbegin()));
+
+      const DataInt& cdata = data;
+      CHECK(std::equal(cdata.crbegin(), cdata.crend(), compare.rbegin()));
+
+      // Down from the end, and back up.
+      DataInt::iterator itr = data.end();
+      Compare_DataInt::iterator citr = compare.end();
+
+      while (itr != data.begin())
+      {
+        --itr;
+        --citr;
+        CHECK_EQUAL(citr->first, itr->first);
+      }
+
+      CHECK(citr == compare.begin());
+
+      DataInt::const_iterator first = cdata.cbegin();
+      DataInt::const_iterator next  = first++;
+      CHECK(next == cdata.begin());
+      CHECK(++next == first);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_random_insert_erase_compared_to_std_map)
+    {
+      DataInt data;
+      Compare_DataInt compare;
+
+      srand(1);
+
+      for (size_t round = 0; round < 20000; ++round)
+      {
+        int key = rand() % int(BIG * 2);
+
+        if ((rand() % 2 == 0) && (compare.size() < BIG))
+        {
+          std::pair<DataInt::iterator, bool> result = data.insert(DataInt::value_type(key, int(round)));
+          bool inserted = compare.insert(Compare_DataInt::value_type(key, int(round))).second;
+
+          CHECK_EQUAL(inserted, result.second);
+          CHECK_EQUAL(key, result.first->first);
+        }
+        else
+        {
+          DataInt::iterator itr = data.lower_bound(key);
+
+          if (itr != data.end())
+          {
+            Compare_DataInt::iterator citr = compare.erase(compare.lower_bound(key));
+            itr = data.erase(itr);
+
+            CHECK_EQUAL((citr == compare.end()), (itr == data.end()));
+
+            if (citr != compare.end())
+            {
+              CHECK_EQUAL(citr->first, itr->first);
+            }
+          }
+        }
+
+        if ((round % 1000) == 0)
+        {
+          CHECK(Check_Same(data, compare));
+        }
+      }
+
+      CHECK(Check_Same(data, compare));
+
+      // Empty it again in key order and out of order.
+      while (!compare.empty())
+      {
+        int key = compare.begin()->first;
+
+        if ((compare.size() % 2) == 0)
+        {
+          key = compare.rbegin()->first;
+        }
+
+        CHECK_EQUAL(1U, data.erase(key));
+        compare.erase(key);
+      }
+
+      CHECK(data.empty());
+      CHECK(data.begin() == data.end());
+
+      // All of the nodes have been returned.
+      for (int i = 0; i < int(BIG); ++i)
+      {
+        data[i] = i;
+      }
+
+      CHECK(data.full());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_deep_tree)
+    {
+      DataLarge data;
+      std::map<int, Large> compare;
+
+      // Ascending, descending and interleaved inserts split nodes at every position.
+      for (int i = 0; i < 50; ++i)
+      {
+        data.insert(DataLarge::value_type(i * 4, Large(i)));
+        data.insert(DataLarge::value_type(1000 - (i * 4), Large(i)));
+        data.insert(DataLarge::value_type((i * 4) + 2, Large(i)));
+        data.insert(DataLarge::value_type(1002 - (i * 4), Large(i)));
+        compare.insert(std::make_pair(i * 4, Large(i)));
+        compare.insert(std::make_pair(1000 - (i * 4), Large(i)));
+        compare.insert(std::make_pair((i * 4) + 2, Large(i)));
+        compare.insert(std::make_pair(1002 - (i * 4), Large(i)));
+      }
+
+      CHECK(Check_Same(data, compare));
+
+      // Erase every other element through the returned iterator.
+      DataLarge::iterator itr = data.begin();
+
+      while (itr != data.end())
+      {
+        compare.erase(itr->first);
+        itr = data.erase(itr);
+
+        if (itr != data.end())
+        {
+          ++itr;
+        }
+      }
+
+      CHECK(Check_Same(data, compare));
+
+      itr = data.erase(data.begin(), data.find(compare.rbegin()->first));
+      compare.erase(compare.begin(), --compare.end());
+
+      CHECK(Check_Same(data, compare));
+      CHECK_EQUAL(1U, data.size());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_compare_operators)
+    {
+      DataInt data1;
+      DataInt data2;
+
+      data1[1] = 1;
+      data1[2] = 2;
+      data2[1] = 1;
+      data2[2] = 2;
+
+      CHECK(data1 == data2);
+      CHECK(!(data1 < data2));
+      CHECK(data1 <= data2);
+      CHECK(data1 >= data2);
+
+      data2[3] = 3;
+
+      CHECK(data1 != data2);
+      CHECK(data1 < data2);
+      CHECK(data1 <= data2);
+      CHECK(data2 > data1);
+      CHECK(data2 >= data1);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_key_value_compare)
+    {
+      DataInt data;
+
+      DataInt::key_compare   kc = data.key_comp();
+      DataInt::value_compare vc = data.value_comp();
+
+      CHECK(kc(1, 2));
+      CHECK(!kc(2, 1));
+      CHECK(vc(DataInt::value_type(1, 9), DataInt::value_type(2, 0)));
+      CHECK(!vc(DataInt::value_type(2, 0), DataInt::value_type(1, 9)));
+    }
+  };
+}
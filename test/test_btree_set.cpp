@@ -0,0 +1,366 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <set>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <stdlib.h>
+
+#include "data.h"
+
+#include "etl/btree_set.h"
+
+namespace
+{
+  SUITE(test_btree_set)
+  {
+    static const size_t SIZE = 10;
+
+    typedef TestDataNDC<std::string> NDC;
+
+    typedef etl::btree_set<NDC, SIZE> DataNDC;
+    typedef etl::ibtree_set<NDC>      IDataNDC;
+    typedef std::set<NDC>             Compare_DataNDC;
+
+    // Large enough for several levels of nodes.
+    static const size_t BIG = 2000;
+
+    typedef etl::btree_set<int, BIG, std::greater<int> > DataInt;
+    typedef std::set<int, std::greater<int> >            Compare_DataInt;
+
+    std::vector<NDC> initial_data;
+    std::vector<NDC> excess_data;
+    std::vector<NDC> different_data;
+
+    //*************************************************************************
+    template <typename TData, typename TCompare>
+    bool Check_Same(const TData& data, const TCompare& compare)
+    {
+      return (data.size() == compare.size()) && std::equal(data.begin(), data.end(), compare.begin());
+    }
+
+    //*************************************************************************
+    struct SetupFixture
+    {
+      SetupFixture()
+      {
+        initial_data.clear();
+        excess_data.clear();
+        different_data.clear();
+
+        for (int i = 0; i < 10; ++i)
+        {
+          std::string key(1, char('A' + ((i * 7) % 10)));
+          initial_data.push_back(NDC(key, i));
+          excess_data.push_back(NDC(key, i));
+          different_data.push_back(NDC(std::string(1, char('K' + i)), i));
+        }
+
+        excess_data.push_back(NDC("Z"));
+      }
+    };
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_default_constructor)
+    {
+      DataNDC data;
+
+      CHECK_EQUAL(0U, data.size());
+      CHECK(data.empty());
+      CHECK_EQUAL(SIZE, data.max_size());
+      CHECK_EQUAL(SIZE, data.available());
+      CHECK(data.begin() == data.end());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_constructor_range)
+    {
+      Compare_DataNDC compare(initial_data.begin(), initial_data.end());
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      CHECK(data.full());
+      CHECK(Check_Same(data, compare));
+    }
+
+#if ETL_CPP11_SUPPORTED && !defined(ETL_STLPORT) && !defined(ETL_NO_STL)
+    //*************************************************************************
+    TEST(test_constructor_initializer_list)
+    {
+      DataInt data = { 2, 3, 1, 2 };
+
+      CHECK_EQUAL(3U, data.size());
+      CHECK_EQUAL(3, *data.begin());
+      CHECK_EQUAL(1, *data.rbegin());
+    }
+#endif
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_destruct_via_ibtree_set)
+    {
+      int current_count = NDC::get_instance_count();
+
+      DataNDC* p = new DataNDC(initial_data.begin(), initial_data.end());
+      CHECK_EQUAL(int(current_count + initial_data.size()), NDC::get_instance_count());
+
+      IDataNDC* pi = p;
+      delete pi;
+
+      CHECK_EQUAL(current_count, NDC::get_instance_count());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_copy_and_assignment)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+      DataNDC copy(data);
+
+      CHECK(data == copy);
+
+      DataNDC other(different_data.begin(), different_data.end());
+      CHECK(data != other);
+
+      other = data;
+      CHECK(data == other);
+
+      IDataNDC& iother = other;
+      iother.clear();
+      iother = data;
+      CHECK(data == other);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_value)
+    {
+      DataNDC data;
+      Compare_DataNDC compare;
+
+      for (size_t i = 0; i < initial_data.size(); ++i)
+      {
+        std::pair<DataNDC::iterator, bool> result = data.insert(initial_data[i]);
+        compare.insert(initial_data[i]);
+
+        CHECK(result.second);
+        CHECK(*result.first == initial_data[i]);
+        CHECK(Check_Same(data, compare));
+      }
+
+      // Already present.
+      std::pair<DataNDC::iterator, bool> result = data.insert(NDC("A", 99));
+      CHECK(!result.second);
+      CHECK_EQUAL(0, result.first->index);
+
+      CHECK_THROW(data.insert(NDC("Z")), etl::btree_set_full);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_range_excess)
+    {
+      DataNDC data;
+
+      CHECK_THROW(data.insert(excess_data.begin(), excess_data.end()), etl::btree_set_full);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_erase)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+      Compare_DataNDC compare(initial_data.begin(), initial_data.end());
+
+      DataNDC::iterator next = data.erase(data.find(NDC("E")));
+      compare.erase(NDC("E"));
+
+      CHECK(*next == NDC("F"));
+      CHECK(Check_Same(data, compare));
+
+      CHECK_EQUAL(1U, data.erase(NDC("A")));
+      CHECK_EQUAL(0U, data.erase(NDC("A")));
+      compare.erase(NDC("A"));
+      CHECK(Check_Same(data, compare));
+
+      next = data.erase(data.find(NDC("C")), data.find(NDC("H")));
+      compare.erase(compare.find(NDC("C")), compare.find(NDC("H")));
+
+      CHECK(*next == NDC("H"));
+      CHECK(Check_Same(data, compare));
+
+      data.erase(data.cbegin(), data.cend());
+      CHECK(data.empty());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_clear)
+    {
+      int current_count = NDC::get_instance_count();
+
+      DataNDC data(initial_data.begin(), initial_data.end());
+      data.clear();
+
+      CHECK(data.empty());
+      CHECK_EQUAL(current_count, NDC::get_instance_count());
+
+      data.assign(different_data.begin(), different_data.end());
+      CHECK(data.full());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_find_count_bounds)
+    {
+      DataInt data;
+      Compare_DataInt compare;
+
+      for (int i = 0; i < 1000; i += 2)
+      {
+        data.insert(i);
+        compare.insert(i);
+      }
+
+      const DataInt& cdata = data;
+
+      for (int i = -1; i < 1002; ++i)
+      {
+        CHECK_EQUAL(compare.count(i), data.count(i));
+        CHECK_EQUAL((compare.find(i) == compare.end()), (data.find(i) == data.end()));
+
+        CHECK_EQUAL(std::distance(compare.begin(), compare.lower_bound(i)), std::distance(data.begin(), data.lower_bound(i)));
+        CHECK_EQUAL(std::distance(compare.begin(), compare.upper_bound(i)), std::distance(data.begin(), data.upper_bound(i)));
+        CHECK_EQUAL(std::distance(compare.begin(), compare.lower_bound(i)), std::distance(cdata.begin(), cdata.lower_bound(i)));
+        CHECK_EQUAL(std::distance(compare.begin(), compare.upper_bound(i)), std::distance(cdata.begin(), cdata.upper_bound(i)));
+
+        std::pair<DataInt::const_iterator, DataInt::const_iterator> range = cdata.equal_range(i);
+        CHECK_EQUAL(compare.count(i), size_t(std::distance(range.first, range.second)));
+      }
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_random_insert_erase_compared_to_std_set)
+    {
+      DataInt data;
+      Compare_DataInt compare;
+
+      srand(2);
+
+      for (size_t round = 0; round < 20000; ++round)
+      {
+        int key = rand() % int(BIG * 2);
+
+        if ((rand() % 2 == 0) && (compare.size() < BIG))
+        {
+          std::pair<DataInt::iterator, bool> result = data.insert(key);
+
+          CHECK_EQUAL(compare.insert(key).second, result.second);
+          CHECK_EQUAL(key, *result.first);
+        }
+        else
+        {
+          DataInt::iterator itr = data.lower_bound(key);
+
+          if (itr != data.end())
+          {
+            Compare_DataInt::iterator citr = compare.erase(compare.lower_bound(key));
+            itr = data.erase(itr);
+
+            CHECK_EQUAL((citr == compare.end()), (itr == data.end()));
+
+            if (citr != compare.end())
+            {
+              CHECK_EQUAL(*citr, *itr);
+            }
+          }
+        }
+
+        if ((round % 1000) == 0)
+        {
+          CHECK(Check_Same(data, compare));
+          CHECK(std::equal(data.rbegin(), data.rend(), compare.rbegin()));
+        }
+      }
+
+      CHECK(Check_Same(data, compare));
+
+      while (!compare.empty())
+      {
+        int key = ((compare.size() % 2) == 0) ? *compare.rbegin() : *compare.begin();
+
+        CHECK_EQUAL(1U, data.erase(key));
+        compare.erase(key);
+      }
+
+      CHECK(data.empty());
+
+      for (int i = 0; i < int(BIG); ++i)
+      {
+        data.insert(i);
+      }
+
+      CHECK(data.full());
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_compare_operators)
+    {
+      DataInt data1;
+      DataInt data2;
+
+      data1.insert(1);
+      data1.insert(2);
+      data2.insert(1);
+      data2.insert(2);
+
+      CHECK(data1 == data2);
+      CHECK(data1 <= data2);
+      CHECK(data1 >= data2);
+
+      data2.insert(3);
+
+      CHECK(data1 != data2);
+      CHECK(data1 < data2);
+      CHECK(data1 <= data2);
+      CHECK(data2 > data1);
+      CHECK(data2 >= data1);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_key_value_compare)
+    {
+      DataInt data;
+
+      DataInt::key_compare   kc = data.key_comp();
+      DataInt::value_compare vc = data.value_comp();
+
+      CHECK(kc(2, 1));
+      CHECK(!kc(1, 2));
+      CHECK(vc(2, 1));
+      CHECK(!vc(1, 2));
+    }
+  };
+}
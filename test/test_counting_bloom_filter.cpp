@@ -0,0 +1,229 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <vector>
+#include <stdint.h>
+
+#include "etl/counting_bloom_filter.h"
+
+#include "etl/fnv_1.h"
+#include "etl/char_traits.h"
+
+namespace
+{
+  struct text_hash_t
+  {
+    typedef const char* argument_type;
+
+    size_t operator ()(argument_type text) const
+    {
+      return etl::fnv_1a_32(text, text + etl::char_traits<char>::length(text));
+    }
+  };
+
+  struct identity_hash_t
+  {
+    typedef uint32_t argument_type;
+
+    size_t operator ()(argument_type value) const
+    {
+      return value;
+    }
+  };
+
+  std::vector<const char*> exist_text     = { "The", "rain", "in", "Spain", "falls", "mainly", "on", "the", "plain" };
+  std::vector<const char*> not_exist_text = { "My", "hovercraft", "is", "full", "of", "eels" };
+
+  typedef etl::counting_bloom_filter<512, text_hash_t> Bloom;
+
+  SUITE(test_counting_bloom_filter)
+  {
+    //*************************************************************************
+    TEST(test_width)
+    {
+      CHECK_EQUAL(4U, size_t(Bloom::NUMBER_OF_BLOCKS));
+      CHECK_EQUAL(512U, size_t(Bloom::WIDTH));
+      CHECK_EQUAL(4U, size_t(Bloom::N_HASHES));
+
+      etl::counting_bloom_filter<130, text_hash_t> bloom;
+      CHECK_EQUAL(256U, bloom.width());
+    }
+
+    //*************************************************************************
+    TEST(test_add_exists)
+    {
+      Bloom bloom;
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        bloom.add(exist_text[i]);
+      }
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        CHECK(bloom.exists(exist_text[i]));
+      }
+
+      for (size_t i = 0; i < not_exist_text.size(); ++i)
+      {
+        CHECK(!bloom.exists(not_exist_text[i]));
+      }
+
+      CHECK(bloom.count() > 0U);
+      CHECK(bloom.count() <= (exist_text.size() * size_t(Bloom::N_HASHES)));
+      CHECK(bloom.usage() < 100U);
+    }
+
+    //*************************************************************************
+    TEST(test_remove)
+    {
+      Bloom bloom;
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        bloom.add(exist_text[i]);
+      }
+
+      CHECK(!bloom.remove("hovercraft"));
+
+      // Remove every other key. The rest must still be found.
+      for (size_t i = 0; i < exist_text.size(); i += 2)
+      {
+        CHECK(bloom.remove(exist_text[i]));
+      }
+
+      for (size_t i = 1; i < exist_text.size(); i += 2)
+      {
+        CHECK(bloom.exists(exist_text[i]));
+      }
+
+      for (size_t i = 1; i < exist_text.size(); i += 2)
+      {
+        CHECK(bloom.remove(exist_text[i]));
+      }
+
+      CHECK_EQUAL(0U, bloom.count());
+    }
+
+    //*************************************************************************
+    TEST(test_add_twice)
+    {
+      Bloom bloom;
+
+      bloom.add("rain");
+      bloom.add("rain");
+
+      CHECK(bloom.remove("rain"));
+      CHECK(bloom.exists("rain"));
+      CHECK(bloom.remove("rain"));
+      CHECK(!bloom.exists("rain"));
+    }
+
+    //*************************************************************************
+    TEST(test_saturation)
+    {
+      etl::counting_bloom_filter<128, identity_hash_t, 1> bloom;
+
+      // Saturate the counter.
+      for (size_t i = 0; i < 20; ++i)
+      {
+        bloom.add(1);
+      }
+
+      CHECK_EQUAL(1U, bloom.count());
+
+      // A saturated counter is never decremented.
+      for (size_t i = 0; i < 20; ++i)
+      {
+        CHECK(bloom.remove(1));
+      }
+
+      CHECK(bloom.exists(1));
+    }
+
+    //*************************************************************************
+    TEST(test_sliding_window)
+    {
+      // Keys leave the window as new ones arrive, so the filter never needs clearing.
+      static etl::counting_bloom_filter<8192, identity_hash_t> bloom;
+      const uint32_t WINDOW = 1000;
+
+      size_t false_negatives = 0;
+
+      for (uint32_t i = 0; i < 20000; ++i)
+      {
+        bloom.add(i);
+
+        if (i >= WINDOW)
+        {
+          bloom.remove(i - WINDOW);
+        }
+
+        false_negatives += bloom.exists(i - (i % WINDOW) / 2) ? 0 : 1;
+      }
+
+      CHECK_EQUAL(0U, false_negatives);
+
+      size_t false_positives = 0;
+
+      for (uint32_t i = 100000; i < 110000; ++i)
+      {
+        false_positives += bloom.exists(i) ? 1 : 0;
+      }
+
+      CHECK(false_positives < 500U);
+    }
+
+    //*************************************************************************
+    TEST(test_copy_and_clear)
+    {
+      Bloom bloom1;
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        bloom1.add(exist_text[i]);
+      }
+
+      Bloom bloom2(bloom1);
+      Bloom bloom3;
+      bloom3 = bloom1;
+
+      bloom1.clear();
+      CHECK_EQUAL(0U, bloom1.count());
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        CHECK(!bloom1.exists(exist_text[i]));
+        CHECK(bloom2.exists(exist_text[i]));
+        CHECK(bloom3.exists(exist_text[i]));
+      }
+    }
+  };
+}
@@ -39,10 +39,63 @@ SOFTWARE.
 #include "etl/crc16_kermit.h"
 #include "etl/crc16_modbus.h"
 #include "etl/crc32.h"
+#include "etl/crc32_c.h"
 #include "etl/crc64_ecma.h"
 
 namespace
 {
+  //***************************************************************************
+  // Pseudo random test data.
+  //***************************************************************************
+  std::vector<uint8_t> make_data(size_t length)
+  {
+    std::vector<uint8_t> data(length);
+    uint32_t seed = 0x12345678;
+
+    for (size_t i = 0; i < length; ++i)
+    {
+      seed = (seed * 1103515245) + 12345;
+      data[i] = uint8_t(seed >> 16);
+    }
+
+    return data;
+  }
+
+  //***************************************************************************
+  // Checks that the block path gives the same result as the byte-wise path
+  // for every length up to 'max_length' and every alignment.
+  //***************************************************************************
+  template <typename TCrc>
+  bool block_matches_bytewise(size_t max_length)
+  {
+    std::vector<uint8_t> data = make_data(max_length + 8);
+
+    for (size_t offset = 0; offset < 8; ++offset)
+    {
+      for (size_t length = 0; length <= max_length; ++length)
+      {
+        const uint8_t* p = &data[offset];
+
+        TCrc bytewise;
+
+        for (size_t i = 0; i < length; ++i)
+        {
+          bytewise.add(p[i]);
+        }
+
+        TCrc block;
+        block.add(p, length);
+
+        if (bytewise.value() != block.value())
+        {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
   SUITE(test_crc)
   {
     //*************************************************************************
@@ -382,6 +435,80 @@ namespace
       CHECK_EQUAL(crc1, crc3);
     }
 
+    //*************************************************************************
+    TEST(test_crc32_add_block)
+    {
+      std::string data("123456789");
+
+      etl::crc32 crc_calculator;
+
+      crc_calculator.add(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+
+      uint32_t crc = crc_calculator.value();
+
+      CHECK_EQUAL(0xCBF43926, crc);
+    }
+
+    //*************************************************************************
+    TEST(test_crc32_add_block_matches_bytewise)
+    {
+      CHECK(block_matches_bytewise<etl::crc32>(300));
+    }
+
+    //*************************************************************************
+    TEST(test_crc32_add_block_in_pieces)
+    {
+      std::vector<uint8_t> data = make_data(10000);
+
+      uint32_t crc1 = etl::crc32(data.begin(), data.end());
+
+      etl::crc32 crc_calculator;
+      crc_calculator.add(&data[0], 3);
+      crc_calculator.add(&data[3], 1000);
+      crc_calculator.add(&data[1003], data.size() - 1003);
+
+      uint32_t crc2 = crc_calculator.value();
+
+      CHECK_EQUAL(crc1, crc2);
+    }
+
+    //*************************************************************************
+    TEST(test_crc32_c)
+    {
+      std::string data("123456789");
+
+      uint32_t crc = etl::crc32_c(data.begin(), data.end());
+
+      CHECK_EQUAL(0xE3069283, crc);
+    }
+
+    //*************************************************************************
+    TEST(test_crc32_c_add_block)
+    {
+      std::string data("123456789");
+
+      etl::crc32_c crc_calculator;
+
+      crc_calculator.add(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+
+      uint32_t crc = crc_calculator.value();
+
+      CHECK_EQUAL(0xE3069283, crc);
+    }
+
+    //*************************************************************************
+    TEST(test_crc32_c_add_block_matches_bytewise)
+    {
+      CHECK(block_matches_bytewise<etl::crc32_c>(300));
+    }
+
+    //*************************************************************************
+    TEST(test_crc16_add_block)
+    {
+      // No block algorithm, so the bytes are added one at a time.
+      CHECK(block_matches_bytewise<etl::crc16>(100));
+    }
+
     //*************************************************************************
     TEST(test_crc64_ecma)
     {
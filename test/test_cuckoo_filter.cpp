@@ -0,0 +1,235 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <vector>
+#include <stdint.h>
+
+#include "etl/cuckoo_filter.h"
+
+#include "etl/fnv_1.h"
+#include "etl/char_traits.h"
+
+namespace
+{
+  struct text_hash_t
+  {
+    typedef const char* argument_type;
+
+    size_t operator ()(argument_type text) const
+    {
+      return etl::fnv_1a_32(text, text + etl::char_traits<char>::length(text));
+    }
+  };
+
+  struct identity_hash_t
+  {
+    typedef uint32_t argument_type;
+
+    size_t operator ()(argument_type value) const
+    {
+      return value;
+    }
+  };
+
+  std::vector<const char*> exist_text     = { "The", "rain", "in", "Spain", "falls", "mainly", "on", "the", "plain" };
+  std::vector<const char*> not_exist_text = { "My", "hovercraft", "is", "full", "of", "eels" };
+
+  typedef etl::cuckoo_filter<64, text_hash_t> Filter;
+
+  SUITE(test_cuckoo_filter)
+  {
+    //*************************************************************************
+    TEST(test_capacity)
+    {
+      CHECK_EQUAL(16U, size_t(Filter::NUMBER_OF_BUCKETS));
+      CHECK_EQUAL(64U, size_t(Filter::CAPACITY));
+
+      // Rounded up to a power of two number of buckets.
+      etl::cuckoo_filter<100, text_hash_t> filter;
+      CHECK_EQUAL(128U, filter.capacity());
+      CHECK(filter.empty());
+      CHECK(!filter.full());
+    }
+
+    //*************************************************************************
+    TEST(test_add_exists)
+    {
+      Filter filter;
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        CHECK(filter.add(exist_text[i]));
+      }
+
+      CHECK_EQUAL(exist_text.size(), filter.size());
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        CHECK(filter.exists(exist_text[i]));
+      }
+
+      for (size_t i = 0; i < not_exist_text.size(); ++i)
+      {
+        CHECK(!filter.exists(not_exist_text[i]));
+      }
+
+      CHECK_EQUAL((100U * exist_text.size()) / 64U, filter.usage());
+    }
+
+    //*************************************************************************
+    TEST(test_remove)
+    {
+      Filter filter;
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        filter.add(exist_text[i]);
+      }
+
+      CHECK(!filter.remove("hovercraft"));
+
+      for (size_t i = 0; i < exist_text.size(); i += 2)
+      {
+        CHECK(filter.remove(exist_text[i]));
+        CHECK(!filter.exists(exist_text[i]));
+      }
+
+      for (size_t i = 1; i < exist_text.size(); i += 2)
+      {
+        CHECK(filter.exists(exist_text[i]));
+      }
+
+      CHECK_EQUAL(exist_text.size() / 2, filter.size());
+    }
+
+    //*************************************************************************
+    TEST(test_add_twice)
+    {
+      Filter filter;
+
+      filter.add("rain");
+      filter.add("rain");
+      CHECK_EQUAL(2U, filter.size());
+
+      CHECK(filter.remove("rain"));
+      CHECK(filter.exists("rain"));
+      CHECK(filter.remove("rain"));
+      CHECK(!filter.exists("rain"));
+      CHECK(filter.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_fill)
+    {
+      static etl::cuckoo_filter<4096, identity_hash_t> filter;
+
+      uint32_t added = 0;
+
+      while (filter.add(added))
+      {
+        ++added;
+      }
+
+      // Four slot buckets fill to about 95% before an add fails.
+      CHECK(filter.full());
+      CHECK(added > ((4096U * 90U) / 100U));
+      CHECK_EQUAL(size_t(added), filter.size());
+
+      // No false negatives, including the victim.
+      for (uint32_t i = 0; i < added; ++i)
+      {
+        CHECK(filter.exists(i));
+      }
+
+      // Removing makes space for the victim.
+      CHECK(filter.remove(0));
+      CHECK(!filter.full());
+      CHECK(filter.add(added));
+
+      for (uint32_t i = 1; i <= added; ++i)
+      {
+        CHECK(filter.exists(i));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_sliding_window)
+    {
+      static etl::cuckoo_filter<2048, identity_hash_t> filter;
+      const uint32_t WINDOW = 1500;
+
+      size_t false_negatives = 0;
+
+      for (uint32_t i = 0; i < 50000; ++i)
+      {
+        CHECK(filter.add(i));
+
+        if (i >= WINDOW)
+        {
+          filter.remove(i - WINDOW);
+        }
+
+        false_negatives += filter.exists(i - (i % WINDOW) / 2) ? 0 : 1;
+      }
+
+      CHECK_EQUAL(0U, false_negatives);
+      CHECK_EQUAL(size_t(WINDOW), filter.size());
+
+      size_t false_positives = 0;
+
+      for (uint32_t i = 100000; i < 200000; ++i)
+      {
+        false_positives += filter.exists(i) ? 1 : 0;
+      }
+
+      // About 2 x 4 x 75% / 65536 with 16 bit fingerprints.
+      CHECK(false_positives < 50U);
+    }
+
+    //*************************************************************************
+    TEST(test_clear)
+    {
+      Filter filter;
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        filter.add(exist_text[i]);
+      }
+
+      filter.clear();
+      CHECK(filter.empty());
+
+      for (size_t i = 0; i < exist_text.size(); ++i)
+      {
+        CHECK(!filter.exists(exist_text[i]));
+      }
+    }
+  };
+}
@@ -41,6 +41,51 @@ SOFTWARE.
 #include <cstring>
 #include <memory>
 
+namespace
+{
+  //***************************************************************************
+  // A type with a user defined copy constructor that may be moved with memmove.
+  //***************************************************************************
+  struct Relocatable
+  {
+    Relocatable(int value_ = 0)
+      : value(value_)
+    {
+    }
+
+    Relocatable(const Relocatable& other)
+      : value(other.value)
+    {
+      ++copies;
+    }
+
+    Relocatable& operator =(const Relocatable& other)
+    {
+      value = other.value;
+      ++copies;
+      return *this;
+    }
+
+    bool operator ==(const Relocatable& other) const
+    {
+      return value == other.value;
+    }
+
+    int value;
+    static int copies;
+  };
+
+  int Relocatable::copies = 0;
+}
+
+namespace etl
+{
+  template <>
+  struct is_trivially_relocatable<Relocatable> : etl::true_type
+  {
+  };
+}
+
 namespace
 {
   SUITE(test_deque)
@@ -1704,6 +1749,116 @@ namespace
        CHECK(data.crbegin() == data.crend());
      }
 
+    //*************************************************************************
+    TEST(test_data_segments)
+    {
+      DataInt data;
+
+      CHECK(data.data_segments().first.empty());
+      CHECK(data.data_segments().second.empty());
+
+      data.assign(int_data1.begin(), int_data1.begin() + 10);
+
+      IDataInt::segments segments = data.data_segments();
+      CHECK_EQUAL(10U, segments.first.size());
+      CHECK_EQUAL(0U, segments.second.size());
+      CHECK_ARRAY_EQUAL(int_data1.data(), segments.first.data(), 10);
+
+      // Move the start near the end of the buffer, so that the elements wrap.
+      for (size_t i = 0; i < 12; ++i)
+      {
+        data.pop_front();
+        data.push_back(int(100 + i));
+      }
+
+      std::vector<int> compare(data.begin(), data.end());
+      std::vector<int> joined;
+
+      const DataInt& cdata = data;
+      IDataInt::const_segments csegments = cdata.data_segments();
+
+      CHECK(!csegments.first.empty());
+      CHECK(!csegments.second.empty());
+      CHECK_EQUAL(data.size(), csegments.first.size() + csegments.second.size());
+      CHECK(&data.front() == csegments.first.data());
+      CHECK(&data.back() == (csegments.second.end() - 1));
+
+      joined.insert(joined.end(), csegments.first.begin(), csegments.first.end());
+      joined.insert(joined.end(), csegments.second.begin(), csegments.second.end());
+      CHECK(compare == joined);
+
+      // Writable through the segments.
+      segments = data.data_segments();
+      *segments.second.begin() = 999;
+      CHECK_EQUAL(999, data[segments.first.size()]);
+    }
+
+    //*************************************************************************
+    TEST(test_assign_and_insert_range_wrapped_trivial)
+    {
+      DataInt data;
+
+      // Move the start near the end of the buffer.
+      data.assign(int_data1.begin(), int_data1.end());
+
+      for (size_t i = 0; i < 11; ++i)
+      {
+        data.pop_front();
+      }
+
+      // Inserts at the end wrap around the buffer.
+      data.insert(data.end(), int_data2.data(), int_data2.data() + int_data2.size());
+      data.insert(data.end(), int_data1.data(), int_data1.data() + 4);
+
+      std::vector<int> compare = { 11, 12, 13, 15, 16, 17, 18, 0, 1, 2, 3 };
+      CHECK_EQUAL(compare.size(), data.size());
+      CHECK(std::equal(compare.begin(), compare.end(), data.begin()));
+
+      // Copy a wrapped deque.
+      DataInt data2(data);
+      CHECK_EQUAL(compare.size(), data2.size());
+      CHECK(std::equal(compare.begin(), compare.end(), data2.begin()));
+
+      DataInt data3;
+      data3.push_back(42);
+      IDataInt& idata3 = data3;
+      idata3 = data;
+      CHECK_EQUAL(compare.size(), data3.size());
+      CHECK(std::equal(compare.begin(), compare.end(), data3.begin()));
+
+      // Assign from an array.
+      data.assign(int_data1.data(), int_data1.data() + int_data1.size());
+      CHECK_EQUAL(int_data1.size(), data.size());
+      CHECK(std::equal(int_data1.begin(), int_data1.end(), data.begin()));
+
+      CHECK_THROW(data.assign(int_data1.data(), int_data1.data() + SIZE + 1), etl::deque_full);
+    }
+
+    //*************************************************************************
+    TEST(test_assign_wrapped_non_trivial)
+    {
+      DataNDC data(initial_data.begin(), initial_data.end());
+
+      for (size_t i = 0; i < 10; ++i)
+      {
+        data.pop_front();
+        data.push_back(initial_data[i]);
+      }
+
+      Compare_Data compare(data.begin(), data.end());
+
+      DataNDC data2(data);
+      CHECK(std::equal(compare.begin(), compare.end(), data2.begin()));
+
+      DataNDC data3;
+      data3 = data;
+      CHECK(std::equal(compare.begin(), compare.end(), data3.begin()));
+
+      data3.assign(&initial_data[0], &initial_data[0] + 5);
+      CHECK(std::equal(initial_data.begin(), initial_data.begin() + 5, data3.begin()));
+      CHECK_EQUAL(5U, data3.size());
+    }
+
     //*************************************************************************
     TEST(test_memcpy_repair)
     {
@@ -1840,5 +1995,56 @@ namespace
       CHECK(data2.empty());
       CHECK_EQUAL(ACTUAL_SIZE, data3.size());
     }
+
+    //*************************************************************************
+    TEST(test_relocatable_insert_erase)
+    {
+      // Every start position, so that the shifted elements wrap around the buffer.
+      for (int start = 0; start < 10; ++start)
+      {
+        for (size_t offset = 0; offset <= 8; ++offset)
+        {
+          etl::deque<Relocatable, 10> data;
+          std::deque<Relocatable> compare_data;
+
+          for (int i = 0; i < start; ++i)
+          {
+            data.push_back(Relocatable());
+            data.pop_front();
+          }
+
+          for (int i = 0; i < 8; ++i)
+          {
+            data.push_back(Relocatable(i));
+            compare_data.push_back(Relocatable(i));
+          }
+
+          // Only the inserted value is copied.
+          Relocatable::copies = 0;
+          data.insert(data.begin() + offset, Relocatable(100));
+          CHECK_EQUAL(1, Relocatable::copies);
+          compare_data.insert(compare_data.begin() + offset, Relocatable(100));
+          CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+
+          data.insert(data.begin() + offset, data[(offset + 5) % data.size()]);
+          compare_data.insert(compare_data.begin() + offset, compare_data[(offset + 5) % compare_data.size()]);
+          CHECK_EQUAL(compare_data.size(), data.size());
+          CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+
+          // Erasing copies nothing.
+          Relocatable::copies = 0;
+          data.erase(data.begin() + offset);
+          CHECK_EQUAL(0, Relocatable::copies);
+          compare_data.erase(compare_data.begin() + offset);
+          CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+
+          size_t last = std::min(offset + 3, data.size());
+          data.erase(data.begin() + offset, data.begin() + last);
+          compare_data.erase(compare_data.begin() + offset, compare_data.begin() + last);
+          CHECK_EQUAL(compare_data.size(), data.size());
+          CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+        }
+      }
+    }
   };
 }
@@ -511,6 +511,91 @@ namespace
       CHECK(std::is_sorted(data.begin(), data.end()));
     }
 
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_assign_sorted)
+    {
+      Compare_DataNDC compare_data(initial_data.begin(), initial_data.end());
+      DataNDC data(different_data.begin(), different_data.end());
+
+      data.assign_sorted(compare_data.begin(), compare_data.end());
+
+      CHECK_EQUAL(compare_data.size(), data.size());
+
+      bool isEqual = std::equal(data.begin(),
+                                data.end(),
+                                compare_data.begin());
+
+      CHECK(isEqual);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_sorted)
+    {
+      Compare_DataNDC compare_data(initial_data.begin(), initial_data.end());
+      std::vector<NDC> sorted(compare_data.begin(), compare_data.end());
+
+      // Every other element, then all of them twice.
+      DataNDC data;
+      Compare_DataNDC expected;
+      std::vector<NDC> more;
+
+      for (size_t i = 0; i < sorted.size(); ++i)
+      {
+        if ((i % 2) == 0)
+        {
+          data.insert(sorted[i]);
+          expected.insert(sorted[i]);
+        }
+
+        // All of them, in pairs. The ones already present are ignored.
+        more.push_back(sorted[i]);
+        more.push_back(sorted[i]);
+      }
+
+      data.insert_sorted(more.begin(), more.end());
+      expected.insert(more.begin(), more.end());
+
+      CHECK_EQUAL(expected.size(), data.size());
+
+      bool isEqual = std::equal(data.begin(),
+                                data.end(),
+                                expected.begin());
+
+      CHECK(isEqual);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_sorted_excess)
+    {
+      Compare_DataNDC compare_data(excess_data.begin(), excess_data.end());
+      DataNDC data;
+
+      CHECK_THROW(data.insert_sorted(compare_data.begin(), compare_data.end()), etl::flat_set_full);
+
+      // As many as fit.
+      CHECK(data.full());
+
+      bool isEqual = std::equal(data.begin(),
+                                data.end(),
+                                compare_data.begin());
+
+      CHECK(isEqual);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_sorted_not_sorted)
+    {
+      Compare_DataNDC compare_data(initial_data.begin(), initial_data.end());
+      std::vector<NDC> unsorted(compare_data.begin(), compare_data.end());
+      std::swap(unsorted.front(), unsorted.back());
+
+      DataNDC data;
+
+      CHECK_THROW(data.insert_sorted(unsorted.begin(), unsorted.end()), etl::flat_set_iterator);
+      CHECK(data.empty());
+    }
+
     //*************************************************************************
     TEST_FIXTURE(SetupFixture, test_insert_range_excess)
     {
@@ -955,6 +955,51 @@ namespace
       CHECK(are_equal);
     }
 
+    //*************************************************************************
+    TEST(test_sort_natural_runs)
+    {
+      // Ascending, descending, descending with equal keys, nearly ordered and random.
+      const int N = 64;
+
+      for (int pattern = 0; pattern < 5; ++pattern)
+      {
+        std::vector<ItemNDC> initial;
+        unsigned random = 1;
+
+        for (int i = 0; i < N; ++i)
+        {
+          int key;
+
+          switch (pattern)
+          {
+            case 0:  key = i;                             break;
+            case 1:  key = N - i;                         break;
+            case 2:  key = (N - i) / 3;                   break;
+            case 3:  key = ((i % 16) == 0) ? (N - i) : i; break;
+            default: random = (random * 1103515245U) + 12345U; key = (random >> 16) % 10; break;
+          }
+
+          const char text[] = { char('0' + (key / 10)), char('0' + (key % 10)), 0 };
+          initial.push_back(ItemNDC(text, i));
+        }
+
+        std::vector<ItemNDC> compare_data(initial);
+        std::stable_sort(compare_data.begin(), compare_data.end());
+
+        etl::forward_list<ItemNDC, N> data(initial.begin(), initial.end());
+        data.sort();
+
+        CHECK_EQUAL(compare_data.size(), data.size());
+
+        std::vector<ItemNDC>::const_iterator citr = compare_data.begin();
+
+        for (etl::forward_list<ItemNDC, N>::const_iterator ditr = data.begin(); ditr != data.end(); ++ditr, ++citr)
+        {
+          CHECK_EQUAL(citr->index, ditr->index);
+        }
+      }
+    }
+
     //*************************************************************************
     TEST_FIXTURE(SetupFixture, test_move)
     {
@@ -827,6 +827,66 @@ namespace
       CHECK(are_equal);
     }
 
+    //*************************************************************************
+    TEST(test_sort_natural_runs)
+    {
+      // Ascending, descending, descending with equal keys, nearly ordered and random.
+      const int N = 64;
+
+      for (int pattern = 0; pattern < 5; ++pattern)
+      {
+        std::vector<ItemNDCNode> initial;
+        unsigned random = 1;
+
+        for (int i = 0; i < N; ++i)
+        {
+          int key;
+
+          switch (pattern)
+          {
+            case 0:  key = i;                             break;
+            case 1:  key = N - i;                         break;
+            case 2:  key = (N - i) / 3;                   break;
+            case 3:  key = ((i % 16) == 0) ? (N - i) : i; break;
+            default: random = (random * 1103515245U) + 12345U; key = (random >> 16) % 10; break;
+          }
+
+          const char text[] = { char('0' + (key / 10)), char('0' + (key % 10)), 0 };
+          initial.push_back(ItemNDCNode(text, i));
+        }
+
+        std::vector<ItemNDCNode> compare_data(initial);
+        std::stable_sort(compare_data.begin(), compare_data.end());
+
+        DataNDC0 data0(initial.begin(), initial.end());
+        DataNDC1 data1(initial.begin(), initial.end());
+
+        data0.sort(); // Just sort one of them.
+
+        CHECK_EQUAL(compare_data.size(), data0.size());
+
+        std::vector<ItemNDCNode>::const_iterator citr = compare_data.begin();
+
+        for (DataNDC0::const_iterator ditr = data0.begin(); ditr != data0.end(); ++ditr, ++citr)
+        {
+          CHECK_EQUAL(citr->data.index, ditr->data.index);
+        }
+
+        // The backward links are restored.
+        std::vector<ItemNDCNode>::const_reverse_iterator rcitr = compare_data.rbegin();
+        DataNDC0::const_iterator ditr = data0.end();
+
+        while (ditr != data0.begin())
+        {
+          --ditr;
+          CHECK_EQUAL(rcitr->data.index, ditr->data.index);
+          ++rcitr;
+        }
+
+        CHECK(std::equal(data1.begin(), data1.end(), initial.begin()));
+      }
+    }
+
     //*************************************************************************
     TEST_FIXTURE(SetupFixture, test_splice_iterator)
     {
@@ -598,6 +598,101 @@ namespace
       CHECK(isEqual);
     }
 
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_assign_sorted)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data(random_data.begin(), random_data.end());
+
+      data.assign_sorted(compare_data.begin(), compare_data.end());
+
+      CHECK_EQUAL(compare_data.size(), data.size());
+
+      bool isEqual = Check_Equal(data.begin(),
+                                 data.end(),
+                                 compare_data.begin());
+
+      CHECK(isEqual);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_sorted)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      std::vector<std::pair<std::string, int> > sorted(compare_data.begin(), compare_data.end());
+
+      // Every other key, then all of them with new values.
+      Data data;
+
+      for (size_t i = 0; i < sorted.size(); i += 2)
+      {
+        data.insert(sorted[i]);
+      }
+
+      std::vector<std::pair<std::string, int> > more(sorted);
+
+      for (size_t i = 0; i < more.size(); ++i)
+      {
+        more[i].second += 100;
+      }
+
+      data.insert_sorted(more.begin(), more.end());
+
+      // The existing values are kept.
+      CHECK_EQUAL(sorted.size(), data.size());
+
+      Data_iterator itr = data.begin();
+
+      for (size_t i = 0; i < sorted.size(); ++i)
+      {
+        CHECK_EQUAL(sorted[i].first, itr->first);
+        CHECK_EQUAL(((i % 2) == 0) ? sorted[i].second : sorted[i].second + 100, itr->second);
+        ++itr;
+      }
+
+      // Still a valid tree.
+      data.erase(sorted[3].first);
+      data.erase(sorted[0].first);
+      data.insert(sorted[0]);
+      compare_data.erase(sorted[3].first);
+
+      CHECK_EQUAL(compare_data.size(), data.size());
+      CHECK(data.find(sorted[3].first) == data.end());
+      CHECK(std::is_sorted(data.begin(), data.end(), data.value_comp()));
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_sorted_excess)
+    {
+      Compare_Data compare_data(excess_data.begin(), excess_data.end());
+      Data data;
+
+      CHECK_THROW(data.insert_sorted(compare_data.begin(), compare_data.end()), etl::map_full);
+
+      // As many as fit.
+      CHECK(data.full());
+
+      bool isEqual = Check_Equal(data.begin(),
+                                 data.end(),
+                                 compare_data.begin());
+
+      CHECK(isEqual);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_sorted_not_sorted)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      std::vector<std::pair<std::string, int> > unsorted(compare_data.begin(), compare_data.end());
+      std::swap(unsorted.front(), unsorted.back());
+
+      Data data;
+
+      CHECK_THROW(data.insert_sorted(unsorted.begin(), unsorted.end()), etl::map_iterator);
+      CHECK(data.empty());
+    }
+
     //*************************************************************************
     TEST_FIXTURE(SetupFixture, test_insert_range_random)
     {
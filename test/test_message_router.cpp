@@ -29,6 +29,7 @@ SOFTWARE.
 #include "UnitTest++.h"
 #include "ExtraCheckMacros.h"
 
+#define ETL_MESSAGE_ROUTER_RECEIVE_COUNTERS
 #include "etl/message_router.h"
 #include "etl/queue.h"
 #include "etl/largest.h"
@@ -197,6 +198,57 @@ namespace
   };
 
 
+#if ETL_CPP11_SUPPORTED && !ETL_MESSAGE_ROUTER_CPP03_CODE
+  //***************************************************************************
+  // Messages with sparse ids.
+  //***************************************************************************
+  template <const size_t N>
+  struct SparseMessage : public etl::message<etl::message_id_t(10 + (N * 12))>
+  {
+    SparseMessage(int value_ = 0)
+      : value(value_)
+    {
+    }
+
+    int value;
+    char padding[N];
+  };
+
+  //***************************************************************************
+  // Router that handles more than 16 message types.
+  //***************************************************************************
+  class SparseRouter : public etl::message_router<SparseRouter,
+                                                  SparseMessage<0>,  SparseMessage<1>,  SparseMessage<2>,  SparseMessage<3>,
+                                                  SparseMessage<4>,  SparseMessage<5>,  SparseMessage<6>,  SparseMessage<7>,
+                                                  SparseMessage<8>,  SparseMessage<9>,  SparseMessage<10>, SparseMessage<11>,
+                                                  SparseMessage<12>, SparseMessage<13>, SparseMessage<14>, SparseMessage<15>,
+                                                  SparseMessage<16>, SparseMessage<17>, SparseMessage<18>, SparseMessage<19>>
+  {
+  public:
+
+    SparseRouter()
+      : message_router(ROUTER1),
+        sum(0),
+        message_unknown_count(0)
+    {
+    }
+
+    template <const size_t N>
+    void on_receive(etl::imessage_router&, const SparseMessage<N>& msg)
+    {
+      sum += msg.value;
+    }
+
+    void on_receive_unknown(etl::imessage_router&, const etl::imessage&)
+    {
+      ++message_unknown_count;
+    }
+
+    int sum;
+    int message_unknown_count;
+  };
+#endif
+
   etl::imessage_router* p_router;
 
   SUITE(test_message_router)
@@ -474,5 +526,82 @@ namespace
       CHECK_EQUAL(0, r1.message4_count);
       CHECK_EQUAL(0, r1.message_unknown_count);
     }
+
+#if ETL_CPP11_SUPPORTED && !ETL_MESSAGE_ROUTER_CPP03_CODE
+    //=========================================================================
+    TEST(message_router_more_than_16_sparse_messages)
+    {
+      SparseRouter router;
+
+      etl::send_message(router, SparseMessage<0>(1));
+      etl::send_message(router, SparseMessage<7>(10));
+      etl::send_message(router, SparseMessage<16>(100));
+      etl::send_message(router, SparseMessage<19>(1000));
+      CHECK_EQUAL(1111, router.sum);
+      CHECK_EQUAL(0, router.message_unknown_count);
+
+      // Ids between and outside of the handled ids.
+      etl::send_message(router, message1);
+      etl::send_message(router, etl::message<11>());
+      etl::send_message(router, etl::message<255>());
+      CHECK_EQUAL(1111, router.sum);
+      CHECK_EQUAL(3, router.message_unknown_count);
+
+      CHECK(router.accepts(SparseMessage<0>::ID));
+      CHECK(router.accepts(SparseMessage<19>::ID));
+      CHECK(!router.accepts(etl::message_id_t(SparseMessage<0>::ID - 1)));
+      CHECK(!router.accepts(etl::message_id_t(SparseMessage<0>::ID + 1)));
+      CHECK(!router.accepts(etl::message_id_t(SparseMessage<19>::ID + 1)));
+    }
+
+    //=========================================================================
+    TEST(message_router_more_than_16_sparse_messages_packet)
+    {
+      typedef SparseRouter::message_packet Packet;
+
+      SparseRouter router;
+
+      CHECK(size_t(Packet::SIZE) >= sizeof(SparseMessage<19>));
+
+      SparseMessage<18> message(42);
+      const etl::imessage& imessage = message;
+
+      Packet packet(imessage);
+      CHECK_EQUAL(SparseMessage<18>::ID, packet.get().message_id);
+      CHECK_EQUAL(42, static_cast<const SparseMessage<18>&>(packet.get()).value);
+
+      router.receive(packet.get());
+      CHECK_EQUAL(42, router.sum);
+
+      etl::message<11> unknown;
+      CHECK_THROW(Packet p(static_cast<const etl::imessage&>(unknown)), etl::unhandled_message_exception);
+    }
+
+    //=========================================================================
+    TEST(message_router_receive_counters)
+    {
+      Router1 r1;
+      Router2 r2;
+
+      etl::send_message(r2, message1);
+      etl::send_message(r2, message4);
+      etl::send_message(r2, message4);
+      etl::send_message(r2, message3);
+
+      CHECK_EQUAL(1U, r2.get_receive_count<Message1>());
+      CHECK_EQUAL(0U, r2.get_receive_count<Message2>());
+      CHECK_EQUAL(2U, r2.get_receive_count<Message4>());
+      CHECK_EQUAL(0U, r2.get_receive_count<Message5>());
+
+      // Messages passed to the successor are not counted.
+      r2.set_successor(r1);
+      etl::send_message(r2, message3);
+      CHECK_EQUAL(1U, r1.get_receive_count<Message3>());
+
+      r2.reset_receive_counts();
+      CHECK_EQUAL(0U, r2.get_receive_count<Message1>());
+      CHECK_EQUAL(0U, r2.get_receive_count<Message4>());
+    }
+#endif
   };
 }
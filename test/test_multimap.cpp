@@ -480,6 +480,105 @@ namespace
       CHECK(isEqual);
     }
 
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_assign_sorted)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      Data data(random_data.begin(), random_data.end());
+
+      data.assign_sorted(compare_data.begin(), compare_data.end());
+
+      CHECK_EQUAL(compare_data.size(), data.size());
+
+      bool isEqual = Check_Equal(data.begin(),
+                                 data.end(),
+                                 compare_data.begin());
+
+      CHECK(isEqual);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_sorted)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      std::vector<std::pair<std::string, int> > sorted(compare_data.begin(), compare_data.end());
+
+      // Every other element, then the rest.
+      Data data;
+      Compare_Data expected;
+      std::vector<std::pair<std::string, int> > more;
+
+      for (size_t i = 0; i < sorted.size(); ++i)
+      {
+        if ((i % 2) == 0)
+        {
+          data.insert(sorted[i]);
+          expected.insert(sorted[i]);
+        }
+        else
+        {
+          more.push_back(sorted[i]);
+        }
+      }
+
+      data.insert_sorted(more.begin(), more.end());
+
+      // Equal keys go after the existing ones.
+      expected.insert(more.begin(), more.end());
+
+      CHECK_EQUAL(expected.size(), data.size());
+
+      bool isEqual = Check_Equal(data.begin(),
+                                 data.end(),
+                                 expected.begin());
+
+      CHECK(isEqual);
+
+      // Still a valid tree.
+      data.erase(data.begin());
+      data.insert(sorted[0]);
+      expected.erase(expected.begin());
+      expected.insert(sorted[0]);
+
+      isEqual = Check_Equal(data.begin(),
+                            data.end(),
+                            expected.begin());
+
+      CHECK(isEqual);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_sorted_excess)
+    {
+      Compare_Data compare_data(excess_data.begin(), excess_data.end());
+      Data data;
+
+      CHECK_THROW(data.insert_sorted(compare_data.begin(), compare_data.end()), etl::multimap_full);
+
+      // As many as fit.
+      CHECK(data.full());
+
+      bool isEqual = Check_Equal(data.begin(),
+                                 data.end(),
+                                 compare_data.begin());
+
+      CHECK(isEqual);
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_sorted_not_sorted)
+    {
+      Compare_Data compare_data(initial_data.begin(), initial_data.end());
+      std::vector<std::pair<std::string, int> > unsorted(compare_data.begin(), compare_data.end());
+      std::swap(unsorted.front(), unsorted.back());
+
+      Data data;
+
+      CHECK_THROW(data.insert_sorted(unsorted.begin(), unsorted.end()), etl::multimap_iterator);
+      CHECK(data.empty());
+    }
+
     //*************************************************************************
     TEST_FIXTURE(SetupFixture, test_insert_range_random)
     {
@@ -0,0 +1,313 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <stdint.h>
+#include <vector>
+
+#include "etl/packed_array.h"
+
+namespace
+{
+  //***************************************************************************
+  // Random values of 'bits' bits.
+  //***************************************************************************
+  std::vector<uint64_t> make_values(size_t count, size_t bits)
+  {
+    std::vector<uint64_t> values;
+    uint64_t x = 0x9E3779B97F4A7C15ULL;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      values.push_back(x >> (64 - bits));
+    }
+
+    return values;
+  }
+
+  //***************************************************************************
+  // Sets every value one at a time and checks them all.
+  //***************************************************************************
+  template <typename TArray>
+  bool check_set_get(size_t bits)
+  {
+    TArray array;
+    std::vector<uint64_t> values = make_values(array.size(), bits);
+
+    for (size_t i = 0; i < array.size(); ++i)
+    {
+      array.set(i, typename TArray::value_type(values[i]));
+    }
+
+    for (size_t i = 0; i < array.size(); ++i)
+    {
+      if (array.get(i) != values[i])
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  //***************************************************************************
+  // Reads and writes ranges at every start and length against single values.
+  //***************************************************************************
+  template <typename TArray>
+  bool check_ranges(size_t bits)
+  {
+    typedef typename TArray::value_type value_t;
+
+    std::vector<uint64_t> source = make_values(TArray::FIELDS_PER_WORD * 4, bits);
+    std::vector<value_t>  values(source.begin(), source.end());
+
+    for (size_t start = 0; start < values.size(); ++start)
+    {
+      for (size_t count = 0; (start + count) <= values.size(); ++count)
+      {
+        TArray array(value_t(TArray::MAX_VALUE));
+        TArray expected(value_t(TArray::MAX_VALUE));
+
+        for (size_t i = 0; i < count; ++i)
+        {
+          expected.set(start + i, values[i]);
+        }
+
+        if (array.set_range(start, values.begin(), count) != (values.begin() + count))
+        {
+          return false;
+        }
+
+        if (array != expected)
+        {
+          return false;
+        }
+
+        std::vector<value_t> result(count + 1, 0);
+
+        if (array.get_range(start, result.begin(), count) != (result.begin() + count))
+        {
+          return false;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+          if (result[i] != values[i])
+          {
+            return false;
+          }
+        }
+
+        if (result[count] != 0)
+        {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  SUITE(test_packed_array)
+  {
+    //*************************************************************************
+    TEST(test_constants)
+    {
+      typedef etl::packed_array<5, 100> Array5;
+      typedef etl::packed_array<7, 1000> Array7;
+      typedef etl::packed_array<64, 3> Array64;
+
+      CHECK_EQUAL(12U, size_t(Array5::FIELDS_PER_WORD));
+      CHECK_EQUAL(9U,  size_t(Array5::WORDS));
+      CHECK_EQUAL(31U, size_t(Array5::MAX_VALUE));
+      CHECK_EQUAL(1U,  sizeof(Array5::value_type));
+
+      CHECK_EQUAL(9U,   size_t(Array7::FIELDS_PER_WORD));
+      CHECK_EQUAL(112U, size_t(Array7::WORDS));
+      CHECK_EQUAL(112U * 8U, sizeof(Array7));
+
+      CHECK_EQUAL(1U, size_t(Array64::FIELDS_PER_WORD));
+      CHECK_EQUAL(UINT64_MAX, uint64_t(Array64::MAX_VALUE));
+
+      Array5 array;
+      CHECK_EQUAL(100U, array.size());
+      CHECK_EQUAL(100U, array.max_size());
+      CHECK(!array.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_default_constructor)
+    {
+      etl::packed_array<3, 50> array;
+
+      for (size_t i = 0; i < array.size(); ++i)
+      {
+        CHECK_EQUAL(0U, array[i]);
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_fill)
+    {
+      etl::packed_array<6, 25> array(45);
+
+      for (size_t i = 0; i < array.size(); ++i)
+      {
+        CHECK_EQUAL(45U, array[i]);
+      }
+
+      // The fields after the last value are unused and zero.
+      CHECK_EQUAL(0U, array.data()[2] >> 30);
+
+      array.reset();
+
+      for (size_t i = 0; i < array.size(); ++i)
+      {
+        CHECK_EQUAL(0U, array[i]);
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_set_get_all_widths)
+    {
+      CHECK((check_set_get<etl::packed_array<1, 200> >(1)));
+      CHECK((check_set_get<etl::packed_array<3, 200> >(3)));
+      CHECK((check_set_get<etl::packed_array<5, 200> >(5)));
+      CHECK((check_set_get<etl::packed_array<7, 200> >(7)));
+      CHECK((check_set_get<etl::packed_array<8, 200> >(8)));
+      CHECK((check_set_get<etl::packed_array<12, 200> >(12)));
+      CHECK((check_set_get<etl::packed_array<17, 200> >(17)));
+      CHECK((check_set_get<etl::packed_array<32, 200> >(32)));
+      CHECK((check_set_get<etl::packed_array<33, 200> >(33)));
+      CHECK((check_set_get<etl::packed_array<63, 200> >(63)));
+      CHECK((check_set_get<etl::packed_array<64, 200> >(64)));
+    }
+
+    //*************************************************************************
+    TEST(test_set_masks_value)
+    {
+      etl::packed_array<4, 16> array;
+
+      array.set(3, 0xFF);
+
+      CHECK_EQUAL(0x0FU, array[3]);
+      CHECK_EQUAL(0U, array[2]);
+      CHECK_EQUAL(0U, array[4]);
+    }
+
+    //*************************************************************************
+    TEST(test_reference)
+    {
+      etl::packed_array<5, 20> array;
+
+      array[0] = 7;
+      array[1] = 31;
+      array[19] = array[1];
+
+      CHECK_EQUAL(7U, array[0]);
+      CHECK_EQUAL(31U, array[1]);
+      CHECK_EQUAL(31U, array[19]);
+      CHECK_EQUAL(0U, array[18]);
+
+      uint8_t value = array[1];
+      CHECK_EQUAL(31U, value);
+
+      const etl::packed_array<5, 20>& carray = array;
+      CHECK_EQUAL(7U, carray[0]);
+    }
+
+    //*************************************************************************
+    TEST(test_at)
+    {
+      etl::packed_array<5, 20> array;
+      const etl::packed_array<5, 20>& carray = array;
+
+      array.at(19) = 3;
+      CHECK_EQUAL(3U, carray.at(19));
+
+      CHECK_THROW(array.at(20), etl::packed_array_out_of_range);
+      CHECK_THROW(carray.at(20), etl::packed_array_out_of_range);
+    }
+
+    //*************************************************************************
+    TEST(test_ranges)
+    {
+      CHECK((check_ranges<etl::packed_array<1, 256> >(1)));
+      CHECK((check_ranges<etl::packed_array<5, 48> >(5)));
+      CHECK((check_ranges<etl::packed_array<7, 36> >(7)));
+      CHECK((check_ranges<etl::packed_array<12, 20> >(12)));
+      CHECK((check_ranges<etl::packed_array<21, 12> >(21)));
+      CHECK((check_ranges<etl::packed_array<40, 4> >(40)));
+      CHECK((check_ranges<etl::packed_array<64, 4> >(64)));
+    }
+
+    //*************************************************************************
+    TEST(test_ranges_to_end)
+    {
+      typedef etl::packed_array<7, 1000> Array;
+
+      Array array;
+      std::vector<uint64_t> source = make_values(array.size(), 7);
+      std::vector<uint8_t>  values(source.begin(), source.end());
+      std::vector<uint8_t>  result(array.size());
+
+      array.set_range(0, values.begin(), values.size());
+      array.get_range(0, result.begin(), result.size());
+
+      CHECK(values == result);
+
+      for (size_t i = 0; i < array.size(); ++i)
+      {
+        CHECK_EQUAL(values[i], array[i]);
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_swap_and_compare)
+    {
+      etl::packed_array<5, 20> array1(1);
+      etl::packed_array<5, 20> array2(2);
+      etl::packed_array<5, 20> array3(2);
+
+      CHECK(array2 == array3);
+      CHECK(array1 != array2);
+
+      swap(array1, array3);
+
+      CHECK(array1 == array2);
+      CHECK_EQUAL(1U, array3[0]);
+
+      array1[5] = 3;
+      CHECK(array1 != array2);
+    }
+  };
+}
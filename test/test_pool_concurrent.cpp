@@ -0,0 +1,460 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <thread>
+#include <vector>
+#include <set>
+#include <string>
+#include <algorithm>
+
+#include "etl/pool_concurrent.h"
+#include "etl/queue_mpmc_atomic.h"
+
+namespace
+{
+  struct Data
+  {
+    Data()
+      : a(0),
+        b(0)
+    {
+    }
+
+    Data(int a_, int b_ = 2)
+      : a(a_),
+        b(b_)
+    {
+    }
+
+    int a;
+    int b;
+  };
+
+  typedef etl::pool_concurrent<Data, 10> Pool;
+
+  SUITE(test_pool_concurrent)
+  {
+    //*************************************************************************
+    TEST(test_allocate)
+    {
+      Pool pool;
+
+      CHECK(pool.empty());
+      CHECK_EQUAL(10U, pool.max_size());
+      CHECK_EQUAL(10U, pool.available());
+
+      std::set<Data*> allocated;
+
+      for (size_t i = 0; i < pool.max_size(); ++i)
+      {
+        Data* p = pool.allocate<Data>();
+        CHECK(p != nullptr);
+        CHECK(pool.is_in_pool(p));
+        allocated.insert(p);
+      }
+
+      // All different.
+      CHECK_EQUAL(10U, allocated.size());
+      CHECK(pool.full());
+      CHECK_EQUAL(0U, pool.available());
+
+      CHECK_THROW(pool.allocate<Data>(), etl::pool_no_allocation);
+    }
+
+    //*************************************************************************
+    TEST(test_release)
+    {
+      Pool pool;
+
+      Data* p1 = pool.allocate<Data>();
+      Data* p2 = pool.allocate<Data>();
+      Data* p3 = pool.allocate<Data>();
+      CHECK_EQUAL(3U, pool.size());
+
+      pool.release(p2);
+      CHECK_EQUAL(2U, pool.size());
+
+      // The last released is the next allocated.
+      CHECK_EQUAL(p2, pool.allocate<Data>());
+
+      pool.release(p1);
+      pool.release(p2);
+      pool.release(p3);
+      CHECK(pool.empty());
+
+      // Every item can still be allocated once.
+      std::set<Data*> allocated;
+
+      for (size_t i = 0; i < pool.max_size(); ++i)
+      {
+        allocated.insert(pool.allocate<Data>());
+      }
+
+      CHECK_EQUAL(10U, allocated.size());
+      CHECK(allocated.find(p1) != allocated.end());
+      CHECK(allocated.find(p2) != allocated.end());
+      CHECK(allocated.find(p3) != allocated.end());
+    }
+
+    //*************************************************************************
+    TEST(test_release_not_in_pool)
+    {
+      Pool pool;
+      Data not_in_pool;
+
+      CHECK(!pool.is_in_pool(&not_in_pool));
+      CHECK_THROW(pool.release(&not_in_pool), etl::pool_object_not_in_pool);
+    }
+
+    //*************************************************************************
+    TEST(test_create_destroy)
+    {
+      Pool pool;
+
+      Data* p1 = pool.create<Data>();
+      Data* p2 = pool.create<Data>(1);
+      Data* p3 = pool.create<Data>(3, 4);
+
+      CHECK_EQUAL(0, p1->a);
+      CHECK_EQUAL(1, p2->a);
+      CHECK_EQUAL(2, p2->b);
+      CHECK_EQUAL(3, p3->a);
+      CHECK_EQUAL(4, p3->b);
+
+      pool.destroy<Data>(p1);
+      pool.destroy<Data>(p2);
+      pool.destroy<Data>(p3);
+
+      CHECK(pool.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_release_all)
+    {
+      Pool pool;
+
+      for (size_t i = 0; i < pool.max_size(); ++i)
+      {
+        pool.allocate<Data>();
+      }
+
+      CHECK(pool.full());
+
+      pool.release_all();
+
+      CHECK(pool.empty());
+
+      for (size_t i = 0; i < pool.max_size(); ++i)
+      {
+        CHECK(pool.allocate<Data>() != nullptr);
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_generic_pool)
+    {
+      etl::generic_pool_concurrent<sizeof(double), etl::alignment_of<double>::value, 4> pool;
+
+      double* pd = pool.create<double>(1.5);
+      int*    pi = pool.create<int>(2);
+
+      CHECK_EQUAL(1.5, *pd);
+      CHECK_EQUAL(2, *pi);
+      CHECK_EQUAL(0U, uintptr_t(pd) % etl::alignment_of<double>::value);
+
+      pool.destroy<double>(pd);
+      pool.destroy<int>(pi);
+
+      CHECK(pool.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_magazine_refill_and_flush)
+    {
+      Pool pool;
+      std::vector<Data*> allocated;
+
+      {
+        etl::pool_magazine<4> magazine(pool);
+        CHECK_EQUAL(4U, magazine.capacity());
+
+        // The first allocation takes half a magazine from the pool.
+        allocated.push_back(magazine.allocate<Data>());
+        CHECK_EQUAL(1U, magazine.size());
+        CHECK_EQUAL(2U, pool.size());
+
+        allocated.push_back(magazine.allocate<Data>());
+        CHECK_EQUAL(0U, magazine.size());
+        CHECK_EQUAL(2U, pool.size());
+
+        // Empty again, so takes another two.
+        allocated.push_back(magazine.allocate<Data>());
+        CHECK_EQUAL(1U, magazine.size());
+        CHECK_EQUAL(4U, pool.size());
+
+        // Releases stay in the magazine until it is full.
+        for (size_t i = 0; i < allocated.size(); ++i)
+        {
+          magazine.release(allocated[i]);
+        }
+
+        CHECK_EQUAL(4U, magazine.size());
+        CHECK_EQUAL(4U, pool.size());
+
+        // Full, so half go back to the pool.
+        Data* p = pool.allocate<Data>();
+        CHECK_EQUAL(5U, pool.size());
+        magazine.release(p);
+        CHECK_EQUAL(3U, magazine.size());
+        CHECK_EQUAL(3U, pool.size());
+
+        // The most recently released is the next allocated.
+        CHECK_EQUAL(p, magazine.allocate<Data>());
+        magazine.release(p);
+      }
+
+      // The destructor returns everything.
+      CHECK(pool.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_magazine_exhausted)
+    {
+      Pool pool;
+      etl::pool_magazine<4> magazine(pool);
+
+      std::set<Data*> allocated;
+
+      for (size_t i = 0; i < pool.max_size(); ++i)
+      {
+        Data* p = magazine.create<Data>(int(i));
+        CHECK(p != nullptr);
+        allocated.insert(p);
+      }
+
+      CHECK_EQUAL(10U, allocated.size());
+      CHECK(pool.full());
+      CHECK_THROW(magazine.allocate<Data>(), etl::pool_no_allocation);
+
+      for (std::set<Data*>::iterator itr = allocated.begin(); itr != allocated.end(); ++itr)
+      {
+        magazine.destroy<Data>(*itr);
+      }
+
+      magazine.flush();
+      CHECK_EQUAL(0U, magazine.size());
+      CHECK(pool.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_magazine_release_not_in_pool)
+    {
+      Pool pool;
+      etl::pool_magazine<4> magazine(pool);
+      Data not_in_pool;
+
+      CHECK_THROW(magazine.release(&not_in_pool), etl::pool_object_not_in_pool);
+    }
+
+    //*************************************************************************
+    // Each thread stamps the items it holds and checks that nobody else has
+    // touched them before giving them back.
+    //*************************************************************************
+    template <typename TAllocator>
+    void stamp_and_check(TAllocator& allocator, int id, size_t rounds, size_t batch, bool& ok)
+    {
+      std::vector<Data*> held;
+
+      for (size_t r = 0; r < rounds; ++r)
+      {
+        for (size_t i = 0; i < batch; ++i)
+        {
+          Data* p = allocator.template allocate<Data>();
+
+          if (p != nullptr)
+          {
+            p->a = id;
+            p->b = int(i);
+            held.push_back(p);
+          }
+        }
+
+        for (size_t i = 0; i < held.size(); ++i)
+        {
+          if (held[i]->a != id)
+          {
+            ok = false;
+          }
+
+          allocator.release(held[i]);
+        }
+
+        held.clear();
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_threads_direct)
+    {
+      static etl::pool_concurrent<Data, 64> pool;
+      const size_t N_THREADS = 4;
+
+      std::vector<std::thread> threads;
+      bool ok[N_THREADS] = { true, true, true, true };
+
+      for (size_t t = 0; t < N_THREADS; ++t)
+      {
+        threads.push_back(std::thread([&, t]
+        {
+          try
+          {
+            stamp_and_check(pool, int(t) + 1, 2000, 16, ok[t]);
+          }
+          catch (...)
+          {
+            ok[t] = false;
+          }
+        }));
+      }
+
+      for (size_t t = 0; t < threads.size(); ++t)
+      {
+        threads[t].join();
+      }
+
+      for (size_t t = 0; t < N_THREADS; ++t)
+      {
+        CHECK(ok[t]);
+      }
+
+      CHECK(pool.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_threads_magazines)
+    {
+      static etl::pool_concurrent<Data, 128> pool;
+      const size_t N_THREADS = 4;
+
+      std::vector<std::thread> threads;
+      bool ok[N_THREADS] = { true, true, true, true };
+
+      for (size_t t = 0; t < N_THREADS; ++t)
+      {
+        threads.push_back(std::thread([&, t]
+        {
+          try
+          {
+            etl::pool_magazine<8> magazine(pool);
+            stamp_and_check(magazine, int(t) + 1, 2000, 20, ok[t]);
+          }
+          catch (...)
+          {
+            ok[t] = false;
+          }
+        }));
+      }
+
+      for (size_t t = 0; t < threads.size(); ++t)
+      {
+        threads[t].join();
+      }
+
+      for (size_t t = 0; t < N_THREADS; ++t)
+      {
+        CHECK(ok[t]);
+      }
+
+      CHECK(pool.empty());
+    }
+
+    //*************************************************************************
+    // Items allocated by one thread and released by another.
+    //*************************************************************************
+    TEST(test_threads_cross_release)
+    {
+      static etl::pool_concurrent<Data, 96> pool;
+      static etl::queue_mpmc_atomic<Data*, 32> handoff;
+      const size_t N_ITEMS = 20000;
+
+      bool ok = true;
+
+      std::thread producer([&]
+      {
+        etl::pool_magazine<8> magazine(pool);
+
+        for (size_t i = 0; i < N_ITEMS; ++i)
+        {
+          Data* p = nullptr;
+
+          while ((p = magazine.allocate<Data>()) == nullptr)
+          {
+            std::this_thread::yield();
+          }
+
+          p->a = int(i);
+
+          while (!handoff.push(p))
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+
+      std::thread consumer([&]
+      {
+        etl::pool_magazine<8> magazine(pool);
+
+        for (size_t i = 0; i < N_ITEMS; ++i)
+        {
+          Data* p;
+
+          while (!handoff.pop(p))
+          {
+            std::this_thread::yield();
+          }
+
+          if (p->a != int(i))
+          {
+            ok = false;
+          }
+
+          magazine.release(p);
+        }
+      });
+
+      producer.join();
+      consumer.join();
+
+      CHECK(ok);
+      CHECK(pool.empty());
+    }
+  };
+}
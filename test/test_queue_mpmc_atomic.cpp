@@ -0,0 +1,482 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <algorithm>
+#include <memory>
+
+#include "etl/queue_mpmc_atomic.h"
+
+namespace
+{
+  struct Data
+  {
+    Data(int a_, int b_ = 2, int c_ = 3, int d_ = 4)
+      : a(a_),
+        b(b_),
+        c(c_),
+        d(d_)
+    {
+    }
+
+    Data()
+      : a(0),
+        b(0),
+        c(0),
+        d(0)
+    {
+    }
+
+    int a;
+    int b;
+    int c;
+    int d;
+  };
+
+  bool operator ==(const Data& lhs, const Data& rhs)
+  {
+    return (lhs.a == rhs.a) && (lhs.b == rhs.b) && (lhs.c == rhs.c) && (lhs.d == rhs.d);
+  }
+
+//  std::ostream& operator <<(std::ostream& os, const Data& data)
+//  {
+//    os << data.a << " " << data.b << " " << data.c << " " << data.d;
+//
+//    return os;
+//  }
+
+  SUITE(test_queue_mpmc_atomic)
+  {
+    //*************************************************************************
+    TEST(test_constructor)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+
+      CHECK_EQUAL(4U, queue.max_size());
+      CHECK_EQUAL(4U, queue.capacity());
+    }
+
+    //*************************************************************************
+    TEST(test_size_push_pop)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+
+      CHECK_EQUAL(0U, queue.size());
+
+      CHECK_EQUAL(4U, queue.available());
+      CHECK_EQUAL(0U, queue.size());
+
+      queue.push(1);
+      CHECK_EQUAL(1U, queue.size());
+      CHECK_EQUAL(3U, queue.available());
+
+      queue.push(2);
+      CHECK_EQUAL(2U, queue.size());
+      CHECK_EQUAL(2U, queue.available());
+
+      queue.push(3);
+      CHECK_EQUAL(3U, queue.size());
+      CHECK_EQUAL(1U, queue.available());
+
+      queue.push(4);
+      CHECK_EQUAL(4U, queue.size());
+      CHECK_EQUAL(0U, queue.available());
+
+      CHECK(!queue.push(5));
+      CHECK(!queue.push(5));
+
+      int i;
+
+      CHECK(queue.pop(i));
+      CHECK_EQUAL(1, i);
+      CHECK_EQUAL(3U, queue.size());
+
+      CHECK(queue.pop(i));
+      CHECK_EQUAL(2, i);
+      CHECK_EQUAL(2U, queue.size());
+
+      CHECK(queue.pop(i));
+      CHECK_EQUAL(3, i);
+      CHECK_EQUAL(1U, queue.size());
+
+      CHECK(queue.pop(i));
+      CHECK_EQUAL(4, i);
+      CHECK_EQUAL(0U, queue.size());
+
+      CHECK(!queue.pop(i));
+      CHECK(!queue.pop(i));
+    }
+
+    //*************************************************************************
+    TEST(test_multiple_emplace)
+    {
+      etl::queue_mpmc_atomic<Data, 4> queue;
+
+      queue.emplace(1);
+      queue.emplace(1, 2);
+      queue.emplace(1, 2, 3);
+      queue.emplace(1, 2, 3, 4);
+
+      CHECK_EQUAL(4U, queue.size());
+
+      Data popped;
+
+      queue.pop(popped);
+      CHECK(popped == Data(1, 2, 3, 4));
+      queue.pop(popped);
+      CHECK(popped == Data(1, 2, 3, 4));
+      queue.pop(popped);
+      CHECK(popped == Data(1, 2, 3, 4));
+      queue.pop(popped);
+      CHECK(popped == Data(1, 2, 3, 4));
+    }
+
+    //*************************************************************************
+    TEST(test_size_push_pop_iqueue)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+
+      etl::iqueue_mpmc_atomic<int>& iqueue = queue;
+
+      CHECK_EQUAL(0U, iqueue.size());
+
+      iqueue.push(1);
+      CHECK_EQUAL(1U, iqueue.size());
+
+      iqueue.push(2);
+      CHECK_EQUAL(2U, iqueue.size());
+
+      iqueue.push(3);
+      CHECK_EQUAL(3U, iqueue.size());
+
+      iqueue.push(4);
+      CHECK_EQUAL(4U, iqueue.size());
+
+      CHECK(!iqueue.push(5));
+      CHECK(!iqueue.push(5));
+
+      int i;
+
+      CHECK(iqueue.pop(i));
+      CHECK_EQUAL(1, i);
+      CHECK_EQUAL(3U, iqueue.size());
+
+      CHECK(iqueue.pop(i));
+      CHECK_EQUAL(2, i);
+      CHECK_EQUAL(2U, iqueue.size());
+
+      CHECK(iqueue.pop(i));
+      CHECK_EQUAL(3, i);
+      CHECK_EQUAL(1U, iqueue.size());
+
+      CHECK(iqueue.pop(i));
+      CHECK_EQUAL(4, i);
+      CHECK_EQUAL(0U, iqueue.size());
+
+      CHECK(!iqueue.pop(i));
+      CHECK(!iqueue.pop(i));
+    }
+
+    //*************************************************************************
+    TEST(test_size_push_pop_void)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+
+      CHECK_EQUAL(0U, queue.size());
+
+      queue.push(1);
+      CHECK_EQUAL(1U, queue.size());
+
+      queue.push(2);
+      CHECK_EQUAL(2U, queue.size());
+
+      queue.push(3);
+      CHECK_EQUAL(3U, queue.size());
+
+      queue.push(4);
+      CHECK_EQUAL(4U, queue.size());
+
+      CHECK(!queue.push(5));
+      CHECK(!queue.push(5));
+
+      CHECK(queue.pop());
+      CHECK_EQUAL(3U, queue.size());
+
+      CHECK(queue.pop());
+      CHECK_EQUAL(2U, queue.size());
+
+      CHECK(queue.pop());
+      CHECK_EQUAL(1U, queue.size());
+
+      CHECK(queue.pop());
+      CHECK_EQUAL(0U, queue.size());
+
+      CHECK(!queue.pop());
+      CHECK(!queue.pop());
+    }
+
+    //*************************************************************************
+    TEST(test_clear)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+
+      CHECK_EQUAL(0U, queue.size());
+
+      queue.push(1);
+      queue.push(2);
+      queue.clear();
+      CHECK_EQUAL(0U, queue.size());
+
+      // Do it again to check that clear() didn't screw up the internals.
+      queue.push(1);
+      queue.push(2);
+      CHECK_EQUAL(2U, queue.size());
+      queue.clear();
+      CHECK_EQUAL(0U, queue.size());
+    }
+
+    //*************************************************************************
+    TEST(test_empty)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+      CHECK(queue.empty());
+
+      queue.push(1);
+      CHECK(!queue.empty());
+
+      queue.clear();
+      CHECK(queue.empty());
+
+      queue.push(1);
+      CHECK(!queue.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_full)
+    {
+      etl::queue_mpmc_atomic<int, 4> queue;
+      CHECK(!queue.full());
+
+      queue.push(1);
+      queue.push(2);
+      queue.push(3);
+      queue.push(4);
+      CHECK(queue.full());
+
+      queue.clear();
+      CHECK(!queue.full());
+
+      queue.push(1);
+      queue.push(2);
+      queue.push(3);
+      queue.push(4);
+      CHECK(queue.full());
+    }
+
+    //*************************************************************************
+    TEST(test_wrap_around)
+    {
+      // A capacity that is not a power of 2.
+      etl::queue_mpmc_atomic<int, 3> queue;
+
+      int expected = 0;
+      int next     = 0;
+
+      for (int i = 0; i < 10000; ++i)
+      {
+        while (queue.push(next))
+        {
+          ++next;
+        }
+
+        CHECK_EQUAL(3U, queue.size());
+        CHECK(queue.full());
+
+        int value;
+
+        for (int j = 0; j < (i % 3) + 1; ++j)
+        {
+          CHECK(queue.pop(value));
+          CHECK_EQUAL(expected, value);
+          ++expected;
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_capacity_one)
+    {
+      std::shared_ptr<int> p(new int(1));
+
+      {
+        etl::queue_mpmc_atomic<std::shared_ptr<int>, 1> queue;
+
+        CHECK(queue.empty());
+        CHECK(!queue.pop());
+
+        for (int i = 0; i < 100; ++i)
+        {
+          CHECK(queue.push(p));
+          CHECK(queue.full());
+
+          // Must not construct over the queued item.
+          CHECK(!queue.push(p));
+          CHECK_EQUAL(2, p.use_count());
+
+          std::shared_ptr<int> value;
+          CHECK(queue.pop(value));
+          CHECK(value == p);
+          CHECK(queue.empty());
+          CHECK(!queue.pop());
+        }
+
+        CHECK(queue.push(p));
+      }
+
+      CHECK_EQUAL(1, p.use_count());
+    }
+
+    //*************************************************************************
+    TEST(test_destruct_remaining)
+    {
+      std::shared_ptr<int> p(new int(1));
+
+      {
+        etl::queue_mpmc_atomic<std::shared_ptr<int>, 4> queue;
+
+        queue.push(p);
+        queue.push(p);
+        CHECK_EQUAL(3, p.use_count());
+      }
+
+      CHECK_EQUAL(1, p.use_count());
+    }
+
+    //=========================================================================
+    TEST(queue_threads)
+    {
+      const size_t N_PRODUCERS = 4;
+      const size_t N_CONSUMERS = 4;
+      const int    LENGTH      = 100000;
+
+      etl::queue_mpmc_atomic<int, 16> queue;
+
+      std::atomic<bool> start(false);
+      std::atomic<int>  popped_count(0);
+
+      std::vector<std::vector<int> > popped(N_CONSUMERS);
+      std::vector<std::thread>       threads;
+
+      for (size_t p = 0; p < N_PRODUCERS; ++p)
+      {
+        threads.push_back(std::thread([&, p]
+        {
+          while (!start.load());
+
+          int value = int(p) * LENGTH;
+
+          for (int i = 0; i < LENGTH; ++i)
+          {
+            while (!queue.push(value))
+            {
+              std::this_thread::yield();
+            }
+
+            ++value;
+          }
+        }));
+      }
+
+      for (size_t c = 0; c < N_CONSUMERS; ++c)
+      {
+        threads.push_back(std::thread([&, c]
+        {
+          while (!start.load());
+
+          int value;
+
+          while (popped_count.load() < int(N_PRODUCERS * LENGTH))
+          {
+            if (queue.pop(value))
+            {
+              popped[c].push_back(value);
+              ++popped_count;
+            }
+            else
+            {
+              std::this_thread::yield();
+            }
+          }
+        }));
+      }
+
+      start.store(true);
+
+      for (size_t i = 0; i < threads.size(); ++i)
+      {
+        threads[i].join();
+      }
+
+      // Every value is popped once, and each producer's values are popped in order.
+      std::vector<int> all;
+
+      for (size_t c = 0; c < N_CONSUMERS; ++c)
+      {
+        std::vector<int> last(N_PRODUCERS, -1);
+
+        for (size_t i = 0; i < popped[c].size(); ++i)
+        {
+          const int value    = popped[c][i];
+          const int producer = value / LENGTH;
+
+          CHECK(value > last[producer]);
+          last[producer] = value;
+        }
+
+        all.insert(all.end(), popped[c].begin(), popped[c].end());
+      }
+
+      std::sort(all.begin(), all.end());
+
+      CHECK_EQUAL(size_t(N_PRODUCERS * LENGTH), all.size());
+
+      for (size_t i = 0; i < all.size(); ++i)
+      {
+        CHECK_EQUAL(int(i), all[i]);
+      }
+
+      CHECK(queue.empty());
+    }
+  };
+}
@@ -31,6 +31,9 @@ SOFTWARE.
 #include <thread>
 #include <chrono>
 #include <vector>
+#include <iterator>
+#include <memory>
+#include <string.h>
 
 #include "etl/queue_spsc_atomic.h"
 
@@ -299,6 +302,401 @@ namespace
       CHECK(queue.full());
     }
 
+    //*************************************************************************
+    TEST(test_separated_layout_size_push_pop)
+    {
+      typedef etl::queue_spsc_atomic<int, 4, etl::memory_model::MEMORY_MODEL_LARGE, etl::queue_spsc_atomic_layout::SEPARATED> Queue;
+
+      Queue queue;
+      etl::iqueue_spsc_atomic<int, etl::memory_model::MEMORY_MODEL_LARGE, etl::queue_spsc_atomic_layout::SEPARATED>& iqueue = queue;
+
+      CHECK(iqueue.empty());
+      CHECK_EQUAL(4U, iqueue.available());
+
+      CHECK(iqueue.push(1));
+      CHECK(iqueue.push(2));
+      CHECK(iqueue.emplace(3));
+      CHECK(iqueue.push(4));
+      CHECK_EQUAL(4U, iqueue.size());
+      CHECK(iqueue.full());
+      CHECK(!iqueue.push(5));
+
+      int i;
+
+      CHECK(iqueue.pop(i));
+      CHECK_EQUAL(1, i);
+
+      // The 'push' side must see the space freed by the 'pop'.
+      CHECK(iqueue.push(5));
+      CHECK(!iqueue.push(6));
+
+      CHECK(iqueue.pop(i));
+      CHECK_EQUAL(2, i);
+      CHECK(iqueue.pop(i));
+      CHECK_EQUAL(3, i);
+      CHECK(iqueue.pop(i));
+      CHECK_EQUAL(4, i);
+      CHECK(iqueue.pop(i));
+      CHECK_EQUAL(5, i);
+      CHECK(!iqueue.pop(i));
+      CHECK(iqueue.empty());
+
+      // The 'pop' side must see the items pushed after it found the queue empty.
+      CHECK(iqueue.push(6));
+      CHECK(iqueue.pop(i));
+      CHECK_EQUAL(6, i);
+    }
+
+    //*************************************************************************
+    TEST(test_separated_layout_wrap_around)
+    {
+      etl::queue_spsc_atomic<int, 3, etl::memory_model::MEMORY_MODEL_SMALL, etl::queue_spsc_atomic_layout::SEPARATED> queue;
+
+      int expected = 0;
+      int next     = 0;
+
+      for (int cycle = 0; cycle < 100; ++cycle)
+      {
+        while (queue.push(next))
+        {
+          ++next;
+        }
+
+        CHECK_EQUAL(3U, size_t(queue.size()));
+
+        int i;
+
+        for (int n = 0; n < (cycle % 3) + 1; ++n)
+        {
+          CHECK(queue.pop(i));
+          CHECK_EQUAL(expected, i);
+          ++expected;
+        }
+      }
+
+      queue.clear();
+      CHECK(queue.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_separated_layout_cache_lines)
+    {
+      etl::queue_spsc_atomic<int, 4, etl::memory_model::MEMORY_MODEL_LARGE, etl::queue_spsc_atomic_layout::SEPARATED> separated;
+      etl::queue_spsc_atomic<int, 4> compact;
+
+      CHECK(sizeof(separated) >= (sizeof(compact) + (3 * ETL_CACHE_LINE_SIZE)));
+    }
+
+    //*************************************************************************
+    TEST(test_push_pop_range)
+    {
+      etl::queue_spsc_atomic<int, 4> queue;
+
+      int input[] = { 1, 2, 3, 4, 5, 6 };
+
+      CHECK_EQUAL(3U, queue.push(input, input + 3));
+      CHECK_EQUAL(3U, queue.size());
+
+      // Only one more fits.
+      CHECK_EQUAL(1U, queue.push(input + 3, input + 6));
+      CHECK(queue.full());
+
+      std::vector<int> output;
+
+      CHECK_EQUAL(2U, queue.pop(std::back_inserter(output), 2));
+
+      // Wraps around the end of the buffer.
+      CHECK_EQUAL(2U, queue.push(input + 4, input + 6));
+
+      CHECK_EQUAL(4U, queue.pop(std::back_inserter(output), 10));
+      CHECK(queue.empty());
+      CHECK_EQUAL(0U, queue.pop(std::back_inserter(output), 10));
+
+      int expected[] = { 1, 2, 3, 4, 5, 6 };
+      CHECK_ARRAY_EQUAL(expected, output.data(), 6);
+    }
+
+    //*************************************************************************
+    TEST(test_write_span_commit_read_span_release)
+    {
+      typedef etl::queue_spsc_atomic<int, 5> Queue;
+
+      Queue queue;
+
+      // Move the indexes to the middle of the buffer.
+      queue.push(0);
+      queue.push(0);
+      queue.push(0);
+      queue.pop();
+      queue.pop();
+      queue.pop();
+
+      Queue::span_pair_type free_space = queue.write_span();
+
+      CHECK_EQUAL(5U, free_space.size());
+      CHECK_EQUAL(3U, free_space.first.size());
+      CHECK_EQUAL(2U, free_space.second.size());
+
+      free_space.first[0] = 1;
+      free_space.first[1] = 2;
+      free_space.first[2] = 3;
+      free_space.second[0] = 4;
+
+      // Nothing is visible until committed.
+      CHECK(queue.empty());
+
+      queue.commit(4);
+      CHECK_EQUAL(4U, queue.size());
+      CHECK_EQUAL(1U, queue.write_span().size());
+
+      Queue::span_pair_type items = queue.read_span();
+
+      CHECK_EQUAL(4U, items.size());
+      CHECK_EQUAL(3U, items.first.size());
+      CHECK_EQUAL(1U, items.second.size());
+      CHECK_EQUAL(1, items.first[0]);
+      CHECK_EQUAL(2, items.first[1]);
+      CHECK_EQUAL(3, items.first[2]);
+      CHECK_EQUAL(4, items.second[0]);
+
+      queue.release(3);
+      CHECK_EQUAL(1U, queue.size());
+
+      int value;
+      CHECK(queue.pop(value));
+      CHECK_EQUAL(4, value);
+
+      CHECK(queue.read_span().empty());
+    }
+
+    //*************************************************************************
+    TEST(test_release_destructs)
+    {
+      typedef etl::queue_spsc_atomic<std::shared_ptr<int>, 4, etl::memory_model::MEMORY_MODEL_LARGE, etl::queue_spsc_atomic_layout::SEPARATED> Queue;
+
+      std::shared_ptr<int> p(new int(1));
+
+      {
+        Queue queue;
+
+        std::shared_ptr<int> input[] = { p, p, p };
+
+        CHECK_EQUAL(3U, queue.push(input, input + 3));
+        CHECK_EQUAL(7, p.use_count());
+
+        queue.release(queue.read_span().first.size() - 1);
+        CHECK_EQUAL(5, p.use_count());
+
+        // Construct in place.
+        Queue::span_pair_type free_space = queue.write_span();
+        ::new (&free_space.first[0]) std::shared_ptr<int>(p);
+        queue.commit(1);
+        CHECK_EQUAL(6, p.use_count());
+      }
+
+      CHECK_EQUAL(1, p.use_count());
+    }
+
+    //*************************************************************************
+    TEST(test_commit_release_span_size)
+    {
+      typedef etl::queue_spsc_atomic<int, 4, etl::memory_model::MEMORY_MODEL_LARGE, etl::queue_spsc_atomic_layout::SEPARATED> Queue;
+
+      Queue queue;
+
+      // Nothing has been acquired yet.
+      CHECK_THROW(queue.commit(1), etl::queue_spsc_atomic_span_size);
+      CHECK_THROW(queue.release(1), etl::queue_spsc_atomic_span_size);
+
+      Queue::span_pair_type free_space = queue.write_span();
+      CHECK_EQUAL(4U, free_space.size());
+
+      free_space.first[0] = 1;
+      free_space.first[1] = 2;
+      free_space.first[2] = 3;
+
+      // The span may be committed in parts, but not beyond its end.
+      queue.commit(2);
+      CHECK_THROW(queue.commit(3), etl::queue_spsc_atomic_span_size);
+      queue.commit(1);
+      CHECK_EQUAL(3U, queue.size());
+
+      Queue::span_pair_type items = queue.read_span();
+      CHECK_EQUAL(3U, items.size());
+
+      CHECK_THROW(queue.release(4), etl::queue_spsc_atomic_span_size);
+      queue.release(1);
+      CHECK_THROW(queue.release(3), etl::queue_spsc_atomic_span_size);
+      queue.release(2);
+      CHECK(queue.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_commit_release_span_size_compact)
+    {
+      // The compact layout checks against the free space and the items in the queue.
+      typedef etl::queue_spsc_atomic<int, 4> Queue;
+
+      Queue queue;
+
+      CHECK_THROW(queue.commit(5), etl::queue_spsc_atomic_span_size);
+      CHECK_THROW(queue.release(1), etl::queue_spsc_atomic_span_size);
+
+      Queue::span_pair_type free_space = queue.write_span();
+      free_space.first[0] = 1;
+      free_space.first[1] = 2;
+      free_space.first[2] = 3;
+
+      queue.commit(3);
+      CHECK_THROW(queue.commit(2), etl::queue_spsc_atomic_span_size);
+      CHECK_EQUAL(3U, queue.size());
+
+      CHECK_EQUAL(3U, queue.read_span().size());
+      CHECK_THROW(queue.release(4), etl::queue_spsc_atomic_span_size);
+      queue.release(3);
+      CHECK(queue.empty());
+    }
+
+    //=========================================================================
+    template <typename TQueue>
+    void span_producer_consumer(TQueue& queue)
+    {
+      typedef typename TQueue::span_pair_type span_pair_type;
+
+      const uint32_t LENGTH = 1000000;
+
+      std::vector<uint32_t> input(LENGTH);
+
+      for (uint32_t i = 0; i < LENGTH; ++i)
+      {
+        input[i] = i;
+      }
+
+      std::vector<uint32_t> output(LENGTH);
+
+      std::thread producer([&]
+      {
+        size_t written = 0;
+
+        while (written < LENGTH)
+        {
+          span_pair_type free_space = queue.write_span();
+
+          size_t n1 = std::min(free_space.first.size(), size_t(LENGTH - written));
+          memcpy(free_space.first.data(), &input[written], n1 * sizeof(uint32_t));
+
+          size_t n2 = std::min(free_space.second.size(), size_t(LENGTH - written - n1));
+          memcpy(free_space.second.data(), &input[written + n1], n2 * sizeof(uint32_t));
+
+          queue.commit(n1 + n2);
+          written += n1 + n2;
+
+          if ((n1 + n2) == 0)
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+
+      size_t read = 0;
+
+      while (read < LENGTH)
+      {
+        span_pair_type items = queue.read_span();
+
+        memcpy(&output[read], items.first.data(), items.first.size() * sizeof(uint32_t));
+        memcpy(&output[read + items.first.size()], items.second.data(), items.second.size() * sizeof(uint32_t));
+
+        queue.release(items.size());
+        read += items.size();
+
+        if (items.empty())
+        {
+          std::this_thread::yield();
+        }
+      }
+
+      producer.join();
+
+      CHECK(input == output);
+      CHECK(queue.empty());
+    }
+
+    TEST(queue_threads_spans_compact)
+    {
+      etl::queue_spsc_atomic<uint32_t, 100> queue;
+
+      span_producer_consumer(queue);
+    }
+
+    TEST(queue_threads_spans_separated)
+    {
+      etl::queue_spsc_atomic<uint32_t, 100, etl::memory_model::MEMORY_MODEL_LARGE, etl::queue_spsc_atomic_layout::SEPARATED> queue;
+
+      span_producer_consumer(queue);
+    }
+
+    //=========================================================================
+    template <typename TQueue>
+    void producer_consumer(TQueue& queue)
+    {
+      const int LENGTH = 1000000;
+
+      std::vector<int> popped;
+      popped.reserve(LENGTH);
+
+      std::thread producer([&]
+      {
+        for (int i = 0; i < LENGTH; ++i)
+        {
+          while (!queue.push(i))
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+
+      int value;
+
+      while (popped.size() < size_t(LENGTH))
+      {
+        if (queue.pop(value))
+        {
+          popped.push_back(value);
+        }
+        else
+        {
+          std::this_thread::yield();
+        }
+      }
+
+      producer.join();
+
+      bool in_order = true;
+
+      for (int i = 0; i < LENGTH; ++i)
+      {
+        in_order = in_order && (popped[i] == i);
+      }
+
+      CHECK(in_order);
+      CHECK(queue.empty());
+    }
+
+    TEST(queue_threads_compact)
+    {
+      etl::queue_spsc_atomic<int, 64> queue;
+
+      producer_consumer(queue);
+    }
+
+    TEST(queue_threads_separated)
+    {
+      etl::queue_spsc_atomic<int, 64, etl::memory_model::MEMORY_MODEL_LARGE, etl::queue_spsc_atomic_layout::SEPARATED> queue;
+
+      producer_consumer(queue);
+    }
+
     //=========================================================================
 #if REALTIME_TEST && defined(ETL_COMPILER_MICROSOFT)
     #if defined(ETL_TARGET_OS_WINDOWS) // Only Windows priority is currently supported
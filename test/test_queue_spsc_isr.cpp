@@ -33,6 +33,7 @@ SOFTWARE.
 #include <thread>
 #include <mutex>
 #include <vector>
+#include <iterator>
 
 #if defined(ETL_COMPILER_MICROSOFT)
 #include <Windows.h>
@@ -531,6 +532,175 @@ namespace
       CHECK(!Access::called_unlock);
     }
 
+    //*************************************************************************
+    TEST(test_push_pop_range)
+    {
+      etl::queue_spsc_isr<int, 4, Access> queue;
+
+      int input[] = { 1, 2, 3, 4, 5, 6 };
+
+      Access::clear();
+      CHECK_EQUAL(3U, queue.push(input, input + 3));
+      CHECK(Access::called_lock);
+      CHECK(Access::called_unlock);
+      CHECK_EQUAL(3U, queue.size());
+
+      // Only one more fits.
+      CHECK_EQUAL(1U, queue.push(input + 3, input + 6));
+      CHECK(queue.full());
+
+      std::vector<int> output;
+
+      Access::clear();
+      CHECK_EQUAL(2U, queue.pop(std::back_inserter(output), 2));
+      CHECK(Access::called_lock);
+      CHECK(Access::called_unlock);
+
+      // Wraps around the end of the buffer.
+      CHECK_EQUAL(2U, queue.push(input + 4, input + 6));
+
+      CHECK_EQUAL(4U, queue.pop(std::back_inserter(output), 10));
+      CHECK(queue.empty());
+      CHECK_EQUAL(0U, queue.pop(std::back_inserter(output), 10));
+
+      int expected[] = { 1, 2, 3, 4, 5, 6 };
+      CHECK_ARRAY_EQUAL(expected, output.data(), 6);
+    }
+
+    //*************************************************************************
+    TEST(test_push_pop_range_from_isr)
+    {
+      etl::queue_spsc_isr<int, 4, Access> queue;
+
+      int input[] = { 1, 2, 3 };
+      int output[3];
+
+      Access::clear();
+      CHECK_EQUAL(3U, queue.push_from_isr(input, input + 3));
+      CHECK_EQUAL(3U, queue.pop_from_isr(output, 3));
+      CHECK(!Access::called_lock);
+      CHECK(!Access::called_unlock);
+
+      CHECK_ARRAY_EQUAL(input, output, 3);
+    }
+
+    //*************************************************************************
+    TEST(test_write_span_commit_read_span_release)
+    {
+      typedef etl::queue_spsc_isr<int, 5, Access> Queue;
+
+      Queue queue;
+
+      // Move the indexes to the middle of the buffer.
+      queue.push(0);
+      queue.push(0);
+      queue.push(0);
+      queue.pop();
+      queue.pop();
+      queue.pop();
+
+      Queue::span_pair_type free_space = queue.write_span();
+
+      CHECK_EQUAL(5U, free_space.size());
+      CHECK_EQUAL(2U, free_space.first.size());
+      CHECK_EQUAL(3U, free_space.second.size());
+
+      free_space.first[0]  = 1;
+      free_space.first[1]  = 2;
+      free_space.second[0] = 3;
+
+      // Nothing is visible until committed.
+      CHECK(queue.empty());
+
+      Access::clear();
+      queue.commit(3);
+      CHECK(Access::called_lock);
+      CHECK(Access::called_unlock);
+      CHECK_EQUAL(3U, queue.size());
+      CHECK_EQUAL(2U, queue.write_span().size());
+
+      Queue::span_pair_type items = queue.read_span();
+
+      CHECK_EQUAL(3U, items.size());
+      CHECK_EQUAL(2U, items.first.size());
+      CHECK_EQUAL(1U, items.second.size());
+      CHECK_EQUAL(1, items.first[0]);
+      CHECK_EQUAL(2, items.first[1]);
+      CHECK_EQUAL(3, items.second[0]);
+
+      queue.release(2);
+      CHECK_EQUAL(1U, queue.size());
+
+      int value;
+      CHECK(queue.pop(value));
+      CHECK_EQUAL(3, value);
+
+      CHECK(queue.read_span().empty());
+    }
+
+    //*************************************************************************
+    TEST(test_write_span_commit_from_isr)
+    {
+      typedef etl::queue_spsc_isr<int, 4, Access> Queue;
+
+      Queue queue;
+
+      Access::clear();
+
+      Queue::span_pair_type free_space = queue.write_span_from_isr();
+      CHECK_EQUAL(4U, free_space.first.size());
+      CHECK(free_space.second.empty());
+
+      free_space.first[0] = 1;
+      queue.commit_from_isr(1);
+
+      Queue::span_pair_type items = queue.read_span_from_isr();
+      CHECK_EQUAL(1U, items.size());
+      CHECK_EQUAL(1, items.first[0]);
+      queue.release_from_isr(1);
+
+      CHECK(queue.empty_from_isr());
+      CHECK(!Access::called_lock);
+      CHECK(!Access::called_unlock);
+    }
+
+    //*************************************************************************
+    TEST(test_commit_release_span_size)
+    {
+      typedef etl::queue_spsc_isr<int, 4, Access> Queue;
+
+      Queue queue;
+
+      // Nothing has been acquired yet.
+      Access::clear();
+      CHECK_THROW(queue.commit(1), etl::queue_spsc_isr_span_size);
+      CHECK_THROW(queue.release(1), etl::queue_spsc_isr_span_size);
+      CHECK_THROW(queue.commit_from_isr(1), etl::queue_spsc_isr_span_size);
+      CHECK_THROW(queue.release_from_isr(1), etl::queue_spsc_isr_span_size);
+
+      // The checks are made before the interrupts are disabled.
+      CHECK(!Access::called_lock);
+
+      Queue::span_pair_type free_space = queue.write_span();
+      CHECK_EQUAL(4U, free_space.size());
+
+      free_space.first[0] = 1;
+      free_space.first[1] = 2;
+
+      queue.commit(1);
+      CHECK_THROW(queue.commit(4), etl::queue_spsc_isr_span_size);
+      queue.commit_from_isr(1);
+      CHECK_EQUAL(2U, queue.size());
+
+      Queue::span_pair_type items = queue.read_span_from_isr();
+      CHECK_EQUAL(2U, items.size());
+
+      CHECK_THROW(queue.release_from_isr(3), etl::queue_spsc_isr_span_size);
+      queue.release(2);
+      CHECK_THROW(queue.release(1), etl::queue_spsc_isr_span_size);
+      CHECK(queue.empty());
+    }
+
     //=========================================================================
 #if REALTIME_TEST && defined(ETL_COMPILER_MICROSOFT)
   #if defined(ETL_TARGET_OS_WINDOWS) // Only Windows priority is currently supported
@@ -0,0 +1,300 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <set>
+#include <string>
+
+#include "etl/slab_allocator.h"
+#include "etl/variant_pool.h"
+
+namespace
+{
+  int destructed;
+
+  //***********************************
+  struct Base
+  {
+    virtual ~Base()
+    {
+      ++destructed;
+    }
+
+    virtual int value() const = 0;
+  };
+
+  //***********************************
+  struct Small : public Base
+  {
+    Small(int i_ = 1)
+      : i(i_)
+    {
+    }
+
+    int value() const
+    {
+      return i;
+    }
+
+    int i;
+  };
+
+  //***********************************
+  struct Medium : public Base
+  {
+    Medium(int a, int b)
+    {
+      data[0] = a;
+      data[7] = b;
+    }
+
+    int value() const
+    {
+      return data[0] + data[7];
+    }
+
+    int data[8];
+  };
+
+  //***********************************
+  struct Large : public Base
+  {
+    Large()
+    {
+      data[0]   = 100;
+      data[127] = 1;
+    }
+
+    int value() const
+    {
+      return data[0] + data[127];
+    }
+
+    int data[128];
+  };
+
+  typedef etl::slab_class<sizeof(Small),  4> SmallClass;
+  typedef etl::slab_class<sizeof(Medium), 3> MediumClass;
+  typedef etl::slab_class<sizeof(Large),  2> LargeClass;
+
+  typedef etl::slab_allocator<SmallClass, MediumClass, LargeClass> Slab;
+
+  SUITE(test_slab_allocator)
+  {
+    //*************************************************************************
+    TEST(test_natural_alignment)
+    {
+      CHECK_EQUAL(1U,  size_t(etl::slab_class<1,  1>::ALIGNMENT));
+      CHECK_EQUAL(4U,  size_t(etl::slab_class<12, 1>::ALIGNMENT));
+      CHECK_EQUAL(8U,  size_t(etl::slab_class<24, 1>::ALIGNMENT));
+      CHECK_EQUAL(size_t(etl::largest_alignment<int64_t, double, void*>::value), size_t(etl::slab_class<64, 1>::ALIGNMENT));
+      CHECK_EQUAL(2U,  size_t(etl::slab_class<64, 1, 2>::ALIGNMENT));
+    }
+
+    //*************************************************************************
+    TEST(test_class_routing)
+    {
+      Slab slab;
+
+      CHECK_EQUAL(3U, size_t(Slab::N_CLASSES));
+      CHECK_EQUAL(3U, slab.number_of_classes());
+
+      CHECK_EQUAL(0U, size_t(Slab::class_for<Small>::value));
+      CHECK_EQUAL(1U, size_t(Slab::class_for<Medium>::value));
+      CHECK_EQUAL(2U, size_t(Slab::class_for<Large>::value));
+      CHECK_EQUAL(0U, size_t(Slab::class_for<char>::value));
+
+      // The runtime lookup agrees.
+      CHECK_EQUAL(0U, slab.class_of<Small>());
+      CHECK_EQUAL(1U, slab.class_of<Medium>());
+      CHECK_EQUAL(2U, slab.class_of<Large>());
+      CHECK_EQUAL(1U, slab.class_index(sizeof(Small) + 1, 1));
+      CHECK_EQUAL(3U, slab.class_index(sizeof(Large) + 1, 1));
+
+      CHECK_EQUAL(sizeof(Small),  slab.item_size(0));
+      CHECK_EQUAL(sizeof(Medium), slab.item_size(1));
+      CHECK_EQUAL(sizeof(Large),  slab.item_size(2));
+    }
+
+    //*************************************************************************
+    TEST(test_create_destroy)
+    {
+      Slab slab;
+
+      Small*  ps = slab.create<Small>(5);
+      Medium* pm = slab.create<Medium>(2, 3);
+      Large*  pl = slab.create<Large>();
+
+      CHECK_EQUAL(5,   ps->value());
+      CHECK_EQUAL(5,   pm->value());
+      CHECK_EQUAL(101, pl->value());
+
+      CHECK(slab.get_pool(0).is_in_pool(ps));
+      CHECK(slab.get_pool(1).is_in_pool(pm));
+      CHECK(slab.get_pool(2).is_in_pool(pl));
+
+      CHECK_EQUAL(1U, slab.size(0));
+      CHECK_EQUAL(1U, slab.size(1));
+      CHECK_EQUAL(1U, slab.size(2));
+      CHECK_EQUAL(3U, slab.size());
+
+      // Through the base.
+      destructed = 0;
+      slab.destroy<Base>(ps);
+      slab.destroy<Base>(pm);
+      slab.destroy<Base>(pl);
+
+      CHECK_EQUAL(3, destructed);
+      CHECK(slab.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_occupancy)
+    {
+      Slab slab;
+
+      CHECK_EQUAL(9U, slab.max_size());
+      CHECK_EQUAL(9U, slab.available());
+      CHECK_EQUAL(4U, slab.max_size(0));
+      CHECK_EQUAL(3U, slab.max_size(1));
+      CHECK_EQUAL(2U, slab.max_size(2));
+
+      for (size_t i = 0; i < 4; ++i)
+      {
+        slab.create<Small>();
+      }
+
+      CHECK(slab.full<Small>());
+      CHECK(!slab.full<Medium>());
+      CHECK(!slab.full());
+      CHECK_EQUAL(0U, slab.available(0));
+      CHECK_EQUAL(3U, slab.available(1));
+      CHECK_EQUAL(5U, slab.available());
+
+      // A full class does not overflow in to the next.
+      CHECK_THROW(slab.create<Small>(), etl::pool_no_allocation);
+      CHECK_EQUAL(0U, slab.size(1));
+
+      slab.release_all();
+      CHECK(slab.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_capacity_bytes)
+    {
+      Slab slab;
+
+      CHECK(slab.capacity_bytes(0) >= 4 * sizeof(Small));
+      CHECK_EQUAL(slab.capacity_bytes(0) + slab.capacity_bytes(1) + slab.capacity_bytes(2), slab.capacity_bytes());
+
+      // Smaller than one class of the largest size.
+      CHECK(slab.capacity_bytes() < (9 * sizeof(Large)));
+    }
+
+    //*************************************************************************
+    TEST(test_release_not_in_slab)
+    {
+      Slab slab;
+      Small s;
+
+      CHECK(!slab.is_in_pool(&s));
+      CHECK_THROW(slab.release(&s), etl::slab_allocator_not_in_slab);
+    }
+
+    //*************************************************************************
+    TEST(test_interface)
+    {
+      Slab slab;
+      etl::islab_allocator& islab = slab;
+
+      Medium* pm = islab.create<Medium>(1, 2);
+      CHECK_EQUAL(1U, islab.size(1));
+
+      CHECK_THROW(islab.allocate<char[1024]>(), etl::slab_allocator_no_class);
+      CHECK(islab.full<char[1024]>());
+
+      islab.destroy(pm);
+      CHECK(islab.empty());
+    }
+
+    //*************************************************************************
+    TEST(test_alignment_routing)
+    {
+      // A class with too little alignment is skipped.
+      etl::slab_allocator<etl::slab_class<16, 2, 1>, etl::slab_class<32, 2> > slab;
+
+      CHECK_EQUAL(0U, slab.class_of<char[16]>());
+      CHECK_EQUAL(1U, slab.class_of<int>());
+
+      int* p = slab.create<int>(3);
+      CHECK_EQUAL(0U, uintptr_t(p) % etl::alignment_of<int>::value);
+      CHECK_EQUAL(1U, slab.size(1));
+      slab.destroy(p);
+    }
+
+    //*************************************************************************
+    TEST(test_variant_pool_ext)
+    {
+      Slab slab;
+      etl::variant_pool_ext<etl::islab_allocator, Small, Medium, Large> pool(slab);
+
+      Small*  ps = pool.create<Small>(7);
+      Medium* pm = pool.create<Medium>(1, 1);
+      Large*  pl = pool.create<Large>();
+
+      CHECK_EQUAL(7, ps->value());
+      CHECK_EQUAL(2, pm->value());
+      CHECK_EQUAL(101, pl->value());
+
+      CHECK_EQUAL(3U, pool.size());
+      CHECK_EQUAL(1U, slab.size(2));
+
+      // The large class only has two.
+      CHECK(pool.create<Large>() != nullptr);
+      CHECK_THROW(pool.create<Large>(), etl::variant_pool_cannot_create);
+
+      CHECK(pool.destroy<Base>(ps));
+      CHECK(pool.destroy<Base>(pm));
+      CHECK(pool.destroy<Base>(pl));
+    }
+
+    //*************************************************************************
+    TEST(test_variant_pool_ext_concrete)
+    {
+      Slab slab;
+      etl::variant_pool_ext<Slab, Small, Medium> pool(slab);
+
+      Small* ps = pool.create<Small>();
+
+      CHECK(slab.get_pool(Slab::class_for<Small>::value).is_in_pool(ps));
+      CHECK(pool.destroy(ps));
+      CHECK(pool.empty());
+    }
+  };
+}
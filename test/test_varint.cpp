@@ -0,0 +1,261 @@
+/******************************************************************************
+The MIT License(MIT)
+
+Embedded Template Library.
+https://github.com/ETLCPP/etl
+http://www.etlcpp.com
+
+Copyright(c) 2018 jwellbelove
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files(the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and / or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions :
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "UnitTest++.h"
+
+#include <stdint.h>
+#include <vector>
+
+#include "etl/varint.h"
+
+namespace
+{
+  //***************************************************************************
+  // The reference encoder, one byte at a time.
+  //***************************************************************************
+  std::vector<unsigned char> reference_encode(uint64_t value)
+  {
+    std::vector<unsigned char> bytes;
+
+    do
+    {
+      unsigned char b = value & 0x7F;
+      value >>= 7;
+      bytes.push_back((value != 0) ? (b | 0x80) : b);
+    } while (value != 0);
+
+    return bytes;
+  }
+
+  //***************************************************************************
+  // A spread of values with every encoded length.
+  //***************************************************************************
+  std::vector<uint64_t> test_values()
+  {
+    std::vector<uint64_t> values;
+
+    for (int bit = 0; bit < 64; ++bit)
+    {
+      uint64_t power = uint64_t(1) << bit;
+      values.push_back(power - 1);
+      values.push_back(power);
+      values.push_back(power + 1);
+    }
+
+    values.push_back(UINT64_MAX);
+
+    uint64_t x = 0x123456789ABCDEF1ULL;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+      values.push_back(x >> (i % 64));
+    }
+
+    return values;
+  }
+
+  SUITE(test_varint)
+  {
+    //*************************************************************************
+    TEST(test_zigzag)
+    {
+      CHECK_EQUAL(0U, etl::zigzag::encode(int32_t(0)));
+      CHECK_EQUAL(1U, etl::zigzag::encode(int32_t(-1)));
+      CHECK_EQUAL(2U, etl::zigzag::encode(int32_t(1)));
+      CHECK_EQUAL(3U, etl::zigzag::encode(int32_t(-2)));
+      CHECK_EQUAL(0xFFFFFFFEU, etl::zigzag::encode(INT32_MAX));
+      CHECK_EQUAL(0xFFFFFFFFU, etl::zigzag::encode(INT32_MIN));
+      CHECK_EQUAL(UINT64_MAX, etl::zigzag::encode(INT64_MIN));
+
+      const int64_t values[] = { 0, 1, -1, 63, -64, 64, -65, INT64_MAX, INT64_MIN, 1234567890123LL, -1234567890123LL };
+
+      for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+      {
+        CHECK_EQUAL(values[i], etl::zigzag::decode(etl::zigzag::encode(values[i])));
+      }
+
+      for (int i = INT8_MIN; i <= INT8_MAX; ++i)
+      {
+        CHECK_EQUAL(int8_t(i), etl::zigzag::decode(etl::zigzag::encode(int8_t(i))));
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_zigzag_range)
+    {
+      const int32_t values[] = { 0, -1, 1, -2, 2, INT32_MIN, INT32_MAX };
+      uint32_t encoded[7];
+      int32_t  decoded[7];
+
+      uint32_t* encoded_end = etl::zigzag::encode(values, values + 7, encoded);
+      int32_t*  decoded_end = etl::zigzag::decode(encoded, encoded_end, decoded);
+
+      CHECK_EQUAL(encoded + 7, encoded_end);
+      CHECK_EQUAL(decoded + 7, decoded_end);
+      CHECK_ARRAY_EQUAL(values, decoded, 7);
+      CHECK_EQUAL(3U, encoded[3]);
+    }
+
+    //*************************************************************************
+    TEST(test_size)
+    {
+      CHECK_EQUAL(1U, etl::varint::size(uint32_t(0)));
+      CHECK_EQUAL(1U, etl::varint::size(uint32_t(127)));
+      CHECK_EQUAL(2U, etl::varint::size(uint32_t(128)));
+      CHECK_EQUAL(5U, etl::varint::size(UINT32_MAX));
+      CHECK_EQUAL(10U, etl::varint::size(UINT64_MAX));
+
+      CHECK_EQUAL(2U, size_t(etl::varint::max_size<uint8_t>::value));
+      CHECK_EQUAL(3U, size_t(etl::varint::max_size<uint16_t>::value));
+      CHECK_EQUAL(5U, size_t(etl::varint::max_size<uint32_t>::value));
+      CHECK_EQUAL(10U, size_t(etl::varint::max_size<uint64_t>::value));
+    }
+
+    //*************************************************************************
+    TEST(test_encode_decode_matches_reference)
+    {
+      std::vector<uint64_t> values = test_values();
+
+      for (size_t i = 0; i < values.size(); ++i)
+      {
+        std::vector<unsigned char> expected = reference_encode(values[i]);
+
+        // Room for the fast path, and exactly enough room.
+        unsigned char buffer[16] = { 0 };
+        size_t lengths[] = { sizeof(buffer), expected.size() };
+
+        for (size_t l = 0; l < 2; ++l)
+        {
+          memset(buffer, 0xFF, sizeof(buffer));
+
+          CHECK_EQUAL(expected.size(), etl::varint::encode(values[i], buffer, lengths[l]));
+          CHECK_ARRAY_EQUAL(expected.data(), buffer, expected.size());
+
+          uint64_t decoded = 0;
+          CHECK_EQUAL(expected.size(), etl::varint::decode(buffer, lengths[l], decoded));
+          CHECK_EQUAL(values[i], decoded);
+        }
+      }
+    }
+
+    //*************************************************************************
+    TEST(test_encode_short_buffer)
+    {
+      unsigned char buffer[4] = { 0 };
+
+      CHECK_EQUAL(0U, etl::varint::encode(uint32_t(0x10000000), buffer, 4));
+      CHECK_EQUAL(4U, etl::varint::encode(uint32_t(0x0FFFFFFF), buffer, 4));
+      CHECK_EQUAL(0U, etl::varint::encode(uint32_t(1), buffer, 0));
+    }
+
+    //*************************************************************************
+    TEST(test_decode_invalid)
+    {
+      uint32_t value32 = 0;
+      uint64_t value64 = 0;
+      uint8_t  value8  = 0;
+
+      // No terminator before the end of the buffer.
+      const unsigned char truncated[] = { 0x80, 0x80, 0x80 };
+      CHECK_EQUAL(0U, etl::varint::decode(truncated, sizeof(truncated), value32));
+
+      // No terminator within ten bytes.
+      const unsigned char too_long[] = { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x00, 0, 0, 0, 0, 0 };
+      CHECK_EQUAL(0U, etl::varint::decode(too_long, sizeof(too_long), value64));
+
+      // The tenth byte holds more than one bit.
+      const unsigned char overflow64[] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x02, 0, 0, 0, 0, 0, 0 };
+      CHECK_EQUAL(0U, etl::varint::decode(overflow64, sizeof(overflow64), value64));
+      CHECK_EQUAL(0U, etl::varint::decode(overflow64, 10, value64));
+
+      // Too large for the type.
+      const unsigned char overflow32[] = { 0x80, 0x80, 0x80, 0x80, 0x10, 0, 0, 0 };
+      CHECK_EQUAL(0U, etl::varint::decode(overflow32, sizeof(overflow32), value32));
+      CHECK_EQUAL(5U, etl::varint::decode(overflow32, sizeof(overflow32), value64));
+      CHECK_EQUAL(0x100000000ULL, value64);
+
+      const unsigned char overflow8[] = { 0x80, 0x02 };
+      CHECK_EQUAL(0U, etl::varint::decode(overflow8, sizeof(overflow8), value8));
+
+      const unsigned char max8[] = { 0xFF, 0x01 };
+      CHECK_EQUAL(2U, etl::varint::decode(max8, sizeof(max8), value8));
+      CHECK_EQUAL(255U, value8);
+    }
+
+    //*************************************************************************
+    TEST(test_encode_decode_range)
+    {
+      std::vector<uint64_t> values = test_values();
+      std::vector<unsigned char> buffer(values.size() * 10);
+      std::vector<unsigned char> expected;
+
+      for (size_t i = 0; i < values.size(); ++i)
+      {
+        std::vector<unsigned char> bytes = reference_encode(values[i]);
+        expected.insert(expected.end(), bytes.begin(), bytes.end());
+      }
+
+      size_t used = etl::varint::encode(values.begin(), values.end(), buffer.data(), buffer.size());
+
+      CHECK_EQUAL(expected.size(), used);
+      CHECK_ARRAY_EQUAL(expected.data(), buffer.data(), used);
+
+      // Too short for all of them.
+      CHECK_EQUAL(0U, etl::varint::encode(values.begin(), values.end(), buffer.data(), used - 1));
+
+      std::vector<uint64_t> decoded(values.size());
+      CHECK_EQUAL(used, etl::varint::decode(buffer.data(), used, decoded.begin(), decoded.size()));
+      CHECK(values == decoded);
+
+      // One more than there are.
+      decoded.push_back(0);
+      CHECK_EQUAL(0U, etl::varint::decode(buffer.data(), used, decoded.begin(), decoded.size()));
+    }
+
+    //*************************************************************************
+    TEST(test_zigzag_varint)
+    {
+      const int32_t values[] = { 0, -1, 1, -64, 63, -65, 64, INT32_MIN, INT32_MAX };
+      const size_t  sizes[]  = { 1,  1, 1,   1,  1,   2,  2,         5,         5 };
+
+      for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+      {
+        unsigned char buffer[8];
+
+        CHECK_EQUAL(sizes[i], etl::varint::encode(etl::zigzag::encode(values[i]), buffer, sizeof(buffer)));
+
+        uint32_t encoded = 0;
+        CHECK_EQUAL(sizes[i], etl::varint::decode(buffer, sizeof(buffer), encoded));
+        CHECK_EQUAL(values[i], etl::zigzag::decode(encoded));
+      }
+    }
+  };
+}
@@ -35,6 +35,51 @@ SOFTWARE.
 
 #include "etl/vector.h"
 
+namespace
+{
+  //***************************************************************************
+  // A type with a user defined copy constructor that may be moved with memmove.
+  //***************************************************************************
+  struct Relocatable
+  {
+    Relocatable(int value_ = 0)
+      : value(value_)
+    {
+    }
+
+    Relocatable(const Relocatable& other)
+      : value(other.value)
+    {
+      ++copies;
+    }
+
+    Relocatable& operator =(const Relocatable& other)
+    {
+      value = other.value;
+      ++copies;
+      return *this;
+    }
+
+    bool operator ==(const Relocatable& other) const
+    {
+      return value == other.value;
+    }
+
+    int value;
+    static int copies;
+  };
+
+  int Relocatable::copies = 0;
+}
+
+namespace etl
+{
+  template <>
+  struct is_trivially_relocatable<Relocatable> : etl::true_type
+  {
+  };
+}
+
 namespace
 {
   SUITE(test_vector)
@@ -1036,5 +1081,77 @@ namespace
 
       CHECK(!is_equal);
     }
+
+    //*************************************************************************
+    TEST(test_is_trivially_relocatable)
+    {
+      CHECK(etl::is_trivially_relocatable<int>::value);
+      CHECK(etl::is_trivially_relocatable<int*>::value);
+      CHECK(etl::is_trivially_relocatable<Relocatable>::value);
+      CHECK(!etl::is_trivially_relocatable<std::vector<int> >::value);
+    }
+
+    //*************************************************************************
+    TEST(test_relocatable_insert_erase)
+    {
+      etl::vector<Relocatable, 32> data;
+      std::vector<Relocatable> compare_data;
+
+      for (int i = 0; i < 8; ++i)
+      {
+        data.push_back(Relocatable(i));
+        compare_data.push_back(Relocatable(i));
+      }
+
+      for (size_t offset = 0; offset <= data.size(); ++offset)
+      {
+        // Only the inserted value is copied.
+        Relocatable::copies = 0;
+        data.insert(data.begin() + offset, Relocatable(100));
+        CHECK_EQUAL(1, Relocatable::copies);
+        compare_data.insert(compare_data.begin() + offset, Relocatable(100));
+        CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+
+        // Erasing copies nothing.
+        Relocatable::copies = 0;
+        data.erase(data.begin() + offset);
+        CHECK_EQUAL(0, Relocatable::copies);
+        compare_data.erase(compare_data.begin() + offset);
+        CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+      }
+
+      data.emplace(data.begin() + 3, 200);
+      compare_data.insert(compare_data.begin() + 3, Relocatable(200));
+      data.insert(data.begin() + 1, 3, Relocatable(300));
+      compare_data.insert(compare_data.begin() + 1, 3, Relocatable(300));
+      data.insert(data.begin() + 5, compare_data.begin(), compare_data.begin() + 4);
+      compare_data.insert(compare_data.begin() + 5, data.begin(), data.begin() + 4);
+      data.erase(data.begin() + 2, data.begin() + 7);
+      compare_data.erase(compare_data.begin() + 2, compare_data.begin() + 7);
+
+      CHECK_EQUAL(compare_data.size(), data.size());
+      CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+    }
+
+    //*************************************************************************
+    TEST(test_relocatable_insert_aliased_value)
+    {
+      etl::vector<Relocatable, 32> data;
+
+      for (int i = 0; i < 8; ++i)
+      {
+        data.push_back(Relocatable(i));
+      }
+
+      // The value is inside the range being shifted.
+      data.insert(data.begin() + 2, data[5]);
+      CHECK_EQUAL(5, data[2].value);
+      CHECK_EQUAL(5, data[6].value);
+
+      data.insert(data.begin() + 1, 2, data[7]);
+      CHECK_EQUAL(6, data[1].value);
+      CHECK_EQUAL(6, data[2].value);
+      CHECK_EQUAL(11U, data.size());
+    }
   };
 }
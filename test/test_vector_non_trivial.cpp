@@ -975,6 +975,46 @@ namespace
       }
     }
 
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_position_n_value_long_tail)
+    {
+      // More elements after the insert position than are inserted.
+      const size_t INITIAL_SIZE = 8;
+      const size_t INSERT_SIZE  = 2;
+      const NDC INITIAL_VALUE("1");
+
+      for (size_t offset = 0; offset <= INITIAL_SIZE; ++offset)
+      {
+        CompareDataNDC compare_data(initial_data.begin(), initial_data.begin() + INITIAL_SIZE);
+        DataNDC data(initial_data.begin(), initial_data.begin() + INITIAL_SIZE);
+
+        data.insert(data.begin() + offset, INSERT_SIZE, INITIAL_VALUE);
+        compare_data.insert(compare_data.begin() + offset, INSERT_SIZE, INITIAL_VALUE);
+
+        CHECK_EQUAL(compare_data.size(), data.size());
+        CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+      }
+    }
+
+    //*************************************************************************
+    TEST_FIXTURE(SetupFixture, test_insert_position_range_long_tail)
+    {
+      // More elements after the insert position than are inserted.
+      const size_t INITIAL_SIZE = 8;
+
+      for (size_t offset = 0; offset <= INITIAL_SIZE; ++offset)
+      {
+        CompareDataNDC compare_data(initial_data.begin(), initial_data.begin() + INITIAL_SIZE);
+        DataNDC data(initial_data.begin(), initial_data.begin() + INITIAL_SIZE);
+
+        data.insert(data.begin() + offset, insert_data.begin(), insert_data.begin() + 2);
+        compare_data.insert(compare_data.begin() + offset, insert_data.begin(), insert_data.begin() + 2);
+
+        CHECK_EQUAL(compare_data.size(), data.size());
+        CHECK(std::equal(data.begin(), data.end(), compare_data.begin()));
+      }
+    }
+
     //*************************************************************************
     TEST_FIXTURE(SetupFixture, test_insert_position_n_value_excess)
     {